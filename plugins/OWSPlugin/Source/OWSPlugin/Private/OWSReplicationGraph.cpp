@@ -5,23 +5,67 @@
 #include "CoreGlobals.h"
 #include "UObject/UObjectIterator.h"
 #include "Engine/NetConnection.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "OWSCharacter.h"
+#include "OWSAdvancedProjectile.h"
+#include "OWSInventoryItem.h"
+#include "OWSAbilityActor.h"
+#include "OWSEnvironmentAbilityActor.h"
 
 UOWSReplicationGraph::UOWSReplicationGraph()
 {
-
+	// Defaults for the plugin's own classes.  ClassReplicationRules in DefaultEngine.ini replaces these.
+	ClassReplicationRules.Emplace(AOWSCharacter::StaticClass(), EOWSClassRepNodeMapping::Spatialize_Dynamic, -1.f, -1, -1.f);
+	ClassReplicationRules.Emplace(AOWSAdvancedProjectile::StaticClass(), EOWSClassRepNodeMapping::Spatialize_Dynamic, -1.f, 1, 2.f);
+	ClassReplicationRules.Emplace(AOWSInventoryItem::StaticClass(), EOWSClassRepNodeMapping::RelevantToOwner, -1.f, -1, -1.f);
+	ClassReplicationRules.Emplace(AOWSAbilityActor::StaticClass(), EOWSClassRepNodeMapping::Spatialize_Dormancy, -1.f, -1, -1.f);
+	ClassReplicationRules.Emplace(AOWSEnvironmentAbilityActor::StaticClass(), EOWSClassRepNodeMapping::Spatialize_Static, -1.f, -1, -1.f);
 }
 
 void UOWSReplicationGraph::InitGlobalActorClassSettings()
 {
 	Super::InitGlobalActorClassSettings();
 
+	// Resolve the rule table once up front rather than per class
+	TMap<UClass*, const FOWSClassReplicationRule*> RulesByClass;
+	for (const FOWSClassReplicationRule& Rule : ClassReplicationRules)
+	{
+		if (UClass* RuleClass = Rule.ActorClass.LoadSynchronous())
+		{
+			RulesByClass.Add(RuleClass, &Rule);
+		}
+		else
+		{
+			UE_LOG(LogNet, Warning, TEXT("UOWSReplicationGraph: Could not load class %s from ClassReplicationRules."), *Rule.ActorClass.ToString());
+		}
+	}
+
+	auto FindRule = [&RulesByClass](UClass* Class) -> const FOWSClassReplicationRule*
+	{
+		for (UClass* RuleClass = Class; RuleClass; RuleClass = RuleClass->GetSuperClass())
+		{
+			if (const FOWSClassReplicationRule* Rule = RulesByClass.FindRef(RuleClass))
+			{
+				return Rule;
+			}
+		}
+		return nullptr;
+	};
+
+	// Player states are routed to UOWSReplicationGraphNode_PlayerStateFrequencyLimiter, and subclasses inherit these settings
+	FClassReplicationInfo PlayerStateRepInfo;
+	PlayerStateRepInfo.DistancePriorityScale = 0.f;
+	PlayerStateRepInfo.ActorChannelFrameTimeout = 0;
+	GlobalActorReplicationInfoMap.SetClassInfo(APlayerState::StaticClass(), PlayerStateRepInfo);
+
 	// ReplicationGraph stores internal associative data for actor classes. 
 	// We build this data here based on actor CDO values.
 	for (TObjectIterator<UClass> It; It; ++It)
 	{
 		UClass* Class = *It;
 		AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
-		if (!ActorCDO || !ActorCDO->GetIsReplicated())
+		if (!ActorCDO || !ActorCDO->GetIsReplicated() || Class->IsChildOf(APlayerState::StaticClass()))
 		{
 			continue;
 		}
@@ -32,35 +76,72 @@ void UOWSReplicationGraph::InitGlobalActorClassSettings()
 			continue;
 		}
 
+		const FOWSClassReplicationRule* Rule = FindRule(Class);
+
+		EOWSClassRepNodeMapping NodeMapping;
+		if (Rule)
+		{
+			NodeMapping = Rule->NodeMapping;
+		}
+		else if (ActorCDO->bAlwaysRelevant)
+		{
+			NodeMapping = EOWSClassRepNodeMapping::RelevantAllConnections;
+		}
+		else if (ActorCDO->bOnlyRelevantToOwner)
+		{
+			NodeMapping = EOWSClassRepNodeMapping::RelevantToOwner;
+		}
+		else
+		{
+			NodeMapping = EOWSClassRepNodeMapping::Spatialize_Dormancy;
+		}
+
+		ClassRepNodePolicies.Set(Class, NodeMapping);
+
 		FClassReplicationInfo ClassInfo;
 
 		// Replication Graph is frame based. Convert NetUpdateFrequency to ReplicationPeriodFrame based on Server MaxTickRate.
-		ClassInfo.ReplicationPeriodFrame = FMath::Max<uint32>((uint32)FMath::RoundToFloat(NetDriver->NetServerMaxTickRate / ActorCDO->NetUpdateFrequency), 1);
+		if (Rule && Rule->ReplicationPeriodFrame >= 0)
+		{
+			ClassInfo.ReplicationPeriodFrame = FMath::Max(Rule->ReplicationPeriodFrame, 1);
+		}
+		else
+		{
+			ClassInfo.ReplicationPeriodFrame = FMath::Max<uint32>((uint32)FMath::RoundToFloat(NetDriver->NetServerMaxTickRate / ActorCDO->NetUpdateFrequency), 1);
+		}
 
-		if (ActorCDO->bAlwaysRelevant || ActorCDO->bOnlyRelevantToOwner)
+		if (NodeMapping == EOWSClassRepNodeMapping::RelevantAllConnections || NodeMapping == EOWSClassRepNodeMapping::RelevantToOwner)
 		{
 			ClassInfo.SetCullDistanceSquared(0.f);
 		}
+		else if (Rule && Rule->CullDistance >= 0.f)
+		{
+			ClassInfo.SetCullDistanceSquared(FMath::Square(Rule->CullDistance));
+		}
 		else
 		{
 			ClassInfo.SetCullDistanceSquared(ActorCDO->NetCullDistanceSquared);
 		}
 
-		TArray<UClass*> ExplicitlySetClasses;
-		auto SetClassInfo = [&](UClass* Class, const FClassReplicationInfo& Info) { GlobalActorReplicationInfoMap.SetClassInfo(Class, Info); ExplicitlySetClasses.Add(Class); };
-
-		FClassReplicationInfo PlayerStateRepInfo;
-		PlayerStateRepInfo.DistancePriorityScale = 0.f;
-		PlayerStateRepInfo.ActorChannelFrameTimeout = 0;
-		SetClassInfo(APlayerState::StaticClass(), PlayerStateRepInfo);
-
-		if (Class != APlayerState::StaticClass())
+		if (Rule && Rule->StarvationPriorityScale >= 0.f)
 		{
-			GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+			ClassInfo.StarvationPriorityScale = Rule->StarvationPriorityScale;
 		}
+
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
 	}
 }
 
+EOWSClassRepNodeMapping UOWSReplicationGraph::GetMappingPolicy(UClass* Class)
+{
+	// Classes loaded after InitGlobalActorClassSettings use their closest parent's policy
+	if (const EOWSClassRepNodeMapping* Policy = ClassRepNodePolicies.Get(Class))
+	{
+		return *Policy;
+	}
+	return EOWSClassRepNodeMapping::Spatialize_Dormancy;
+}
+
 void UOWSReplicationGraph::InitGlobalGraphNodes()
 {
 	// -----------------------------------------------
@@ -82,7 +163,7 @@ void UOWSReplicationGraph::InitGlobalGraphNodes()
 	// -----------------------------------------------
 	//	Player State specialization. This will return a rolling subset of the player states to replicate
 	// -----------------------------------------------
-	UOWSReplicationGraphNode_PlayerStateFrequencyLimiter* PlayerStateNode = CreateNewNode<UOWSReplicationGraphNode_PlayerStateFrequencyLimiter>();
+	PlayerStateNode = CreateNewNode<UOWSReplicationGraphNode_PlayerStateFrequencyLimiter>();
 	AddGlobalGraphNode(PlayerStateNode);
 }
 
@@ -98,30 +179,56 @@ void UOWSReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnecti
 
 void UOWSReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
 {
-	if (ActorInfo.Actor->bAlwaysRelevant)
+	// Player states are always relevant, but replicate through the frequency limiter rather than to everyone every frame
+	if (ActorInfo.Actor->IsA<APlayerState>())
 	{
-		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		PlayerStateNode->NotifyAddNetworkActor(ActorInfo);
+		return;
 	}
-	else if (ActorInfo.Actor->bOnlyRelevantToOwner)
+
+	switch (GetMappingPolicy(ActorInfo.Class))
 	{
+	case EOWSClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+
+	case EOWSClassRepNodeMapping::RelevantToOwner:
 		ActorsWithoutNetConnection.Add(ActorInfo.Actor);
-	}
-	else
-	{
-		// Note that UReplicationGraphNode_GridSpatialization2D has 3 methods for adding actor based on the mobility of the actor. Since AActor lacks this information, we will
-		// add all spatialized actors as dormant actors: meaning they will be treated as possibly dynamic (moving) when not dormant, and as static (not moving) when dormant.
+		break;
+
+	case EOWSClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+
+	case EOWSClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+
+	case EOWSClassRepNodeMapping::Spatialize_Dormancy:
+		// Treated as possibly dynamic (moving) when not dormant, and as static (not moving) when dormant.
 		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+
+	default:
+		break;
 	}
 }
 
 void UOWSReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
 {
-	if (ActorInfo.Actor->bAlwaysRelevant)
+	if (ActorInfo.Actor->IsA<APlayerState>())
 	{
-		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		PlayerStateNode->NotifyRemoveNetworkActor(ActorInfo);
+		return;
 	}
-	else if (ActorInfo.Actor->bOnlyRelevantToOwner)
+
+	switch (GetMappingPolicy(ActorInfo.Class))
 	{
+	case EOWSClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+
+	case EOWSClassRepNodeMapping::RelevantToOwner:
 		if (ActorInfo.Actor->GetNetConnection())
 		{
 			if (UReplicationGraphNode* Node = GetAlwaysRelevantNodeForConnection(ActorInfo.Actor->GetNetConnection()))
@@ -129,10 +236,23 @@ void UOWSReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedAc
 				Node->NotifyRemoveNetworkActor(ActorInfo);
 			}
 		}
-	}
-	else
-	{
+		ActorsWithoutNetConnection.RemoveSwap(ActorInfo.Actor);
+		break;
+
+	case EOWSClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+
+	case EOWSClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+
+	case EOWSClassRepNodeMapping::Spatialize_Dormancy:
 		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+
+	default:
+		break;
 	}
 }
 
@@ -231,6 +351,8 @@ void UOWSReplicationGraph::AddPlayerToParty(AOWSPlayerState* PS)
 			PartyNode->PlayerStates.AddUnique(PS);
 			AddConnectionGraphNode(PartyNode, NetConnection);
 		}
+
+		PlayerStateNode->NotifyPartyChanged(PS);
 	}
 }
 
@@ -241,39 +363,208 @@ UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::UOWSReplicationGraphNode_P
 	bRequiresPrepareForReplicationCall = true;
 }
 
-void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplication()
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
 {
-	QUICK_SCOPE_CYCLE_COUNTER(UOWSReplicationGraphNode_PlayerStateFrequencyLimiter_GlobalPrepareForReplication);
+	APlayerState* PS = Cast<APlayerState>(ActorInfo.Actor);
+	if (PS && !PlayerStateIndices.Contains(PS))
+	{
+		PlayerStateIndices.Add(PS, PlayerStates.Add(PS));
+		bBucketsDirty = true;
+		bPartyListsDirty = true;
+	}
+}
 
+bool UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	APlayerState* PS = Cast<APlayerState>(ActorInfo.Actor);
+
+	int32 Index;
+	if (!PS || !PlayerStateIndices.RemoveAndCopyValue(PS, Index))
+	{
+		return false;
+	}
+
+	// Keep the list compact by moving the last player state into the hole
+	PlayerStates.RemoveAtSwap(Index, 1, false);
+	if (Index < PlayerStates.Num())
+	{
+		PlayerStateIndices[PlayerStates[Index]] = Index;
+	}
+
+	bBucketsDirty = true;
+	bPartyListsDirty = true;
+
+	// The cells are only refreshed periodically, so drop it from its cell now rather than hand a destroyed actor to the driver
+	for (TPair<FIntPoint, FActorRepListRefView>& Cell : NearbyCells)
+	{
+		Cell.Value.Remove(PS);
+	}
+
+	return true;
+}
+
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyResetAllNetworkActors()
+{
+	PlayerStates.Reset();
+	PlayerStateIndices.Reset();
 	ReplicationActorLists.Reset();
-	ForceNetUpdateReplicationActorList.Reset();
+	PartyLists.Reset();
+	NearbyCells.Reset();
+	bBucketsDirty = true;
+	bPartyListsDirty = true;
+}
+
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyPartyChanged(APlayerState* PlayerState)
+{
+	if (PlayerStateIndices.Contains(PlayerState))
+	{
+		bPartyListsDirty = true;
+	}
+}
+
+FIntPoint UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / NearbyCellSize), FMath::FloorToInt(Location.Y / NearbyCellSize));
+}
+
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::RebuildBuckets()
+{
+	// Spread the player states evenly so every bucket holds about TargetActorsPerFrame of them
+	const int32 NumBuckets = FMath::Max(1, FMath::DivideAndRoundUp(PlayerStates.Num(), TargetActorsPerFrame));
+
+	ReplicationActorLists.SetNum(NumBuckets);
+	for (FActorRepListRefView& List : ReplicationActorLists)
+	{
+		List.PrepareForWrite();
+	}
+
+	int32 ValidIndex = 0;
+	for (APlayerState* PS : PlayerStates)
+	{
+		if (IsActorValidForReplicationGather(PS))
+		{
+			ReplicationActorLists[ValidIndex++ % NumBuckets].Add(PS);
+		}
+	}
+}
 
-	ReplicationActorLists.AddDefaulted();
-	FActorRepListRefView* CurrentList = &ReplicationActorLists[0];
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::RebuildPartyLists()
+{
+	for (TPair<int32, FActorRepListRefView>& Party : PartyLists)
+	{
+		Party.Value.PrepareForWrite();
+	}
+
+	for (APlayerState* PS : PlayerStates)
+	{
+		AOWSPlayerState* OWSPlayerState = Cast<AOWSPlayerState>(PS);
+		if (OWSPlayerState && OWSPlayerState->AlwaysRelevantPartyID != 0 && IsActorValidForReplicationGather(PS))
+		{
+			FActorRepListRefView& PartyList = PartyLists.FindOrAdd(OWSPlayerState->AlwaysRelevantPartyID);
+			if (!PartyList.IsValid())
+			{
+				PartyList.PrepareForWrite();
+			}
+			PartyList.Add(PS);
+		}
+	}
+}
 
-	// We rebuild our lists of player states each frame. This is not as efficient as it could be but its the simplest way
-	// to handle players disconnecting and keeping the lists compact. If the lists were persistent we would need to defrag them as players left.
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::RebuildNearbyCells()
+{
+	for (TPair<FIntPoint, FActorRepListRefView>& Cell : NearbyCells)
+	{
+		Cell.Value.PrepareForWrite();
+	}
 
-	for (TActorIterator<APlayerState> It(GetWorld()); It; ++It)
+	for (APlayerState* PS : PlayerStates)
 	{
-		APlayerState* PS = *It;
-		if (IsActorValidForReplicationGather(PS) == false)
+		// Buckets and party lists only rebuild when someone joins, leaves or changes party.  This periodic pass is where they
+		// find out that a player state they hold has stopped being valid to gather (e.g. torn off or pending kill).
+		if (!IsActorValidForReplicationGather(PS))
 		{
+			bBucketsDirty = true;
+			bPartyListsDirty = true;
 			continue;
 		}
 
-		if (CurrentList->Num() >= TargetActorsPerFrame)
+		if (APawn* Pawn = PS->GetPawn())
+		{
+			FActorRepListRefView& CellList = NearbyCells.FindOrAdd(GetCell(Pawn->GetActorLocation()));
+			if (!CellList.IsValid())
+			{
+				CellList.PrepareForWrite();
+			}
+			CellList.Add(PS);
+		}
+	}
+
+	// Drop cells nobody has stood in since the last rebuild so the map follows where the players are
+	for (auto It = NearbyCells.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Num() == 0)
 		{
-			ReplicationActorLists.AddDefaulted();
-			CurrentList = &ReplicationActorLists.Last();
+			It.RemoveCurrent();
 		}
+	}
+}
+
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplication()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(UOWSReplicationGraphNode_PlayerStateFrequencyLimiter_GlobalPrepareForReplication);
+
+	// Nothing to do on frames where no player joined, left or changed party, except the periodic nearby refresh
+
+	if (bBucketsDirty)
+	{
+		RebuildBuckets();
+		bBucketsDirty = false;
+	}
 
-		CurrentList->Add(PS);
+	if (bPartyListsDirty)
+	{
+		RebuildPartyLists();
+		bPartyListsDirty = false;
+	}
+
+	if (PreparedFrames++ % FMath::Max(NearbyReplicationPeriodFrames, 1) == 0)
+	{
+		RebuildNearbyCells();
 	}
 }
 
 void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
 {
+	if (ReplicationActorLists.Num() == 0)
+	{
+		return;
+	}
+
+	// Party members first, then nearby players.  The driver skips anything already replicated to this connection this frame.
+	const APlayerController* ViewingController = Params.ConnectionManager.NetConnection ? Params.ConnectionManager.NetConnection->PlayerController : nullptr;
+	const AOWSPlayerState* ViewingPlayerState = ViewingController ? Cast<AOWSPlayerState>(ViewingController->PlayerState) : nullptr;
+	if (ViewingPlayerState && ViewingPlayerState->AlwaysRelevantPartyID != 0)
+	{
+		if (const FActorRepListRefView* PartyList = PartyLists.Find(ViewingPlayerState->AlwaysRelevantPartyID))
+		{
+			if (PartyList->Num() > 0)
+			{
+				Params.OutGatheredReplicationLists.AddReplicationActorList(*PartyList);
+			}
+		}
+	}
+
+	if (Params.ReplicationFrameNum % FMath::Max(NearbyReplicationPeriodFrames, 1) == 0 && Params.Viewers.Num() > 0)
+	{
+		if (const FActorRepListRefView* CellList = NearbyCells.Find(GetCell(Params.Viewers[0].ViewLocation)))
+		{
+			if (CellList->Num() > 0)
+			{
+				Params.OutGatheredReplicationLists.AddReplicationActorList(*CellList);
+			}
+		}
+	}
+
 	const int32 ListIdx = Params.ReplicationFrameNum % ReplicationActorLists.Num();
 	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorLists[ListIdx]);
 
@@ -294,6 +585,11 @@ void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::LogNode(FReplicationG
 		LogActorRepList(DebugInfo, FString::Printf(TEXT("Bucket[%d]"), i++), List);
 	}
 
+	for (const TPair<int32, FActorRepListRefView>& Party : PartyLists)
+	{
+		LogActorRepList(DebugInfo, FString::Printf(TEXT("Party[%d]"), Party.Key), Party.Value);
+	}
+
 	DebugInfo.PopIndent();
 }
 
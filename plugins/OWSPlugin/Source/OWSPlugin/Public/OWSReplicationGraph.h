@@ -7,6 +7,49 @@
 #include "OWSPlayerState.h"
 #include "OWSReplicationGraph.generated.h"
 
+class UOWSReplicationGraphNode_PlayerStateFrequencyLimiter;
+
+/** Which graph node an actor class is routed to */
+UENUM()
+enum class EOWSClassRepNodeMapping : uint8
+{
+	NotRouted,					// Not replicated through the graph
+	RelevantAllConnections,		// Always relevant to every connection
+	RelevantToOwner,			// Only relevant to the owning connection
+	Spatialize_Static,			// Spatialized, and never moves
+	Spatialize_Dynamic,			// Spatialized, and moves every frame
+	Spatialize_Dormancy,		// Spatialized, treated as static while dormant and dynamic while awake
+};
+
+/** Replication settings for an actor class and its subclasses.  Negative values keep the value derived from the class defaults. */
+USTRUCT()
+struct FOWSClassReplicationRule
+{
+	GENERATED_BODY()
+
+	FOWSClassReplicationRule() { }
+	FOWSClassReplicationRule(TSoftClassPtr<AActor> InActorClass, EOWSClassRepNodeMapping InNodeMapping, float InCullDistance, int32 InReplicationPeriodFrame, float InStarvationPriorityScale)
+		: ActorClass(InActorClass), NodeMapping(InNodeMapping), CullDistance(InCullDistance), ReplicationPeriodFrame(InReplicationPeriodFrame), StarvationPriorityScale(InStarvationPriorityScale) { }
+
+	UPROPERTY(config)
+		TSoftClassPtr<AActor> ActorClass;
+
+	UPROPERTY(config)
+		EOWSClassRepNodeMapping NodeMapping = EOWSClassRepNodeMapping::Spatialize_Dormancy;
+
+	/** Zero replicates at any distance */
+	UPROPERTY(config)
+		float CullDistance = -1.f;
+
+	/** Replicate every N server frames */
+	UPROPERTY(config)
+		int32 ReplicationPeriodFrame = -1;
+
+	/** How much priority grows for each frame the actor was skipped */
+	UPROPERTY(config)
+		float StarvationPriorityScale = -1.f;
+};
+
 USTRUCT()
 struct FOWSConnectionAlwaysRelevantNodePair
 {
@@ -53,6 +96,9 @@ public:
 	UPROPERTY()
 		UReplicationGraphNode_ActorList* AlwaysRelevantNode;
 
+	UPROPERTY()
+		UOWSReplicationGraphNode_PlayerStateFrequencyLimiter* PlayerStateNode;
+
 	UPROPERTY()
 		TArray<FOWSConnectionAlwaysRelevantNodePair> AlwaysRelevantForConnectionList;
 
@@ -63,20 +109,41 @@ public:
 	UPROPERTY()
 		TMap<int32, UOWSReplicationGraphNode_AlwaysRelevantToParty*> PartyMap;
 
+	/** Per-class replication settings, most derived class wins.  Set in DefaultEngine.ini under [/Script/OWSPlugin.OWSReplicationGraph] to replace the defaults. */
+	UPROPERTY(config)
+		TArray<FOWSClassReplicationRule> ClassReplicationRules;
+
 	UReplicationGraphNode_AlwaysRelevant_ForConnection* GetAlwaysRelevantNodeForConnection(UNetConnection* Connection);
+
+protected:
+
+	EOWSClassRepNodeMapping GetMappingPolicy(UClass* Class);
+
+	/** Resolved from ClassReplicationRules and class defaults in InitGlobalActorClassSettings */
+	TClassMap<EOWSClassRepNodeMapping> ClassRepNodePolicies;
 };
 
 
-/** This is a specialized node for handling PlayerState replication in a frequency limited fashion. It tracks all player states but only returns a subset of them to the replication driver each frame. */
+/**
+ * This is a specialized node for handling PlayerState replication in a frequency limited fashion. It tracks all player states but only returns a subset of them to the replication driver each frame.
+ * Player states are kept in a persistent compact list maintained by add/remove notifications, so nothing is rebuilt on frames where no player joined, left or changed party.
+ * Each connection also gets its own party members every frame and nearby players every NearbyReplicationPeriodFrames, ahead of the rolling buckets.
+ */
 UCLASS()
 class UOWSReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplicationGraphNode
 {
 	GENERATED_BODY()
 
-		UOWSReplicationGraphNode_PlayerStateFrequencyLimiter();
+public:
 
-	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override { }
-	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override { return false; }
+	UOWSReplicationGraphNode_PlayerStateFrequencyLimiter();
+
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+
+	/** Call when a player state's AlwaysRelevantPartyID changes */
+	void NotifyPartyChanged(APlayerState* PlayerState);
 
 	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
 
@@ -87,10 +154,32 @@ class UOWSReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplication
 	/** How many actors we want to return to the replication driver per frame. Will not suppress ForceNetUpdate. */
 	int32 TargetActorsPerFrame = 2;
 
+	/** Player states whose pawns share a cell of this size with the viewer are replicated ahead of the rolling buckets */
+	float NearbyCellSize = 5000.f;
+
+	/** How often nearby player states are returned, and how often pawn positions are re-bucketed into cells */
+	int32 NearbyReplicationPeriodFrames = 4;
+
 private:
 
+	void RebuildBuckets();
+	void RebuildPartyLists();
+	void RebuildNearbyCells();
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** Every tracked player state, compact.  Removal swaps the last entry into the hole. */
+	TArray<APlayerState*> PlayerStates;
+	TMap<APlayerState*, int32> PlayerStateIndices;
+
+	bool bBucketsDirty = false;
+	bool bPartyListsDirty = false;
+	uint32 PreparedFrames = 0;
+
 	TArray<FActorRepListRefView> ReplicationActorLists;
 	FActorRepListRefView ForceNetUpdateReplicationActorList;
+
+	TMap<int32, FActorRepListRefView> PartyLists;
+	TMap<FIntPoint, FActorRepListRefView> NearbyCells;
 };
 
 
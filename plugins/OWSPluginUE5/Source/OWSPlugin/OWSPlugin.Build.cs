@@ -30,6 +30,7 @@ public class OWSPlugin : ModuleRules
 				"Core",
                 "CoreUObject",
                 "Engine",
+                "NetCore",
                 "InputCore",
                 "MoviePlayer",
                 "GameplayAbilities",
@@ -54,7 +55,8 @@ public class OWSPlugin : ModuleRules
                 "MessagingCommon",
                 "Json",
                 "JsonUtilities",
-                "HTTP"
+                "HTTP",
+                "WebSockets"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -1,8 +1,10 @@
 // Copyright 2022 Sabre Dart Studios
 
 #include "OWSAPISubsystem.h"
+#include "OWSJsonStructReader.h"
 #include "Runtime/Engine/Classes/Kismet/GameplayStatics.h"
 #include "JsonObjectConverter.h"
+#include "TimerManager.h"
 
 void UOWSAPISubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -40,11 +42,70 @@ void UOWSAPISubsystem::Initialize(FSubsystemCollectionBase& Collection)
 		OWS2GlobalDataAPIPath,
 		GGameIni
 	);
+
+	GConfig->GetFloat(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSRequestBatchWindowInSeconds"),
+		OWSRequestBatchWindowInSeconds,
+		GGameIni
+	);
+
+	GConfig->GetInt(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSMaxRequestsPerBatch"),
+		OWSMaxRequestsPerBatch,
+		GGameIni
+	);
+
+	//Endpoints that have a bulk equivalent on the API side.  Calls to any other endpoint are sent immediately.
+	RegisterBulkEndpoint("api/Characters/AddOrUpdateCustomData", "api/Characters/AddOrUpdateCustomDataBulk");
+	RegisterBulkEndpoint("api/Abilities/AddAbilityToCharacter", "api/Abilities/AddAbilityToCharacterBulk");
+	RegisterBulkEndpoint("api/Abilities/UpdateAbilityOnCharacter", "api/Abilities/UpdateAbilityOnCharacterBulk");
 }
 
 void UOWSAPISubsystem::Deinitialize()
 {
+	//Don't drop saves that are still waiting for their batch window
+	FlushAllQueuedRequests();
+
+	//There is no later response to wait for, so calls held back for ordering go out now in the order they were queued
+	for (TPair<FString, TArray<FOWSQueuedRequest>>& DeferredRequests : DeferredRequestsByOrderingKey)
+	{
+		for (FOWSQueuedRequest& DeferredRequest : DeferredRequests.Value)
+		{
+			const FString ApiModuleToCall = DeferredRequest.ApiModuleToCall;
+			const FString ApiToCall = DeferredRequest.ApiToCall;
+			FString RequestBody = DeferredRequest.PostParameters;
+			TArray<FOWSQueuedRequest> SingleRequest;
+			SingleRequest.Add(MoveTemp(DeferredRequest));
+
+			SendQueuedRequests(ApiModuleToCall, ApiToCall, MoveTemp(SingleRequest), false, MoveTemp(RequestBody));
+		}
+	}
+	DeferredRequestsByOrderingKey.Empty();
+}
+
+FString UOWSAPISubsystem::GetOWS2APIPathForModule(const FString& ApiModuleToCall) const
+{
+	if (ApiModuleToCall == "PublicAPI")
+	{
+		return OWS2APIPath;
+	}
+	else if (ApiModuleToCall == "InstanceManagementAPI")
+	{
+		return OWS2InstanceManagementAPIPath;
+	}
+	else if (ApiModuleToCall == "CharacterPersistenceAPI")
+	{
+		return OWS2CharacterPersistenceAPIPath;
+	}
+	else if (ApiModuleToCall == "GlobalDataAPI")
+	{
+		return OWS2GlobalDataAPIPath;
+	}
 
+	//When an ApiModuleToCall is not specified, use the PublicAPI
+	return OWS2APIPath;
 }
 
 void UOWSAPISubsystem::GetJsonObjectFromResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FString CallingMethodName, FString& ErrorMsg, TSharedPtr<FJsonObject>& JsonObject)
@@ -77,30 +138,217 @@ void UOWSAPISubsystem::ProcessOWS2POSTRequest(FString ApiModuleToCall, FString A
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
 	Request->OnProcessRequestComplete().BindUObject(this, InMethodPtr);
 
-	FString OWS2APIPathToUse = "";
+	FString OWS2APIPathToUse = GetOWS2APIPathForModule(ApiModuleToCall);
 
-	if (ApiModuleToCall == "PublicAPI")
+	Request->SetURL(FString(OWS2APIPathToUse + ApiToCall));
+	Request->SetVerb("POST");
+	Request->SetHeader(TEXT("User-Agent"), "X-UnrealEngine-Agent");
+	Request->SetHeader("Content-Type", TEXT("application/json"));
+	Request->SetHeader(TEXT("X-CustomerGUID"), OWSAPICustomerKey);
+	Request->SetContentAsString(PostParameters);
+	Request->ProcessRequest();
+}
+
+void UOWSAPISubsystem::ProcessOWS2GETRequest(FString ApiModuleToCall, FString ApiToCall, void (UOWSAPISubsystem::* InMethodPtr)(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful))
+{
+	Http = &FHttpModule::Get();
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
+	Request->OnProcessRequestComplete().BindUObject(this, InMethodPtr);
+
+	FString OWS2APIPathToUse = GetOWS2APIPathForModule(ApiModuleToCall);
+
+	Request->SetURL(FString(OWS2APIPathToUse + ApiToCall));
+	Request->SetVerb("GET");
+	Request->SetHeader(TEXT("User-Agent"), "X-UnrealEngine-Agent");
+	Request->SetHeader("Content-Type", TEXT("application/json"));
+	Request->SetHeader(TEXT("X-CustomerGUID"), OWSAPICustomerKey);
+	Request->ProcessRequest();
+}
+
+
+/*
+Request Pipeline
+
+Calls made through QueueOWS2POSTRequest to an endpoint registered with RegisterBulkEndpoint are held for
+OWSRequestBatchWindowInSeconds.  Every call to the same endpoint that arrives inside that window is sent
+as one JSON array to the bulk endpoint, and the bulk endpoint answers with one JSON array entry per call,
+in the same order.  Each entry is handed back to the OnComplete delegate of the call that produced it.
+
+Calls that pass the same OrderingKey (for example every ability call for one character) reach the API in
+the order they were queued.  A call to a different endpoint than the one its OrderingKey is already waiting
+on sends that batch first, and then waits until the API has answered it before it is queued itself.
+*/
+void UOWSAPISubsystem::RegisterBulkEndpoint(FString ApiToCall, FString BulkApiToCall)
+{
+	BulkEndpoints.Add(ApiToCall, BulkApiToCall);
+}
+
+void UOWSAPISubsystem::QueueOWS2POSTRequest(FString ApiModuleToCall, FString ApiToCall, FString PostParameters, FOWSQueuedRequestCompleteDelegate OnComplete, FString OrderingKey)
+{
+	FOWSQueuedRequest QueuedRequest;
+	QueuedRequest.ApiModuleToCall = MoveTemp(ApiModuleToCall);
+	QueuedRequest.ApiToCall = MoveTemp(ApiToCall);
+	QueuedRequest.PostParameters = MoveTemp(PostParameters);
+	QueuedRequest.OrderingKey = MoveTemp(OrderingKey);
+	QueuedRequest.OnComplete = MoveTemp(OnComplete);
+
+	QueueOWS2POSTRequest_Internal(MoveTemp(QueuedRequest));
+}
+
+void UOWSAPISubsystem::QueueOWS2POSTRequest_Internal(FOWSQueuedRequest QueuedRequest)
+{
+	const FString BatchKey = QueuedRequest.ApiModuleToCall + QueuedRequest.ApiToCall;
+	const FString OrderingKey = QueuedRequest.OrderingKey;
+
+	if (!OrderingKey.IsEmpty())
 	{
-		OWS2APIPathToUse = OWS2APIPath;
+		//An earlier call for this OrderingKey is already waiting its turn, so this one goes in line behind it
+		if (TArray<FOWSQueuedRequest>* DeferredRequests = DeferredRequestsByOrderingKey.Find(OrderingKey))
+		{
+			DeferredRequests->Add(MoveTemp(QueuedRequest));
+			return;
+		}
+
+		//Earlier calls for this OrderingKey are batched on another endpoint.  Send them now so this call can follow them.
+		if (const FString* PendingBatchKey = PendingBatchKeyByOrderingKey.Find(OrderingKey))
+		{
+			if (*PendingBatchKey != BatchKey)
+			{
+				FString BatchKeyToFlush = *PendingBatchKey;
+				FlushQueuedRequestBatch(BatchKeyToFlush);
+			}
+		}
+
+		if (InFlightRequestCountByOrderingKey.Contains(OrderingKey))
+		{
+			DeferredRequestsByOrderingKey.Add(OrderingKey).Add(MoveTemp(QueuedRequest));
+			return;
+		}
 	}
-	else if (ApiModuleToCall == "InstanceManagementAPI")
+
+	UGameInstance* GameInstance = GetGameInstance();
+
+	//Endpoints without a bulk equivalent, or batching turned off, go out right away
+	if (OWSRequestBatchWindowInSeconds <= 0.f || !BulkEndpoints.Contains(QueuedRequest.ApiToCall) || !GameInstance)
 	{
-		OWS2APIPathToUse = OWS2InstanceManagementAPIPath;
+		const FString ApiModuleToCall = QueuedRequest.ApiModuleToCall;
+		const FString ApiToCall = QueuedRequest.ApiToCall;
+		FString RequestBody = QueuedRequest.PostParameters;
+		TArray<FOWSQueuedRequest> SingleRequest;
+		SingleRequest.Add(MoveTemp(QueuedRequest));
+
+		SendQueuedRequests(ApiModuleToCall, ApiToCall, MoveTemp(SingleRequest), false, MoveTemp(RequestBody));
+		return;
 	}
-	else if (ApiModuleToCall == "CharacterPersistenceAPI")
+
+	FOWSQueuedRequestBatch& Batch = PendingRequestBatches.FindOrAdd(BatchKey);
+
+	if (Batch.Requests.Num() == 0)
 	{
-		OWS2APIPathToUse = OWS2CharacterPersistenceAPIPath;
+		Batch.ApiModuleToCall = QueuedRequest.ApiModuleToCall;
+		Batch.ApiToCall = QueuedRequest.ApiToCall;
+		GameInstance->GetTimerManager().SetTimer(Batch.FlushTimerHandle,
+			FTimerDelegate::CreateUObject(this, &UOWSAPISubsystem::FlushQueuedRequestBatch, BatchKey), OWSRequestBatchWindowInSeconds, false);
 	}
-	else if (ApiModuleToCall == "GlobalDataAPI")
+
+	if (!OrderingKey.IsEmpty())
 	{
-		OWS2APIPathToUse = OWS2GlobalDataAPIPath;
+		PendingBatchKeyByOrderingKey.Add(OrderingKey, BatchKey);
 	}
-	else //When an ApiModuleToCall is not specified, use the PublicAPI
+
+	Batch.Requests.Add(MoveTemp(QueuedRequest));
+
+	if (Batch.Requests.Num() >= OWSMaxRequestsPerBatch)
 	{
-		OWS2APIPathToUse = OWS2APIPath;
+		FlushQueuedRequestBatch(BatchKey);
 	}
+}
 
-	Request->SetURL(FString(OWS2APIPathToUse + ApiToCall));
+void UOWSAPISubsystem::FlushAllQueuedRequests()
+{
+	TArray<FString> BatchKeys;
+	PendingRequestBatches.GetKeys(BatchKeys);
+
+	for (const FString& BatchKey : BatchKeys)
+	{
+		FlushQueuedRequestBatch(BatchKey);
+	}
+}
+
+void UOWSAPISubsystem::FlushQueuedRequestBatch(FString BatchKey)
+{
+	FOWSQueuedRequestBatch Batch;
+	if (!PendingRequestBatches.RemoveAndCopyValue(BatchKey, Batch) || Batch.Requests.Num() == 0)
+	{
+		return;
+	}
+
+	UGameInstance* GameInstance = GetGameInstance();
+	if (GameInstance)
+	{
+		GameInstance->GetTimerManager().ClearTimer(Batch.FlushTimerHandle);
+	}
+
+	for (const FOWSQueuedRequest& QueuedRequest : Batch.Requests)
+	{
+		if (!QueuedRequest.OrderingKey.IsEmpty())
+		{
+			PendingBatchKeyByOrderingKey.Remove(QueuedRequest.OrderingKey);
+		}
+	}
+
+	//A batch of one doesn't need the bulk endpoint
+	const bool bSendToBulkEndpoint = Batch.Requests.Num() > 1;
+	FString ApiToCall = Batch.ApiToCall;
+	FString PostParameters;
+
+	if (bSendToBulkEndpoint)
+	{
+		ApiToCall = BulkEndpoints.FindChecked(Batch.ApiToCall);
+
+		//Each PostParameters is already a JSON object, so the bulk body is just those objects joined into an array
+		int32 BodyLength = 2;
+		for (const FOWSQueuedRequest& QueuedRequest : Batch.Requests)
+		{
+			BodyLength += QueuedRequest.PostParameters.Len() + 1;
+		}
+
+		PostParameters.Reserve(BodyLength);
+		PostParameters.AppendChar(TEXT('['));
+		for (int32 RequestIndex = 0; RequestIndex < Batch.Requests.Num(); RequestIndex++)
+		{
+			if (RequestIndex > 0)
+			{
+				PostParameters.AppendChar(TEXT(','));
+			}
+			PostParameters.Append(Batch.Requests[RequestIndex].PostParameters);
+		}
+		PostParameters.AppendChar(TEXT(']'));
+	}
+	else
+	{
+		PostParameters = Batch.Requests[0].PostParameters;
+	}
+
+	UE_LOG(OWS, Verbose, TEXT("FlushQueuedRequestBatch - Sending %d queued call(s) to %s"), Batch.Requests.Num(), *ApiToCall);
+
+	SendQueuedRequests(Batch.ApiModuleToCall, ApiToCall, MoveTemp(Batch.Requests), bSendToBulkEndpoint, MoveTemp(PostParameters));
+}
+
+void UOWSAPISubsystem::SendQueuedRequests(const FString& ApiModuleToCall, const FString& ApiToCall, TArray<FOWSQueuedRequest> QueuedRequests, bool bSendToBulkEndpoint, FString PostParameters)
+{
+	for (const FOWSQueuedRequest& QueuedRequest : QueuedRequests)
+	{
+		if (!QueuedRequest.OrderingKey.IsEmpty())
+		{
+			InFlightRequestCountByOrderingKey.FindOrAdd(QueuedRequest.OrderingKey)++;
+		}
+	}
+
+	Http = &FHttpModule::Get();
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
+	Request->OnProcessRequestComplete().BindUObject(this, &UOWSAPISubsystem::OnQueuedRequestResponseReceived, MoveTemp(QueuedRequests), bSendToBulkEndpoint);
+	Request->SetURL(FString(GetOWS2APIPathForModule(ApiModuleToCall) + ApiToCall));
 	Request->SetVerb("POST");
 	Request->SetHeader(TEXT("User-Agent"), "X-UnrealEngine-Agent");
 	Request->SetHeader("Content-Type", TEXT("application/json"));
@@ -109,41 +357,98 @@ void UOWSAPISubsystem::ProcessOWS2POSTRequest(FString ApiModuleToCall, FString A
 	Request->ProcessRequest();
 }
 
-void UOWSAPISubsystem::ProcessOWS2GETRequest(FString ApiModuleToCall, FString ApiToCall, void (UOWSAPISubsystem::* InMethodPtr)(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful))
+void UOWSAPISubsystem::OnQueuedRequestResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TArray<FOWSQueuedRequest> QueuedRequests, bool bSentToBulkEndpoint)
 {
-	Http = &FHttpModule::Get();
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-	Request->OnProcessRequestComplete().BindUObject(this, InMethodPtr);
+	//Hand each queued call the raw JSON of its own result without building a DOM for the whole batch
+	TArray<FString> ResultContents;
 
-	FString OWS2APIPathToUse = "";
+	if (!bWasSuccessful || !Response.IsValid())
+	{
+		UE_LOG(OWS, Error, TEXT("OnQueuedRequestResponseReceived - Response was unsuccessful or invalid for %d queued call(s)!"), QueuedRequests.Num());
+	}
+	else if (!bSentToBulkEndpoint)
+	{
+		ResultContents.Init(Response->GetContentAsString(), QueuedRequests.Num());
+	}
+	else if (!FOWSJsonStructReader::ReadArrayElements(Response->GetContent(), ResultContents) || ResultContents.Num() != QueuedRequests.Num())
+	{
+		UE_LOG(OWS, Error, TEXT("OnQueuedRequestResponseReceived - Bulk response did not contain one result per queued call! Expected %d, got %d."), QueuedRequests.Num(), ResultContents.Num());
+		ResultContents.Reset();
+	}
 
-	if (ApiModuleToCall == "PublicAPI")
+	const bool bHaveResults = ResultContents.Num() == QueuedRequests.Num();
+
+	for (int32 RequestIndex = 0; RequestIndex < QueuedRequests.Num(); RequestIndex++)
 	{
-		OWS2APIPathToUse = OWS2APIPath;
+		QueuedRequests[RequestIndex].OnComplete.ExecuteIfBound(bHaveResults, bHaveResults ? ResultContents[RequestIndex] : FString());
 	}
-	else if (ApiModuleToCall == "InstanceManagementAPI")
+
+	ReleaseOrderedRequests(QueuedRequests);
+}
+
+void UOWSAPISubsystem::ReleaseOrderedRequests(const TArray<FOWSQueuedRequest>& CompletedRequests)
+{
+	TArray<FString> ReleasedOrderingKeys;
+
+	for (const FOWSQueuedRequest& CompletedRequest : CompletedRequests)
 	{
-		OWS2APIPathToUse = OWS2InstanceManagementAPIPath;
+		if (CompletedRequest.OrderingKey.IsEmpty())
+		{
+			continue;
+		}
+
+		int32* InFlightCount = InFlightRequestCountByOrderingKey.Find(CompletedRequest.OrderingKey);
+		if (InFlightCount && --(*InFlightCount) <= 0)
+		{
+			InFlightRequestCountByOrderingKey.Remove(CompletedRequest.OrderingKey);
+			ReleasedOrderingKeys.AddUnique(CompletedRequest.OrderingKey);
+		}
 	}
-	else if (ApiModuleToCall == "CharacterPersistenceAPI")
+
+	//Queue the held back calls again in their original order.  The first one that needs another endpoint holds the rest back again.
+	for (const FString& OrderingKey : ReleasedOrderingKeys)
 	{
-		OWS2APIPathToUse = OWS2CharacterPersistenceAPIPath;
+		TArray<FOWSQueuedRequest> DeferredRequests;
+		if (DeferredRequestsByOrderingKey.RemoveAndCopyValue(OrderingKey, DeferredRequests))
+		{
+			for (FOWSQueuedRequest& DeferredRequest : DeferredRequests)
+			{
+				QueueOWS2POSTRequest_Internal(MoveTemp(DeferredRequest));
+			}
+		}
 	}
-	else if (ApiModuleToCall == "GlobalDataAPI")
+}
+
+bool UOWSAPISubsystem::ReadQueuedRequestResult(bool bWasSuccessful, const FString& ResponseContent, FString& ErrorMsg)
+{
+	if (!bWasSuccessful)
 	{
-		OWS2APIPathToUse = OWS2GlobalDataAPIPath;
+		ErrorMsg = TEXT("Unknown error connecting to server!");
+		return false;
 	}
-	else //When an ApiModuleToCall is not specified, use the PublicAPI
+
+	//Some single endpoints, like AddOrUpdateCustomData, answer with an empty body when they succeed
+	if (ResponseContent.IsEmpty())
 	{
-		OWS2APIPathToUse = OWS2APIPath;
+		return true;
 	}
 
-	Request->SetURL(FString(OWS2APIPathToUse + ApiToCall));
-	Request->SetVerb("GET");
-	Request->SetHeader(TEXT("User-Agent"), "X-UnrealEngine-Agent");
-	Request->SetHeader("Content-Type", TEXT("application/json"));
-	Request->SetHeader(TEXT("X-CustomerGUID"), OWSAPICustomerKey);
-	Request->ProcessRequest();
+	FSuccessAndErrorMessage SuccessAndErrorMessage;
+	FTCHARToUTF8 Utf8ResponseContent(*ResponseContent);
+
+	if (!FOWSJsonStructReader::ReadStruct(TConstArrayView<uint8>(reinterpret_cast<const uint8*>(Utf8ResponseContent.Get()), Utf8ResponseContent.Length()), SuccessAndErrorMessage))
+	{
+		ErrorMsg = TEXT("Server returned no data!");
+		return false;
+	}
+
+	if (!SuccessAndErrorMessage.Success)
+	{
+		ErrorMsg = SuccessAndErrorMessage.ErrorMessage;
+		return false;
+	}
+
+	return true;
 }
 
 
@@ -157,16 +462,13 @@ void UOWSAPISubsystem::GetGlobalDataItem(FString GlobalDataKey)
 void UOWSAPISubsystem::OnGetGlobalDataItemResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
 	FString ErrorMsg;
-	TSharedPtr<FJsonObject> JsonObject;
-	GetJsonObjectFromResponse(Request, Response, bWasSuccessful, "OnGetGlobalDataItemResponseReceived", ErrorMsg, JsonObject);
+	TSharedPtr<FGlobalDataItem> GlobalDataItem = FOWSJsonStructReader::ReadResponse<FGlobalDataItem>(Response, bWasSuccessful, "OnGetGlobalDataItemResponseReceived", ErrorMsg);
 	if (!ErrorMsg.IsEmpty())
 	{
 		OnErrorGetGlobalDataItemDelegate.ExecuteIfBound(ErrorMsg);
 		return;
 	}
 
-	TSharedPtr<FGlobalDataItem> GlobalDataItem = GetStructFromJsonObject<FGlobalDataItem>(JsonObject);
-
 	OnNotifyGetGlobalDataItemDelegate.ExecuteIfBound(GlobalDataItem);
 }
 
@@ -191,16 +493,13 @@ void UOWSAPISubsystem::AddOrUpdateGlobalDataItem(FString GlobalDataKey, FString
 void UOWSAPISubsystem::OnAddOrUpdateGlobalDataItemResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
 	FString ErrorMsg;
-	TSharedPtr<FJsonObject> JsonObject;
-	GetJsonObjectFromResponse(Request, Response, bWasSuccessful, "OnAddOrUpdateGlobalDataItemResponseReceived", ErrorMsg, JsonObject);
+	TSharedPtr<FSuccessAndErrorMessage> SuccessAndErrorMessage = FOWSJsonStructReader::ReadResponse<FSuccessAndErrorMessage>(Response, bWasSuccessful, "OnAddOrUpdateGlobalDataItemResponseReceived", ErrorMsg);
 	if (!ErrorMsg.IsEmpty())
 	{
 		OnErrorAddOrUpdateGlobalDataItemDelegate.ExecuteIfBound(ErrorMsg);
 		return;
 	}
 
-	TSharedPtr<FSuccessAndErrorMessage> SuccessAndErrorMessage = GetStructFromJsonObject<FSuccessAndErrorMessage>(JsonObject);
-
 	if (!SuccessAndErrorMessage->ErrorMessage.IsEmpty())
 	{
 		OnErrorAddOrUpdateGlobalDataItemDelegate.ExecuteIfBound(*SuccessAndErrorMessage->ErrorMessage);
@@ -233,16 +532,13 @@ void UOWSAPISubsystem::CreateCharacterUsingDefaultCharacterValues(FString UserSe
 void UOWSAPISubsystem::OnCreateCharacterUsingDefaultCharacterValuesResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
 	FString ErrorMsg;
-	TSharedPtr<FJsonObject> JsonObject;
-	GetJsonObjectFromResponse(Request, Response, bWasSuccessful, "OnCreateCharacterUsingDefaultCharacterValuesResponseReceived", ErrorMsg, JsonObject);
+	TSharedPtr<FSuccessAndErrorMessage> SuccessAndErrorMessage = FOWSJsonStructReader::ReadResponse<FSuccessAndErrorMessage>(Response, bWasSuccessful, "OnCreateCharacterUsingDefaultCharacterValuesResponseReceived", ErrorMsg);
 	if (!ErrorMsg.IsEmpty())
 	{
 		OnErrorCreateCharacterUsingDefaultCharacterValuesDelegate.ExecuteIfBound(ErrorMsg);
 		return;
 	}
 
-	TSharedPtr<FSuccessAndErrorMessage> SuccessAndErrorMessage = GetStructFromJsonObject<FSuccessAndErrorMessage>(JsonObject);
-
 	if (!SuccessAndErrorMessage->ErrorMessage.IsEmpty())
 	{
 		OnErrorCreateCharacterUsingDefaultCharacterValuesDelegate.ExecuteIfBound(*SuccessAndErrorMessage->ErrorMessage);
@@ -272,16 +568,13 @@ void UOWSAPISubsystem::Logout(FString UserSessionGUID)
 void UOWSAPISubsystem::OnLogoutResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
 	FString ErrorMsg;
-	TSharedPtr<FJsonObject> JsonObject;
-	GetJsonObjectFromResponse(Request, Response, bWasSuccessful, "OnLogoutResponseReceived", ErrorMsg, JsonObject);
+	TSharedPtr<FSuccessAndErrorMessage> SuccessAndErrorMessage = FOWSJsonStructReader::ReadResponse<FSuccessAndErrorMessage>(Response, bWasSuccessful, "OnLogoutResponseReceived", ErrorMsg);
 	if (!ErrorMsg.IsEmpty())
 	{
 		OnErrorLogoutDelegate.ExecuteIfBound(ErrorMsg);
 		return;
 	}
 
-	TSharedPtr<FSuccessAndErrorMessage> SuccessAndErrorMessage = GetStructFromJsonObject<FSuccessAndErrorMessage>(JsonObject);
-
 	if (!SuccessAndErrorMessage->ErrorMessage.IsEmpty())
 	{
 		OnErrorLogoutDelegate.ExecuteIfBound(*SuccessAndErrorMessage->ErrorMessage);
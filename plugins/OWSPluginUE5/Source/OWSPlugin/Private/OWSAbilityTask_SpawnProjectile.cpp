@@ -8,6 +8,7 @@
 #include "AbilitySystemComponent.h"
 #include "Runtime/Core/Public/Math/TransformNonVectorized.h"
 #include "OWSPlayerController.h"
+#include "OWSProjectilePoolSubsystem.h"
 
 
 
@@ -94,15 +95,11 @@ bool UOWSAbilityTask_SpawnProjectile::BeginSpawningActor(UGameplayAbility* Ownin
 			if (Ability->GetCurrentActorInfo()->IsNetAuthority() || (CatchupTickDelta > 0.f))
 			{
 				APawn* MyPawn = Cast<APawn>(Ability->GetCurrentActorInfo()->AvatarActor);
-				FActorSpawnParameters Params;
-				Params.Instigator = MyPawn;
-				Params.Owner = MyPawn;
-				Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 				
 				FTransform SpawnTransform;
 				GetAimTransform(SpawnTransform);
 
-				AOWSAdvancedProjectile* NewProjectile = GetWorld()->SpawnActor<AOWSAdvancedProjectile>(ProjectileClass, SpawnTransform.GetLocation(), SpawnTransform.GetRotation().Rotator(), Params);
+				AOWSAdvancedProjectile* NewProjectile = SpawnOrReuseProjectile(ProjectileClass.Get(), SpawnTransform, MyPawn, !Ability->GetCurrentActorInfo()->IsNetAuthority());
 				if (NewProjectile)
 				{
 					if (Ability->GetCurrentActorInfo()->IsNetAuthority())
@@ -272,6 +269,21 @@ bool UOWSAbilityTask_SpawnProjectile::BeginSpawningActor(UGameplayAbility* Ownin
 }
 
 
+AOWSAdvancedProjectile* UOWSAbilityTask_SpawnProjectile::SpawnOrReuseProjectile(TSubclassOf<AOWSAdvancedProjectile> InProjectileClass, const FTransform& SpawnTransform, APawn* MyPawn, bool bFakeClientProjectile)
+{
+	UOWSProjectilePoolSubsystem* ProjectilePool = GetWorld()->GetSubsystem<UOWSProjectilePoolSubsystem>();
+	if (ProjectilePool)
+	{
+		return ProjectilePool->AcquireProjectile(InProjectileClass, SpawnTransform, MyPawn, bFakeClientProjectile);
+	}
+
+	FActorSpawnParameters Params;
+	Params.Instigator = MyPawn;
+	Params.Owner = MyPawn;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	return GetWorld()->SpawnActor<AOWSAdvancedProjectile>(InProjectileClass, SpawnTransform, Params);
+}
+
 void UOWSAbilityTask_SpawnProjectile::SpawnDelayedFakeProjectile()
 {
 	AOWSPlayerController* OwningPlayer = Cast<AOWSPlayerController>(Ability->GetCurrentActorInfo()->PlayerController);
@@ -289,11 +301,7 @@ void UOWSAbilityTask_SpawnProjectile::SpawnDelayedFakeProjectile()
 		float CatchupTickDelta = (OwningPlayer ? OwningPlayer->GetPredictionTime() : 0.f);
 
 		APawn* MyPawn = Cast<APawn>(Ability->GetCurrentActorInfo()->AvatarActor);
-		FActorSpawnParameters Params;
-		Params.Instigator = MyPawn;
-		Params.Owner = MyPawn;
-		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-		AOWSAdvancedProjectile* NewProjectile = GetWorld()->SpawnActor<AOWSAdvancedProjectile>(DelayedProjectile.ProjectileClass, DelayedProjectile.SpawnLocation, DelayedProjectile.SpawnRotation, Params);
+		AOWSAdvancedProjectile* NewProjectile = SpawnOrReuseProjectile(DelayedProjectile.ProjectileClass, FTransform(DelayedProjectile.SpawnRotation, DelayedProjectile.SpawnLocation), MyPawn, true);
 		if (NewProjectile)
 		{	
 			NewProjectile->InitFakeProjectile(OwningPlayer);
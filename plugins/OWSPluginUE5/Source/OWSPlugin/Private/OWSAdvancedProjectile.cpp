@@ -13,6 +13,9 @@
 #include "Runtime/Engine/Classes/Engine/OverlapResult.h"
 #include "Abilities/GameplayAbilityTargetTypes.h"
 #include "AbilitySystemBlueprintLibrary.h"
+#include "OWSLagCompensationSubsystem.h"
+#include "OWSProjectilePoolSubsystem.h"
+#include "OWSProjectileSimulationSubsystem.h"
 
 class UAbilitySystemComponent;
 class UGameplayTagsManager;
@@ -76,6 +79,20 @@ AOWSAdvancedProjectile::AOWSAdvancedProjectile(const class FObjectInitializer& O
 
 	NetPriority = 2.f;
 	SetMinNetUpdateFrequency(100.0f);
+
+	//Only ticks on the server while lag compensated
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	bUseLagCompensation = true;
+	LagCompensationRewindSeconds = 0.f;
+
+	bUseProjectilePool = true;
+	bPooledProjectile = false;
+	bInProjectilePool = false;
+	PoolGeneration = 0;
+
+	bUseBatchedSimulation = false;
+	BatchedSimulationIndex = INDEX_NONE;
 }
 
 void AOWSAdvancedProjectile::PreInitializeComponents()
@@ -161,6 +178,9 @@ void AOWSAdvancedProjectile::BeginPlay()
 	{
 		UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Projectile Auth BeginPlay: %s"), *ServerOrClient, *GetName());
 
+		StartLagCompensation();
+		StartBatchedSimulation();
+
 		/*
 		UNetDriver* NetDriver = GetNetDriver();
 		if (NetDriver != NULL && NetDriver->IsServer())
@@ -177,80 +197,130 @@ void AOWSAdvancedProjectile::BeginPlay()
 	}
 	else
 	{
-		AOWSPlayerController* MyPlayer = Cast<AOWSPlayerController>(InstigatorController ? InstigatorController : GEngine->GetFirstLocalPlayerController(GetWorld()));
-		if (MyPlayer)
+		InitReplicatedProjectile();
+	}
+}
+
+void AOWSAdvancedProjectile::StartLagCompensation()
+{
+	//The server spawned this projectile half a round trip after the player fired it, and the player saw other pawns half a round trip
+	//behind the server, so rewind pawns by the same prediction time the client uses to catch its copy up.
+	AOWSPlayerController* InstigatorPlayer = Cast<AOWSPlayerController>(InstigatorController);
+	UOWSLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UOWSLagCompensationSubsystem>();
+	if (bUseLagCompensation && InstigatorPlayer && !InstigatorPlayer->IsLocalController() && LagCompensation)
+	{
+		LagCompensationRewindSeconds = FMath::Min(InstigatorPlayer->GetPredictionTime(), LagCompensation->GetMaxRewindSeconds());
+		if (LagCompensationRewindSeconds > 0.f)
 		{
-			UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Projectile Not Auth BeginPlay: %s"), *ServerOrClient, *GetName());
+			LagCompensationPreviousLocation = GetActorLocation();
+			SetActorTickEnabled(true);
+		}
+	}
+}
 
-			// Move projectile to match where it is on server now (to make up for replication time)
-			float CatchupTickDelta = MyPlayer->GetPredictionTime();
-			if (CatchupTickDelta > 0.f)
-			{
-				CatchupTick(CatchupTickDelta);
-			}
+void AOWSAdvancedProjectile::StartBatchedSimulation()
+{
+	UOWSProjectileSimulationSubsystem* ProjectileSimulation = bUseBatchedSimulation ? GetWorld()->GetSubsystem<UOWSProjectileSimulationSubsystem>() : NULL;
+	if (ProjectileSimulation)
+	{
+		ProjectileSimulation->RegisterProjectile(this);
+	}
+}
+
+void AOWSAdvancedProjectile::StopBatchedSimulation()
+{
+	UOWSProjectileSimulationSubsystem* ProjectileSimulation = (BatchedSimulationIndex != INDEX_NONE) ? GetWorld()->GetSubsystem<UOWSProjectileSimulationSubsystem>() : NULL;
+	if (ProjectileSimulation)
+	{
+		ProjectileSimulation->UnregisterProjectile(this);
+	}
+}
 
-			// look for associated fake client projectile
-			AOWSAdvancedProjectile* BestMatch = NULL;
-			FVector VelDir = GetVelocity().GetSafeNormal();
-			int32 BestMatchIndex = 0;
-			float BestDist = 0.f;
+void AOWSAdvancedProjectile::InitReplicatedProjectile()
+{
+	FString ServerOrClient;
+	if (GetNetMode() == NM_DedicatedServer)
+	{
+		ServerOrClient = "Server";
+	}
+	else
+	{
+		ServerOrClient = "Client";
+	}
 
-			UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Start Searching Fakes"), *ServerOrClient);
+	AOWSPlayerController* MyPlayer = Cast<AOWSPlayerController>(InstigatorController ? InstigatorController : GEngine->GetFirstLocalPlayerController(GetWorld()));
+	if (MyPlayer)
+	{
+		UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Projectile Not Auth BeginPlay: %s"), *ServerOrClient, *GetName());
+
+		// Move projectile to match where it is on server now (to make up for replication time)
+		float CatchupTickDelta = MyPlayer->GetPredictionTime();
+		if (CatchupTickDelta > 0.f)
+		{
+			CatchupTick(CatchupTickDelta);
+		}
 
-			for (int32 i = 0; i < MyPlayer->FakeProjectiles.Num(); i++)
+		// look for associated fake client projectile
+		AOWSAdvancedProjectile* BestMatch = NULL;
+		FVector VelDir = GetVelocity().GetSafeNormal();
+		int32 BestMatchIndex = 0;
+		float BestDist = 0.f;
+
+		UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Start Searching Fakes"), *ServerOrClient);
+
+		for (int32 i = 0; i < MyPlayer->FakeProjectiles.Num(); i++)
+		{
+			UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Evaluating Fake #: %d"), *ServerOrClient, i);
+
+			AOWSAdvancedProjectile* Fake = MyPlayer->FakeProjectiles[i];
+			if (!Fake || Fake->IsPendingKillPending() || Fake->IsInProjectilePool())
 			{
-				UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Evaluating Fake #: %d"), *ServerOrClient, i);
+				UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Invalid Fake or Pending Kill"), *ServerOrClient);
 
-				AOWSAdvancedProjectile* Fake = MyPlayer->FakeProjectiles[i];
-				if (!Fake || Fake->IsPendingKillPending())
-				{
-					UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Invalid Fake or Pending Kill"), *ServerOrClient);
+				MyPlayer->FakeProjectiles.RemoveAt(i, 1);
+				i--;
+			}
+			else if (Fake->GetClass() == GetClass())
+			{
+				UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Our Fake Class Matches"), *ServerOrClient);
 
-					MyPlayer->FakeProjectiles.RemoveAt(i, 1);
-					i--;
-				}
-				else if (Fake->GetClass() == GetClass())
+				// must share direction unless falling! 
+				if (CanMatchFake(Fake, VelDir))
 				{
-					UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Our Fake Class Matches"), *ServerOrClient);
-
-					// must share direction unless falling! 
-					if (CanMatchFake(Fake, VelDir))
+					if (BestMatch)
 					{
-						if (BestMatch)
-						{
-							// see if new one is better
-							float NewDist = (Fake->GetActorLocation() - GetActorLocation()).SizeSquared();
-							if (BestDist > NewDist)
-							{
-								BestMatch = Fake;
-								BestMatchIndex = i;
-								BestDist = NewDist;
-
-								UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Projectile Not Auth Found a better Match"), *ServerOrClient);
-							}
-						}
-						else
+						// see if new one is better
+						float NewDist = (Fake->GetActorLocation() - GetActorLocation()).SizeSquared();
+						if (BestDist > NewDist)
 						{
 							BestMatch = Fake;
 							BestMatchIndex = i;
-							BestDist = (BestMatch->GetActorLocation() - GetActorLocation()).SizeSquared();
+							BestDist = NewDist;
 
-							UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Projectile Not Auth Found a Match"), *ServerOrClient);
+							UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Projectile Not Auth Found a better Match"), *ServerOrClient);
 						}
 					}
+					else
+					{
+						BestMatch = Fake;
+						BestMatchIndex = i;
+						BestDist = (BestMatch->GetActorLocation() - GetActorLocation()).SizeSquared();
+
+						UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Projectile Not Auth Found a Match"), *ServerOrClient);
+					}
 				}
 			}
-			if (BestMatch)
-			{
-				UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Projectile Not Auth calling BeginFakeProjectileSynch"), *ServerOrClient);
+		}
+		if (BestMatch)
+		{
+			UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Projectile Not Auth calling BeginFakeProjectileSynch"), *ServerOrClient);
 
-				MyPlayer->FakeProjectiles.RemoveAt(BestMatchIndex, 1);
-				BeginFakeProjectileSynch(BestMatch);
-			}
-			else
-			{
-				UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Projectile Not Auth WE DID NOT FIND A FAKE!"), *ServerOrClient);
-			}
+			MyPlayer->FakeProjectiles.RemoveAt(BestMatchIndex, 1);
+			BeginFakeProjectileSynch(BestMatch);
+		}
+		else
+		{
+			UE_LOG(OWS, Verbose, TEXT("%s: BeginPlay: Projectile Not Auth WE DID NOT FIND A FAKE!"), *ServerOrClient);
 		}
 	}
 }
@@ -303,7 +373,8 @@ void AOWSAdvancedProjectile::InitFakeProjectile(AOWSPlayerController* OwningPlay
 
 		UE_LOG(OWS, Verbose, TEXT("%s: InitFakeProjectile: Add to Fakes List"), *ServerOrClient);
 
-		OwningPlayer->FakeProjectiles.Add(this);
+		//A pooled fake can come back before the replicated projectile cleaned up its old entry
+		OwningPlayer->FakeProjectiles.AddUnique(this);
 	}
 }
 
@@ -584,12 +655,25 @@ void AOWSAdvancedProjectile::Destroyed()
 
 	if (MyFakeProjectile)
 	{
-		MyFakeProjectile->Destroy();
+		MyFakeProjectile->ReturnToPoolOrDestroy();
 	}
+	StopBatchedSimulation();
 	GetWorldTimerManager().ClearAllTimersForObject(this);
 	Super::Destroyed();
 }
 
+void AOWSAdvancedProjectile::LifeSpanExpired()
+{
+	if (bPooledProjectile)
+	{
+		ReturnToPoolOrDestroy();
+	}
+	else
+	{
+		Super::LifeSpanExpired();
+	}
+}
+
 void AOWSAdvancedProjectile::ShutDown()
 {
 	UE_LOG(OWS, Verbose, TEXT("ShutDown: %s"), *GetName());
@@ -614,7 +698,8 @@ void AOWSAdvancedProjectile::ShutDown()
 				// tick the particles one last time for e.g. SpawnPerUnit effects (particularly noticeable improvement for fast moving projectiles)
 				PSC->TickComponent(0.0f, LEVELTICK_All, NULL);
 				PSC->DeactivateSystem();
-				PSC->bAutoDestroy = true;
+				//Pooled projectiles keep their particle systems for the next shot
+				PSC->bAutoDestroy = !bPooledProjectile;
 				bFoundParticles = true;
 			}
 			else
@@ -663,6 +748,197 @@ void AOWSAdvancedProjectile::TornOff()
 	}
 }
 
+bool AOWSAdvancedProjectile::IsReplicatedByServer() const
+{
+	return GetIsReplicated() && GetLocalRole() == ROLE_Authority && (GetNetMode() == NM_DedicatedServer || GetNetMode() == NM_ListenServer);
+}
+
+void AOWSAdvancedProjectile::MarkPooled()
+{
+	bPooledProjectile = true;
+
+	PooledComponentVisibility.Reset();
+	TArray<USceneComponent*> Components;
+	GetComponents<USceneComponent>(Components);
+	for (USceneComponent* Component : Components)
+	{
+		FOWSProjectileComponentVisibility& ComponentVisibility = PooledComponentVisibility.AddDefaulted_GetRef();
+		ComponentVisibility.Component = Component;
+		ComponentVisibility.bHiddenInGame = Component->bHiddenInGame;
+		ComponentVisibility.bVisible = Component->GetVisibleFlag();
+	}
+}
+
+void AOWSAdvancedProjectile::ReturnToPoolOrDestroy()
+{
+	UOWSProjectilePoolSubsystem* ProjectilePool = bPooledProjectile ? GetWorld()->GetSubsystem<UOWSProjectilePoolSubsystem>() : NULL;
+	if (ProjectilePool)
+	{
+		ProjectilePool->ReleaseProjectile(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+void AOWSAdvancedProjectile::ResetForPool()
+{
+	UE_LOG(OWS, Verbose, TEXT("ResetForPool: %s"), *GetName());
+
+	//Same as Destroyed, the fake goes with its master
+	if (MyFakeProjectile)
+	{
+		AOWSAdvancedProjectile* FakeProjectile = MyFakeProjectile;
+		MyFakeProjectile = NULL;
+		FakeProjectile->MasterProjectile = NULL;
+		FakeProjectile->ReturnToPoolOrDestroy();
+	}
+	if (MasterProjectile)
+	{
+		if (MasterProjectile->MyFakeProjectile == this)
+		{
+			MasterProjectile->MyFakeProjectile = NULL;
+		}
+		MasterProjectile = NULL;
+	}
+
+	StopBatchedSimulation();
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	SetLifeSpan(0.f);
+	SetActorTickEnabled(false);
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+	ProjectileMovement->StopMovementImmediately();
+	ProjectileMovement->SetActive(false);
+
+	//Unlike ShutDown there is no lifespan left for effects to die off in
+	TArray<UActorComponent*> Components;
+	GetComponents(Components);
+	for (UActorComponent* Component : Components)
+	{
+		if (UFXSystemComponent* FXSystem = Cast<UFXSystemComponent>(Component))
+		{
+			FXSystem->DeactivateImmediate();
+		}
+		else if (UAudioComponent* Audio = Cast<UAudioComponent>(Component))
+		{
+			Audio->Stop();
+		}
+	}
+
+	//Stays exploded while idle so late overlaps are ignored
+	bExploded = true;
+	bInOverlap = false;
+	bFakeClientProjectile = false;
+	LagCompensationRewindSeconds = 0.f;
+	ImpactedActor = NULL;
+	DamageEffectOnHit = FGameplayEffectSpecHandle();
+	AoEDamageEffectOnHit = FGameplayEffectSpecHandle();
+	ActivateAbilityTagOnImpact = GetClass()->GetDefaultObject<AOWSAdvancedProjectile>()->ActivateAbilityTagOnImpact;
+	bInProjectilePool = true;
+
+	//Clients already received the hidden state, so an idle projectile has nothing left to replicate until it is reused
+	if (IsReplicatedByServer())
+	{
+		SetNetDormancy(DORM_DormantAll);
+	}
+}
+
+void AOWSAdvancedProjectile::ActivateFromPool(const FTransform& SpawnTransform, APawn* NewInstigator)
+{
+	UE_LOG(OWS, Verbose, TEXT("ActivateFromPool: %s"), *GetName());
+
+	bInProjectilePool = false;
+	bExploded = false;
+
+	SetActorLocationAndRotation(SpawnTransform.GetLocation(), SpawnTransform.GetRotation(), false, NULL, ETeleportType::ResetPhysics);
+
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		SetInstigator(NewInstigator);
+		SetOwner(NewInstigator);
+	}
+	InstigatorController = NULL;
+	OnRep_Instigator();
+
+	for (const FOWSProjectileComponentVisibility& ComponentVisibility : PooledComponentVisibility)
+	{
+		if (USceneComponent* Component = ComponentVisibility.Component.Get())
+		{
+			Component->SetHiddenInGame(ComponentVisibility.bHiddenInGame);
+			Component->SetVisibility(ComponentVisibility.bVisible);
+		}
+	}
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+
+	//Restart whatever started on its own at spawn, e.g. trails and ambient sounds that ShutDown turned off
+	TArray<UActorComponent*> Components;
+	GetComponents(Components);
+	for (UActorComponent* Component : Components)
+	{
+		if (Component != ProjectileMovement && Component->bAutoActivate)
+		{
+			Component->Activate(true);
+		}
+	}
+
+	//Same as UProjectileMovementComponent::InitializeComponent on a fresh spawn.  Stopping cleared the updated component.
+	ProjectileMovement->SetUpdatedComponent(RootComponent);
+	ProjectileMovement->SetActive(true);
+	FVector InitialVelocity = GetClass()->GetDefaultObject<AOWSAdvancedProjectile>()->ProjectileMovement->Velocity;
+	if (ProjectileMovement->InitialSpeed > 0.f)
+	{
+		InitialVelocity = InitialVelocity.GetSafeNormal() * ProjectileMovement->InitialSpeed;
+	}
+	if (ProjectileMovement->bInitialVelocityInLocalSpace)
+	{
+		ProjectileMovement->SetVelocityInLocalSpace(InitialVelocity);
+	}
+	else
+	{
+		ProjectileMovement->Velocity = InitialVelocity;
+	}
+	ProjectileMovement->UpdateComponentVelocity();
+
+	SetLifeSpan(InitialLifeSpan);
+
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		StartLagCompensation();
+		StartBatchedSimulation();
+	}
+
+	if (IsReplicatedByServer())
+	{
+		PoolGeneration++;
+		SetNetDormancy(DORM_Awake);
+		bForceNextRepMovement = true;
+		ForceNetUpdate();
+	}
+
+	OnActivatedFromPool();
+}
+
+void AOWSAdvancedProjectile::OnRep_PoolGeneration()
+{
+	//The first replication of a projectile goes through BeginPlay instead
+	if (!HasActorBegunPlay())
+	{
+		return;
+	}
+
+	UE_LOG(OWS, Verbose, TEXT("OnRep_PoolGeneration: Server reused %s"), *GetName());
+
+	ResetForPool();
+	ActivateFromPool(FTransform(UTProjReplicatedMovement.Rotation, UTProjReplicatedMovement.Location), GetInstigator());
+	ProjectileMovement->Velocity = UTProjReplicatedMovement.LinearVelocity;
+	ProjectileMovement->UpdateComponentVelocity();
+
+	InitReplicatedProjectile();
+}
+
 void AOWSAdvancedProjectile::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
 	//Don't overlap with self
@@ -681,6 +957,14 @@ void AOWSAdvancedProjectile::OnOverlapBegin(UPrimitiveComponent* OverlappedCompo
 	if (OtherActor == GetInstigator())
 		return;
 
+	//Physics overlaps see pawns where they are now.  Lag compensated pawn hits come from LagCompensatedPawnSweep instead.
+	if (LagCompensationRewindSeconds > 0.f && OtherActor->IsA<APawn>())
+	{
+		UOWSLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UOWSLagCompensationSubsystem>();
+		if (LagCompensation && LagCompensation->IsTrackingPawn(Cast<APawn>(OtherActor)))
+			return;
+	}
+
 	if (!bInOverlap)
 	{
 		TGuardValue<bool> OverlapGuard(bInOverlap, true);
@@ -790,7 +1074,7 @@ void AOWSAdvancedProjectile::ProcessHit_Implementation(AActor* OtherActor, UPrim
 			if (MyFakeProjectile && !MyFakeProjectile->IsPendingKillPending())
 			{
 				MyFakeProjectile->ProcessHit_Implementation(OtherActor, OtherComp, Hit);
-				Destroy();
+				ReturnToPoolOrDestroy();
 				return;
 			}
 			if (OtherActor != NULL)
@@ -841,7 +1125,7 @@ void AOWSAdvancedProjectile::Explode_Implementation(const FHitResult& Hit, UPrim
 
 	if (FMath::IsNearlyZero(ExplosionDamageRadius) || !AoEDamageEffectOnHit.IsValid())
 	{
-		Destroy();
+		ReturnToPoolOrDestroy();
 		return;
 	}
 
@@ -906,7 +1190,7 @@ void AOWSAdvancedProjectile::Explode_Implementation(const FHitResult& Hit, UPrim
 		}
 	}
 
-	Destroy();
+	ReturnToPoolOrDestroy();
 }
 
 void AOWSAdvancedProjectile::DamageImpactedActor_Implementation(AActor* OtherActor, UPrimitiveComponent* OtherComp, const FHitResult& Hit)
@@ -1035,9 +1319,43 @@ void AOWSAdvancedProjectile::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	//Catchup
+	if (LagCompensationRewindSeconds > 0.f && !bExploded)
+	{
+		LagCompensatedPawnSweep();
+	}
+}
+
+void AOWSAdvancedProjectile::LagCompensatedPawnSweep()
+{
+	UOWSLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UOWSLagCompensationSubsystem>();
+	if (!LagCompensation)
+	{
+		return;
+	}
+
+	const FVector SweepStart = LagCompensationPreviousLocation;
+	const FVector SweepEnd = GetActorLocation();
+	LagCompensationPreviousLocation = SweepEnd;
 
+	auto ShouldConsiderPawn = [this](APawn* Pawn)
+	{
+		return Pawn != GetInstigator() && !ShouldIgnoreHit(Pawn, Cast<UPrimitiveComponent>(Pawn->GetRootComponent()));
+	};
 
+	FOWSLagCompensationHit PawnHit;
+	if (!LagCompensation->SweepRewoundPawns(SweepStart, SweepEnd, OverlapRadius, LagCompensation->GetServerTime() - LagCompensationRewindSeconds, ShouldConsiderPawn, PawnHit))
+	{
+		return;
+	}
+
+	FCollisionQueryParams Params(FName(TEXT("PawnSphereOverlapTrace")), true, this);
+	Params.AddIgnoredActor(PawnHit.Pawn);
+
+	// same as OnPawnSphereOverlapBegin, make sure there is nothing between the rewound pawn and the projectile
+	if (!GetWorld()->LineTraceTestByChannel(PawnHit.ImpactPoint, PawnHit.Location, COLLISION_TRACE_WEAPON, Params))
+	{
+		ProcessHit(PawnHit.Pawn, Cast<UPrimitiveComponent>(PawnHit.Pawn->GetRootComponent()), PawnHit.ToHitResult(SweepStart, SweepEnd));
+	}
 }
 
 void AOWSAdvancedProjectile::SetDamageEffectOnHit(FGameplayEffectSpecHandle DamageEffect)
@@ -1078,6 +1396,7 @@ void AOWSAdvancedProjectile::GetLifetimeReplicatedProps(TArray<class FLifetimePr
 
 	//DOREPLIFETIME(AActor, GetInstigator());
 	DOREPLIFETIME_CONDITION(AOWSAdvancedProjectile, UTProjReplicatedMovement, COND_SimulatedOrPhysics);
+	DOREPLIFETIME(AOWSAdvancedProjectile, PoolGeneration);
 	//DOREPLIFETIME_CONDITION(AOWSAdvancedProjectile, ProjectilePredictionKey, COND_OwnerOnly);
 
 	
@@ -2,49 +2,128 @@
 
 
 #include "OWSAnimInstance.h"
+#include "Algo/BinarySearch.h"
+#include "Animation/AnimSequence.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
 
-float UOWSAnimInstance::GetStartTimeByDistance(UAnimSequence* AnimSequence, float distance)
+namespace OWSDistanceMatching
 {
-    FRawCurveTracks CurvesOfAnim = AnimSequence->GetCurveData();
-    TArray<FFloatCurve> Curves = CurvesOfAnim.FloatCurves;
-    FFloatCurve DistanceCurve, SpeedCurve;
+    static const FName DistanceCurveName(TEXT("DistanceCurve"));
+
+    //Shared by every anim instance.  Anim updates on worker threads take the read lock; only building a new table takes the write lock.
+    static FRWLock TablesLock;
+    static TMap<TObjectKey<UAnimSequence>, TSharedPtr<const FOWSDistanceMatchingTable>> Tables;
 
-    for (int i = 0; i < Curves.Num(); i++)
+    static TSharedPtr<const FOWSDistanceMatchingTable> BuildTable(const UAnimSequence* AnimSequence)
     {
-        if (Curves[i].GetName().GetPlainNameString() == "DistanceCurve")
+        const FFloatCurve* DistanceCurve = nullptr;
+        for (const FFloatCurve& Curve : AnimSequence->GetCurveData().FloatCurves)
         {
-            DistanceCurve = Curves[i];
+            if (Curve.GetName() == DistanceCurveName)
+            {
+                DistanceCurve = &Curve;
+                break;
+            }
         }
-        else if (Curves[i].GetName().GetPlainNameString() == "Speed") {
-            SpeedCurve = Curves[i];
+
+        if (!DistanceCurve || DistanceCurve->FloatCurve.GetNumKeys() < 2)
+        {
+            return nullptr;
         }
-    }
 
-    int keys = DistanceCurve.FloatCurve.GetNumKeys();
-    float min; float max; DistanceCurve.FloatCurve.GetValueRange(min, max);
-    if (keys > 1) {
-        if (distance > max) {
-            return DistanceCurve.FloatCurve.Keys[keys - 1].Time;
+        TSharedPtr<FOWSDistanceMatchingTable> Table = MakeShared<FOWSDistanceMatchingTable>();
+        const TArray<FRichCurveKey>& Keys = DistanceCurve->FloatCurve.Keys;
+        Table->Distances.Reserve(Keys.Num());
+        Table->Times.Reserve(Keys.Num());
+
+        //Keep distances non-decreasing so they can be binary searched.  A key that moves backwards is clamped to the furthest distance so far.
+        for (const FRichCurveKey& Key : Keys)
+        {
+            Table->Distances.Add(Table->Distances.Num() > 0 ? FMath::Max(Key.Value, Table->Distances.Last()) : Key.Value);
+            Table->Times.Add(Key.Time);
         }
-        else if (distance < min) {
-            return DistanceCurve.FloatCurve.Keys[0].Time;
+
+        return Table;
+    }
+}
+
+float FOWSDistanceMatchingTable::GetTimeAtDistance(float Distance) const
+{
+    const int32 NumKeys = Distances.Num();
+    if (NumKeys == 0)
+    {
+        return 0.f;
+    }
+
+    //First key further than Distance
+    const int32 UpperIndex = Algo::UpperBound(Distances, Distance);
+    if (UpperIndex == 0)
+    {
+        return Times[0];
+    }
+    if (UpperIndex == NumKeys)
+    {
+        return Times[NumKeys - 1];
+    }
+
+    //Linear between the two keys around Distance
+    const int32 LowerIndex = UpperIndex - 1;
+    const float Alpha = (Distance - Distances[LowerIndex]) / (Distances[UpperIndex] - Distances[LowerIndex]);
+    return FMath::Lerp(Times[LowerIndex], Times[UpperIndex], Alpha);
+}
+
+TSharedPtr<const FOWSDistanceMatchingTable> FOWSDistanceMatchingTable::FindOrBuild(const UAnimSequence* AnimSequence)
+{
+    if (!AnimSequence)
+    {
+        return nullptr;
+    }
+
+    const TObjectKey<UAnimSequence> SequenceKey(AnimSequence);
+    {
+        FReadScopeLock ReadLock(OWSDistanceMatching::TablesLock);
+        if (const TSharedPtr<const FOWSDistanceMatchingTable>* Table = OWSDistanceMatching::Tables.Find(SequenceKey))
+        {
+            return *Table;
         }
-        else {
+    }
 
-            for (int x = 1; x < keys - 1; x++) {
-                if (DistanceCurve.FloatCurve.Keys[x].Value > distance) {
+    //Sequences without a DistanceCurve are cached as null too, so they aren't searched again
+    TSharedPtr<const FOWSDistanceMatchingTable> NewTable = OWSDistanceMatching::BuildTable(AnimSequence);
 
-                    //Exact Value (linear)
-                    float deltaDist, deltaTime, pct;
-                    deltaDist = DistanceCurve.FloatCurve.Keys[x].Value - DistanceCurve.FloatCurve.Keys[x - 1].Value;
-                    deltaTime = DistanceCurve.FloatCurve.Keys[x].Time - DistanceCurve.FloatCurve.Keys[x - 1].Time;
-                    pct = (distance - DistanceCurve.FloatCurve.Keys[x - 1].Value) / deltaDist;
+    FWriteScopeLock WriteLock(OWSDistanceMatching::TablesLock);
+    if (const TSharedPtr<const FOWSDistanceMatchingTable>* Table = OWSDistanceMatching::Tables.Find(SequenceKey))
+    {
+        //Another thread built it first
+        return *Table;
+    }
 
-                    return DistanceCurve.FloatCurve.Keys[x - 1].Time + deltaTime * pct;
-                }
-            }
+    //Drop the tables of sequences that have been unloaded
+    for (auto TableIt = OWSDistanceMatching::Tables.CreateIterator(); TableIt; ++TableIt)
+    {
+        if (!TableIt.Key().ResolveObjectPtr())
+        {
+            TableIt.RemoveCurrent();
         }
     }
 
-    return 0;
-}
\ No newline at end of file
+    OWSDistanceMatching::Tables.Add(SequenceKey, NewTable);
+    return NewTable;
+}
+
+void UOWSAnimInstance::NativeInitializeAnimation()
+{
+    Super::NativeInitializeAnimation();
+
+    for (const UAnimSequence* AnimSequence : DistanceMatchedSequences)
+    {
+        FOWSDistanceMatchingTable::FindOrBuild(AnimSequence);
+    }
+}
+
+float UOWSAnimInstance::GetStartTimeByDistance(UAnimSequence* AnimSequence, float distance)
+{
+    TSharedPtr<const FOWSDistanceMatchingTable> Table = FOWSDistanceMatchingTable::FindOrBuild(AnimSequence);
+    return Table ? Table->GetTimeAtDistance(distance) : 0.f;
+}
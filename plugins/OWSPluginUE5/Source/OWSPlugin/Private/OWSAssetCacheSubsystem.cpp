@@ -0,0 +1,393 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "OWSAssetCacheSubsystem.h"
+#include "OWSPlugin.h"
+#include "Misc/PackageName.h"
+#include "Runtime/Core/Public/Misc/ConfigCacheIni.h"
+
+void UOWSAssetCacheSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	MaxCachedAssets = 256;
+
+	GConfig->GetInt(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSAssetCacheMaxAssets"),
+		MaxCachedAssets,
+		GGameIni
+	);
+
+	MaxCachedAssets = FMath::Max(MaxCachedAssets, 1);
+}
+
+void UOWSAssetCacheSubsystem::Deinitialize()
+{
+	for (TPair<FSoftObjectPath, FOWSCachedAsset>& CachedAsset : CachedAssets)
+	{
+		if (CachedAsset.Value.Handle.IsValid())
+		{
+			CachedAsset.Value.Handle->CancelHandle();
+		}
+	}
+
+	CachedAssets.Empty();
+	LRUList.Empty();
+
+	Super::Deinitialize();
+}
+
+void UOWSAssetCacheSubsystem::RequestAsset(const FSoftObjectPath& AssetPath, FOWSAssetLoadedDelegate OnLoaded)
+{
+	if (AssetPath.IsNull())
+	{
+		OnLoaded.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	if (FOWSCachedAsset* CachedAsset = CachedAssets.Find(AssetPath))
+	{
+		if (CachedAsset->LRUNode)
+		{
+			MarkUsed(*CachedAsset);
+			OnLoaded.ExecuteIfBound(AssetPath.ResolveObject());
+		}
+		else
+		{
+			//Already loading, so wait on that request
+			CachedAsset->PendingCallbacks.Add(MoveTemp(OnLoaded));
+		}
+		return;
+	}
+
+	CachedAssets.Add(AssetPath).PendingCallbacks.Add(MoveTemp(OnLoaded));
+
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(AssetPath, FStreamableDelegate::CreateUObject(this, &UOWSAssetCacheSubsystem::OnAssetLoaded, AssetPath));
+
+	//The load can finish, or fail, inside RequestAsyncLoad, so look the entry up again
+	if (FOWSCachedAsset* CachedAsset = CachedAssets.Find(AssetPath))
+	{
+		CachedAsset->Handle = Handle;
+	}
+}
+
+void UOWSAssetCacheSubsystem::RequestAssetAsync(const FString& AssetPath, const FOWSAssetLoadedDynamicDelegate& OnLoaded)
+{
+	RequestAsset(FSoftObjectPath(AssetPath), FOWSAssetLoadedDelegate::CreateLambda([OnLoaded](UObject* LoadedAsset)
+	{
+		OnLoaded.ExecuteIfBound(LoadedAsset);
+	}));
+}
+
+UObject* UOWSAssetCacheSubsystem::GetCachedAsset(const FSoftObjectPath& AssetPath)
+{
+	FOWSCachedAsset* CachedAsset = CachedAssets.Find(AssetPath);
+
+	if (!CachedAsset || !CachedAsset->LRUNode)
+	{
+		return nullptr;
+	}
+
+	MarkUsed(*CachedAsset);
+	return AssetPath.ResolveObject();
+}
+
+UObject* UOWSAssetCacheSubsystem::LoadAssetSynchronous(const FSoftObjectPath& AssetPath)
+{
+	if (AssetPath.IsNull())
+	{
+		return nullptr;
+	}
+
+	if (FOWSCachedAsset* CachedAsset = CachedAssets.Find(AssetPath))
+	{
+		if (CachedAsset->LRUNode)
+		{
+			MarkUsed(*CachedAsset);
+			return AssetPath.ResolveObject();
+		}
+
+		if (CachedAsset->Handle.IsValid())
+		{
+			CachedAsset->Handle->WaitUntilComplete();
+		}
+
+		//The completion delegate may not have run yet.  OnAssetLoaded ignores the second call.
+		OnAssetLoaded(AssetPath);
+		return GetCachedAsset(AssetPath);
+	}
+
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestSyncLoad(AssetPath);
+	UObject* LoadedAsset = Handle.IsValid() ? Handle->GetLoadedAsset() : nullptr;
+
+	if (!LoadedAsset)
+	{
+		return nullptr;
+	}
+
+	FOWSCachedAsset& CachedAsset = CachedAssets.Add(AssetPath);
+	CachedAsset.Handle = Handle;
+	LRUList.AddHead(AssetPath);
+	CachedAsset.LRUNode = LRUList.GetHead();
+
+	EvictLeastRecentlyUsed();
+
+	return LoadedAsset;
+}
+
+void UOWSAssetCacheSubsystem::PrefetchAssets(const TArray<FSoftObjectPath>& AssetPaths)
+{
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
+	{
+		if (!AssetPath.IsNull() && !CachedAssets.Contains(AssetPath))
+		{
+			RequestAsset(AssetPath, FOWSAssetLoadedDelegate());
+		}
+	}
+}
+
+void UOWSAssetCacheSubsystem::PrefetchItemAssets(const TArray<FInventoryItemStruct>& Items)
+{
+	TArray<FSoftObjectPath> AssetPaths;
+	AssetPaths.Reserve(Items.Num() * 2);
+
+	for (const FInventoryItemStruct& Item : Items)
+	{
+		for (const FString* AssetPath : { &Item.WeaponActorClassPath, &Item.StaticMeshPath, &Item.SkeletalMeshPath, &Item.TextureToUseForIcon })
+		{
+			if (!AssetPath->IsEmpty())
+			{
+				AssetPaths.Emplace(*AssetPath);
+			}
+		}
+	}
+
+	PrefetchAssets(AssetPaths);
+}
+
+void UOWSAssetCacheSubsystem::PrefetchCustomCharacterDataAssets(const TArray<FCustomCharacterDataStruct>& CustomCharacterData)
+{
+	TArray<FSoftObjectPath> AssetPaths;
+
+	for (const FCustomCharacterDataStruct& CustomData : CustomCharacterData)
+	{
+		if (FPackageName::IsValidObjectPath(CustomData.FieldValue))
+		{
+			AssetPaths.Emplace(CustomData.FieldValue);
+		}
+	}
+
+	PrefetchAssets(AssetPaths);
+}
+
+void UOWSAssetCacheSubsystem::EvictAsset(const FSoftObjectPath& AssetPath)
+{
+	FOWSCachedAsset* CachedAsset = CachedAssets.Find(AssetPath);
+
+	//Requests that are still loading have callbacks waiting on them
+	if (!CachedAsset || !CachedAsset->LRUNode)
+	{
+		return;
+	}
+
+	LRUList.RemoveNode(CachedAsset->LRUNode);
+
+	if (CachedAsset->Handle.IsValid())
+	{
+		CachedAsset->Handle->ReleaseHandle();
+	}
+
+	CachedAssets.Remove(AssetPath);
+}
+
+void UOWSAssetCacheSubsystem::OnAssetLoaded(FSoftObjectPath AssetPath)
+{
+	FOWSCachedAsset* CachedAsset = CachedAssets.Find(AssetPath);
+
+	if (!CachedAsset || CachedAsset->LRUNode)
+	{
+		return;
+	}
+
+	TArray<FOWSAssetLoadedDelegate> Callbacks = MoveTemp(CachedAsset->PendingCallbacks);
+	UObject* LoadedAsset = AssetPath.ResolveObject();
+
+	if (LoadedAsset)
+	{
+		LRUList.AddHead(AssetPath);
+		CachedAsset->LRUNode = LRUList.GetHead();
+		EvictLeastRecentlyUsed();
+	}
+	else
+	{
+		UE_LOG(OWS, Error, TEXT("UOWSAssetCacheSubsystem - Error loading asset: %s"), *AssetPath.ToString());
+		CachedAssets.Remove(AssetPath);
+	}
+
+	for (FOWSAssetLoadedDelegate& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound(LoadedAsset);
+	}
+}
+
+void UOWSAssetCacheSubsystem::MarkUsed(FOWSCachedAsset& CachedAsset)
+{
+	if (CachedAsset.LRUNode != LRUList.GetHead())
+	{
+		LRUList.RemoveNode(CachedAsset.LRUNode, false);
+		LRUList.AddHead(CachedAsset.LRUNode);
+	}
+}
+
+void UOWSAssetCacheSubsystem::EvictLeastRecentlyUsed()
+{
+	while (LRUList.Num() > MaxCachedAssets)
+	{
+		EvictAsset(LRUList.GetTail()->GetValue());
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+
+#include "Animation/SkeletalMeshActor.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+
+namespace OWSAssetCacheBenchmark
+{
+	static TArray<ASkeletalMeshActor*> SpawnCharacters(UWorld* World, int32 NumCharacters)
+	{
+		TArray<ASkeletalMeshActor*> Characters;
+		const int32 GridWidth = FMath::CeilToInt(FMath::Sqrt((float)NumCharacters));
+
+		for (int32 CharacterIndex = 0; CharacterIndex < NumCharacters; CharacterIndex++)
+		{
+			const FVector Location((CharacterIndex % GridWidth) * 200.f, (CharacterIndex / GridWidth) * 200.f, 0.f);
+			Characters.Add(World->SpawnActor<ASkeletalMeshActor>(Location, FRotator::ZeroRotator));
+		}
+
+		return Characters;
+	}
+
+	static void DestroyCharacters(TArray<ASkeletalMeshActor*>& Characters)
+	{
+		for (ASkeletalMeshActor* Character : Characters)
+		{
+			if (IsValid(Character))
+			{
+				Character->Destroy();
+			}
+		}
+		Characters.Reset();
+	}
+
+	//Equips NumCharacters characters with the given meshes, first with LoadObject on the game thread and then through the asset cache
+	static void EquipBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || Args.Num() < 2)
+		{
+			UE_LOG(OWS, Display, TEXT("Usage: OWS.AssetCache.EquipBenchmark <NumCharacters> <SkeletalMeshPath> [SkeletalMeshPath...]"));
+			return;
+		}
+
+		UOWSAssetCacheSubsystem* AssetCache = World->GetGameInstance() ? World->GetGameInstance()->GetSubsystem<UOWSAssetCacheSubsystem>() : nullptr;
+		if (!AssetCache)
+		{
+			return;
+		}
+
+		const int32 NumCharacters = FMath::Max(FCString::Atoi(*Args[0]), 1);
+		TArray<FSoftObjectPath> MeshPaths;
+		for (int32 ArgIndex = 1; ArgIndex < Args.Num(); ArgIndex++)
+		{
+			MeshPaths.Emplace(Args[ArgIndex]);
+			AssetCache->EvictAsset(MeshPaths.Last());
+		}
+
+		//Start both passes with the meshes unloaded, or the first pass pays for the second
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		TArray<ASkeletalMeshActor*> Characters = SpawnCharacters(World, NumCharacters);
+
+		const double SyncStart = FPlatformTime::Seconds();
+		for (int32 CharacterIndex = 0; CharacterIndex < Characters.Num(); CharacterIndex++)
+		{
+			const FSoftObjectPath& MeshPath = MeshPaths[CharacterIndex % MeshPaths.Num()];
+			USkeletalMesh* Mesh = LoadObject<USkeletalMesh>(nullptr, *MeshPath.ToString(), nullptr, LOAD_None, nullptr);
+			if (Characters[CharacterIndex])
+			{
+				Characters[CharacterIndex]->GetSkeletalMeshComponent()->SetSkeletalMesh(Mesh);
+			}
+		}
+		const double SyncSeconds = FPlatformTime::Seconds() - SyncStart;
+
+		DestroyCharacters(Characters);
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		UE_LOG(OWS, Display, TEXT("OWS.AssetCache.EquipBenchmark - %d characters, %d meshes"), NumCharacters, MeshPaths.Num());
+		UE_LOG(OWS, Display, TEXT("  LoadObject:   %.3f ms stall in one frame"), SyncSeconds * 1000.0);
+
+		//Async pass.  The stall is the longest frame until every character has its mesh.
+		Characters = SpawnCharacters(World, NumCharacters);
+
+		struct FAsyncPass
+		{
+			TArray<TWeakObjectPtr<ASkeletalMeshActor>> Characters;
+			int32 NumRemaining = 0;
+			double RequestSeconds = 0.0;
+			double LongestFrameSeconds = 0.0;
+			double StartTime = 0.0;
+			int32 Frames = 0;
+		};
+		TSharedRef<FAsyncPass> Pass = MakeShared<FAsyncPass>();
+		Pass->NumRemaining = Characters.Num();
+		Pass->StartTime = FPlatformTime::Seconds();
+
+		for (int32 CharacterIndex = 0; CharacterIndex < Characters.Num(); CharacterIndex++)
+		{
+			Pass->Characters.Add(Characters[CharacterIndex]);
+			AssetCache->RequestAsset(MeshPaths[CharacterIndex % MeshPaths.Num()], FOWSAssetLoadedDelegate::CreateLambda([Pass, CharacterIndex](UObject* LoadedAsset)
+			{
+				if (ASkeletalMeshActor* Character = Pass->Characters[CharacterIndex].Get())
+				{
+					Character->GetSkeletalMeshComponent()->SetSkeletalMesh(Cast<USkeletalMesh>(LoadedAsset));
+				}
+				Pass->NumRemaining--;
+			}));
+		}
+		Pass->RequestSeconds = FPlatformTime::Seconds() - Pass->StartTime;
+
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Pass](float DeltaTime)
+		{
+			Pass->Frames++;
+			Pass->LongestFrameSeconds = FMath::Max(Pass->LongestFrameSeconds, (double)DeltaTime);
+
+			if (Pass->NumRemaining > 0)
+			{
+				return true;
+			}
+
+			UE_LOG(OWS, Display, TEXT("  Asset cache:  %.3f ms to issue requests, longest frame %.3f ms, all equipped after %d frames (%.3f ms)"),
+				Pass->RequestSeconds * 1000.0, Pass->LongestFrameSeconds * 1000.0, Pass->Frames, (FPlatformTime::Seconds() - Pass->StartTime) * 1000.0);
+
+			for (TWeakObjectPtr<ASkeletalMeshActor>& Character : Pass->Characters)
+			{
+				if (Character.IsValid())
+				{
+					Character->Destroy();
+				}
+			}
+			return false;
+		}));
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs EquipBenchmarkCommand(
+		TEXT("OWS.AssetCache.EquipBenchmark"),
+		TEXT("Spawns NumCharacters skeletal mesh actors and equips them with LoadObject, then through the asset cache, and logs the game thread stall of each. Args: <NumCharacters> <SkeletalMeshPath> [SkeletalMeshPath...]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&EquipBenchmark));
+}
+
+#endif
@@ -0,0 +1,35 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "OWSBenchmarkFrameTimes.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "OWSPlugin.h"
+
+void FOWSBenchmarkFrameTimes::Reserve(float Seconds)
+{
+	FrameTimes.Reserve(FMath::CeilToInt32(Seconds * 240.f));
+}
+
+void FOWSBenchmarkFrameTimes::LogAndReset()
+{
+	const int32 NumFrames = FrameTimes.Num();
+	if (NumFrames == 0)
+	{
+		return;
+	}
+
+	FrameTimes.Sort();
+	float TotalTime = 0.f;
+	for (const float FrameTime : FrameTimes)
+	{
+		TotalTime += FrameTime;
+	}
+
+	UE_LOG(OWS, Display, TEXT("  Frame time: average %.3f ms, 99th percentile %.3f ms, worst %.3f ms over %d frames"),
+		TotalTime / NumFrames * 1000.f, FrameTimes[FMath::Min(NumFrames * 99 / 100, NumFrames - 1)] * 1000.f, FrameTimes.Last() * 1000.f, NumFrames);
+
+	FrameTimes.Reset();
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include "Runtime/Core/Public/Misc/Guid.h"
 #include "Runtime/Core/Public/Misc/ConfigCacheIni.h"
 #include "OWSPlayerController.h"
+#include "OWSAssetCacheSubsystem.h"
 #include "Runtime/Engine/Classes/GameFramework/PlayerState.h"
 
 // Sets default values
@@ -31,6 +32,12 @@ AOWSCharacter::AOWSCharacter(const class FObjectInitializer& ObjectInitializer)
 	TeamId = FGenericTeamId(TeamNumber);
 
 	bShouldAutoLoadCustomCharacterStats = false;
+	bLoadCharacterWithBootstrap = false;
+
+	MaxInspectDistance = 2000.f;
+
+	//HUD inventories replicate as registered subobjects
+	bReplicateUsingRegisteredSubObjectList = true;
 
 	//AlwaysRelevantPartyID = 0;
 }
@@ -49,7 +56,14 @@ void AOWSCharacter::PossessedBy(AController* NewController)
 	{
 		if (!IsAMob)
 		{
-			LoadCharacterStats();
+			if (bLoadCharacterWithBootstrap)
+			{
+				LoadCharacterBootstrap();
+			}
+			else
+			{
+				LoadCharacterStats();
+			}
 		}
 	}
 }
@@ -139,6 +153,17 @@ void AOWSCharacter::GetCharacterStatsBase()
 	}
 }
 
+void AOWSCharacter::LoadCharacterBootstrap()
+{
+	AOWSPlayerController* PC = Cast<AOWSPlayerController>(this->Controller);
+	if (PC && PC->PlayerState)
+	{
+		FString PlayerName = PC->PlayerState->GetPlayerName();
+
+		PC->OWSPlayerControllerComponent->GetCharacterBootstrap(PlayerName);
+	}
+}
+
 void AOWSCharacter::LoadCustomCharacterStats_Implementation() {
 
 }
@@ -618,6 +643,7 @@ void AOWSCharacter::ProcessCustomCharacterData(TSharedPtr<FJsonObject> JsonObjec
 			CustomCharacterData.Add(tempCustomData);
 		}
 
+		GetGameInstance()->GetSubsystem<UOWSAssetCacheSubsystem>()->PrefetchCustomCharacterDataAssets(CustomCharacterData);
 		NotifyGetCustomCharacterData(CustomCharacterData);
 	}
 	else
@@ -851,7 +877,7 @@ void AOWSCharacter::ReadInventoryItems(const TArray<TSharedPtr<FJsonValue>> Rows
 		tempInventoryItem.TextureIcon = nullptr;
 		if (!tempInventoryItem.TextureToUseForIcon.IsEmpty())
 		{
-			tempInventoryItem.TextureIcon = LoadObject<UTexture2D>(NULL, *tempInventoryItem.TextureToUseForIcon, NULL, LOAD_None, NULL);
+			tempInventoryItem.TextureIcon = GetGameInstance()->GetSubsystem<UOWSAssetCacheSubsystem>()->LoadAssetSynchronous<UTexture2D>(tempInventoryItem.TextureToUseForIcon);
 
 			if (!tempInventoryItem.TextureIcon)
 			{
@@ -870,6 +896,9 @@ void AOWSCharacter::ReadInventoryItems(const TArray<TSharedPtr<FJsonValue>> Rows
 
 		InventoryItems.Add(tempInventoryItem);
 	}
+
+	//Start streaming meshes and weapon classes now so equipping these items doesn't load them on the game thread
+	GetGameInstance()->GetSubsystem<UOWSAssetCacheSubsystem>()->PrefetchItemAssets(InventoryItems);
 }
 
 
@@ -1516,92 +1545,36 @@ AOWSGameMode* AOWSCharacter::GetGameMode()
 //HUD Inventory System
 void AOWSCharacter::OnRep_InventoriesToManage()
 {
-	if (InventoriesToManage.Num() < 1)
-	{
-		UE_LOG(OWS, Error, TEXT("OnRep_InventoriesToManage.Num() < 1"));
-		return;
-	}
-
-	if (InventoriesToManage[0])
+	for (UOWSInventory* Inventory : InventoriesToManage)
 	{
-		UE_LOG(OWS, Error, TEXT("OnRep_InventoriesToManage First Entry is Valid!"));
-		return;
+		if (Inventory)
+		{
+			Inventory->SetOwningPlayerCharacter(this);
+		}
 	}
-
-	UE_LOG(OWS, Error, TEXT("OnRep_InventoriesToManage"));
 }
 
 UOWSInventory* AOWSCharacter::CreateHUDInventory(FName InventoryName, int32 Size, int32 NumberOfColumns)
 {
 	if (GetLocalRole() == ROLE_Authority)
 	{
-		UOWSInventory* Inventory = NewObject<UOWSInventory>();
+		UOWSInventory* Inventory = NewObject<UOWSInventory>(this);
+		Inventory->SetOwningPlayerCharacter(this);
 		Inventory->SetInventoryName(InventoryName);
 		Inventory->SetInventorySize(Size, NumberOfColumns);
-		Inventory->SetOwningPlayerCharacter(this);
 		InventoriesToManage.Add(Inventory);
-		Client_CreateHUDInventory(InventoryName, Size, NumberOfColumns);
+		//The owning client gets the inventory and its contents through replication
+		AddReplicatedSubObject(Inventory, COND_OwnerOnly);
 		return Inventory;
 	}
 
 	return nullptr;
 }
 
-void AOWSCharacter::Client_CreateHUDInventory_Implementation(FName InventoryName, int32 Size, int32 NumberOfColumns)
-{
-	if (GetLocalRole() != ROLE_Authority)
-	{
-		UOWSInventory* Inventory = NewObject<UOWSInventory>();
-		Inventory->SetInventoryName(InventoryName);
-		Inventory->SetInventorySize(Size, NumberOfColumns);
-		Inventory->SetOwningPlayerCharacter(this);
-		InventoriesToManage.Add(Inventory);
-	}
-}
-
-void AOWSCharacter::Client_AddItemToInventory_Implementation(const FName& InventoryName, const FString& ItemName, const int32 StackSize, const int32 InSlotNumber, const int32 NumberOfUsesLeft, const int32 Condition,
-	const FString& PerInstanceCustomData, const FGuid UniqueItemGUID, const int32 ItemMeshID)
-{
-	AOWSInventoryItem* Item = NewObject<AOWSInventoryItem>();
-	Item->ItemName = ItemName;
-	Item->StackSize = StackSize;
-	Item->NumberOfUsesLeft = NumberOfUsesLeft;
-	Item->Condition = Condition;
-	Item->PerInstanceCustomData = PerInstanceCustomData;
-	Item->UniqueItemGUID = UniqueItemGUID;
-	Item->ItemMeshID = ItemMeshID;
-
-	auto FoundEntry = LocalInventoryItems.FindByPredicate([&](FInventoryItemStruct& InItem)
-	{
-		return InItem.ItemName == ItemName;
-	});
-
-	if (FoundEntry)
-	{
-		AOWSPlayerController* PlayerController = Cast<AOWSPlayerController>(GetController());
-
-		Item->IconTexture = PlayerController->LoadTextureReference(FoundEntry->TextureToUseForIcon);
-		Item->IconSlotWidth = FoundEntry->IconSlotWidth;
-		Item->IconSlotHeight = FoundEntry->IconSlotHeight;
-	}
-
-	UOWSInventory* FoundInventory = GetHUDInventoryFromName(InventoryName);
-
-	if (FoundInventory)
-	{
-		FoundInventory->AddItemToSlot_Internal(Item, InSlotNumber);
-	}
-}
-
 bool AOWSCharacter::AddItemToLocalInventoryItems(const FString& ItemName, const bool ItemCanStack, const bool IsUsable, const bool IsConsumedOnUse, const int32 ItemTypeID,
 	const FString& TextureToUseForIcon, const int32 IconSlotWidth, const int32 IconSlotHeight, const int32 ItemMeshID, const FString& CustomData)
 {
-	auto FoundEntry = LocalInventoryItems.FindByPredicate([&](FInventoryItemStruct& InItem)
-	{
-		return InItem.ItemName == ItemName;
-	});
-
-	if (FoundEntry)
+	if (LocalInventoryItemCatalog.Contains(LocalInventoryItems, FName(*ItemName)))
 		return false;
 
 	FInventoryItemStruct tempItem;
@@ -1617,7 +1590,7 @@ bool AOWSCharacter::AddItemToLocalInventoryItems(const FString& ItemName, const
 	tempItem.ItemMeshID = ItemMeshID;
 	tempItem.CustomData = CustomData;
 
-	LocalInventoryItems.Add(tempItem);
+	LocalInventoryItemCatalog.Add(LocalInventoryItems, tempItem);
 
 	return true;
 }
@@ -1638,7 +1611,17 @@ void AOWSCharacter::Client_AddItemToLocalInventoryItems_Implementation(const FSt
 	tempItem.ItemMeshID = ItemMeshID;
 	tempItem.CustomData = CustomData;
 
-	LocalInventoryItems.Add(tempItem);
+	LocalInventoryItemCatalog.Add(LocalInventoryItems, tempItem);
+
+	//Slots holding this item may have replicated before its definition did
+	const FName ItemFName(*ItemName);
+	for (UOWSInventory* Inventory : InventoriesToManage)
+	{
+		if (Inventory)
+		{
+			Inventory->RefreshItemIcons(ItemFName);
+		}
+	}
 }
 
 UOWSInventory* AOWSCharacter::GetHUDInventoryFromName(FName InventoryName)
@@ -1680,6 +1663,65 @@ UOWSInventory* AOWSCharacter::GetHUDInventoryFromName(FName InventoryName)
 }
 
 
+bool AOWSCharacter::Server_MoveInventorySlot_Validate(FName SourceInventoryName, int32 SourceSlot, FName DestInventoryName, int32 DestSlot)
+{
+	return SourceSlot >= 0 && DestSlot >= 0;
+}
+
+void AOWSCharacter::Server_MoveInventorySlot_Implementation(FName SourceInventoryName, int32 SourceSlot, FName DestInventoryName, int32 DestSlot)
+{
+	UOWSInventory* SourceInventory = GetHUDInventoryFromName(SourceInventoryName);
+	UOWSInventory* DestInventory = GetHUDInventoryFromName(DestInventoryName);
+
+	//The client may have been looking at a slot the server has already changed
+	if (!SourceInventory || !DestInventory || !SourceInventory->FindItemInSlot(SourceSlot) || !DestInventory->InventoryItemRecords.IsValidIndex(DestSlot))
+		return;
+
+	if (SourceInventory == DestInventory)
+	{
+		if (SourceSlot == DestSlot)
+			return;
+
+		if (!SourceInventory->MergeSlots(SourceSlot, DestSlot) && !SourceInventory->SwapSlots(SourceSlot, DestSlot))
+			return;
+	}
+	else
+	{
+		if (!SourceInventory->SwapSlotWithInventory(SourceSlot, DestInventory, DestSlot))
+			return;
+
+		SerializeAndSaveInventory(SourceInventoryName);
+	}
+
+	SerializeAndSaveInventory(DestInventoryName);
+}
+
+bool AOWSCharacter::Server_SplitInventoryStack_Validate(FName InventoryName, int32 Slot, int32 Quantity)
+{
+	return Slot >= 0 && Quantity > 0;
+}
+
+void AOWSCharacter::Server_SplitInventoryStack_Implementation(FName InventoryName, int32 Slot, int32 Quantity)
+{
+	UOWSInventory* Inventory = GetHUDInventoryFromName(InventoryName);
+	const FOWSInventoryItemRecord* ItemToSplit = Inventory ? Inventory->FindItemInSlot(Slot) : nullptr;
+
+	//Splitting off the whole stack would just move it
+	if (!ItemToSplit || Quantity >= ItemToSplit->Quantity)
+		return;
+
+	const int32 EmptySlot = Inventory->FindFirstEmptySlotToFitItemOfSize(ItemToSplit->IconSlotWidth, ItemToSplit->IconSlotHeight);
+	if (EmptySlot == -1)
+		return;
+
+	FString SplitCustomData;
+	const FOWSInventoryItemRecord SplitItems = Inventory->RemoveItemsFromSlot(Slot, Quantity, SplitCustomData);
+	Inventory->AddItemToSlot_Internal(SplitItems, SplitCustomData, EmptySlot);
+
+	SerializeAndSaveInventory(InventoryName);
+}
+
+
 FString AOWSCharacter::SerializeInventory(FName InventoryName)
 {
 	FString output = "";
@@ -1688,15 +1730,15 @@ FString AOWSCharacter::SerializeInventory(FName InventoryName)
 
 	if (InventoryToSerialize)
 	{
-		//Loop through the ItemStacks and serialize them to a string
-		for (auto ItemStack : InventoryToSerialize->InventoryItemStacks)
+		//Loop through the slots and serialize them to a string
+		for (int32 SlotNumber = 0; SlotNumber < InventoryToSerialize->InventoryItemRecords.Num(); SlotNumber++)
 		{
-			AOWSInventoryItem* InventoryItem = ItemStack->GetTopItemFromStack();
+			const FOWSInventoryItemRecord& InventoryItem = InventoryToSerialize->InventoryItemRecords[SlotNumber];
 
 			//Only save valid items
-			if (InventoryItem)
+			if (!InventoryItem.IsEmpty())
 			{
-				output += InventoryItem->UniqueItemGUID.ToString() + "*" + FString::FromInt(ItemStack->SlotNumber) + "*" + FString::FromInt(ItemStack->InventoryItems.Num()) + "*" + FString::FromInt(InventoryItem->NumberOfUsesLeft) + "*" + FString::FromInt(InventoryItem->Condition);
+				output += InventoryItem.UniqueItemGUID.ToString() + "*" + FString::FromInt(SlotNumber) + "*" + FString::FromInt(InventoryItem.Quantity) + "*" + FString::FromInt(InventoryItem.NumberOfUsesLeft) + "*" + FString::FromInt(InventoryItem.Condition);
 				output += "|";
 			}
 		}
@@ -1722,84 +1764,247 @@ void AOWSCharacter::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & Out
 	DOREPLIFETIME(AOWSCharacter, Gender);
 	DOREPLIFETIME(AOWSCharacter, IsEnemy);
 	DOREPLIFETIME(AOWSCharacter, CharacterLevel);
-	DOREPLIFETIME(AOWSCharacter, XP);
-	DOREPLIFETIME(AOWSCharacter, HitDice);
-	DOREPLIFETIME(AOWSCharacter, HitDie);
+	DOREPLIFETIME(AOWSCharacter, TeamNumber);
 	DOREPLIFETIME(AOWSCharacter, MaxHP);
 	DOREPLIFETIME(AOWSCharacter, Wounds);
-	DOREPLIFETIME(AOWSCharacter, Strength);
-	DOREPLIFETIME(AOWSCharacter, Dexterity);
-	DOREPLIFETIME(AOWSCharacter, Constitution);
-	DOREPLIFETIME(AOWSCharacter, Intellect);
-	DOREPLIFETIME(AOWSCharacter, Wisdom);
-	DOREPLIFETIME(AOWSCharacter, Charisma);
-	DOREPLIFETIME(AOWSCharacter, Spirit);
-	DOREPLIFETIME(AOWSCharacter, Magic);
-	DOREPLIFETIME(AOWSCharacter, Fortitude);
-	DOREPLIFETIME(AOWSCharacter, Reflex);
-	DOREPLIFETIME(AOWSCharacter, Willpower);
-	DOREPLIFETIME(AOWSCharacter, TeamNumber);
-	DOREPLIFETIME(AOWSCharacter, Perception);
-	DOREPLIFETIME(AOWSCharacter, Acrobatics);
-	DOREPLIFETIME(AOWSCharacter, Climb);
-	DOREPLIFETIME(AOWSCharacter, Stealth);
-	DOREPLIFETIME(AOWSCharacter, Thirst);
-	DOREPLIFETIME(AOWSCharacter, Hunger);
-	DOREPLIFETIME(AOWSCharacter, Gold);
-	DOREPLIFETIME(AOWSCharacter, Score);
 	DOREPLIFETIME(AOWSCharacter, MaxHealth);
 	DOREPLIFETIME(AOWSCharacter, Health);
-	DOREPLIFETIME(AOWSCharacter, HealthRegenRate);
-	DOREPLIFETIME(AOWSCharacter, MaxMana);
-	DOREPLIFETIME(AOWSCharacter, Mana);
-	DOREPLIFETIME(AOWSCharacter, ManaRegenRate);
-	DOREPLIFETIME(AOWSCharacter, MaxEnergy);
-	DOREPLIFETIME(AOWSCharacter, Energy);
-	DOREPLIFETIME(AOWSCharacter, EnergyRegenRate);
-	DOREPLIFETIME(AOWSCharacter, MaxFatigue);
-	DOREPLIFETIME(AOWSCharacter, Fatigue);
-	DOREPLIFETIME(AOWSCharacter, FatigueRegenRate);
-	DOREPLIFETIME(AOWSCharacter, MaxStamina);
-	DOREPLIFETIME(AOWSCharacter, Stamina);
-	DOREPLIFETIME(AOWSCharacter, StaminaRegenRate);
-	DOREPLIFETIME(AOWSCharacter, MaxEndurance);
-	DOREPLIFETIME(AOWSCharacter, Endurance);
-	DOREPLIFETIME(AOWSCharacter, EnduranceRegenRate);
-	DOREPLIFETIME(AOWSCharacter, Agility);
-	DOREPLIFETIME(AOWSCharacter, BaseAttack);
-	DOREPLIFETIME(AOWSCharacter, BaseAttackBonus);
-	DOREPLIFETIME(AOWSCharacter, AttackPower);
-	DOREPLIFETIME(AOWSCharacter, AttackSpeed);
-	DOREPLIFETIME(AOWSCharacter, CritChance);
-	DOREPLIFETIME(AOWSCharacter, CritMultiplier);
-	DOREPLIFETIME(AOWSCharacter, Haste);
-	DOREPLIFETIME(AOWSCharacter, SpellPower);
-	DOREPLIFETIME(AOWSCharacter, SpellPenetration);
-	DOREPLIFETIME(AOWSCharacter, Defense);
-	DOREPLIFETIME(AOWSCharacter, Dodge);
-	DOREPLIFETIME(AOWSCharacter, Parry);
-	DOREPLIFETIME(AOWSCharacter, Avoidance);
-	DOREPLIFETIME(AOWSCharacter, Versatility);
-	DOREPLIFETIME(AOWSCharacter, Multishot);
-	DOREPLIFETIME(AOWSCharacter, Initiative);
-	DOREPLIFETIME(AOWSCharacter, NaturalArmor);
-	DOREPLIFETIME(AOWSCharacter, PhysicalArmor);
-	DOREPLIFETIME(AOWSCharacter, BonusArmor);
-	DOREPLIFETIME(AOWSCharacter, ForceArmor);
-	DOREPLIFETIME(AOWSCharacter, MagicArmor);
-	DOREPLIFETIME(AOWSCharacter, Resistance);
-	DOREPLIFETIME(AOWSCharacter, ReloadSpeed);
-
-	DOREPLIFETIME(AOWSCharacter, PremiumCurrency);
-	DOREPLIFETIME(AOWSCharacter, FreeCurrency);
-	DOREPLIFETIME(AOWSCharacter, Silver);
-	DOREPLIFETIME(AOWSCharacter, Copper);
-
-	DOREPLIFETIME(AOWSCharacter, Range);
-	DOREPLIFETIME(AOWSCharacter, Speed);
 
 	DOREPLIFETIME(AOWSCharacter, IsAdmin);
 	DOREPLIFETIME(AOWSCharacter, IsModerator);
 
-	//DOREPLIFETIME_CONDITION(AOWSCharacter, InventoriesToManage, COND_OwnerOnly)
+	// Replicate the rest of the sheet to the owner only
+	DOREPLIFETIME_CONDITION(AOWSCharacter, OwnerStatSheet, COND_OwnerOnly);
+
+	DOREPLIFETIME_CONDITION(AOWSCharacter, InventoriesToManage, COND_OwnerOnly);
+}
+
+namespace OWSCharacterStatSheet
+{
+	//Order is the wire format, so only ever append
+	static float AOWSCharacter::* const FloatStats[] = {
+		&AOWSCharacter::HitDie, &AOWSCharacter::Thirst, &AOWSCharacter::Hunger, &AOWSCharacter::HealthRegenRate,
+		&AOWSCharacter::MaxMana, &AOWSCharacter::Mana, &AOWSCharacter::ManaRegenRate,
+		&AOWSCharacter::MaxEnergy, &AOWSCharacter::Energy, &AOWSCharacter::EnergyRegenRate,
+		&AOWSCharacter::MaxFatigue, &AOWSCharacter::Fatigue, &AOWSCharacter::FatigueRegenRate,
+		&AOWSCharacter::MaxStamina, &AOWSCharacter::Stamina, &AOWSCharacter::StaminaRegenRate,
+		&AOWSCharacter::MaxEndurance, &AOWSCharacter::Endurance, &AOWSCharacter::EnduranceRegenRate,
+		&AOWSCharacter::Strength, &AOWSCharacter::Dexterity, &AOWSCharacter::Constitution, &AOWSCharacter::Intellect,
+		&AOWSCharacter::Wisdom, &AOWSCharacter::Charisma, &AOWSCharacter::Agility, &AOWSCharacter::Spirit,
+		&AOWSCharacter::Magic, &AOWSCharacter::Fortitude, &AOWSCharacter::Reflex, &AOWSCharacter::Willpower,
+		&AOWSCharacter::BaseAttack, &AOWSCharacter::BaseAttackBonus, &AOWSCharacter::AttackPower, &AOWSCharacter::AttackSpeed,
+		&AOWSCharacter::CritChance, &AOWSCharacter::CritMultiplier, &AOWSCharacter::Haste,
+		&AOWSCharacter::SpellPower, &AOWSCharacter::SpellPenetration,
+		&AOWSCharacter::Defense, &AOWSCharacter::Dodge, &AOWSCharacter::Parry, &AOWSCharacter::Avoidance,
+		&AOWSCharacter::Versatility, &AOWSCharacter::Multishot, &AOWSCharacter::Initiative,
+		&AOWSCharacter::NaturalArmor, &AOWSCharacter::PhysicalArmor, &AOWSCharacter::BonusArmor, &AOWSCharacter::ForceArmor,
+		&AOWSCharacter::MagicArmor, &AOWSCharacter::Resistance, &AOWSCharacter::ReloadSpeed,
+		&AOWSCharacter::Range, &AOWSCharacter::Speed
+	};
+
+	static int32 AOWSCharacter::* const IntStats[] = {
+		&AOWSCharacter::XP, &AOWSCharacter::Gold, &AOWSCharacter::Silver, &AOWSCharacter::Copper,
+		&AOWSCharacter::FreeCurrency, &AOWSCharacter::PremiumCurrency, &AOWSCharacter::Score,
+		&AOWSCharacter::HitDice, &AOWSCharacter::Perception, &AOWSCharacter::Acrobatics, &AOWSCharacter::Climb, &AOWSCharacter::Stealth
+	};
+
+	//Only ever sent to the owning connection.  Inspecting another player zeroes these rather than dropping them, so indices still line up.
+	static int32 AOWSCharacter::* const OwnerOnlyIntStats[] = {
+		&AOWSCharacter::Gold, &AOWSCharacter::Silver, &AOWSCharacter::Copper, &AOWSCharacter::FreeCurrency, &AOWSCharacter::PremiumCurrency
+	};
+
+	//What one connection last received
+	class FDeltaState : public INetDeltaBaseState
+	{
+	public:
+		TArray<float> FloatStats;
+		TArray<int32> IntStats;
+
+		virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+		{
+			const FDeltaState* Other = static_cast<const FDeltaState*>(OtherState);
+			return FloatStats == Other->FloatStats && IntStats == Other->IntStats;
+		}
+	};
+
+	template <typename T>
+	void WriteChangedStats(FBitWriter& Writer, const TArray<T>& Stats, const TArray<T>* LastSentStats)
+	{
+		uint32 NumStats = Stats.Num();
+		Writer.SerializeIntPacked(NumStats);
+
+		for (int32 StatIndex = 0; StatIndex < Stats.Num(); StatIndex++)
+		{
+			T Value = Stats[StatIndex];
+			const bool bChanged = !LastSentStats || !LastSentStats->IsValidIndex(StatIndex) || (*LastSentStats)[StatIndex] != Value;
+			Writer.WriteBit(bChanged);
+			if (bChanged)
+			{
+				Writer << Value;
+			}
+		}
+	}
+
+	template <typename T>
+	void ReadChangedStats(FBitReader& Reader, TArray<T>& Stats)
+	{
+		uint32 NumStats = 0;
+		Reader.SerializeIntPacked(NumStats);
+		if (NumStats > 1024)
+		{
+			Reader.SetError();
+			return;
+		}
+		Stats.SetNumZeroed(NumStats);
+
+		for (uint32 StatIndex = 0; StatIndex < NumStats && !Reader.IsError(); StatIndex++)
+		{
+			if (Reader.ReadBit())
+			{
+				Reader << Stats[StatIndex];
+			}
+		}
+	}
+}
+
+bool FOWSCharacterStatSheet::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	using namespace OWSCharacterStatSheet;
+
+	if (DeltaParms.Writer)
+	{
+		const FDeltaState* OldState = static_cast<const FDeltaState*>(DeltaParms.OldState);
+
+		//Nothing changed since this connection's last update
+		if (OldState && OldState->FloatStats == FloatStats && OldState->IntStats == IntStats)
+		{
+			return false;
+		}
+
+		TSharedPtr<FDeltaState> NewState = MakeShared<FDeltaState>();
+		NewState->FloatStats = FloatStats;
+		NewState->IntStats = IntStats;
+		*DeltaParms.NewState = NewState;
+
+		WriteChangedStats(*DeltaParms.Writer, FloatStats, OldState ? &OldState->FloatStats : nullptr);
+		WriteChangedStats(*DeltaParms.Writer, IntStats, OldState ? &OldState->IntStats : nullptr);
+		return true;
+	}
+
+	if (DeltaParms.Reader)
+	{
+		ReadChangedStats(*DeltaParms.Reader, FloatStats);
+		ReadChangedStats(*DeltaParms.Reader, IntStats);
+		return !DeltaParms.Reader->IsError();
+	}
+
+	//No object references to map
+	return true;
+}
+
+void AOWSCharacter::PackStatSheet(FOWSCharacterStatSheet& OutStatSheet) const
+{
+	OutStatSheet.FloatStats.SetNumUninitialized(UE_ARRAY_COUNT(OWSCharacterStatSheet::FloatStats));
+	for (int32 StatIndex = 0; StatIndex < UE_ARRAY_COUNT(OWSCharacterStatSheet::FloatStats); StatIndex++)
+	{
+		OutStatSheet.FloatStats[StatIndex] = this->*OWSCharacterStatSheet::FloatStats[StatIndex];
+	}
+
+	OutStatSheet.IntStats.SetNumUninitialized(UE_ARRAY_COUNT(OWSCharacterStatSheet::IntStats));
+	for (int32 StatIndex = 0; StatIndex < UE_ARRAY_COUNT(OWSCharacterStatSheet::IntStats); StatIndex++)
+	{
+		OutStatSheet.IntStats[StatIndex] = this->*OWSCharacterStatSheet::IntStats[StatIndex];
+	}
+}
+
+void AOWSCharacter::UnpackStatSheet(const FOWSCharacterStatSheet& StatSheet)
+{
+	const int32 NumFloatStats = FMath::Min<int32>(StatSheet.FloatStats.Num(), UE_ARRAY_COUNT(OWSCharacterStatSheet::FloatStats));
+	for (int32 StatIndex = 0; StatIndex < NumFloatStats; StatIndex++)
+	{
+		this->*OWSCharacterStatSheet::FloatStats[StatIndex] = StatSheet.FloatStats[StatIndex];
+	}
+
+	const int32 NumIntStats = FMath::Min<int32>(StatSheet.IntStats.Num(), UE_ARRAY_COUNT(OWSCharacterStatSheet::IntStats));
+	for (int32 StatIndex = 0; StatIndex < NumIntStats; StatIndex++)
+	{
+		this->*OWSCharacterStatSheet::IntStats[StatIndex] = StatSheet.IntStats[StatIndex];
+	}
+}
+
+void AOWSCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	//Copying ~70 values is cheaper than comparing them as separate properties, and only the owner's connection diffs them
+	PackStatSheet(OwnerStatSheet);
+
+	Super::PreReplication(ChangedPropertyTracker);
+}
+
+void AOWSCharacter::OnRep_OwnerStatSheet()
+{
+	UnpackStatSheet(OwnerStatSheet);
+}
+
+void AOWSCharacter::RequestInspectStats(AOWSCharacter* Target)
+{
+	if (Target)
+	{
+		Server_RequestInspectStats(Target);
+	}
+}
+
+bool AOWSCharacter::Server_RequestInspectStats_Validate(AOWSCharacter* Target)
+{
+	//Target can be null if it was destroyed while the request was in flight
+	return !Target || Target->GetWorld() == GetWorld();
+}
+
+void AOWSCharacter::Server_RequestInspectStats_Implementation(AOWSCharacter* Target)
+{
+	if (!Target)
+	{
+		return;
+	}
+
+	//Out of range requests are dropped rather than kicked, the client's view of Target's position can lag behind
+	if (Target != this && FVector::DistSquared(GetActorLocation(), Target->GetActorLocation()) > FMath::Square(MaxInspectDistance))
+	{
+		UE_LOG(OWS, Verbose, TEXT("Server_RequestInspectStats - %s is too far away from %s to inspect"), *Target->GetName(), *GetName());
+		return;
+	}
+
+	FOWSCharacterStatSheet TargetStatSheet;
+	Target->PackStatSheet(TargetStatSheet);
+
+	if (Target != this)
+	{
+		using namespace OWSCharacterStatSheet;
+
+		for (int32 StatIndex = 0; StatIndex < UE_ARRAY_COUNT(IntStats); StatIndex++)
+		{
+			for (int32 AOWSCharacter::* const OwnerOnlyStat : OwnerOnlyIntStats)
+			{
+				if (IntStats[StatIndex] == OwnerOnlyStat)
+				{
+					TargetStatSheet.IntStats[StatIndex] = 0;
+				}
+			}
+		}
+	}
+
+	Client_ReceiveInspectStats(Target, TargetStatSheet.FloatStats, TargetStatSheet.IntStats);
+}
+
+void AOWSCharacter::Client_ReceiveInspectStats_Implementation(AOWSCharacter* Target, const TArray<float>& FloatStats, const TArray<int32>& IntStats)
+{
+	if (!Target)
+	{
+		return;
+	}
+
+	FOWSCharacterStatSheet TargetStatSheet;
+	TargetStatSheet.FloatStats = FloatStats;
+	TargetStatSheet.IntStats = IntStats;
+	Target->UnpackStatSheet(TargetStatSheet);
+	Target->NotifyInspectStatsReceived();
 }
\ No newline at end of file
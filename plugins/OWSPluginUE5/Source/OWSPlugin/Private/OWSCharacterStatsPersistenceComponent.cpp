@@ -0,0 +1,313 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "OWSCharacterStatsPersistenceComponent.h"
+#include "OWSPlugin.h"
+#include "OWSCharacterWithAbilities.h"
+#include "OWSPlayerController.h"
+#include "OWSPlayerControllerComponent.h"
+#include "OWSAttributeSet.h"
+#include "AbilitySystemComponent.h"
+#include "GameFramework/PlayerState.h"
+#include "Runtime/JsonUtilities/Public/JsonObjectConverter.h"
+#include "TimerManager.h"
+
+namespace OWSCharacterStatsPersistence
+{
+	//One saved stat.  Exactly one of GetAttribute, FloatField or IntField is set.
+	struct FPersistedStat
+	{
+		const TCHAR* ColumnName;
+		FGameplayAttribute(*GetAttribute)();
+		float AOWSCharacter::* FloatField;
+		int32 AOWSCharacter::* IntField;
+	};
+
+#define OWS_ATTRIBUTE_STAT(Name) { TEXT(#Name), &UOWSAttributeSet::Get##Name##Attribute, nullptr, nullptr }
+#define OWS_FLOAT_STAT(Column, Field) { TEXT(Column), nullptr, &AOWSCharacter::Field, nullptr }
+#define OWS_INT_STAT(Column, Field) { TEXT(Column), nullptr, nullptr, &AOWSCharacter::Field }
+
+	//Same sources as AOWSCharacterWithAbilities::UpdateCharacterStats
+	static const FPersistedStat Stats[] = {
+		OWS_INT_STAT("CharacterLevel", CharacterLevel),
+		OWS_INT_STAT("Gender", Gender),
+		OWS_INT_STAT("XP", XP),
+		OWS_INT_STAT("TeamNumber", TeamNumber),
+		OWS_INT_STAT("Gold", Gold),
+		OWS_INT_STAT("Silver", Silver),
+		OWS_INT_STAT("Copper", Copper),
+		OWS_INT_STAT("FreeCurrency", FreeCurrency),
+		OWS_INT_STAT("PremiumCurrency", PremiumCurrency),
+		OWS_INT_STAT("Score", Score),
+		OWS_INT_STAT("HitDie", HitDice),
+		OWS_INT_STAT("Perception", Perception),
+		OWS_INT_STAT("Acrobatics", Acrobatics),
+		OWS_INT_STAT("Climb", Climb),
+		OWS_INT_STAT("Stealth", Stealth),
+		OWS_FLOAT_STAT("Wounds", Wounds),
+		OWS_FLOAT_STAT("Thirst", Thirst),
+		OWS_FLOAT_STAT("Hunger", Hunger),
+		OWS_ATTRIBUTE_STAT(MaxHealth),
+		OWS_ATTRIBUTE_STAT(Health),
+		OWS_ATTRIBUTE_STAT(HealthRegenRate),
+		OWS_ATTRIBUTE_STAT(MaxMana),
+		OWS_ATTRIBUTE_STAT(Mana),
+		OWS_ATTRIBUTE_STAT(ManaRegenRate),
+		OWS_ATTRIBUTE_STAT(MaxEnergy),
+		OWS_ATTRIBUTE_STAT(Energy),
+		OWS_ATTRIBUTE_STAT(EnergyRegenRate),
+		OWS_ATTRIBUTE_STAT(MaxFatigue),
+		OWS_ATTRIBUTE_STAT(Fatigue),
+		OWS_ATTRIBUTE_STAT(FatigueRegenRate),
+		OWS_ATTRIBUTE_STAT(MaxStamina),
+		OWS_ATTRIBUTE_STAT(Stamina),
+		OWS_ATTRIBUTE_STAT(StaminaRegenRate),
+		OWS_ATTRIBUTE_STAT(MaxEndurance),
+		OWS_ATTRIBUTE_STAT(Endurance),
+		OWS_ATTRIBUTE_STAT(EnduranceRegenRate),
+		OWS_ATTRIBUTE_STAT(Strength),
+		OWS_ATTRIBUTE_STAT(Dexterity),
+		OWS_ATTRIBUTE_STAT(Constitution),
+		OWS_ATTRIBUTE_STAT(Intellect),
+		OWS_ATTRIBUTE_STAT(Wisdom),
+		OWS_ATTRIBUTE_STAT(Charisma),
+		OWS_ATTRIBUTE_STAT(Agility),
+		OWS_ATTRIBUTE_STAT(Spirit),
+		OWS_ATTRIBUTE_STAT(Magic),
+		OWS_ATTRIBUTE_STAT(Fortitude),
+		OWS_ATTRIBUTE_STAT(Reflex),
+		OWS_ATTRIBUTE_STAT(Willpower),
+		OWS_ATTRIBUTE_STAT(BaseAttack),
+		OWS_ATTRIBUTE_STAT(BaseAttackBonus),
+		OWS_ATTRIBUTE_STAT(AttackPower),
+		OWS_ATTRIBUTE_STAT(AttackSpeed),
+		OWS_ATTRIBUTE_STAT(CritChance),
+		OWS_ATTRIBUTE_STAT(CritMultiplier),
+		OWS_ATTRIBUTE_STAT(Haste),
+		OWS_ATTRIBUTE_STAT(SpellPower),
+		OWS_ATTRIBUTE_STAT(SpellPenetration),
+		OWS_ATTRIBUTE_STAT(Defense),
+		OWS_ATTRIBUTE_STAT(Dodge),
+		OWS_ATTRIBUTE_STAT(Parry),
+		OWS_ATTRIBUTE_STAT(Avoidance),
+		OWS_ATTRIBUTE_STAT(Versatility),
+		OWS_ATTRIBUTE_STAT(Multishot),
+		OWS_ATTRIBUTE_STAT(Initiative),
+		OWS_ATTRIBUTE_STAT(NaturalArmor),
+		OWS_ATTRIBUTE_STAT(PhysicalArmor),
+		OWS_ATTRIBUTE_STAT(BonusArmor),
+		OWS_ATTRIBUTE_STAT(ForceArmor),
+		OWS_ATTRIBUTE_STAT(MagicArmor),
+		OWS_ATTRIBUTE_STAT(Resistance),
+		OWS_ATTRIBUTE_STAT(ReloadSpeed),
+		OWS_ATTRIBUTE_STAT(Range),
+		OWS_ATTRIBUTE_STAT(Speed)
+	};
+
+#undef OWS_ATTRIBUTE_STAT
+#undef OWS_FLOAT_STAT
+#undef OWS_INT_STAT
+
+	static constexpr int32 NumStats = UE_ARRAY_COUNT(Stats);
+}
+
+UOWSCharacterStatsPersistenceComponent::UOWSCharacterStatsPersistenceComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	FlushInterval = 10.f;
+	bHasSavedBaseline = false;
+	bFlushInFlight = false;
+}
+
+void UOWSCharacterStatsPersistenceComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	using namespace OWSCharacterStatsPersistence;
+
+	OwningCharacter = Cast<AOWSCharacterWithAbilities>(GetOwner());
+	if (!OwningCharacter || !OwningCharacter->HasAuthority() || OwningCharacter->IsAMob)
+	{
+		return;
+	}
+
+	GConfig->GetFloat(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSCharacterStatsFlushInterval"),
+		FlushInterval,
+		GGameIni
+	);
+
+	SavedValues.SetNumZeroed(NumStats);
+	InFlightValues.SetNumZeroed(NumStats);
+	DirtyStats.Init(false, NumStats);
+	InFlightStats.Init(false, NumStats);
+
+	if (UAbilitySystemComponent* AbilitySystem = OwningCharacter->GetAbilitySystemComponent())
+	{
+		for (int32 StatIndex = 0; StatIndex < NumStats; StatIndex++)
+		{
+			if (Stats[StatIndex].GetAttribute)
+			{
+				AbilitySystem->GetGameplayAttributeValueChangeDelegate(Stats[StatIndex].GetAttribute()).AddUObject(this, &UOWSCharacterStatsPersistenceComponent::OnAttributeChanged, StatIndex);
+			}
+		}
+	}
+
+	if (FlushInterval > 0.f)
+	{
+		GetWorld()->GetTimerManager().SetTimer(FlushTimerHandle, this, &UOWSCharacterStatsPersistenceComponent::FlushDirtyStats, FlushInterval, true);
+	}
+}
+
+void UOWSCharacterStatsPersistenceComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (FlushTimerHandle.IsValid())
+	{
+		GetWorld()->GetTimerManager().ClearTimer(FlushTimerHandle);
+
+		//Don't lose whatever changed since the last flush
+		if (EndPlayReason == EEndPlayReason::Destroyed || EndPlayReason == EEndPlayReason::RemovedFromWorld)
+		{
+			bFlushInFlight = false;
+			FlushDirtyStats();
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+double UOWSCharacterStatsPersistenceComponent::GetStatValue(int32 StatIndex) const
+{
+	const OWSCharacterStatsPersistence::FPersistedStat& Stat = OWSCharacterStatsPersistence::Stats[StatIndex];
+
+	if (Stat.GetAttribute)
+	{
+		return OwningCharacter->GetAbilitySystemComponent()->GetNumericAttributeBase(Stat.GetAttribute());
+	}
+
+	if (Stat.FloatField)
+	{
+		return OwningCharacter->*Stat.FloatField;
+	}
+
+	return OwningCharacter->*Stat.IntField;
+}
+
+void UOWSCharacterStatsPersistenceComponent::OnAttributeChanged(const FOnAttributeChangeData& Data, int32 StatIndex)
+{
+	DirtyStats[StatIndex] = true;
+}
+
+void UOWSCharacterStatsPersistenceComponent::MarkAllStatsSaved()
+{
+	if (!OwningCharacter || SavedValues.Num() != OWSCharacterStatsPersistence::NumStats)
+	{
+		return;
+	}
+
+	for (int32 StatIndex = 0; StatIndex < OWSCharacterStatsPersistence::NumStats; StatIndex++)
+	{
+		SavedValues[StatIndex] = GetStatValue(StatIndex);
+	}
+
+	DirtyStats.SetRange(0, DirtyStats.Num(), false);
+	bHasSavedBaseline = true;
+}
+
+void UOWSCharacterStatsPersistenceComponent::RequestFullResync()
+{
+	if (OwningCharacter)
+	{
+		//Saves every stat and calls MarkAllStatsSaved
+		OwningCharacter->UpdateCharacterStats();
+	}
+}
+
+void UOWSCharacterStatsPersistenceComponent::FlushDirtyStats()
+{
+	using namespace OWSCharacterStatsPersistence;
+
+	if (!bHasSavedBaseline || bFlushInFlight || !OwningCharacter)
+	{
+		return;
+	}
+
+	AOWSPlayerController* PC = Cast<AOWSPlayerController>(OwningCharacter->Controller);
+	if (!PC || !PC->PlayerState)
+	{
+		return;
+	}
+
+	FUpdateCharacterStatsDeltaJSONPost CharacterStatsDelta;
+
+	for (int32 StatIndex = 0; StatIndex < NumStats; StatIndex++)
+	{
+		//Attributes mark themselves dirty.  The few stats that live on the character are cheap enough to compare every flush.
+		if (!DirtyStats[StatIndex] && Stats[StatIndex].GetAttribute)
+		{
+			continue;
+		}
+
+		DirtyStats[StatIndex] = false;
+
+		const double Value = GetStatValue(StatIndex);
+		if (Value == SavedValues[StatIndex])
+		{
+			continue;
+		}
+
+		InFlightStats[StatIndex] = true;
+		InFlightValues[StatIndex] = Value;
+
+		if (Stats[StatIndex].IntField)
+		{
+			CharacterStatsDelta.UpdateCharacterStatsDelta.IntStats.Add(Stats[StatIndex].ColumnName, (int32)Value);
+		}
+		else
+		{
+			CharacterStatsDelta.UpdateCharacterStatsDelta.FloatStats.Add(Stats[StatIndex].ColumnName, (float)Value);
+		}
+	}
+
+	if (CharacterStatsDelta.UpdateCharacterStatsDelta.IntStats.Num() == 0 && CharacterStatsDelta.UpdateCharacterStatsDelta.FloatStats.Num() == 0)
+	{
+		return;
+	}
+
+	CharacterStatsDelta.UpdateCharacterStatsDelta.CharName = PC->PlayerState->GetPlayerName();
+
+	FString PostParameters = "";
+	if (!FJsonObjectConverter::UStructToJsonObjectString(CharacterStatsDelta, PostParameters))
+	{
+		UE_LOG(OWS, Error, TEXT("FlushDirtyStats Error serializing CharacterStatsDelta!"));
+		OnFlushFailed(TEXT("Serialization failed"));
+		return;
+	}
+
+	bFlushInFlight = true;
+	PC->OWSPlayerControllerComponent->OnNotifyUpdateCharacterStatsDeltaDelegate.BindUObject(this, &UOWSCharacterStatsPersistenceComponent::OnFlushSucceeded);
+	PC->OWSPlayerControllerComponent->OnErrorUpdateCharacterStatsDeltaDelegate.BindUObject(this, &UOWSCharacterStatsPersistenceComponent::OnFlushFailed);
+	PC->OWSPlayerControllerComponent->UpdateCharacterStatsDelta(PostParameters);
+}
+
+void UOWSCharacterStatsPersistenceComponent::OnFlushSucceeded()
+{
+	for (TConstSetBitIterator<> It(InFlightStats); It; ++It)
+	{
+		SavedValues[It.GetIndex()] = InFlightValues[It.GetIndex()];
+	}
+
+	InFlightStats.SetRange(0, InFlightStats.Num(), false);
+	bFlushInFlight = false;
+}
+
+void UOWSCharacterStatsPersistenceComponent::OnFlushFailed(const FString& ErrorMsg)
+{
+	UE_LOG(OWS, Warning, TEXT("UOWSCharacterStatsPersistenceComponent - Stats delta save failed, will retry next flush: %s"), *ErrorMsg);
+
+	//Send them again next flush
+	DirtyStats.CombineWithBitwiseOR(InFlightStats, EBitwiseOperatorFlags::MaintainSize);
+	InFlightStats.SetRange(0, InFlightStats.Num(), false);
+	bFlushInFlight = false;
+}
@@ -13,6 +13,7 @@
 #include "GameplayTagsModule.h"
 #include "OWSAttributeSet.h"
 #include "OWSAdvancedProjectile.h"
+#include "OWSCharacterStatsPersistenceComponent.h"
 //#include "OWSGameplayAbility.h"
 #include "Runtime/Engine/Classes/GameFramework/PlayerState.h"
 
@@ -30,6 +31,10 @@ AOWSCharacterWithAbilities::AOWSCharacterWithAbilities(const class FObjectInitia
 	WeaponAbilityHandles.SetNum(22, EAllowShrinking::No);
 
 	OWSAttributes = CreateDefaultSubobject<UOWSAttributeSet>(TEXT("AttributeSet"));
+
+	StatsPersistence = CreateDefaultSubobject<UOWSCharacterStatsPersistenceComponent>(TEXT("StatsPersistence"));
+
+	bDefaultAbilitiesGranted = false;
 }
 
 
@@ -170,121 +175,96 @@ void AOWSCharacterWithAbilities::OnRep_Controller()
 
 void AOWSCharacterWithAbilities::AddDefaultGameplayAbilities()
 {
-	if (AbilitySystem)
+	if (!AbilitySystem || !HasAuthority())
+		return;
+
+	//PossessedBy runs again when a controller re-possesses this character.  The abilities are still there.
+	if (bDefaultAbilitiesGranted)
+		return;
+
+	bDefaultAbilitiesGranted = true;
+
+	const TSubclassOf<UGameplayAbility> SpellSlots[] = { Ability1, Ability2, Ability3, Ability4, Ability5, Ability6, Ability7, Ability8, Ability9, Ability0,
+		Ability11, Ability12, Ability13, Ability14, Ability15, Ability16, Ability17, Ability18, Ability19, Ability20, Ability21, Ability22 };
+	const TSubclassOf<UGameplayAbility> WeaponSlots[] = { Weapon1, Weapon2 };
+
+	TArray<FOWSAbilitySetEntry, TInlineAllocator<32>> DefaultAbilities;
+
+	for (int32 SlotIndex = 0; SlotIndex < UE_ARRAY_COUNT(SpellSlots); SlotIndex++)
 	{
-		if (HasAuthority())
+		if (SpellSlots[SlotIndex])
 		{
-			if (Ability1)
-			{
-				SpellAbilityHandles[0] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability1.GetDefaultObject(), 1, 0));
-			}
-
-			if (Ability2)
-			{
-				SpellAbilityHandles[1] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability2.GetDefaultObject(), 1, 1));
-			}
+			DefaultAbilities.Emplace(SpellSlots[SlotIndex], EOWSAbilitySetSlot::Spell, SlotIndex + 1);
+		}
+	}
 
-			if (Ability3)
-			{
-				SpellAbilityHandles[2] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability3.GetDefaultObject(), 1, 2));
-			}
+	for (int32 SlotIndex = 0; SlotIndex < UE_ARRAY_COUNT(WeaponSlots); SlotIndex++)
+	{
+		if (WeaponSlots[SlotIndex])
+		{
+			DefaultAbilities.Emplace(WeaponSlots[SlotIndex], EOWSAbilitySetSlot::Weapon, SlotIndex + 1);
+		}
+	}
 
-			if (Ability4)
-			{
-				SpellAbilityHandles[3] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability4.GetDefaultObject(), 1, 3));
-			}
+	if (DefaultAbilitySet)
+	{
+		DefaultAbilities.Append(DefaultAbilitySet->Abilities);
+	}
 
-			if (Ability5)
-			{
-				SpellAbilityHandles[4] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability5.GetDefaultObject(), 1, 4));
-			}
+	GrantAbilities(DefaultAbilities);
+}
 
-			if (Ability6)
-			{
-				SpellAbilityHandles[5] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability6.GetDefaultObject(), 1, 5));
-			}
+void AOWSCharacterWithAbilities::GrantAbilitySet(const UOWSAbilitySet* AbilitySet)
+{
+	if (AbilitySet)
+	{
+		GrantAbilities(AbilitySet->Abilities);
+	}
+}
 
-			if (Ability7)
-			{
-				SpellAbilityHandles[6] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability7.GetDefaultObject(), 1, 6));
-			}
+void AOWSCharacterWithAbilities::GrantAbilities(TConstArrayView<FOWSAbilitySetEntry> Abilities)
+{
+	if (!AbilitySystem || !HasAuthority() || Abilities.Num() == 0)
+		return;
 
-			if (Ability8)
-			{
-				SpellAbilityHandles[7] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability8.GetDefaultObject(), 1, 7));
-			}
+	//One allocation for the whole batch instead of growing the spec array on each GiveAbility
+	TArray<FGameplayAbilitySpec>& ActivatableAbilities = AbilitySystem->GetActivatableAbilities();
+	ActivatableAbilities.Reserve(ActivatableAbilities.Num() + Abilities.Num());
 
-			if (Ability9)
-			{
-				SpellAbilityHandles[8] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability9.GetDefaultObject(), 1, 8));
-			}
+	for (const FOWSAbilitySetEntry& Entry : Abilities)
+	{
+		if (!Entry.Ability)
+			continue;
 
-			if (Ability0)
-			{
-				SpellAbilityHandles[9] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability0.GetDefaultObject(), 1, 9));
-			}
-			
-			if (Ability11)
-			{
-				SpellAbilityHandles[10] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability11.GetDefaultObject(), 1, 10));
-			}
-			if (Ability12)
-			{
-				SpellAbilityHandles[11] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability12.GetDefaultObject(), 1, 11));
-			}
-			if (Ability13)
-			{
-				SpellAbilityHandles[12] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability13.GetDefaultObject(), 1, 12));
-			}
-			if (Ability14)
-			{
-				SpellAbilityHandles[13] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability14.GetDefaultObject(), 1, 13));
-			}
-			if (Ability15)
-			{
-				SpellAbilityHandles[14] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability15.GetDefaultObject(), 1, 14));
-			}
-			if (Ability16)
-			{
-				SpellAbilityHandles[15] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability16.GetDefaultObject(), 1, 15));
-			}
-			if (Ability17)
-			{
-				SpellAbilityHandles[16] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability17.GetDefaultObject(), 1, 16));
-			}
-			if (Ability18)
-			{
-				SpellAbilityHandles[17] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability18.GetDefaultObject(), 1, 17));
-			}
-			if (Ability19)
-			{
-				SpellAbilityHandles[18] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability19.GetDefaultObject(), 1, 18));
-			}
-			if (Ability20)
-			{
-				SpellAbilityHandles[19] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability20.GetDefaultObject(), 1, 19));
-			}
-			if (Ability21)
-			{
-				SpellAbilityHandles[20] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability21.GetDefaultObject(), 1, 20));
-			}
-			if (Ability22)
-			{
-				SpellAbilityHandles[21] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Ability22.GetDefaultObject(), 1, 21));
-			}
+		FGameplayAbilitySpecHandle* SlotHandle = nullptr;
+		if (Entry.SlotType == EOWSAbilitySetSlot::Spell && Entry.SlotNumber > 0 && Entry.SlotNumber <= SpellAbilityHandles.Num())
+		{
+			SlotHandle = &SpellAbilityHandles[Entry.SlotNumber - 1];
+		}
+		else if (Entry.SlotType == EOWSAbilitySetSlot::Weapon && Entry.SlotNumber > 0 && Entry.SlotNumber <= WeaponAbilityHandles.Num())
+		{
+			SlotHandle = &WeaponAbilityHandles[Entry.SlotNumber - 1];
+		}
+		else if (Entry.SlotType != EOWSAbilitySetSlot::None)
+		{
+			UE_LOG(OWS, Warning, TEXT("AOWSCharacterWithAbilities - GrantAbilities: %s has an invalid slot number %d"), *Entry.Ability->GetName(), Entry.SlotNumber);
+			continue;
+		}
 
-			if (Weapon1)
-			{
-				WeaponAbilityHandles[0] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Weapon1.GetDefaultObject(), 1, 22));
-			}
+		const FGameplayAbilitySpecHandle NewHandle = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Entry.Ability.GetDefaultObject(), Entry.AbilityLevel, Entry.GetInputID()));
 
-			if (Weapon2)
+		if (SlotHandle)
+		{
+			if (SlotHandle->IsValid())
 			{
-				WeaponAbilityHandles[1] = AbilitySystem->GiveAbility(FGameplayAbilitySpec(Weapon2.GetDefaultObject(), 1, 23));
+				AbilitySystem->ClearAbility(*SlotHandle);
 			}
-
+			*SlotHandle = NewHandle;
 		}
 	}
+
+	//Send the whole batch to the owner on the next net update
+	ForceNetUpdate();
 }
 
 void AOWSCharacterWithAbilities::SetupAttributeChangeDelegates()
@@ -536,6 +516,9 @@ void AOWSCharacterWithAbilities::LoadAttributesFromJSON(TSharedPtr<FJsonObject>
 	OWSAttributes->SetReloadSpeed(JsonObject->GetNumberField(TEXT("ReloadSpeed")));
 	OWSAttributes->SetRange(JsonObject->GetNumberField(TEXT("Range")));
 	OWSAttributes->SetSpeed(JsonObject->GetNumberField(TEXT("Speed")));
+
+	//Everything that was just loaded is already saved
+	StatsPersistence->MarkAllStatsSaved();
 }
 
 
@@ -750,6 +733,7 @@ void AOWSCharacterWithAbilities::UpdateCharacterStats()
 		if (FJsonObjectConverter::UStructToJsonObjectString(CharacterStats, PostParameters))
 		{
 			PC->OWSPlayerControllerComponent->UpdateCharacterStats(PostParameters);
+			StatsPersistence->MarkAllStatsSaved();
 		}
 		else
 		{
@@ -2,278 +2,420 @@
 
 #include "OWSChatManager.h"
 #include "OWSPlugin.h"
-#include "Runtime/Online/HTTP/Public/Http.h"
+#include "OWSPlayerController.h"
+#include "OWSJsonStructReader.h"
+#include "WebSocketsModule.h"
+#include "IWebSocket.h"
+#include "JsonObjectConverter.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerState.h"
 #include "Runtime/Core/Public/Misc/ConfigCacheIni.h"
 
 
 // Sets default values
 AOWSChatManager::AOWSChatManager()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = false;
 
-	Http = &FHttpModule::Get();
+	bReplicates = true;
+	bAlwaysRelevant = true;
+
+	ChatFlushInterval = 0.1f;
+	ChatReconnectDelay = 5.f;
+	ChatHistorySize = 100;
+	MaxMessageID = 0;
+	LastLocalChatMessageID = 0;
 }
 
 // Called when the game starts or when spawned
 void AOWSChatManager::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	GConfig->GetString(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSChatRelayURL"),
+		ChatRelayURL,
+		GGameIni
+	);
+
+	GConfig->GetString(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSAPICustomerKey"),
+		OWSAPICustomerKey,
+		GGameIni
+	);
+
+	GConfig->GetFloat(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSChatFlushInterval"),
+		ChatFlushInterval,
+		GGameIni
+	);
+
+	GConfig->GetFloat(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSChatReconnectDelay"),
+		ChatReconnectDelay,
+		GGameIni
+	);
+
+	GConfig->GetInt(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSChatHistorySize"),
+		ChatHistorySize,
+		GGameIni
+	);
+
+	if (ChatRelayURL.IsEmpty())
+	{
+		UE_LOG(OWS, Warning, TEXT("AOWSChatManager - OWSChatRelayURL is not set.  Chat will only reach players on this zone server."));
+	}
+	else
+	{
+		ConnectToChatRelay();
+	}
+
+	GetWorldTimerManager().SetTimer(FlushTimerHandle, this, &AOWSChatManager::FlushChat, FMath::Max(ChatFlushInterval, 0.01f), true);
 }
 
-// Called every frame
-void AOWSChatManager::Tick( float DeltaTime )
+void AOWSChatManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick( DeltaTime );
+	GetWorldTimerManager().ClearTimer(FlushTimerHandle);
+	GetWorldTimerManager().ClearTimer(ReconnectTimerHandle);
+
+	if (ChatRelaySocket.IsValid())
+	{
+		//Send anything still queued before the zone goes away
+		FlushChat();
+
+		ChatRelaySocket->OnConnected().RemoveAll(this);
+		ChatRelaySocket->OnConnectionError().RemoveAll(this);
+		ChatRelaySocket->OnClosed().RemoveAll(this);
+		ChatRelaySocket->OnRawMessage().RemoveAll(this);
+		ChatRelaySocket->Close();
+		ChatRelaySocket.Reset();
+	}
 
+	Super::EndPlay(EndPlayReason);
 }
 
-void AOWSChatManager::SendGlobalChat(FString SentFromCharacterName, FString Message)
+void AOWSChatManager::ConnectToChatRelay()
 {
-	/*
-	FString PlayerName = SentFromCharacterName;
-	PlayerName = PlayerName.Replace(TEXT(" "), TEXT("%20"));
-
-	FString FullMessageToSend = SentFromCharacterName + FString(TEXT(": ")) + Message;
-
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-	Request->OnProcessRequestComplete().BindUObject(this, &AOWSChatManager::OnSendGlobalChatResponseReceived);
-	//This is the url on which to process the request
-	FString url = FString(TEXT("http://" +  + "/Chat/AddGlobalChatMessage"));	
-
-	FString PostParameters = FString(TEXT("id=")) + PlayerName
-		+ FString(TEXT("&Message=")) + FullMessageToSend
-		+ FString(TEXT("&CustomerGUID=")) + RPGAPICustomerKey;
-
-	Request->SetURL(url);
-	Request->SetVerb("POST");
-	Request->SetHeader(TEXT("User-Agent"), "X-UnrealEngine-Agent");
-	Request->SetHeader("Content-Type", TEXT("application/x-www-form-urlencoded"));
-	Request->SetContentAsString(PostParameters);
-	Request->ProcessRequest();
-	*/
+	TMap<FString, FString> Headers;
+	Headers.Add(TEXT("X-CustomerGUID"), OWSAPICustomerKey);
+
+	ChatRelaySocket = FModuleManager::LoadModuleChecked<FWebSocketsModule>(TEXT("WebSockets")).CreateWebSocket(ChatRelayURL, TEXT("ows-chat"), Headers);
+	ChatRelaySocket->OnConnected().AddUObject(this, &AOWSChatManager::OnChatRelayConnected);
+	ChatRelaySocket->OnConnectionError().AddUObject(this, &AOWSChatManager::OnChatRelayConnectionError);
+	ChatRelaySocket->OnClosed().AddUObject(this, &AOWSChatManager::OnChatRelayClosed);
+	ChatRelaySocket->OnRawMessage().AddUObject(this, &AOWSChatManager::OnChatRelayRawMessage);
+	ChatRelaySocket->Connect();
 }
 
-void AOWSChatManager::OnSendGlobalChatResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void AOWSChatManager::OnChatRelayConnected()
 {
-	//UE_LOG(LogTemp, Warning, TEXT("Response %s"), *Response->GetContentAsString());
+	UE_LOG(OWS, Log, TEXT("AOWSChatManager - Connected to chat relay %s"), *ChatRelayURL);
+
+	//The relay forgets this server's group members when the connection drops, so tell it again
+	for (const TPair<FString, TSet<FString>>& ChatGroup : ChatGroupMembers)
+	{
+		for (const FString& CharacterName : ChatGroup.Value)
+		{
+			FChatGroupMembershipChange& MembershipChange = PendingOutbound.MembershipChanges.AddDefaulted_GetRef();
+			MembershipChange.CharacterName = CharacterName;
+			MembershipChange.ChatGroupName = ChatGroup.Key;
+			MembershipChange.Joined = true;
+		}
+	}
 }
 
-void AOWSChatManager::SendChatToChannel(FString SentFromCharacterName, FString Message, FString ChatChannelName)
+void AOWSChatManager::OnChatRelayConnectionError(const FString& Error)
 {
-	/*
-	FString PlayerName = SentFromCharacterName;
-	PlayerName = PlayerName.Replace(TEXT(" "), TEXT("%20"));
-
-	FString FullMessageToSend = SentFromCharacterName + FString(TEXT(": ")) + Message;
-
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-	Request->OnProcessRequestComplete().BindUObject(this, &AOWSChatManager::OnSendChatToChannelResponseReceived);
-	//This is the url on which to process the request
-	FString url = FString(TEXT("http://" +  + "/Chat/AddGroupChatMessage"));
-
-	FString PostParameters = FString(TEXT("id=")) + PlayerName
-		+ FString(TEXT("&Message=")) + FullMessageToSend		
-		+ FString(TEXT("&ChatGroupName=")) + ChatChannelName
-		+ FString(TEXT("&CustomerGUID=")) + RPGAPICustomerKey;
-
-	Request->SetURL(url);
-	Request->SetVerb("POST");
-	Request->SetHeader(TEXT("User-Agent"), "X-UnrealEngine-Agent");
-	Request->SetHeader("Content-Type", TEXT("application/x-www-form-urlencoded"));
-	Request->SetContentAsString(PostParameters);
-	Request->ProcessRequest();
-	*/
+	UE_LOG(OWS, Error, TEXT("AOWSChatManager - Error connecting to chat relay %s: %s"), *ChatRelayURL, *Error);
+	ScheduleReconnect();
 }
 
-void AOWSChatManager::OnSendChatToChannelResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void AOWSChatManager::OnChatRelayClosed(int32 StatusCode, const FString& Reason, bool bWasClean)
 {
-
+	UE_LOG(OWS, Warning, TEXT("AOWSChatManager - Chat relay connection closed (%d): %s"), StatusCode, *Reason);
+	ScheduleReconnect();
 }
 
-void AOWSChatManager::SendPrivateChatMessage(FString SentFromCharacterName, FString SendToCharacterName, FString Message)
+void AOWSChatManager::ScheduleReconnect()
 {
-	/*
-	FString PlayerName = SentFromCharacterName;
-	PlayerName = PlayerName.Replace(TEXT(" "), TEXT("%20"));
-
-	FString FullMessageToSend = SentFromCharacterName + FString(TEXT(": ")) + Message;
-
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-	Request->OnProcessRequestComplete().BindUObject(this, &AOWSChatManager::OnSendPrivateChatMessageResponseReceived);
-	//This is the url on which to process the request
-	FString url = FString(TEXT("http://" +  + "/Chat/AddPrivateChatMessage"));
-
-	FString PostParameters = FString(TEXT("id=")) + PlayerName
-		+ FString(TEXT("Message=")) + FullMessageToSend
-		+ FString(TEXT("&ToCharName=")) + SendToCharacterName
-		+ FString(TEXT("&CustomerGUID=")) + RPGAPICustomerKey;
-
-	Request->SetURL(url);
-	Request->SetVerb("POST");
-	Request->SetHeader(TEXT("User-Agent"), "X-UnrealEngine-Agent");
-	Request->SetHeader("Content-Type", TEXT("application/x-www-form-urlencoded"));
-	Request->SetContentAsString(PostParameters);
-	Request->ProcessRequest();
-	*/
+	ReceiveBuffer.Reset();
+
+	if (!GetWorldTimerManager().IsTimerActive(ReconnectTimerHandle))
+	{
+		GetWorldTimerManager().SetTimer(ReconnectTimerHandle, this, &AOWSChatManager::ConnectToChatRelay, ChatReconnectDelay, false);
+	}
 }
 
-void AOWSChatManager::OnSendPrivateChatMessageResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void AOWSChatManager::OnChatRelayRawMessage(const void* Data, SIZE_T Size, SIZE_T BytesRemaining)
 {
+	ReceiveBuffer.Append(static_cast<const uint8*>(Data), Size);
+
+	//Large frames can arrive in pieces
+	if (BytesRemaining > 0)
+	{
+		return;
+	}
 
+	FChatRelayFrame IncomingFrame;
+	if (FOWSJsonStructReader::ReadStruct(ReceiveBuffer, IncomingFrame))
+	{
+		PendingIncoming.Append(MoveTemp(IncomingFrame.Messages));
+	}
+	else
+	{
+		UE_LOG(OWS, Error, TEXT("AOWSChatManager - Error Deserializing chat relay frame!"));
+	}
+
+	ReceiveBuffer.Reset();
 }
 
+void AOWSChatManager::SendGlobalChat(FString SentFromCharacterName, FString Message)
+{
+	SendChatMessage(SentFromCharacterName, Message, FString(), FString());
+}
 
-void AOWSChatManager::GetNewChatMessages(int32 LastChatMessageReceived)
+void AOWSChatManager::SendChatToChannel(FString SentFromCharacterName, FString Message, FString ChatChannelName)
+{
+	SendChatMessage(SentFromCharacterName, Message, FString(), ChatChannelName);
+}
+
+void AOWSChatManager::SendPrivateChatMessage(FString SentFromCharacterName, FString SendToCharacterName, FString Message)
 {
-	/*
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-	Request->OnProcessRequestComplete().BindUObject(this, &AOWSChatManager::OnGetNewChatMessagesResponseReceived);
-	//This is the url on which to process the request
-	FString url = FString(TEXT("http://" +  + "/Chat/GetNewChatMessages/"));
-
-	FString PostParameters = FString(TEXT("LastMessageReceived=")) + FString::FromInt(LastChatMessageReceived)
-		+ FString(TEXT("&CustomerGUID=")) + RPGAPICustomerKey;
-
-	Request->SetURL(url);
-	Request->SetVerb("POST");
-	Request->SetHeader(TEXT("User-Agent"), "X-UnrealEngine-Agent");
-	Request->SetHeader("Content-Type", TEXT("application/x-www-form-urlencoded"));
-	Request->SetContentAsString(PostParameters);
-	//UE_LOG(LogTemp, Error, TEXT("Sending: %s"), *PostParameters);
-	Request->ProcessRequest();
-	*/
+	SendChatMessage(SentFromCharacterName, Message, SendToCharacterName, FString());
 }
 
-void AOWSChatManager::OnGetNewChatMessagesResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void AOWSChatManager::SendChatMessage(const FString& SentFromCharacterName, const FString& Message, const FString& SendToCharacterName, const FString& ChatGroupName)
 {
-	/*
-	//UE_LOG(LogTemp, Error, TEXT("OnGetNewChatMessagesResponseReceived"));
-	if (bWasSuccessful)
+	//Server code (NPCs, system messages, the listen server host) sends under whatever name it passes in
+	if (HasAuthority())
 	{
-		TSharedPtr<FJsonObject> JsonObject;
-		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+		FChatMessage ChatMessage;
+		ChatMessage.ChatMessage = Message;
+		ChatMessage.SentByCharName = SentFromCharacterName;
+		ChatMessage.SentToCharName = SendToCharacterName;
+		ChatMessage.ChatGroupName = ChatGroupName;
+
+		QueueOutgoingChatMessage(ChatMessage);
+		return;
+	}
 
-		if (FJsonSerializer::Deserialize(Reader, JsonObject))
+	//On a client the server takes the sender name from the PlayerState of the controller the RPC arrives on
+	AOWSPlayerController* LocalPlayerController = nullptr;
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		AOWSPlayerController* PlayerController = Cast<AOWSPlayerController>(Iterator->Get());
+		if (!PlayerController || !PlayerController->IsLocalController())
 		{
-			if (JsonObject->GetStringField("success") == "true")
-			{
-				TArray<TSharedPtr<FJsonValue>> Rows = JsonObject->GetArrayField("rows");
-
-				TArray<FChatMessage> ChatMessages;
-
-				int32 MaxMessageID = 0;
-
-				MaxMessageID = JsonObject->GetIntegerField("maxchatmessageid");
-			
-				for (int RowNum = 0; RowNum != Rows.Num(); RowNum++) {
-					FChatMessage tempChatMessage;
-					TSharedPtr<FJsonObject> tempRow = Rows[RowNum]->AsObject();
-					tempChatMessage.ChatMessage = tempRow->GetStringField("ChatMessage");
-					tempChatMessage.ChatMessageID = tempRow->GetIntegerField("ChatMessageID");
-					tempChatMessage.SentByCharID = tempRow->GetIntegerField("SentByCharID");
-					tempChatMessage.SentByCharName = tempRow->GetStringField("SentByCharName");
-					tempChatMessage.SentToCharID = tempRow->GetIntegerField("SentToCharID");
-					tempChatMessage.SentToCharName = tempRow->GetStringField("SentToCharName");
-					tempChatMessage.ChatGroupID = tempRow->GetIntegerField("ChatGroupID");
-					tempChatMessage.ChatGroupName = tempRow->GetStringField("ChatGroupName");
-
-					ChatMessages.Add(tempChatMessage);
-				}
-
-				NotifyGetNewChatMessages(ChatMessages, MaxMessageID);
-			}
+			continue;
 		}
-		else
+
+		//Prefer the split screen player whose character is sending
+		if (!LocalPlayerController || (PlayerController->PlayerState && PlayerController->PlayerState->GetPlayerName() == SentFromCharacterName))
 		{
-			UE_LOG(OWS, Error, TEXT("OnLoginResponseReceived Server returned no data!"));
+			LocalPlayerController = PlayerController;
 		}
 	}
-	else
+
+	if (!LocalPlayerController)
+	{
+		UE_LOG(OWS, Error, TEXT("AOWSChatManager - SendChatMessage requires a local AOWSPlayerController!"));
+		return;
+	}
+
+	//The server disconnects anyone who sends more than this, so don't let a long paste do it
+	if (SendToCharacterName.Len() > AOWSPlayerController::MaxChatNameLength || ChatGroupName.Len() > AOWSPlayerController::MaxChatNameLength)
 	{
-		UE_LOG(OWS, Error, TEXT("OnLoginResponseReceived Error accessing login server!"));
+		UE_LOG(OWS, Error, TEXT("AOWSChatManager - SendChatMessage recipient or chat group name is longer than %d characters!"), AOWSPlayerController::MaxChatNameLength);
+		return;
 	}
-	*/
+
+	LocalPlayerController->Server_SendChatMessage(Message.Left(AOWSPlayerController::MaxChatMessageLength), SendToCharacterName, ChatGroupName);
 }
 
+void AOWSChatManager::QueueOutgoingChatMessage(const FChatMessage& ChatMessage)
+{
+	if (ChatRelayURL.IsEmpty())
+	{
+		//The relay numbers messages when it has one.  Without it, number them here so GetNewChatMessages can replay them.
+		FChatMessage& LocalMessage = PendingIncoming.Add_GetRef(ChatMessage);
+		LocalMessage.ChatMessageID = ++LastLocalChatMessageID;
+	}
+	else
+	{
+		PendingOutbound.Messages.Add(ChatMessage);
+	}
+}
 
 void AOWSChatManager::AddOrJoinChatGroup(FString CharacterNameToAdd, FString ChatGroupName)
 {
-	/*
-	FString PlayerName = CharacterNameToAdd;
-	PlayerName = PlayerName.Replace(TEXT(" "), TEXT("%20"));
-
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-	Request->OnProcessRequestComplete().BindUObject(this, &AOWSChatManager::OnAddOrJoinChatGroupResponseReceived);
-	//This is the url on which to process the request
-	FString url = FString(TEXT("http://" +  + "/Chat/AddOrJoinChatGroup"));
-
-	FString PostParameters = FString(TEXT("id=")) + PlayerName
-		+ FString(TEXT("&ChatGroupName=")) + ChatGroupName
-		+ FString(TEXT("&CustomerGUID=")) + RPGAPICustomerKey;
-
-	Request->SetURL(url);
-	Request->SetVerb("POST");
-	Request->SetHeader(TEXT("User-Agent"), "X-UnrealEngine-Agent");
-	Request->SetHeader("Content-Type", TEXT("application/x-www-form-urlencoded"));
-	Request->SetContentAsString(PostParameters);
-	Request->ProcessRequest();
-	*/
+	if (!HasAuthority())
+	{
+		UE_LOG(OWS, Warning, TEXT("AOWSChatManager - AddOrJoinChatGroup can only be called on the server!"));
+		return;
+	}
+
+	ChatGroupMembers.FindOrAdd(ChatGroupName).Add(CharacterNameToAdd);
+
+	FChatGroupMembershipChange& MembershipChange = PendingOutbound.MembershipChanges.AddDefaulted_GetRef();
+	MembershipChange.CharacterName = CharacterNameToAdd;
+	MembershipChange.ChatGroupName = ChatGroupName;
+	MembershipChange.Joined = true;
 }
 
-void AOWSChatManager::OnAddOrJoinChatGroupResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void AOWSChatManager::LeaveChatGroup(FString CharacterNameToRemove, FString ChatGroupName)
 {
-	/*
-	if (bWasSuccessful)
+	if (!HasAuthority())
 	{
-
+		UE_LOG(OWS, Warning, TEXT("AOWSChatManager - LeaveChatGroup can only be called on the server!"));
+		return;
 	}
-	else
+
+	if (TSet<FString>* Members = ChatGroupMembers.Find(ChatGroupName))
 	{
-		UE_LOG(OWS, Error, TEXT("OnAddOrJoinChatGroupResponseReceived Error accessing login server!"));
+		Members->Remove(CharacterNameToRemove);
+		if (Members->Num() == 0)
+		{
+			ChatGroupMembers.Remove(ChatGroupName);
+		}
 	}
-	*/
+
+	FChatGroupMembershipChange& MembershipChange = PendingOutbound.MembershipChanges.AddDefaulted_GetRef();
+	MembershipChange.CharacterName = CharacterNameToRemove;
+	MembershipChange.ChatGroupName = ChatGroupName;
+	MembershipChange.Joined = false;
 }
 
+void AOWSChatManager::FlushChat()
+{
+	//Outbound messages wait in the queue while the relay is reconnecting
+	const bool bHasOutbound = PendingOutbound.Messages.Num() > 0 || PendingOutbound.MembershipChanges.Num() > 0;
+	if (bHasOutbound && ChatRelaySocket.IsValid() && ChatRelaySocket->IsConnected())
+	{
+		FString FrameJson;
+		if (FJsonObjectConverter::UStructToJsonObjectString(PendingOutbound, FrameJson))
+		{
+			ChatRelaySocket->Send(FrameJson);
+		}
 
-void AOWSChatManager::LeaveChatGroup(FString CharacterNameToRemove, FString ChatGroupName)
+		PendingOutbound.Messages.Reset();
+		PendingOutbound.MembershipChanges.Reset();
+	}
+
+	if (PendingIncoming.Num() > 0)
+	{
+		FanOutIncomingMessages();
+	}
+}
+
+void AOWSChatManager::FanOutIncomingMessages()
 {
-	/*
-	FString PlayerName = CharacterNameToRemove;
-	PlayerName = PlayerName.Replace(TEXT(" "), TEXT("%20"));
-
-	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-	Request->OnProcessRequestComplete().BindUObject(this, &AOWSChatManager::OnLeaveChatGroupResponseReceived);
-	//This is the url on which to process the request
-	FString url = FString(TEXT("http://" +  + "/Chat/LeaveChatGroup"));
-
-	FString PostParameters = FString(TEXT("id=")) + PlayerName
-		+ FString(TEXT("&ChatGroupName=")) + ChatGroupName
-		+ FString(TEXT("&CustomerGUID=")) + RPGAPICustomerKey;
-
-	Request->SetURL(url);
-	Request->SetVerb("POST");
-	Request->SetHeader(TEXT("User-Agent"), "X-UnrealEngine-Agent");
-	Request->SetHeader("Content-Type", TEXT("application/x-www-form-urlencoded"));
-	Request->SetContentAsString(PostParameters);
-	Request->ProcessRequest();
-	*/
+	TArray<FChatMessage> GlobalMessages;
+	TMap<AOWSPlayerController*, TArray<FChatMessage>> MessagesByPlayer;
+	TMap<FString, AOWSPlayerController*> PlayersByCharacterName;
+
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		AOWSPlayerController* PlayerController = Cast<AOWSPlayerController>(Iterator->Get());
+		if (PlayerController && PlayerController->PlayerState)
+		{
+			PlayersByCharacterName.Add(PlayerController->PlayerState->GetPlayerName(), PlayerController);
+		}
+	}
+
+	for (const FChatMessage& ChatMessage : PendingIncoming)
+	{
+		if (!ChatMessage.SentToCharName.IsEmpty())
+		{
+			//Private messages also go back to the sender so their own chat window shows what they sent
+			for (const FString* CharacterName : { &ChatMessage.SentToCharName, &ChatMessage.SentByCharName })
+			{
+				if (AOWSPlayerController** PlayerController = PlayersByCharacterName.Find(*CharacterName))
+				{
+					MessagesByPlayer.FindOrAdd(*PlayerController).Add(ChatMessage);
+				}
+			}
+		}
+		else if (!ChatMessage.ChatGroupName.IsEmpty())
+		{
+			if (const TSet<FString>* Members = ChatGroupMembers.Find(ChatMessage.ChatGroupName))
+			{
+				for (const FString& CharacterName : *Members)
+				{
+					if (AOWSPlayerController** PlayerController = PlayersByCharacterName.Find(CharacterName))
+					{
+						MessagesByPlayer.FindOrAdd(*PlayerController).Add(ChatMessage);
+					}
+				}
+			}
+		}
+		else
+		{
+			GlobalMessages.Add(ChatMessage);
+		}
+	}
+
+	PendingIncoming.Reset();
+
+	if (GlobalMessages.Num() > 0)
+	{
+		Multicast_ReceiveGlobalChatMessages(GlobalMessages);
+	}
+
+	for (const TPair<AOWSPlayerController*, TArray<FChatMessage>>& PlayerMessages : MessagesByPlayer)
+	{
+		PlayerMessages.Key->Client_ReceiveChatMessages(PlayerMessages.Value);
+	}
 }
 
-void AOWSChatManager::OnLeaveChatGroupResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void AOWSChatManager::Multicast_ReceiveGlobalChatMessages_Implementation(const TArray<FChatMessage>& ChatMessages)
 {
-	/*
-	if (bWasSuccessful)
+	if (GetNetMode() == NM_DedicatedServer)
 	{
+		return;
+	}
+
+	ReceiveChatMessages(ChatMessages);
+}
 
+void AOWSChatManager::ReceiveChatMessages(const TArray<FChatMessage>& ChatMessages)
+{
+	for (const FChatMessage& ChatMessage : ChatMessages)
+	{
+		MaxMessageID = FMath::Max(MaxMessageID, ChatMessage.ChatMessageID);
 	}
-	else
+
+	RecentMessages.Append(ChatMessages);
+	if (RecentMessages.Num() > ChatHistorySize)
 	{
-		UE_LOG(OWS, Error, TEXT("OnLeaveChatGroupResponseReceived Error accessing login server!"));
+		RecentMessages.RemoveAt(0, RecentMessages.Num() - ChatHistorySize);
 	}
-	*/
+
+	NotifyGetNewChatMessages(ChatMessages, MaxMessageID);
 }
 
+void AOWSChatManager::GetNewChatMessages(int32 LastChatMessageReceived)
+{
+	TArray<FChatMessage> NewChatMessages;
 
+	for (const FChatMessage& ChatMessage : RecentMessages)
+	{
+		if (ChatMessage.ChatMessageID > LastChatMessageReceived)
+		{
+			NewChatMessages.Add(ChatMessage);
+		}
+	}
 
+	NotifyGetNewChatMessages(NewChatMessages, MaxMessageID);
+}
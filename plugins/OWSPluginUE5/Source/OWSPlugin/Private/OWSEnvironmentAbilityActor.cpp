@@ -2,6 +2,7 @@
 
 
 #include "OWSEnvironmentAbilityActor.h"
+#include "OWSTargetingSubsystem.h"
 
 // Sets default values
 AOWSEnvironmentAbilityActor::AOWSEnvironmentAbilityActor()
@@ -89,7 +90,20 @@ void AOWSEnvironmentAbilityActor::ActivatePeriodicAbility()
 	}
 
 	TArray<AActor*> OverlappingActors;
-	SphereCollision->GetOverlappingActors(OverlappingActors, ActorClassFilter);
+
+	//Only characters can have an ability activated, so the pawn grid has everything this can affect
+	UOWSTargetingSubsystem* TargetingSubsystem = GetWorld()->GetSubsystem<UOWSTargetingSubsystem>();
+	if (TargetingSubsystem && TargetingSubsystem->IsTrackingPawns())
+	{
+		TArray<APawn*> OverlappingPawns;
+		TargetingSubsystem->RunQuery(FOWSTargetingQuery::MakeSphere(GetActorLocation(), SphereCollision->GetScaledSphereRadius()),
+			[this](APawn* Pawn) { return !ActorClassFilter || Pawn->IsA(ActorClassFilter); }, OverlappingPawns);
+		OverlappingActors.Append(OverlappingPawns);
+	}
+	else
+	{
+		SphereCollision->GetOverlappingActors(OverlappingActors, ActorClassFilter);
+	}
 
 	for (auto ActorThatMightHaveASC : OverlappingActors)
 	{
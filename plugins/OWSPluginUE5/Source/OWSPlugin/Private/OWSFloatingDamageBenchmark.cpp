@@ -0,0 +1,104 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "OWSPlugin.h"
+#include "OWSBenchmarkFrameTimes.h"
+#include "OWSHUD.h"
+#include "EngineUtils.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+namespace OWSFloatingDamageBenchmark
+{
+	struct FStressPass
+	{
+		TWeakObjectPtr<AOWSHUD> HUD;
+		TArray<TWeakObjectPtr<APawn>> Targets;
+		FRandomStream Random;
+		float HitsPerSecond = 0.f;
+		float Seconds = 0.f;
+		float Elapsed = 0.f;
+		float HitBudget = 0.f;
+		int32 HitsAdded = 0;
+		FOWSBenchmarkFrameTimes FrameTimes;
+	};
+
+	//Feeds the local HUD HitsPerSecond floating damage items on random pawns for Seconds, then logs the frame times.  Run it with 0 hits first for a baseline.
+	static void StressTest(const TArray<FString>& Args, UWorld* World)
+	{
+		APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		AOWSHUD* HUD = PlayerController ? Cast<AOWSHUD>(PlayerController->GetHUD()) : nullptr;
+		if (!HUD)
+		{
+			UE_LOG(OWS, Display, TEXT("OWS.HUD.FloatingDamageStress needs a local player with an AOWSHUD"));
+			return;
+		}
+
+		TSharedRef<FStressPass> Pass = MakeShared<FStressPass>();
+		Pass->HUD = HUD;
+		Pass->HitsPerSecond = Args.Num() > 0 ? FMath::Max(FCString::Atof(*Args[0]), 0.f) : 500.f;
+		Pass->Seconds = Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 1.f) : 10.f;
+		Pass->Random.Initialize(1234);
+
+		for (TActorIterator<APawn> PawnIt(World); PawnIt; ++PawnIt)
+		{
+			Pass->Targets.Add(*PawnIt);
+		}
+
+		if (Pass->Targets.Num() == 0)
+		{
+			UE_LOG(OWS, Display, TEXT("OWS.HUD.FloatingDamageStress needs at least one pawn to put damage on"));
+			return;
+		}
+
+		Pass->FrameTimes.Reserve(Pass->Seconds);
+
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Pass](float DeltaTime)
+		{
+			AOWSHUD* HUD = Pass->HUD.Get();
+			if (!HUD)
+			{
+				return false;
+			}
+
+			Pass->Elapsed += DeltaTime;
+			Pass->FrameTimes.Add(DeltaTime);
+
+			Pass->HitBudget += Pass->HitsPerSecond * DeltaTime;
+			while (Pass->HitBudget >= 1.f)
+			{
+				Pass->HitBudget -= 1.f;
+
+				APawn* Target = Pass->Targets[Pass->Random.RandHelper(Pass->Targets.Num())].Get();
+				if (Target)
+				{
+					const bool IsHealing = Pass->Random.FRand() < 0.2f;
+					const bool IsCritical = Pass->Random.FRand() < 0.1f;
+					HUD->AddFloatingDamageItem(FString::FromInt(Pass->Random.RandRange(1, 999)), Target, FVector(0.f, 0.f, 100.f), IsHealing, IsCritical, true, true);
+					Pass->HitsAdded++;
+				}
+			}
+
+			if (Pass->Elapsed < Pass->Seconds)
+			{
+				return true;
+			}
+
+			UE_LOG(OWS, Display, TEXT("OWS.HUD.FloatingDamageStress - %.0f hits/s on %d pawns for %.1f s, %d hits added, pool of %d, aggregation window %.2f s"),
+				Pass->HitsPerSecond, Pass->Targets.Num(), Pass->Elapsed, Pass->HitsAdded, HUD->MaxFloatingDamageItems, HUD->FloatingDamageAggregationWindow);
+			Pass->FrameTimes.LogAndReset();
+			return false;
+		}));
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs StressTestCommand(
+		TEXT("OWS.HUD.FloatingDamageStress"),
+		TEXT("Adds floating damage on random pawns through the local AOWSHUD and logs the frame times. Run with 0 hits for a baseline. Args: [HitsPerSecond=500] [Seconds=10]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&StressTest));
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include "Runtime/Engine/Classes/Components/StaticMeshComponent.h"
 #include "Runtime/Engine/Classes/Components/SkeletalMeshComponent.h"
 #include "OWSPlayerController.h"
+#include "OWSAssetCacheSubsystem.h"
 
 void UOWSGameInstance::Init()
 {
@@ -53,7 +54,7 @@ void UOWSGameInstance::HideLoadingScreen()
 
 TSubclassOf<class AActor> UOWSGameInstance::LoadWeaponActorClassFromPath(FString WeaponActorClassPath)
 {
-	auto cls = StaticLoadObject(UObject::StaticClass(), nullptr, *WeaponActorClassPath);
+	auto cls = GetSubsystem<UOWSAssetCacheSubsystem>()->LoadAssetSynchronous(FSoftObjectPath(WeaponActorClassPath));
 
 	if (cls)
 	{
@@ -62,6 +63,12 @@ TSubclassOf<class AActor> UOWSGameInstance::LoadWeaponActorClassFromPath(FString
 		{
 			return (UClass*)bp->GeneratedClass;
 		}
+
+		//Cooked builds have the generated class, not the Blueprint
+		if (UClass* GeneratedClass = Cast<UClass>(cls))
+		{
+			return GeneratedClass;
+		}
 	}
 
 	return NULL;
@@ -70,7 +77,7 @@ TSubclassOf<class AActor> UOWSGameInstance::LoadWeaponActorClassFromPath(FString
 UStaticMesh* UOWSGameInstance::LoadStaticMeshFromPath(FString StaticMeshPath)
 {
 	UStaticMesh* tempStaticMesh;
-	tempStaticMesh = LoadObject<UStaticMesh>(NULL, *StaticMeshPath, NULL, LOAD_None, NULL);
+	tempStaticMesh = GetSubsystem<UOWSAssetCacheSubsystem>()->LoadAssetSynchronous<UStaticMesh>(StaticMeshPath);
 
 	if (!tempStaticMesh)
 	{
@@ -84,7 +91,7 @@ UStaticMesh* UOWSGameInstance::LoadStaticMeshFromPath(FString StaticMeshPath)
 USkeletalMesh* UOWSGameInstance::LoadSkeletalMeshFromPath(FString SkeletalMeshPath)
 {
 	USkeletalMesh* tempSkeletalMesh;
-	tempSkeletalMesh = LoadObject<USkeletalMesh>(NULL, *SkeletalMeshPath, NULL, LOAD_None, NULL);
+	tempSkeletalMesh = GetSubsystem<UOWSAssetCacheSubsystem>()->LoadAssetSynchronous<USkeletalMesh>(SkeletalMeshPath);
 
 	if (!tempSkeletalMesh)
 	{
@@ -98,7 +105,7 @@ USkeletalMesh* UOWSGameInstance::LoadSkeletalMeshFromPath(FString SkeletalMeshPa
 USkeleton* UOWSGameInstance::LoadSkeletonFromPath(FString SkeletonPath)
 {
 	USkeleton* tempSkeleton;
-	tempSkeleton = LoadObject<USkeleton>(NULL, *SkeletonPath, NULL, LOAD_None, NULL);
+	tempSkeleton = GetSubsystem<UOWSAssetCacheSubsystem>()->LoadAssetSynchronous<USkeleton>(SkeletonPath);
 
 	if (!tempSkeleton)
 	{
@@ -112,7 +119,7 @@ USkeleton* UOWSGameInstance::LoadSkeletonFromPath(FString SkeletonPath)
 UMaterialInstance* UOWSGameInstance::LoadMaterialInstanceFromPath(FString MaterialInstancePath)
 {
 	UMaterialInstance* tempMaterial;
-	tempMaterial = LoadObject<UMaterialInstance>(NULL, *MaterialInstancePath, NULL, LOAD_None, NULL);
+	tempMaterial = GetSubsystem<UOWSAssetCacheSubsystem>()->LoadAssetSynchronous<UMaterialInstance>(MaterialInstancePath);
 
 	if (!tempMaterial)
 	{
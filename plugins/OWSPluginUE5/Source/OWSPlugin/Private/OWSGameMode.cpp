@@ -6,8 +6,13 @@
 #include "OWSPlayerState.h"
 #include "OWSPlayerController.h"
 #include "OWSAPISubsystem.h"
+#include "OWSSaveSchedulerSubsystem.h"
+#include "OWSItemMeshRegistry.h"
+#include "OWSJsonStructReader.h"
+#include "OWSReplicationGraph.h"
 #include "Runtime/Engine/Classes/Kismet/GameplayStatics.h"
 #include "Runtime/Core/Public/Misc/ConfigCacheIni.h"
+#include "Misc/Base64.h"
 
 AOWSGameMode::AOWSGameMode()
 {
@@ -89,10 +94,16 @@ void AOWSGameMode::AddOrUpdateGlobalDataItemError(const FString& ErrorMsg)
 }
 
 void AOWSGameMode::ProcessOWS2POSTRequest(FString ApiModuleToCall, FString ApiToCall, FString PostParameters, void (AOWSGameMode::* InMethodPtr)(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful))
+{
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateOWS2POSTRequest(ApiModuleToCall, ApiToCall, PostParameters);
+	Request->OnProcessRequestComplete().BindUObject(this, InMethodPtr);
+	Request->ProcessRequest();
+}
+
+TSharedRef<IHttpRequest, ESPMode::ThreadSafe> AOWSGameMode::CreateOWS2POSTRequest(FString ApiModuleToCall, FString ApiToCall, FString PostParameters)
 {
 	Http = &FHttpModule::Get();
 	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = Http->CreateRequest();
-	Request->OnProcessRequestComplete().BindUObject(this, InMethodPtr);
 
 	FString OWS2APIPathToUse = "";
 
@@ -119,7 +130,7 @@ void AOWSGameMode::ProcessOWS2POSTRequest(FString ApiModuleToCall, FString ApiTo
 	Request->SetHeader("Content-Type", TEXT("application/json"));
 	Request->SetHeader(TEXT("X-CustomerGUID"), OWSAPICustomerKey);
 	Request->SetContentAsString(PostParameters);
-	Request->ProcessRequest();
+	return Request;
 }
 
 void AOWSGameMode::GetJsonObjectFromResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FString CallingMethodName, FString& ErrorMsg, TSharedPtr<FJsonObject>& JsonObject)
@@ -155,6 +166,10 @@ void AOWSGameMode::StartPlay()
 		//Get a list of all item definitions
 		//GetAllInventoryItems();
 
+		FActorSpawnParameters RegistrySpawnInfo;
+		RegistrySpawnInfo.Owner = this;
+		ItemMeshRegistry = GetWorld()->SpawnActor<AOWSItemMeshRegistry>(RegistrySpawnInfo);
+
 		//Get the ZoneInstanceID
 		FString CommandLineZoneInstanceID;
 		FParse::Value(FCommandLine::Get(), TEXT("zoneinstanceid="), CommandLineZoneInstanceID);
@@ -178,13 +193,52 @@ void AOWSGameMode::StartPlay()
 			GetWorld()->GetTimerManager().SetTimer(UpdateServerStatusEveryXSecondsTimerHandle, this, &AOWSGameMode::UpdateNumberOfPlayers, UpdateServerStatusEveryXSeconds, true);
 		}
 
-		if (SaveIntervalInSeconds > 0.f)
+		//With the save scheduler on, UOWSSaveSchedulerSubsystem saves players as they move instead of this timer
+		if (SaveIntervalInSeconds > 0.f && !IsUsingSaveScheduler())
 		{
 			GetWorld()->GetTimerManager().SetTimer(SaveAllPlayerLocationsTimerHandle, this, &AOWSGameMode::SaveAllPlayerLocations, SaveIntervalInSeconds, true);
 		}
 	}
 }
 
+void AOWSGameMode::PostLogin(APlayerController* NewPlayer)
+{
+	Super::PostLogin(NewPlayer);
+
+	if (UOWSSaveSchedulerSubsystem* SaveScheduler = GetWorld()->GetSubsystem<UOWSSaveSchedulerSubsystem>())
+	{
+		SaveScheduler->RegisterPlayer(NewPlayer);
+	}
+}
+
+void AOWSGameMode::Logout(AController* Exiting)
+{
+	APlayerController* ExitingPlayerController = Cast<APlayerController>(Exiting);
+
+	if (UOWSSaveSchedulerSubsystem* SaveScheduler = GetWorld()->GetSubsystem<UOWSSaveSchedulerSubsystem>())
+	{
+		//Flushes their last location
+		SaveScheduler->UnregisterPlayer(ExitingPlayerController);
+	}
+
+	if (Exiting && Exiting->PlayerState)
+	{
+		const FString PlayerName = Exiting->PlayerState->GetPlayerName();
+
+		//Whoever picks this player up next starts from a keyframe.  If a save is still in flight, forget them once it's answered.
+		if (PlayersWithPositionSaveInFlight.Contains(PlayerName))
+		{
+			PlayersPendingLogout.Add(PlayerName);
+		}
+		else
+		{
+			AcknowledgedPlayerPositions.Remove(PlayerName);
+		}
+	}
+
+	Super::Logout(Exiting);
+}
+
 FString AOWSGameMode::InitNewPlayer(APlayerController* NewPlayerController, const FUniqueNetIdRepl& UniqueId, const FString& Options, const FString& Portal)
 {
 	FString retString = Super::InitNewPlayer(NewPlayerController, UniqueId, Options, Portal);
@@ -416,7 +470,7 @@ void AOWSGameMode::OnGetAllInventoryItemsResponseReceived(FHttpRequestPtr Reques
 					if (tempInventoryItem.IconSlotHeight < 1)
 						tempInventoryItem.IconSlotHeight = 1;
 
-					AllInventoryItems.Add(tempInventoryItem);
+					ItemCatalog.Add(AllInventoryItems, tempInventoryItem);
 					NotifyGetAllInventoryItems();
 					BroadcastItemLibraryLoaded();
 				}
@@ -453,6 +507,12 @@ void AOWSGameMode::SaveAllPlayerLocations()
 {
 	UE_LOG(OWS, Verbose, TEXT("SaveAllPlayerLocations Started"));
 
+	if (bSavePlayerLocationsAsDeltas)
+	{
+		SaveAllPlayerLocationsAsDeltas();
+		return;
+	}
+
 	FString DataToSave;
 	int PlayerIndex = 0;
 
@@ -534,6 +594,323 @@ void AOWSGameMode::OnSaveAllPlayerLocationsResponseReceived(FHttpRequestPtr Requ
 	}
 }
 
+/*
+Binary Player Location Snapshot
+
+Only players that moved past SavePlayerLocationMinDistance / SavePlayerLocationMinRotationDegrees since their last acknowledged
+save are written.  A player with no acknowledged save is written as a keyframe (absolute values), everyone else as a delta against
+their acknowledged save.  All integers are LEB128 varints, signed values are zigzag encoded:
+
+uint8 Version, varint RecordCount, then per record:
+varint NameLength, UTF-8 Name, uint8 Flags (bit 0 = keyframe), [uint32 little endian BaselineHash, deltas only], zigzag X, Y, Z, zigzag Roll, Pitch, Yaw
+
+BaselineHash is HashPosition of the acknowledged save the delta was made from.  The API only applies a delta on top of a baseline
+with the same hash, and otherwise reports the player in PlayersNeedingKeyframe.
+
+The snapshot is base64 encoded into FUpdateAllPlayerPositionsDeltaJSONPost and decoded by PlayerPositionDeltaDecoder in OWSShared.
+*/
+namespace OWSPlayerLocationSnapshot
+{
+	static constexpr uint8 Version = 2;
+	static constexpr uint8 KeyframeFlag = 1;
+	static constexpr double LocationScale = 10.0;
+
+	static void WriteVarUInt(TArray<uint8>& Output, uint64 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Output.Add(static_cast<uint8>(Value | 0x80));
+			Value >>= 7;
+		}
+		Output.Add(static_cast<uint8>(Value));
+	}
+
+	static void WriteVarInt(TArray<uint8>& Output, int64 Value)
+	{
+		WriteVarUInt(Output, (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63));
+	}
+
+	//32 bit FNV-1a of X, Y, Z as little endian int64 followed by RX, RY, RZ as little endian uint16.  Matches PlayerPositionBaseline.GetHash.
+	static uint32 HashPosition(const FOWSSavedPlayerPosition& Position)
+	{
+		uint32 Hash = 2166136261u;
+
+		auto HashBytes = [&Hash](uint64 Value, int32 ByteCount)
+		{
+			for (int32 ByteIndex = 0; ByteIndex < ByteCount; ByteIndex++)
+			{
+				Hash = (Hash ^ static_cast<uint8>(Value >> (ByteIndex * 8))) * 16777619u;
+			}
+		};
+
+		HashBytes(static_cast<uint64>(Position.X), 8);
+		HashBytes(static_cast<uint64>(Position.Y), 8);
+		HashBytes(static_cast<uint64>(Position.Z), 8);
+		HashBytes(Position.RX, 2);
+		HashBytes(Position.RY, 2);
+		HashBytes(Position.RZ, 2);
+
+		return Hash;
+	}
+
+	//Shortest signed distance between two compressed rotation axis values
+	static int32 AxisDelta(uint16 From, uint16 To)
+	{
+		return static_cast<int16>(static_cast<uint16>(To - From));
+	}
+}
+
+void AOWSGameMode::SaveAllPlayerLocationsAsDeltas()
+{
+	int PlayerIndex = 0;
+
+	if (NextSaveGroupIndex < SplitSaveIntoHowManyGroups)
+	{
+		NextSaveGroupIndex++;
+	}
+	else
+	{
+		NextSaveGroupIndex = 0;
+	}
+
+	TArray<uint8> Records;
+	TMap<FString, FOWSSavedPlayerPosition> SentPlayerPositions;
+
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		if (NextSaveGroupIndex == PlayerIndex % SplitSaveIntoHowManyGroups)
+		{
+			AppendPlayerLocationRecord(Iterator->Get(), Records, SentPlayerPositions, false);
+		}
+
+		PlayerIndex++;
+	}
+
+	if (SentPlayerPositions.Num() < 1)
+	{
+		UE_LOG(OWS, Verbose, TEXT("SaveAllPlayerLocations - No players moved in batch #: %i"), NextSaveGroupIndex);
+		return;
+	}
+
+	SendPlayerLocationRecords(Records, MoveTemp(SentPlayerPositions));
+}
+
+bool AOWSGameMode::GetPlayerPositionToSave(APlayerController* PlayerController, FString& PlayerName, FOWSSavedPlayerPosition& Position) const
+{
+	using namespace OWSPlayerLocationSnapshot;
+
+	APawn* MyPawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+
+	if (!MyPawn || !PlayerController->PlayerState)
+	{
+		return false;
+	}
+
+	const FVector PawnLocation = MyPawn->GetActorLocation();
+	const FRotator PawnRotation = MyPawn->GetActorRotation();
+
+	PlayerName = PlayerController->PlayerState->GetPlayerName();
+	Position.X = FMath::RoundToInt64(PawnLocation.X * LocationScale);
+	Position.Y = FMath::RoundToInt64(PawnLocation.Y * LocationScale);
+	Position.Z = FMath::RoundToInt64(PawnLocation.Z * LocationScale);
+	Position.RX = FRotator::CompressAxisToShort(PawnRotation.Roll);
+	Position.RY = FRotator::CompressAxisToShort(PawnRotation.Pitch);
+	Position.RZ = FRotator::CompressAxisToShort(PawnRotation.Yaw);
+	return true;
+}
+
+void AOWSGameMode::WritePlayerLocationRecord(TArray<uint8>& Records, const FString& PlayerName, const FOWSSavedPlayerPosition& Position, const FOWSSavedPlayerPosition* Acknowledged) const
+{
+	using namespace OWSPlayerLocationSnapshot;
+
+	FTCHARToUTF8 PlayerNameUTF8(*PlayerName);
+	WriteVarUInt(Records, PlayerNameUTF8.Length());
+	Records.Append(reinterpret_cast<const uint8*>(PlayerNameUTF8.Get()), PlayerNameUTF8.Length());
+
+	if (Acknowledged)
+	{
+		const uint32 BaselineHash = HashPosition(*Acknowledged);
+		Records.Add(0);
+		Records.Add(static_cast<uint8>(BaselineHash));
+		Records.Add(static_cast<uint8>(BaselineHash >> 8));
+		Records.Add(static_cast<uint8>(BaselineHash >> 16));
+		Records.Add(static_cast<uint8>(BaselineHash >> 24));
+		WriteVarInt(Records, Position.X - Acknowledged->X);
+		WriteVarInt(Records, Position.Y - Acknowledged->Y);
+		WriteVarInt(Records, Position.Z - Acknowledged->Z);
+		WriteVarInt(Records, AxisDelta(Acknowledged->RX, Position.RX));
+		WriteVarInt(Records, AxisDelta(Acknowledged->RY, Position.RY));
+		WriteVarInt(Records, AxisDelta(Acknowledged->RZ, Position.RZ));
+	}
+	else
+	{
+		Records.Add(KeyframeFlag);
+		WriteVarInt(Records, Position.X);
+		WriteVarInt(Records, Position.Y);
+		WriteVarInt(Records, Position.Z);
+		WriteVarInt(Records, Position.RX);
+		WriteVarInt(Records, Position.RY);
+		WriteVarInt(Records, Position.RZ);
+	}
+}
+
+bool AOWSGameMode::AppendPlayerLocationRecord(APlayerController* PlayerController, TArray<uint8>& Records, TMap<FString, FOWSSavedPlayerPosition>& SentPlayerPositions, bool bForceKeyframe)
+{
+	using namespace OWSPlayerLocationSnapshot;
+
+	FString PlayerName;
+	FOWSSavedPlayerPosition Position;
+
+	if (!GetPlayerPositionToSave(PlayerController, PlayerName, Position))
+	{
+		return true;
+	}
+
+	//Deltas must be against an acknowledged save, so wait for the one in flight to be answered
+	if (PlayersWithPositionSaveInFlight.Contains(PlayerName))
+	{
+		return false;
+	}
+
+	const FOWSSavedPlayerPosition* Acknowledged = bForceKeyframe ? nullptr : AcknowledgedPlayerPositions.Find(PlayerName);
+
+	if (Acknowledged)
+	{
+		const double MinDistanceQuantized = SavePlayerLocationMinDistance * LocationScale;
+		const int32 MinRotationCompressed = FMath::CeilToInt(SavePlayerLocationMinRotationDegrees * 65536.f / 360.f);
+
+		const double DX = static_cast<double>(Position.X - Acknowledged->X);
+		const double DY = static_cast<double>(Position.Y - Acknowledged->Y);
+		const double DZ = static_cast<double>(Position.Z - Acknowledged->Z);
+
+		const bool bMoved = DX * DX + DY * DY + DZ * DZ >= MinDistanceQuantized * MinDistanceQuantized;
+		const bool bTurned = FMath::Abs(AxisDelta(Acknowledged->RX, Position.RX)) >= MinRotationCompressed
+			|| FMath::Abs(AxisDelta(Acknowledged->RY, Position.RY)) >= MinRotationCompressed
+			|| FMath::Abs(AxisDelta(Acknowledged->RZ, Position.RZ)) >= MinRotationCompressed;
+
+		if (!bMoved && !bTurned)
+		{
+			return true;
+		}
+	}
+
+	WritePlayerLocationRecord(Records, PlayerName, Position, Acknowledged);
+	SentPlayerPositions.Add(PlayerName, Position);
+	return true;
+}
+
+void AOWSGameMode::SendPlayerLocationRecords(const TArray<uint8>& Records, TMap<FString, FOWSSavedPlayerPosition> SentPlayerPositions)
+{
+	using namespace OWSPlayerLocationSnapshot;
+
+	TArray<uint8> Snapshot;
+	Snapshot.Reserve(Records.Num() + 6);
+	Snapshot.Add(Version);
+	WriteVarUInt(Snapshot, SentPlayerPositions.Num());
+	Snapshot.Append(Records);
+
+	UE_LOG(OWS, Verbose, TEXT("SaveAllPlayerLocations - Saving %d moved player(s) in %d bytes"), SentPlayerPositions.Num(), Snapshot.Num());
+
+	FUpdateAllPlayerPositionsDeltaJSONPost UpdateAllPlayerPositionsDeltaJSONPost;
+	UpdateAllPlayerPositionsDeltaJSONPost.SerializedPlayerLocationDelta = FBase64::Encode(Snapshot);
+	UpdateAllPlayerPositionsDeltaJSONPost.MapName = "";
+	FString PostParameters = "";
+	if (FJsonObjectConverter::UStructToJsonObjectString(UpdateAllPlayerPositionsDeltaJSONPost, PostParameters))
+	{
+		for (const TPair<FString, FOWSSavedPlayerPosition>& SentPlayerPosition : SentPlayerPositions)
+		{
+			PlayersWithPositionSaveInFlight.Add(SentPlayerPosition.Key);
+		}
+
+		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateOWS2POSTRequest("CharacterPersistenceAPI", "api/Characters/UpdateAllPlayerPositionsDelta", PostParameters);
+		Request->OnProcessRequestComplete().BindUObject(this, &AOWSGameMode::OnSaveAllPlayerLocationsDeltaResponseReceived, MoveTemp(SentPlayerPositions));
+		Request->ProcessRequest();
+	}
+	else
+	{
+		UE_LOG(OWS, Error, TEXT("SaveAllPlayerLocations Error serializing UpdateAllPlayerPositionsDeltaJSONPost!"));
+	}
+}
+
+void AOWSGameMode::FlushPlayerLocation(APlayerController* PlayerController)
+{
+	FString PlayerName;
+	FOWSSavedPlayerPosition Position;
+
+	if (!GetPlayerPositionToSave(PlayerController, PlayerName, Position))
+	{
+		return;
+	}
+
+	//A save for this player is already on its way.  Hold on to where they are now and send it as a keyframe once that one is answered.
+	if (PlayersWithPositionSaveInFlight.Contains(PlayerName))
+	{
+		PendingFinalPlayerPositions.Add(PlayerName, Position);
+		return;
+	}
+
+	TArray<uint8> Records;
+	TMap<FString, FOWSSavedPlayerPosition> SentPlayerPositions;
+	WritePlayerLocationRecord(Records, PlayerName, Position, nullptr);
+	SentPlayerPositions.Add(PlayerName, Position);
+	SendPlayerLocationRecords(Records, MoveTemp(SentPlayerPositions));
+}
+
+void AOWSGameMode::OnSaveAllPlayerLocationsDeltaResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TMap<FString, FOWSSavedPlayerPosition> SentPlayerPositions)
+{
+	FString ErrorMsg;
+	TSharedPtr<FUpdateAllPlayerPositionsDeltaResult> DeltaResult = FOWSJsonStructReader::ReadResponse<FUpdateAllPlayerPositionsDeltaResult>(Response, bWasSuccessful, "OnSaveAllPlayerLocationsDeltaResponseReceived", ErrorMsg);
+
+	bool bSaved = false;
+	TArray<FString> PlayersNeedingKeyframe;
+
+	if (DeltaResult.IsValid())
+	{
+		bSaved = DeltaResult->Success;
+		PlayersNeedingKeyframe = MoveTemp(DeltaResult->PlayersNeedingKeyframe);
+	}
+
+	if (!bSaved)
+	{
+		UE_LOG(OWS, Error, TEXT("OnSaveAllPlayerLocationsDeltaResponseReceived Error saving player locations! %s"), *ErrorMsg);
+	}
+
+	TArray<uint8> FinalRecords;
+	TMap<FString, FOWSSavedPlayerPosition> FinalPlayerPositions;
+
+	for (const TPair<FString, FOWSSavedPlayerPosition>& SentPlayerPosition : SentPlayerPositions)
+	{
+		PlayersWithPositionSaveInFlight.Remove(SentPlayerPosition.Key);
+
+		//If we don't know what the API applied, fall back to a keyframe on the next save
+		if (!bSaved || PlayersNeedingKeyframe.Contains(SentPlayerPosition.Key))
+		{
+			AcknowledgedPlayerPositions.Remove(SentPlayerPosition.Key);
+		}
+		else
+		{
+			AcknowledgedPlayerPositions.Add(SentPlayerPosition.Key, SentPlayerPosition.Value);
+		}
+
+		FOWSSavedPlayerPosition FinalPosition;
+		if (PendingFinalPlayerPositions.RemoveAndCopyValue(SentPlayerPosition.Key, FinalPosition))
+		{
+			WritePlayerLocationRecord(FinalRecords, SentPlayerPosition.Key, FinalPosition, nullptr);
+			FinalPlayerPositions.Add(SentPlayerPosition.Key, FinalPosition);
+		}
+		else if (PlayersPendingLogout.Remove(SentPlayerPosition.Key) > 0)
+		{
+			//Whoever picks this player up next starts from a keyframe
+			AcknowledgedPlayerPositions.Remove(SentPlayerPosition.Key);
+		}
+	}
+
+	if (FinalPlayerPositions.Num() > 0)
+	{
+		SendPlayerLocationRecords(FinalRecords, MoveTemp(FinalPlayerPositions));
+	}
+}
+
 
 void AOWSGameMode::GetAllCharactersOnline()
 {
@@ -628,17 +1005,12 @@ void AOWSGameMode::GetZoneInstancesForZone(FString ZoneName)
 
 void AOWSGameMode::OnGetZoneInstancesForZoneResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
-	if (bWasSuccessful)
+	if (bWasSuccessful && Response.IsValid())
 	{
-		TArray<TSharedPtr<FJsonValue>> JsonArray;
-		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+		TArray<FZoneInstance> ZoneInstances;
 
-		if (FJsonSerializer::Deserialize(Reader, JsonArray))
+		if (FOWSJsonStructReader::ReadStructArray(Response->GetContent(), ZoneInstances))
 		{
-			TArray<FZoneInstance> ZoneInstances;
-
-			FJsonObjectConverter::JsonArrayToUStruct(JsonArray, &ZoneInstances, 0, 0);
-
 			NotifyGetZoneInstancesForZone(ZoneInstances);
 		}
 		else
@@ -673,18 +1045,19 @@ void AOWSGameMode::OnGetZoneInstanceFromZoneInstanceIDResponseReceived(FHttpRequ
 	if (bWasSuccessful)
 	{
 		FGetServerInstanceFromPort ServerInstanceFromPort;
-		FString JsonString = Response->GetContentAsString();
-		if (FJsonObjectConverter::JsonObjectStringToUStruct(JsonString, &ServerInstanceFromPort))
+		if (Response.IsValid() && FOWSJsonStructReader::ReadStruct(Response->GetContent(), ServerInstanceFromPort))
 		{
 			if (ServerInstanceFromPort.ZoneName != "")
 			{
 				IAmZoneName = ServerInstanceFromPort.ZoneName;
 				UE_LOG(OWS, Verbose, TEXT("I am ZoneName: %s"), *IAmZoneName);
+				ApplyZoneReplicationSettings(ServerInstanceFromPort.MapName);
 				NotifyGetZoneInstanceFromZoneInstanceID(IAmZoneName);
 			}
 			else
 			{
 				UE_LOG(OWS, Warning, TEXT("OnGetZoneInstanceFromZoneInstanceIDResponseReceived No Rows!  Ignore this error if you are running from the editor in Play as Client mode!"));
+				ApplyZoneReplicationSettings(GetWorld()->GetMapName());
 				ErrorGetZoneInstanceFromZoneInstanceID(TEXT("OnGetZoneInstanceFromZoneInstanceIDResponseReceived No Rows!  Ignore this error if you are running from the editor in Play as Client mode!"));
 			}
 		}
@@ -701,6 +1074,16 @@ void AOWSGameMode::OnGetZoneInstanceFromZoneInstanceIDResponseReceived(FHttpRequ
 	}
 }
 
+void AOWSGameMode::ApplyZoneReplicationSettings(const FString& MapName)
+{
+	UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	UOWSReplicationGraph* ReplicationGraph = NetDriver ? Cast<UOWSReplicationGraph>(NetDriver->GetReplicationDriver()) : nullptr;
+	if (ReplicationGraph)
+	{
+		ReplicationGraph->ApplyZoneSpatialSettings(IAmZoneName, MapName);
+	}
+}
+
 void AOWSGameMode::UpdateNumberOfPlayers()
 {
 	UE_LOG(OWS, Verbose, TEXT("UpdateNumberOfPlayers Started..."));
@@ -797,16 +1180,13 @@ void AOWSGameMode::AddZone(FString ZoneName, FString MapName, int SoftPlayerCap,
 void AOWSGameMode::OnAddZoneResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
 	FString ErrorMsg;
-	TSharedPtr<FJsonObject> JsonObject;
-	GetJsonObjectFromResponse(Request, Response, bWasSuccessful, "OnAddZoneResponseReceived", ErrorMsg, JsonObject);
+	TSharedPtr<FSuccessAndErrorMessage> SuccessAndErrorMessage = FOWSJsonStructReader::ReadResponse<FSuccessAndErrorMessage>(Response, bWasSuccessful, "OnAddZoneResponseReceived", ErrorMsg);
 	if (!ErrorMsg.IsEmpty())
 	{
 		ErrorAddZone(ErrorMsg);
 		return;
 	}
 
-	TSharedPtr<FSuccessAndErrorMessage> SuccessAndErrorMessage = GetStructFromJsonObject<FSuccessAndErrorMessage>(JsonObject);
-
 	if (!SuccessAndErrorMessage->ErrorMessage.IsEmpty())
 	{
 		ErrorAddZone(*SuccessAndErrorMessage->ErrorMessage);
@@ -842,16 +1222,13 @@ void AOWSGameMode::UpdateZone(int32 MapID, FString ZoneName, FString MapName, in
 void AOWSGameMode::OnUpdateZoneResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
 	FString ErrorMsg;
-	TSharedPtr<FJsonObject> JsonObject;
-	GetJsonObjectFromResponse(Request, Response, bWasSuccessful, "OnUpdateZoneResponseReceived", ErrorMsg, JsonObject);
+	TSharedPtr<FSuccessAndErrorMessage> SuccessAndErrorMessage = FOWSJsonStructReader::ReadResponse<FSuccessAndErrorMessage>(Response, bWasSuccessful, "OnUpdateZoneResponseReceived", ErrorMsg);
 	if (!ErrorMsg.IsEmpty())
 	{
 		ErrorUpdateZone(ErrorMsg);
 		return;
 	}
 
-	TSharedPtr<FSuccessAndErrorMessage> SuccessAndErrorMessage = GetStructFromJsonObject<FSuccessAndErrorMessage>(JsonObject);
-
 	if (!SuccessAndErrorMessage->ErrorMessage.IsEmpty())
 	{
 		ErrorUpdateZone(*SuccessAndErrorMessage->ErrorMessage);
@@ -869,25 +1246,34 @@ FString AOWSGameMode::GetAddressURLAndPort()
 
 void AOWSGameMode::AddItemMeshToAllPlayers(const FString& ItemName, const int32 ItemMeshID)
 {
-	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
-	{
-		AOWSPlayerController* MyPlayerController = Cast<AOWSPlayerController>(Iterator->Get());
+	MeshItemsMap.Add(ItemName, ItemMeshID);
 
-		if (MyPlayerController)
-		{
-			MyPlayerController->AddItemToLocalMeshItemsMap(ItemName, ItemMeshID);
-		}
+	//Replicated to every player, including ones who join later
+	if (ItemMeshRegistry)
+	{
+		ItemMeshRegistry->AddItemMesh(ItemName, ItemMeshID);
 	}
 }
 
 FInventoryItemStruct& AOWSGameMode::FindItemDefinition(FString ItemName)
 {
-	auto FoundEntry = AllInventoryItems.FindByPredicate([&](FInventoryItemStruct& InItem)
+	//Don't add every name we're asked about to the FName table.  A name that was never interned can't be an item.
+	const FName ItemFName(*ItemName, FNAME_Find);
+	FInventoryItemStruct* FoundEntry = ItemFName.IsNone() ? nullptr : ItemCatalog.FindItem(AllInventoryItems, ItemFName);
+
+	if (!FoundEntry)
 	{
-		return InItem.ItemName == ItemName;
-	});
+		UE_LOG(OWS, Error, TEXT("FindItemDefinition - No item definition found for %s!"), *ItemName);
+		MissingItemDefinition = FInventoryItemStruct();
+		return MissingItemDefinition;
+	}
 
-	return (*FoundEntry);
+	return *FoundEntry;
+}
+
+const FInventoryItemStruct* AOWSGameMode::FindItemDefinitionByName(const FName ItemName)
+{
+	return ItemCatalog.FindItem(AllInventoryItems, ItemName);
 }
 
 AOWSPlayerController* AOWSGameMode::GetPlayerControllerFromCharacterName(const FString CharacterName)
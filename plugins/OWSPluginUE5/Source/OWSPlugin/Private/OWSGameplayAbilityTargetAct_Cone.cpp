@@ -5,6 +5,7 @@
 #include "WorldCollision.h"
 #include "Abilities/GameplayAbility.h"
 #include "Runtime/Engine/Classes/Engine/OverlapResult.h"
+#include "OWSTargetingSubsystem.h"
 
 
 AOWSGameplayAbilityTargetAct_Cone::AOWSGameplayAbilityTargetAct_Cone(const FObjectInitializer& ObjectInitializer)
@@ -45,6 +46,27 @@ FGameplayAbilityTargetDataHandle AOWSGameplayAbilityTargetAct_Cone::MakeTargetDa
 
 TArray<TWeakObjectPtr<AActor> >	AOWSGameplayAbilityTargetAct_Cone::PerformOverlap(const FVector& Origin)
 {
+	TArray<TWeakObjectPtr<AActor>>	HitActors;
+
+	//On the server, read the targeting grid instead of querying the physics scene
+	UOWSTargetingSubsystem* TargetingSubsystem = SourceActor->GetWorld()->GetSubsystem<UOWSTargetingSubsystem>();
+	if (TargetingSubsystem && TargetingSubsystem->IsTrackingPawns())
+	{
+		FOWSTargetingQuery Query = FOWSTargetingQuery::MakeCone(Origin, ForwardVector, Radius, HalfAngle);
+		Query.SetTeamFilter(Filter);
+
+		TArray<APawn*> Pawns;
+		TargetingSubsystem->RunQuery(Query, [this](APawn* Pawn) { return Filter.FilterPassesForActor(Pawn); }, Pawns);
+
+		HitActors.Reserve(Pawns.Num());
+		for (APawn* Pawn : Pawns)
+		{
+			HitActors.Add(Pawn);
+		}
+
+		return HitActors;
+	}
+
 	bool bTraceComplex = false;
 
 	FCollisionQueryParams Params(SCENE_QUERY_STAT(RadiusTargetingOverlap), bTraceComplex);
@@ -54,13 +76,21 @@ TArray<TWeakObjectPtr<AActor> >	AOWSGameplayAbilityTargetAct_Cone::PerformOverla
 
 	SourceActor->GetWorld()->OverlapMultiByObjectType(Overlaps, Origin, FQuat::Identity, FCollisionObjectQueryParams(ECC_Pawn), FCollisionShape::MakeSphere(Radius), Params);
 
-	TArray<TWeakObjectPtr<AActor>>	HitActors;
+	//A pawn with several overlapping components shows up once per component
+	TSet<APawn*> TestedPawns;
+	TestedPawns.Reserve(Overlaps.Num());
 
 	for (int32 i = 0; i < Overlaps.Num(); ++i)
 	{
 		//Should this check to see if these pawns are in the AimTarget list?
 		APawn* PawnActor = Cast<APawn>(Overlaps[i].GetActor());
-		if (PawnActor && !HitActors.Contains(PawnActor) && Filter.FilterPassesForActor(PawnActor))
+		bool bAlreadyTested = false;
+		if (PawnActor)
+		{
+			TestedPawns.Add(PawnActor, &bAlreadyTested);
+		}
+
+		if (PawnActor && !bAlreadyTested && Filter.FilterPassesForActor(PawnActor))
 		{
 			FVector ActorOrigin;
 			FVector ActorBoxExtent;
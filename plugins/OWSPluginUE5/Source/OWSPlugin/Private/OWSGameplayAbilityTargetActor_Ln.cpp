@@ -26,7 +26,7 @@ FHitResult AOWSGameplayAbilityTargetActor_Ln::PerformTrace(AActor* InSourceActor
 	// ------------------------------------------------------
 
 	FHitResult ReturnHitResult;
-	LineTraceWithFilter(ReturnHitResult, InSourceActor->GetWorld(), OWSFilter, TraceStart, TraceEnd, TraceProfile.Name, Params);
+	LineTraceWithFilter(ReturnHitResult, InSourceActor->GetWorld(), OWSFilter, TraceStart, TraceEnd, TraceProfile.Name, Params, GetLagCompensationRewindSeconds());
 	//Default to end of trace line if we don't hit anything.
 	if (!ReturnHitResult.bBlockingHit)
 	{
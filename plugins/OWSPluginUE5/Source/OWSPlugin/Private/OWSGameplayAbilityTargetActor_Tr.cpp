@@ -4,6 +4,7 @@
 #include "DrawDebugHelpers.h"
 #include "GameFramework/PlayerController.h"
 #include "Abilities/GameplayAbility.h"
+#include "OWSLagCompensationSubsystem.h"
 
 // --------------------------------------------------------------------------------------------------------------------------------------------------------
 //
@@ -19,6 +20,7 @@ AOWSGameplayAbilityTargetActor_Tr::AOWSGameplayAbilityTargetActor_Tr(const FObje
 
 	MaxRange = 999999.0f;
 	bTraceAffectsAimPitch = true;
+	bUseLagCompensation = true;
 }
 
 void AOWSGameplayAbilityTargetActor_Tr::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -33,7 +35,7 @@ void AOWSGameplayAbilityTargetActor_Tr::EndPlay(const EEndPlayReason::Type EndPl
 
 
 
-void AOWSGameplayAbilityTargetActor_Tr::LineTraceWithFilter(FHitResult& OutHitResult, const UWorld* World, const FOWSGameplayTargetDataFilterHandle FilterHandle, const FVector& Start, const FVector& End, FName ProfileName, const FCollisionQueryParams Params)
+void AOWSGameplayAbilityTargetActor_Tr::LineTraceWithFilter(FHitResult& OutHitResult, const UWorld* World, const FOWSGameplayTargetDataFilterHandle FilterHandle, const FVector& Start, const FVector& End, FName ProfileName, const FCollisionQueryParams Params, float RewindSeconds)
 {
 	check(World);
 
@@ -43,6 +45,12 @@ void AOWSGameplayAbilityTargetActor_Tr::LineTraceWithFilter(FHitResult& OutHitRe
 	OutHitResult.TraceStart = Start;
 	OutHitResult.TraceEnd = End;
 
+	if (RewindSeconds > 0.f)
+	{
+		ApplyLagCompensation(OutHitResult, World, FilterHandle, Start, End, 0.f, ProfileName, Params, HitResults, RewindSeconds);
+		return;
+	}
+
 	for (int32 HitIdx = 0; HitIdx < HitResults.Num(); ++HitIdx)
 	{
 		const FHitResult& Hit = HitResults[HitIdx];
@@ -56,7 +64,7 @@ void AOWSGameplayAbilityTargetActor_Tr::LineTraceWithFilter(FHitResult& OutHitRe
 	}
 }
 
-void AOWSGameplayAbilityTargetActor_Tr::SweepWithFilter(FHitResult& OutHitResult, const UWorld* World, const FOWSGameplayTargetDataFilterHandle FilterHandle, const FVector& Start, const FVector& End, const FQuat& Rotation, const FCollisionShape CollisionShape, FName ProfileName, const FCollisionQueryParams Params)
+void AOWSGameplayAbilityTargetActor_Tr::SweepWithFilter(FHitResult& OutHitResult, const UWorld* World, const FOWSGameplayTargetDataFilterHandle FilterHandle, const FVector& Start, const FVector& End, const FQuat& Rotation, const FCollisionShape CollisionShape, FName ProfileName, const FCollisionQueryParams Params, float RewindSeconds)
 {
 	check(World);
 
@@ -66,6 +74,13 @@ void AOWSGameplayAbilityTargetActor_Tr::SweepWithFilter(FHitResult& OutHitResult
 	OutHitResult.TraceStart = Start;
 	OutHitResult.TraceEnd = End;
 
+	if (RewindSeconds > 0.f)
+	{
+		//Rewound pawns are tested against the shape's bounding sphere
+		ApplyLagCompensation(OutHitResult, World, FilterHandle, Start, End, CollisionShape.GetExtent().GetMax(), ProfileName, Params, HitResults, RewindSeconds);
+		return;
+	}
+
 	for (int32 HitIdx = 0; HitIdx < HitResults.Num(); ++HitIdx)
 	{
 		const FHitResult& Hit = HitResults[HitIdx];
@@ -79,6 +94,81 @@ void AOWSGameplayAbilityTargetActor_Tr::SweepWithFilter(FHitResult& OutHitResult
 	}
 }
 
+void AOWSGameplayAbilityTargetActor_Tr::ApplyLagCompensation(FHitResult& OutHitResult, const UWorld* World, const FOWSGameplayTargetDataFilterHandle& FilterHandle, const FVector& Start, const FVector& End, float SweepRadius, FName ProfileName, const FCollisionQueryParams& Params, const TArray<FHitResult>& HitResults, float RewindSeconds)
+{
+	UOWSLagCompensationSubsystem* LagCompensation = World->GetSubsystem<UOWSLagCompensationSubsystem>();
+
+	//The physics hits have pawns where they are now.  Only use them for the world geometry and untracked actors.
+	FVector WorldBlockEnd = End;
+	for (const FHitResult& Hit : HitResults)
+	{
+		AActor* HitActor = Hit.HitObjectHandle.FetchActor();
+		if (LagCompensation && LagCompensation->IsTrackingPawn(Cast<APawn>(HitActor)))
+		{
+			continue;
+		}
+
+		if (!Hit.HitObjectHandle.IsValid() || FilterHandle.FilterPassesForActor(HitActor))
+		{
+			OutHitResult = Hit;
+			OutHitResult.bBlockingHit = true; // treat it as a blocking hit
+			WorldBlockEnd = Hit.Location;
+			break;
+		}
+	}
+
+	if (!LagCompensation)
+	{
+		return;
+	}
+
+	ECollisionChannel TraceChannel;
+	FCollisionResponseParams ResponseParams;
+	UCollisionProfile::GetChannelAndResponseParams(ProfileName, TraceChannel, ResponseParams);
+
+	//Same rules the physics query would have used: ignored actors, both sides of the collision response, then the target filter
+	auto ShouldConsiderPawn = [&](APawn* Pawn)
+	{
+		if (Params.GetIgnoredActors().Contains(Pawn->GetUniqueID()))
+		{
+			return false;
+		}
+
+		if (const UPrimitiveComponent* RootPrimitive = Cast<UPrimitiveComponent>(Pawn->GetRootComponent()))
+		{
+			if (RootPrimitive->GetCollisionResponseToChannel(TraceChannel) == ECR_Ignore
+				|| ResponseParams.CollisionResponse.GetResponse(RootPrimitive->GetCollisionObjectType()) == ECR_Ignore)
+			{
+				return false;
+			}
+		}
+
+		return FilterHandle.FilterPassesForActor(Pawn);
+	};
+
+	FOWSLagCompensationHit PawnHit;
+	if (LagCompensation->SweepRewoundPawns(Start, WorldBlockEnd, SweepRadius, LagCompensation->GetServerTime() - RewindSeconds, ShouldConsiderPawn, PawnHit))
+	{
+		OutHitResult = PawnHit.ToHitResult(Start, End);
+	}
+}
+
+float AOWSGameplayAbilityTargetActor_Tr::GetLagCompensationRewindSeconds() const
+{
+	if (!bUseLagCompensation || !OwningAbility || !HasAuthority())
+	{
+		return 0.f;
+	}
+
+	const UOWSLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UOWSLagCompensationSubsystem>();
+	if (!LagCompensation)
+	{
+		return 0.f;
+	}
+
+	return LagCompensation->GetRewindSeconds(OwningAbility->GetCurrentActorInfo()->PlayerController.Get());
+}
+
 void AOWSGameplayAbilityTargetActor_Tr::AimWithPlayerController(const AActor* InSourceActor, FCollisionQueryParams Params, const FVector& TraceStart, FVector& OutTraceEnd, bool bIgnorePitch) const
 {
 	if (!OwningAbility) // Server and launching client only
@@ -99,7 +189,7 @@ void AOWSGameplayAbilityTargetActor_Tr::AimWithPlayerController(const AActor* In
 	ClipCameraRayToAbilityRange(ViewStart, ViewDir, TraceStart, MaxRange, ViewEnd);
 
 	FHitResult HitResult;
-	LineTraceWithFilter(HitResult, InSourceActor->GetWorld(), OWSFilter, ViewStart, ViewEnd, TraceProfile.Name, Params);
+	LineTraceWithFilter(HitResult, InSourceActor->GetWorld(), OWSFilter, ViewStart, ViewEnd, TraceProfile.Name, Params, GetLagCompensationRewindSeconds());
 
 	const bool bUseTraceResult = HitResult.bBlockingHit && (FVector::DistSquared(TraceStart, HitResult.Location) <= (MaxRange * MaxRange));
 
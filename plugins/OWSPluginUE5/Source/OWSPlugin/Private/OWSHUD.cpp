@@ -7,22 +7,89 @@ AOWSHUD::AOWSHUD()
 {
 	SplitNumber = 1;
 	StackToSplitSize = 2;
+	SlotToSplit = INDEX_NONE;
+	bIsDraggingItem = false;
 	bDrawSecondIconForStack = true;
 	StackDrawOffset = 3.f;
 	StackDrawTextOffset = 15.f;
+	MaxFloatingDamageItems = 128;
+	FloatingDamageAggregationWindow = 0.2f;
+	NextFloatingDamageItem = 0;
+}
+
+//Reads whole number damage text such as "125" or "+40".  Anything else is drawn as is and never aggregated.
+static bool ParseFloatingDamageAmount(const FString& DamageText, int64& OutAmount)
+{
+	const TCHAR* Digits = *DamageText;
+	if (*Digits == TEXT('+') || *Digits == TEXT('-'))
+	{
+		Digits++;
+	}
+
+	if (*Digits == TEXT('\0') || FCString::Strlen(Digits) > 18)
+	{
+		return false;
+	}
+
+	for (const TCHAR* Char = Digits; *Char; Char++)
+	{
+		if (!FChar::IsDigit(*Char))
+		{
+			return false;
+		}
+	}
+
+	OutAmount = FCString::Atoi64(*DamageText);
+	return true;
 }
 
 void AOWSHUD::AddFloatingDamageItem(FString DamageText, AActor* DamagedActor, FVector DamagedActorOffset, bool IsHealing, bool IsCritical, bool ShowDropShadow, bool ShowOutline)
 {
-	FFloatingDamage TempFloatingDamageItem;
+	int64 Amount = 0;
+	const bool IsNumeric = ParseFloatingDamageAmount(DamageText, Amount);
+
+	if (IsNumeric && AggregateFloatingDamage(DamagedActor, Amount, IsHealing, IsCritical))
+	{
+		return;
+	}
+
+	//Size the pool on first use, or after MaxFloatingDamageItems is changed
+	const int32 PoolSize = FMath::Max(MaxFloatingDamageItems, 1);
+	if (FloatingDamageItems.Num() != PoolSize)
+	{
+		FloatingDamageItems.SetNum(PoolSize);
+	}
+	if (NextFloatingDamageItem >= PoolSize)
+	{
+		NextFloatingDamageItem = 0;
+	}
+
+	//Items expire at different rates, so take the first free slot from the ring position on.  Only evict the oldest item when every slot is live.
+	int32 SlotToUse = NextFloatingDamageItem;
+	for (int32 Offset = 0; Offset < PoolSize; Offset++)
+	{
+		const int32 Slot = (NextFloatingDamageItem + Offset) % PoolSize;
+		if (FloatingDamageItems[Slot].MarkedForDeletion)
+		{
+			SlotToUse = Slot;
+			break;
+		}
+	}
+
+	FFloatingDamage& TempFloatingDamageItem = FloatingDamageItems[SlotToUse];
+	NextFloatingDamageItem = (SlotToUse + 1) % PoolSize;
 
+	//Reuses the slot's string buffer when it is big enough
 	TempFloatingDamageItem.DamageText = DamageText;
+	TempFloatingDamageItem.Amount = Amount;
+	TempFloatingDamageItem.IsNumeric = IsNumeric;
 	TempFloatingDamageItem.IsHealing = IsHealing;
 	TempFloatingDamageItem.IsCritical = IsCritical;
 	TempFloatingDamageItem.DamageTextLength = 0.f;
 	TempFloatingDamageItem.DamagedActor = DamagedActor;	
 	TempFloatingDamageItem.DamagedActorOffset = DamagedActorOffset;
 	TempFloatingDamageItem.Alpha = 1.f;
+	TempFloatingDamageItem.TimeSinceLastHit = 0.f;
 	TempFloatingDamageItem.MarkedForDeletion = false;
 	TempFloatingDamageItem.ShowDropShadow = ShowDropShadow;
 	TempFloatingDamageItem.ShowOutline = ShowOutline;
@@ -35,47 +102,109 @@ void AOWSHUD::AddFloatingDamageItem(FString DamageText, AActor* DamagedActor, FV
 	{
 		TempFloatingDamageItem.TimeLeft = FloatingHealingMinimumDisplayTime;
 	}
+}
+
+bool AOWSHUD::AggregateFloatingDamage(AActor* DamagedActor, int64 Amount, bool IsHealing, bool IsCritical)
+{
+	if (FloatingDamageAggregationWindow <= 0.f || !DamagedActor)
+	{
+		return false;
+	}
+
+	for (FFloatingDamage& FloatingDamageItem : FloatingDamageItems)
+	{
+		if (FloatingDamageItem.MarkedForDeletion || !FloatingDamageItem.IsNumeric || FloatingDamageItem.DamagedActor != DamagedActor
+			|| FloatingDamageItem.IsHealing != IsHealing || FloatingDamageItem.IsCritical != IsCritical
+			|| FloatingDamageItem.TimeSinceLastHit > FloatingDamageAggregationWindow)
+		{
+			continue;
+		}
+
+		const bool bShowPlusSign = FloatingDamageItem.DamageText.StartsWith(TEXT("+"));
+
+		FloatingDamageItem.Amount += Amount;
+		FloatingDamageItem.DamageText.Reset();
+		FloatingDamageItem.DamageText.Appendf(bShowPlusSign ? TEXT("+%lld") : TEXT("%lld"), FloatingDamageItem.Amount);
+		FloatingDamageItem.DamageTextLength = 0.f;
+		FloatingDamageItem.TimeSinceLastHit = 0.f;
+		FloatingDamageItem.TimeLeft = IsHealing ? FloatingHealingMinimumDisplayTime : FloatingDamageMinimumDisplayTime;
+		FloatingDamageItem.Alpha = 1.f;
+		return true;
+	}
 
-	FloatingDamageItems.Add(TempFloatingDamageItem);
+	return false;
 }
 
 void AOWSHUD::CleanUpFloatingDamageItems()
 {
-	FloatingDamageItems.RemoveAll([](const FFloatingDamage item) {
-		return item.MarkedForDeletion == true;
-	});
+	//Pool slots are reused in place, so there is nothing to compact.  Free the ones whose actor is gone.
+	for (FFloatingDamage& FloatingDamageItem : FloatingDamageItems)
+	{
+		if (!IsValid(FloatingDamageItem.DamagedActor))
+		{
+			FloatingDamageItem.MarkedForDeletion = true;
+		}
+	}
+}
+
+float AOWSHUD::MeasureFloatingText(const FString& Text, UFont* Font)
+{
+	FOWSNumericGlyphWidths* GlyphWidths = NumericGlyphWidthCache.Find(Font);
+
+	if (!GlyphWidths)
+	{
+		static const TCHAR Glyphs[] = TEXT("0123456789+-.,");
+
+		GlyphWidths = &NumericGlyphWidthCache.Add(Font);
+		for (int32 GlyphIndex = 0; GlyphIndex < FOWSNumericGlyphWidths::NumGlyphs; GlyphIndex++)
+		{
+			float TextHeight = 0.f;
+			GetTextSize(FString::Chr(Glyphs[GlyphIndex]), GlyphWidths->Widths[GlyphIndex], TextHeight, Font, 1.f);
+		}
+	}
+
+	float TextWidth = 0.f;
+	for (const TCHAR Char : Text)
+	{
+		const int32 GlyphIndex = FOWSNumericGlyphWidths::GetGlyphIndex(Char);
+
+		//Not numeric, so measure the whole string
+		if (GlyphIndex == INDEX_NONE)
+		{
+			float TextHeight = 0.f;
+			GetTextSize(Text, TextWidth, TextHeight, Font, 1.f);
+			return TextWidth;
+		}
+
+		TextWidth += GlyphWidths->Widths[GlyphIndex];
+	}
+
+	return TextWidth;
 }
 
 void AOWSHUD::RenderFloatingDamage(float DeltaTime)
 {
+	if (!Canvas)
+		return;
+
 	for (FFloatingDamage& FloatingDamageItem : FloatingDamageItems)
 	{
+		if (FloatingDamageItem.MarkedForDeletion)
+			continue;
+
 		if (FloatingDamageItem.DamagedActor)
 		{
-			//Calculate text width the first time
-			if (FloatingDamageItem.DamageTextLength <= 0.f)
-			{
-				float TextWidth = 0.f, TextHeight = 0.f;
-				GetTextSize(FloatingDamageItem.DamageText, TextWidth, TextHeight, FloatingDamageFont, 1.f);
-				FloatingDamageItem.DamageTextLength = TextWidth;
-			}
-
 			//Move text up
 			FloatingDamageItem.DamagedActorOffset.Z += FloatingDamageSpeed.Y * DeltaTime;
 
-			//Calcualte DamagedActor location on screen
-			FVector DamageLocation = FloatingDamageItem.DamagedActor->GetActorLocation() + FloatingDamageItem.DamagedActorOffset;
-			FVector ProjectedScreenLocation = Project(DamageLocation);
-			FloatingDamageItem.DisplayLocation.X = ProjectedScreenLocation.X - (FloatingDamageItem.DamageTextLength / 2.f);
-			FloatingDamageItem.DisplayLocation.Y = ProjectedScreenLocation.Y;
-
 			//Remove DeltaTime from TimeLeft
 			FloatingDamageItem.TimeLeft -= DeltaTime;
+			FloatingDamageItem.TimeSinceLastHit += DeltaTime;
 
 			//Has time expired?
 			if (FloatingDamageItem.TimeLeft < 0.1f)
 			{
-				//Mark for deletion that will happen in CleanUpFloatingDamageItems()
+				//Free the pool slot
 				FloatingDamageItem.MarkedForDeletion = true;
 			}
 			else
@@ -168,6 +297,31 @@ void AOWSHUD::RenderFloatingDamage(float DeltaTime)
 					}
 				}
 
+				//Calcualte DamagedActor location on screen.  Skip drawing anything behind the camera.
+				FVector DamageLocation = FloatingDamageItem.DamagedActor->GetActorLocation() + FloatingDamageItem.DamagedActorOffset;
+				FVector ProjectedScreenLocation = Project(DamageLocation);
+				if (ProjectedScreenLocation.Z <= 0.f)
+				{
+					continue;
+				}
+
+				//Calculate text width the first time, and again when another hit changes the text
+				if (FloatingDamageItem.DamageTextLength <= 0.f)
+				{
+					FloatingDamageItem.DamageTextLength = MeasureFloatingText(FloatingDamageItem.DamageText, FloatingTextFont);
+				}
+
+				FloatingDamageItem.DisplayLocation.X = ProjectedScreenLocation.X - (FloatingDamageItem.DamageTextLength / 2.f);
+				FloatingDamageItem.DisplayLocation.Y = ProjectedScreenLocation.Y;
+
+				//Skip drawing anything off screen
+				const float TextHeight = FloatingTextFont ? FloatingTextFont->GetMaxCharHeight() : 0.f;
+				if (FloatingDamageItem.DisplayLocation.X + FloatingDamageItem.DamageTextLength < 0.f || FloatingDamageItem.DisplayLocation.X > Canvas->ClipX
+					|| FloatingDamageItem.DisplayLocation.Y + TextHeight < 0.f || FloatingDamageItem.DisplayLocation.Y > Canvas->ClipY)
+				{
+					continue;
+				}
+
 				TextColorToRender.A = FloatingDamageItem.Alpha;
 				DropShadowColorToRender.A = FloatingDamageItem.Alpha;
 				OutlineColorToRender.A = FloatingDamageItem.Alpha;
@@ -184,6 +338,11 @@ void AOWSHUD::RenderFloatingDamage(float DeltaTime)
 				DrawText(FloatingDamageItem.DamageText, TextColorToRender, FloatingDamageItem.DisplayLocation.X, FloatingDamageItem.DisplayLocation.Y, FloatingTextFont, 1.f);
 			}
 		}
+		else
+		{
+			//The actor is gone
+			FloatingDamageItem.MarkedForDeletion = true;
+		}
 	}
 }
 
@@ -985,13 +1144,12 @@ void AOWSHUD::RenderInteractiveInventoryGrid(UOWSInventory* Inventory, UTexture*
 
 			if (Inventory && Inventory->IsValidLowLevel())
 			{
-				UOWSInventoryItemStack* InventoryItemStack = Inventory->GetStackInSlot(SlotNumber);
-
-				if (!InventoryItemStack)
+				if (!Inventory->InventoryItemRecords.IsValidIndex(SlotNumber))
 					continue;
 
-				AOWSInventoryItem* InventoryItem = InventoryItemStack->GetTopItemFromStack();
-				if (InventoryItem && InventoryItem->IsValidLowLevel())
+				const FOWSInventoryItemRecord* InventoryItem = Inventory->FindItemInSlot(SlotNumber);
+				const bool bSlotIsBeingDragged = IsSlotBeingDragged(Inventory, SlotNumber);
+				if (InventoryItem)
 				{
 					UTexture* Texture = InventoryItem->IconTexture;
 					float CalculatedIconWidth = (float)iconWidth * (float)InventoryItem->IconSlotWidth + ((float)XSpacing * (float)(InventoryItem->IconSlotWidth - 1));
@@ -1007,31 +1165,31 @@ void AOWSHUD::RenderInteractiveInventoryGrid(UOWSInventory* Inventory, UTexture*
 						Size->Y = CalculatedIconHeight;
 					}
 
-					if (InventoryItemStack->IsBeingDragged)
+					if (bSlotIsBeingDragged)
 					{
 						DrawTexture(EmptySlotTexture, Position->X, Position->Y, (float)iconWidth, (float)iconHeight, 0.0f, 0.0f, 1.0f, 1.0f);
 					}
 					else
 					{
 						DrawTexture(Texture, Position->X, Position->Y, CalculatedIconWidth, CalculatedIconHeight, 0.0f, 0.0f, 1.0f, 1.0f);
-						if (InventoryItemStack->InventoryItems.Num() > 1)
+						if (InventoryItem->Quantity > 1)
 						{
 							if (bDrawSecondIconForStack)
 							{
 								DrawTexture(Texture, Position->X + StackDrawOffset, Position->Y + StackDrawOffset, CalculatedIconWidth - StackDrawOffset, CalculatedIconHeight - StackDrawOffset, 0.0f, 0.0f, 1.0f, 1.0f);
 							}
 
-							const FString StackSizeText = FString::FromInt(InventoryItemStack->InventoryItems.Num());
+							const FString StackSizeText = FString::FromInt(InventoryItem->Quantity);
 							DrawText(StackSizeText, FLinearColor::White, Position->X + CalculatedIconWidth - StackDrawTextOffset, Position->Y + CalculatedIconHeight - StackDrawTextOffset);
 						}
 					}
 				}
-				else if (!Inventory->IsSlotFilled(SlotNumber) || (ItemStackBeingDragged && ItemStackBeingDragged->IsBeingDragged && SlotsToShowWhileDragging.Contains(SlotNumber)))
+				else if (!Inventory->IsSlotFilled(SlotNumber) || (bIsDraggingItem && InventoryBeingDraggedFrom == Inventory->InventoryName && SlotsToShowWhileDragging.Contains(SlotNumber)))
 				{
 					DrawTexture(EmptySlotTexture, Position->X, Position->Y, (float)iconWidth, (float)iconHeight, 0.0f, 0.0f, 1.0f, 1.0f);
 				}
 
-				if (InventoryItemStack != ItemStackBeingDragged || (ItemStackBeingDragged && !ItemStackBeingDragged->IsBeingDragged))
+				if (!bSlotIsBeingDragged)
 				{
 					this->AddHitBox(*Position, *Size, InventorySlotName, true, 99);
 				}
@@ -1039,24 +1197,24 @@ void AOWSHUD::RenderInteractiveInventoryGrid(UOWSInventory* Inventory, UTexture*
 		}
 	}
 
-	if (ItemStackBeingDragged && ItemStackBeingDragged->IsBeingDragged)
+	if (bIsDraggingItem)
 	{
-		AOWSInventoryItem* InventoryItem = ItemStackBeingDragged->GetTopItemFromStack();
-		if (InventoryItem && InventoryItem->IsValidLowLevel())
+		const FOWSInventoryItemRecord* InventoryItem = GetItemBeingDragged();
+		if (InventoryItem)
 		{
 			UTexture* Texture = InventoryItem->IconTexture;
 			float CalculatedIconWidth = (float)iconWidth * (float)InventoryItem->IconSlotWidth + ((float)XSpacing * (float)(InventoryItem->IconSlotWidth - 1));
 			float CalculatedIconHeight = (float)iconHeight * (float)InventoryItem->IconSlotHeight + ((float)YSpacing * (float)(InventoryItem->IconSlotHeight - 1));
 
 			DrawTexture(Texture, MouseLocation.X - ((float)iconWidth / 2), MouseLocation.Y - ((float)iconHeight / 2), (float)CalculatedIconWidth, (float)CalculatedIconHeight, 0.0f, 0.0f, 1.0f, 1.0f);
-			if (ItemStackBeingDragged->InventoryItems.Num() > 1)
+			if (InventoryItem->Quantity > 1)
 			{
 				if (bDrawSecondIconForStack)
 				{
 					DrawTexture(Texture, MouseLocation.X - ((float)iconWidth / 2) + StackDrawOffset, MouseLocation.Y - ((float)iconHeight / 2) + StackDrawOffset, (float)CalculatedIconWidth - StackDrawOffset, (float)CalculatedIconHeight - StackDrawOffset, 0.0f, 0.0f, 1.0f, 1.0f);
 				}
 
-				const FString StackSizeText = FString::FromInt(ItemStackBeingDragged->InventoryItems.Num());
+				const FString StackSizeText = FString::FromInt(InventoryItem->Quantity);
 				DrawText(StackSizeText, FLinearColor::White, MouseLocation.X - (CalculatedIconWidth / 2) + CalculatedIconWidth - StackDrawTextOffset, MouseLocation.Y - (CalculatedIconHeight / 2) + CalculatedIconHeight - StackDrawTextOffset);
 			}
 		}
@@ -1115,24 +1273,22 @@ void AOWSHUD::RenderInteractiveInventoryGridUsingLockedSlotGroups(UOWSInventory*
 
 						if (Inventory && Inventory->IsValidLowLevel())
 						{
-							UOWSInventoryItemStack* InventoryItemStack = Inventory->GetStackInSlot(Slot);
-
-							AOWSInventoryItem* InventoryItem = InventoryItemStack->GetTopItemFromStack();
-							if (InventoryItem && InventoryItem->IsValidLowLevel())
+							const FOWSInventoryItemRecord* InventoryItem = Inventory->FindItemInSlot(Slot);
+							if (InventoryItem)
 							{
 								UTexture* Texture = InventoryItem->IconTexture;
 
-								if (InventoryItemStack->IsBeingDragged)
+								if (IsSlotBeingDragged(Inventory, Slot))
 								{
 									DrawTexture(EmptySlotTexture, Position->X, Position->Y, (float)iconWidth, (float)iconHeight, 0.0f, 0.0f, 1.0f, 1.0f);
 								}
 								else
 								{
 									DrawTexture(Texture, Position->X, Position->Y, (float)iconWidth, (float)iconHeight, 0.0f, 0.0f, 1.0f, 1.0f);
-									if (InventoryItemStack->InventoryItems.Num() > 1)
+									if (InventoryItem->Quantity > 1)
 									{
 										DrawTexture(Texture, Position->X + 5.0f, Position->Y, (float)iconWidth - 5.0f, (float)iconHeight - 5.0f, 0.0f, 0.0f, 1.0f, 1.0f);
-										const FString StackSizeText = FString::FromInt(InventoryItemStack->InventoryItems.Num());
+										const FString StackSizeText = FString::FromInt(InventoryItem->Quantity);
 										DrawText(StackSizeText, FLinearColor::White, Position->X + iconWidth - 15.0f, Position->Y + iconHeight - 20.0f);
 									}
 								}
@@ -1150,24 +1306,38 @@ void AOWSHUD::RenderInteractiveInventoryGridUsingLockedSlotGroups(UOWSInventory*
 		}
 	}
 
-	if (ItemStackBeingDragged && ItemStackBeingDragged->IsBeingDragged)
+	if (bIsDraggingItem)
 	{
-		AOWSInventoryItem* InventoryItem = ItemStackBeingDragged->GetTopItemFromStack();
-		if (InventoryItem && InventoryItem->IsValidLowLevel())
+		const FOWSInventoryItemRecord* InventoryItem = GetItemBeingDragged();
+		if (InventoryItem)
 		{
 			UTexture* Texture = InventoryItem->IconTexture;
 
 			DrawTexture(Texture, MouseLocation.X - (iconWidth / 2), MouseLocation.Y - (iconHeight / 2), (float)iconWidth, (float)iconHeight, 0.0f, 0.0f, 1.0f, 1.0f);
-			if (ItemStackBeingDragged->InventoryItems.Num() > 1)
+			if (InventoryItem->Quantity > 1)
 			{
 				DrawTexture(Texture, MouseLocation.X - (iconWidth / 2) + 5, MouseLocation.Y - (iconHeight / 2), (float)iconWidth - 5, (float)iconHeight - 5, 0.0f, 0.0f, 1.0f, 1.0f);
-				const FString StackSizeText = FString::FromInt(ItemStackBeingDragged->InventoryItems.Num());
+				const FString StackSizeText = FString::FromInt(InventoryItem->Quantity);
 				DrawText(StackSizeText, FLinearColor::White, MouseLocation.X - (iconWidth / 2) + iconWidth - 15.0f, MouseLocation.Y - (iconHeight / 2) + iconHeight - 20.0f);
 			}
 		}
 	}
 }
 
+bool AOWSHUD::IsSlotBeingDragged(const UOWSInventory* Inventory, int32 Slot) const
+{
+	return bIsDraggingItem && Slot == SlotBeingDraggedFrom && Inventory->InventoryName == InventoryBeingDraggedFrom;
+}
+
+const FOWSInventoryItemRecord* AOWSHUD::GetItemBeingDragged() const
+{
+	if (!bIsDraggingItem || !OWSChar)
+		return nullptr;
+
+	UOWSInventory* SourceInventory = OWSChar->GetHUDInventoryFromName(InventoryBeingDraggedFrom);
+	return SourceInventory ? SourceInventory->FindItemInSlot(SlotBeingDraggedFrom) : nullptr;
+}
+
 void AOWSHUD::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
@@ -1220,21 +1390,10 @@ void AOWSHUD::NotifyHitBoxClick(const FName BoxName)
 	}
 	else if (BoxName == "SplitStackButton")
 	{
-		if (InventoryItemStackToSplit)
+		//The server splits the stack and replicates both slots back
+		if (OWSChar)
 		{
-			UOWSInventory* Inventory = OWSChar->GetHUDInventoryFromName(InventoryBeingDraggedFrom);
-			if (Inventory)
-			{
-				AOWSInventoryItem* SplitItem = InventoryItemStackToSplit->RemoveFromTopOfStack();
-				if (SplitItem)
-				{
-					int32 Slot = Inventory->FindFirstEmptySlotToFitItemOfSize(SplitItem->IconSlotWidth, SplitItem->IconSlotHeight);
-					if (Slot != -1)
-					{
-						Inventory->AddItemToSlot(SplitItem, Slot);
-					}
-				}
-			}
+			OWSChar->Server_SplitInventoryStack(InventoryToSplitFrom, SlotToSplit, SplitNumber);
 		}
 		SplitDialogOpen = false;
 	}
@@ -1266,31 +1425,26 @@ void AOWSHUD::NotifyHitBoxClick(const FName BoxName)
 
 			if (Inventory)
 			{
-				UOWSInventoryItemStack* InventoryItemStack = Inventory->GetStackInSlot(Slot);
-				if (InventoryItemStack)
-				{
-					AOWSInventoryItem* ItemToStartDragging = InventoryItemStack->GetTopItemFromStack();
+				const FOWSInventoryItemRecord* ItemToStartDragging = Inventory->FindItemInSlot(Slot);
 
-					//Don't drag an empty slot
-					if (ItemToStartDragging)
+				//Don't drag an empty slot
+				if (ItemToStartDragging)
+				{
+					InventoryBeingDraggedFrom = InventoryName;
+					SlotBeingDraggedFrom = Slot;
+					bIsDraggingItem = true;
+					SlotsToShowWhileDragging.Empty();
+					if (ItemToStartDragging->IconSlotWidth > 1 || ItemToStartDragging->IconSlotHeight > 1)
 					{
-						InventoryBeingDraggedFrom = InventoryName;
-						SlotBeingDraggedFrom = Slot;
-						ItemStackBeingDragged = InventoryItemStack;
-						ItemStackBeingDragged->IsBeingDragged = true;
-						SlotsToShowWhileDragging.Empty();
-						if (ItemToStartDragging->IconSlotWidth > 1 || ItemToStartDragging->IconSlotHeight > 1)
-						{
-							float SlotNumberDividedByNumberOfColumns = Slot / Inventory->NumberOfColumns;
-							int32 StartingRow = FMath::FloorToInt(SlotNumberDividedByNumberOfColumns);
-							int32 StartingCol = Slot % Inventory->NumberOfColumns;
+						float SlotNumberDividedByNumberOfColumns = Slot / Inventory->NumberOfColumns;
+						int32 StartingRow = FMath::FloorToInt(SlotNumberDividedByNumberOfColumns);
+						int32 StartingCol = Slot % Inventory->NumberOfColumns;
 
-							for (int32 CurRow = StartingRow; CurRow < StartingRow + ItemToStartDragging->IconSlotHeight; CurRow++) {
-								for (int32 CurCol = StartingCol; CurCol < StartingCol + ItemToStartDragging->IconSlotWidth; CurCol++) {
-									if (CurRow != StartingRow || CurCol != StartingCol)
-									{
-										SlotsToShowWhileDragging.Add((CurRow * Inventory->NumberOfColumns) + CurCol);
-									}
+						for (int32 CurRow = StartingRow; CurRow < StartingRow + ItemToStartDragging->IconSlotHeight; CurRow++) {
+							for (int32 CurCol = StartingCol; CurCol < StartingCol + ItemToStartDragging->IconSlotWidth; CurCol++) {
+								if (CurRow != StartingRow || CurCol != StartingCol)
+								{
+									SlotsToShowWhileDragging.Add((CurRow * Inventory->NumberOfColumns) + CurCol);
 								}
 							}
 						}
@@ -1331,9 +1485,9 @@ void AOWSHUD::GetInput()
 
 	if (PC->WasInputKeyJustReleased(EKeys::LeftMouseButton))
 	{
-		if (ItemStackBeingDragged)
+		if (bIsDraggingItem)
 		{
-			ItemStackBeingDragged->IsBeingDragged = false;
+			bIsDraggingItem = false;
 			if (HitBoxesOver.Num() > 0)
 			{
 				FString BoxNameStr = HitBoxesOver.Array().Top().GetPlainNameString();
@@ -1342,45 +1496,11 @@ void AOWSHUD::GetInput()
 				int32 Slot = 0;
 				GetInventoryNameAndSlot(BoxName, InventoryName, Slot);
 				UOWSInventory* Inventory = OWSChar->GetHUDInventoryFromName(InventoryName);
-				if (Inventory)
+				UOWSInventory* SourceInventory = OWSChar->GetHUDInventoryFromName(InventoryBeingDraggedFrom);
+				if (Inventory && SourceInventory && (InventoryBeingDraggedFrom != InventoryName || Slot != SlotBeingDraggedFrom))
 				{
-					UOWSInventory* SourceInventory = OWSChar->GetHUDInventoryFromName(InventoryBeingDraggedFrom);
-					UOWSInventoryItemStack* InventoryItemStackSource = SourceInventory->GetStackInSlot(SlotBeingDraggedFrom);
-					UOWSInventoryItemStack* InventoryItemStackDest = Inventory->GetStackInSlot(Slot);
-
-					if (InventoryBeingDraggedFrom == InventoryName && Slot != SlotBeingDraggedFrom)
-					{
-						AOWSInventoryItem* SourceItem = InventoryItemStackSource->GetTopItemFromStack();
-						AOWSInventoryItem* DestItem = InventoryItemStackDest->GetTopItemFromStack();
-						if (DestItem)
-						{
-							if (SourceItem->UniqueItemGUID == DestItem->UniqueItemGUID
-								&& SourceItem->CanStack
-								&& InventoryItemStackDest->InventoryItems.Num() < DestItem->StackSize)
-							{
-								InventoryItemStackDest->AddToStack(InventoryItemStackSource);
-								SourceInventory->RemoveStackFromSlot(SlotBeingDraggedFrom);
-								OWSChar->SerializeAndSaveInventory(InventoryName);
-							}
-							else
-							{
-								Inventory->SwapSlots(Slot, SlotBeingDraggedFrom);
-								OWSChar->SerializeAndSaveInventory(InventoryName);
-							}
-						}
-						else
-						{
-							Inventory->SwapSlots(Slot, SlotBeingDraggedFrom);
-							OWSChar->SerializeAndSaveInventory(InventoryName);
-						}
-					}
-					else if (InventoryBeingDraggedFrom != InventoryName)
-					{
-						SourceInventory->AddStackToSlot(InventoryItemStackDest, SlotBeingDraggedFrom);
-						Inventory->AddStackToSlot(InventoryItemStackSource, Slot);
-						OWSChar->SerializeAndSaveInventory(InventoryName);
-					}
-
+					//Stacks onto the destination if it can, otherwise swaps.  The server makes the move and replicates the slots back.
+					OWSChar->Server_MoveInventorySlot(InventoryBeingDraggedFrom, SlotBeingDraggedFrom, InventoryName, Slot);
 				}
 			}
 		}
@@ -1432,10 +1552,15 @@ void AOWSHUD::GetInput()
 			UOWSInventory* Inventory = OWSChar->GetHUDInventoryFromName(InventoryName);
 			if (Inventory)
 			{
-				InventoryItemStackToSplit = Inventory->GetStackInSlot(Slot);
-				StackToSplitSize = InventoryItemStackToSplit->InventoryItems.Num();
+				const FOWSInventoryItemRecord* ItemToSplit = Inventory->FindItemInSlot(Slot);
+				InventoryToSplitFrom = InventoryName;
+				SlotToSplit = Slot;
+				StackToSplitSize = ItemToSplit ? ItemToSplit->Quantity : 0;
 				if (StackToSplitSize > 1)
+				{
+					SplitNumber = 1;
 					SplitDialogOpen = true;
+				}
 			}
 		}
 	}
@@ -3,25 +3,65 @@
 #include "OWSInventory.h"
 #include "OWSPlugin.h"
 #include "OWSGameMode.h"
+#include "Net/UnrealNetwork.h"
+
+void FOWSInventorySlotEntry::PreReplicatedRemove(const FOWSInventorySlotEntries& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnSlotRemoved(*this);
+	}
+}
+
+void FOWSInventorySlotEntry::PostReplicatedAdd(const FOWSInventorySlotEntries& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnSlotReplicated(*this);
+	}
+}
+
+void FOWSInventorySlotEntry::PostReplicatedChange(const FOWSInventorySlotEntries& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnSlotReplicated(*this);
+	}
+}
 
 UOWSInventory::UOWSInventory(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
-	//SetReplicates(true);
-	//bOnlyRelevantToOwner = true;
+	ReplicatedSlots.Owner = this;
+}
+
+void UOWSInventory::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	//AOWSCharacter registers inventories as owner only subobjects, so these only go to the owning client
+	DOREPLIFETIME(UOWSInventory, InventoryName);
+	DOREPLIFETIME(UOWSInventory, NumberOfGroupsUnlocked);
+	DOREPLIFETIME(UOWSInventory, SlotsPerGroup);
+	DOREPLIFETIME(UOWSInventory, NumberOfSlots);
+	DOREPLIFETIME(UOWSInventory, NumberOfColumns);
+	DOREPLIFETIME(UOWSInventory, ReplicatedSlots);
 }
 
 void UOWSInventory::SetInventorySize(int32 Size, int32 inNumberOfColumns)
 {
 	NumberOfSlots = Size;
 	this->NumberOfColumns = inNumberOfColumns;
-	InventoryItemStacks.Empty();
-	SlotsFilled.Empty();
-	for (int32 CurSlot = 0; CurSlot < Size; CurSlot++)
+	InventoryItemRecords.Reset();
+	InventoryItemRecords.SetNum(Size);
+	PerInstanceCustomData.Empty();
+	SlotsFilled.Reset(Size, inNumberOfColumns);
+
+	if (IsServerInventory())
 	{
-		UOWSInventoryItemStack* tempInventoryItemStack = NewObject<UOWSInventoryItemStack>();
-		InventoryItemStacks.Add(tempInventoryItemStack);
-		SlotsFilled.Add(false);
+		ReplicatedSlots.Items.Reset();
+		ReplicatedSlotIndices.Reset();
+		ReplicatedSlots.MarkArrayDirty();
 	}
 }
 
@@ -30,23 +70,13 @@ void UOWSInventory::SetInventoryName(FName inInventoryName)
 	InventoryName = inInventoryName;
 }
 
-void UOWSInventory::AddStackToSlot(UOWSInventoryItemStack* ItemStack, int32 Slot)
-{
-	if (InventoryItemStacks.IsValidIndex(Slot))
-	{
-		ItemStack->SlotNumber = Slot;
-		InventoryItemStacks[Slot] = ItemStack;
-		UpdateSlotsFilled();
-	}
-}
-
 void UOWSInventory::RemoveStackFromSlot(int32 Slot)
 {
-	if (InventoryItemStacks.IsValidIndex(Slot))
+	if (InventoryItemRecords.IsValidIndex(Slot))
 	{
-		UOWSInventoryItemStack* tempInventoryItemStack = NewObject<UOWSInventoryItemStack>();
-		InventoryItemStacks[Slot] = tempInventoryItemStack;
-		UpdateSlotsFilled();
+		ReleasePerInstanceCustomData(Slot);
+		InventoryItemRecords[Slot] = FOWSInventoryItemRecord();
+		RefreshSlot(Slot);
 	}
 }
 
@@ -61,8 +91,6 @@ bool UOWSInventory::AddItemToInventory(AOWSInventoryItem* Item)
 	int32 Slot = FindFirstEmptySlotToFitItemOfSize(Item->IconSlotWidth, Item->IconSlotHeight);
 	if (Slot != -1 && Slot < (NumberOfGroupsUnlocked * SlotsPerGroup)) //-1 = Full Inventory
 	{
-		//Add item on the server
-		//AddItemToSlot_Internal(Item, Slot);
 		//Call AddItemToInventory on OWSCharacter
 		FGuid UniqueItemGUID;
 
@@ -72,7 +100,15 @@ bool UOWSInventory::AddItemToInventory(AOWSInventoryItem* Item)
 		if (!OWSGameMode)
 			return false;
 
-		FInventoryItemStruct& ItemDefinition = OWSGameMode->FindItemDefinition(Item->ItemName);
+		const FInventoryItemStruct* FoundItemDefinition = OWSGameMode->FindItemDefinitionByName(FName(*Item->ItemName));
+
+		if (!FoundItemDefinition)
+		{
+			UE_LOG(OWS, Error, TEXT("UOWSInventory - AddItemToInventory - No item definition found for %s!"), *Item->ItemName);
+			return false;
+		}
+
+		const FInventoryItemStruct& ItemDefinition = *FoundItemDefinition;
 
 		bool bWasItemAdded = OwningPlayerCharacter->AddItemToLocalInventoryItems(Item->ItemName, ItemDefinition.ItemCanStack, ItemDefinition.IsUsable, ItemDefinition.IsConsumedOnUse, ItemDefinition.ItemTypeID,
 			ItemDefinition.TextureToUseForIcon, ItemDefinition.IconSlotWidth, ItemDefinition.IconSlotHeight, ItemDefinition.ItemMeshID, ItemDefinition.CustomData);
@@ -88,21 +124,40 @@ bool UOWSInventory::AddItemToInventory(AOWSInventoryItem* Item)
 
 		//Add item to server side inventory
 		OwningPlayerCharacter->AddItemToInventory(InventoryName.ToString(), Item->ItemName, Slot, Item->StackSize, Item->NumberOfUsesLeft, Item->Condition, UniqueItemGUID);
-		//Call the Owning client to add the item locally
-		OwningPlayerCharacter->Client_AddItemToInventory(InventoryName, Item->ItemName, Item->StackSize, Slot, Item->NumberOfUsesLeft, Item->Condition,
-			Item->PerInstanceCustomData, UniqueItemGUID, Item->ItemMeshID);
-		return true;
+
+		FOWSInventoryItemRecord PickedUpItem = Item->MakeInventoryRecord();
+		if (UniqueItemGUID.IsValid())
+		{
+			PickedUpItem.UniqueItemGUID = UniqueItemGUID;
+		}
+		PickedUpItem.bCanStack = ItemDefinition.ItemCanStack;
+		PickedUpItem.MaxStackSize = ItemDefinition.ItemStackSize;
+
+		//Add item on the server.  It reaches the owning client through ReplicatedSlots.
+		return AddItemToSlot_Internal(PickedUpItem, Item->PerInstanceCustomData, Slot);
 	}
 
 	return false;
 }
 
 //Can only be called on the Server side
-void UOWSInventory::AddItemToSlot(AOWSInventoryItem* Item, int32 Slot)
+void UOWSInventory::AddItemToSlot(const FOWSInventoryItemRecord& Item, const FString& InPerInstanceCustomData, int32 Slot)
 {	
 	UE_LOG(OWS, Warning, TEXT("UOWSInventory - AddItemToSlot Started"));
 
-	AddItemToSlot_Internal(Item, Slot);
+	if (!AddItemToSlot_Internal(Item, InPerInstanceCustomData, Slot))
+	{
+		//Slot holds something this stack can't go on top of, so put it in the first empty space that fits instead
+		const int32 EmptySlot = FindFirstEmptySlotToFitItemOfSize(Item.IconSlotWidth, Item.IconSlotHeight);
+
+		if (EmptySlot == -1 || !AddItemToSlot_Internal(Item, InPerInstanceCustomData, EmptySlot))
+		{
+			UE_LOG(OWS, Error, TEXT("UOWSInventory - AddItemToSlot - No room in %s for %d %s!"), *InventoryName.ToString(), Item.Quantity, *Item.ItemName.ToString());
+			return;
+		}
+	}
+
+	const FString ItemName = Item.ItemName.ToString();
 
 	//Replicate item definition if it does not already exist
 	AOWSGameMode* OWSGameMode = OwningPlayerCharacter->GetGameMode();
@@ -110,43 +165,56 @@ void UOWSInventory::AddItemToSlot(AOWSInventoryItem* Item, int32 Slot)
 	if (!OWSGameMode)
 		return;
 
-	FInventoryItemStruct& ItemDefinition = OWSGameMode->FindItemDefinition(Item->ItemName);
+	const FInventoryItemStruct* FoundItemDefinition = OWSGameMode->FindItemDefinitionByName(Item.ItemName);
+
+	if (!FoundItemDefinition)
+	{
+		UE_LOG(OWS, Error, TEXT("UOWSInventory - AddItemToSlot - No item definition found for %s!"), *ItemName);
+		return;
+	}
 
-	bool bWasItemAdded = OwningPlayerCharacter->AddItemToLocalInventoryItems(Item->ItemName, ItemDefinition.ItemCanStack, ItemDefinition.IsUsable, ItemDefinition.IsConsumedOnUse, ItemDefinition.ItemTypeID,
+	const FInventoryItemStruct& ItemDefinition = *FoundItemDefinition;
+
+	bool bWasItemAdded = OwningPlayerCharacter->AddItemToLocalInventoryItems(ItemName, ItemDefinition.ItemCanStack, ItemDefinition.IsUsable, ItemDefinition.IsConsumedOnUse, ItemDefinition.ItemTypeID,
 		ItemDefinition.TextureToUseForIcon, ItemDefinition.IconSlotWidth, ItemDefinition.IconSlotHeight, ItemDefinition.ItemMeshID, ItemDefinition.CustomData);
 
 	if (bWasItemAdded)
 	{
 		UE_LOG(OWS, Warning, TEXT("UOWSInventory - AddItemToSlot - AddItemMeshToAllPlayers Called"));
-		OwningPlayerCharacter->GetGameMode()->AddItemMeshToAllPlayers(Item->ItemName, ItemDefinition.ItemMeshID);
+		OwningPlayerCharacter->GetGameMode()->AddItemMeshToAllPlayers(ItemName, ItemDefinition.ItemMeshID);
 
-		OwningPlayerCharacter->Client_AddItemToLocalInventoryItems(Item->ItemName, ItemDefinition.ItemCanStack, ItemDefinition.IsUsable, ItemDefinition.IsConsumedOnUse, ItemDefinition.ItemTypeID,
+		OwningPlayerCharacter->Client_AddItemToLocalInventoryItems(ItemName, ItemDefinition.ItemCanStack, ItemDefinition.IsUsable, ItemDefinition.IsConsumedOnUse, ItemDefinition.ItemTypeID,
 			ItemDefinition.TextureToUseForIcon, ItemDefinition.IconSlotWidth, ItemDefinition.IconSlotHeight, ItemDefinition.ItemMeshID, ItemDefinition.CustomData);
 	}
 
-	//Call the Owning client to add the item locally
-	OwningPlayerCharacter->Client_AddItemToInventory(InventoryName, Item->ItemName, Item->StackSize, Slot, Item->NumberOfUsesLeft, Item->Condition,
-		Item->PerInstanceCustomData, Item->UniqueItemGUID, Item->ItemMeshID);
+	//The item itself reaches the owning client through ReplicatedSlots
 }
 
-void UOWSInventory::AddItemToSlot_Internal(AOWSInventoryItem* Item, int32 Slot)
+bool UOWSInventory::AddItemToSlot_Internal(const FOWSInventoryItemRecord& Item, const FString& InPerInstanceCustomData, int32 Slot)
 {
-	UOWSInventoryItemStack* InventoryItemStack = GetStackInSlot(Slot);
-	if (InventoryItemStack)
+	if (!InventoryItemRecords.IsValidIndex(Slot) || Item.IsEmpty())
+		return false;
+
+	FOWSInventoryItemRecord& SlotItem = InventoryItemRecords[Slot];
+
+	if (SlotItem.IsEmpty())
 	{
-		if (!InventoryItemStack->GetTopItemFromStack())
-		{
-			InventoryItemStack = NewObject<UOWSInventoryItemStack>();
-			InventoryItemStack->AddToStack(Item);
-			//Set the SlotNumber
-			InventoryItemStack->SlotNumber = Slot;
-			AddStackToSlot(InventoryItemStack, Slot);
-		}
-		else
-		{
-			InventoryItemStack->AddToStack(Item);
-		}
+		SlotItem = Item;
+		SlotItem.CustomDataHandle = AddPerInstanceCustomData(InPerInstanceCustomData);
+		RefreshSlot(Slot);
+		return true;
 	}
+
+	//Only add to the stack if nothing is lost doing it: the whole quantity has to fit and the custom data has to match
+	if (!SlotItem.CanStackWith(Item) || Item.Quantity > SlotItem.GetMaxStackSize() - SlotItem.Quantity || GetPerInstanceCustomData(SlotItem) != InPerInstanceCustomData)
+	{
+		UE_LOG(OWS, Warning, TEXT("UOWSInventory - AddItemToSlot_Internal - Slot %d in %s holds %d %s, can't add %d %s"), Slot, *InventoryName.ToString(), SlotItem.Quantity, *SlotItem.ItemName.ToString(), Item.Quantity, *Item.ItemName.ToString());
+		return false;
+	}
+
+	SlotItem.Quantity += Item.Quantity;
+	RefreshSlot(Slot);
+	return true;
 }
 
 
@@ -154,207 +222,444 @@ void UOWSInventory::AddItemsFromInventoryItemStruct(const TArray<FInventoryItemS
 {
 	UE_LOG(OWS, Warning, TEXT("UOWSInventory - AddItemsFromInventoryItemStruct"));
 
-	for (auto CurItem : ItemsToAdd)
+	for (const FInventoryItemStruct& CurItem : ItemsToAdd)
 	{
-		AOWSInventoryItem* ItemToAdd = NewObject<AOWSInventoryItem>();
+		FOWSInventoryItemRecord ItemToAdd;
+
+		ItemToAdd.ItemName = FName(*CurItem.ItemName);
+		ItemToAdd.UniqueItemGUID = CurItem.UniqueItemGUID;
+		ItemToAdd.Quantity = FMath::Max(CurItem.Quantity, 1);
+		ItemToAdd.MaxStackSize = CurItem.ItemStackSize;
+		ItemToAdd.Condition = CurItem.Condition;
+		ItemToAdd.NumberOfUsesLeft = CurItem.NumberOfUsesLeft;
+		ItemToAdd.ItemMeshID = CurItem.ItemMeshID;
+		ItemToAdd.IconSlotWidth = static_cast<uint8>(FMath::Clamp(CurItem.IconSlotWidth, 1, 255));
+		ItemToAdd.IconSlotHeight = static_cast<uint8>(FMath::Clamp(CurItem.IconSlotHeight, 1, 255));
+		ItemToAdd.bCanStack = CurItem.ItemCanStack;
+		ItemToAdd.IconTexture = CurItem.TextureIcon;
+
+		//The whole stack goes in at once
+		AddItemToSlot(ItemToAdd, CurItem.PerInstanceCustomData, CurItem.InSlotNumber);
+	}
+}
 
-		ItemToAdd->UniqueItemGUID = CurItem.UniqueItemGUID;
-		ItemToAdd->ItemName = CurItem.ItemName;
-		ItemToAdd->StackSize = CurItem.ItemStackSize;
-		ItemToAdd->Condition = CurItem.Condition;
-		ItemToAdd->IconTexture = CurItem.TextureIcon;
-		ItemToAdd->ItemMeshID = CurItem.ItemMeshID;
+FOWSInventoryItemRecord UOWSInventory::RemoveItemsFromSlot(int32 Slot, int32 Quantity, FString& OutPerInstanceCustomData)
+{
+	FOWSInventoryItemRecord RemovedItems;
+	OutPerInstanceCustomData.Empty();
 
-		for (int CurItemToAddToStack = 0; CurItemToAddToStack < FMath::Max(CurItem.Quantity, 1); CurItemToAddToStack++)
-		{
-			AddItemToSlot(ItemToAdd, CurItem.InSlotNumber);
-		}
+	if (!InventoryItemRecords.IsValidIndex(Slot) || InventoryItemRecords[Slot].IsEmpty() || Quantity <= 0)
+		return RemovedItems;
+
+	FOWSInventoryItemRecord& SlotItem = InventoryItemRecords[Slot];
+
+	RemovedItems = SlotItem;
+	RemovedItems.Quantity = FMath::Min(Quantity, SlotItem.Quantity);
+	RemovedItems.CustomDataHandle = INDEX_NONE;
+
+	if (RemovedItems.Quantity < SlotItem.Quantity)
+	{
+		SlotItem.Quantity -= RemovedItems.Quantity;
+		OutPerInstanceCustomData = GetPerInstanceCustomData(SlotItem);
+		RefreshSlot(Slot);
+	}
+	else
+	{
+		OutPerInstanceCustomData = ReleasePerInstanceCustomData(Slot);
+		SlotItem = FOWSInventoryItemRecord();
+		RefreshSlot(Slot);
 	}
+
+	return RemovedItems;
 }
 
-AOWSInventoryItem* UOWSInventory::RemoveOneItemFromSlot(int32 Slot)
+AOWSInventoryItem* UOWSInventory::DropItemsFromSlot(int32 Slot, int32 Quantity, const FTransform& SpawnTransform, TSubclassOf<AOWSInventoryItem> ItemClass)
 {
-	UOWSInventoryItemStack* InventoryItemStack = GetStackInSlot(Slot);
-	if (InventoryItemStack)
-	{
-		AOWSInventoryItem* InventoryItem = InventoryItemStack->GetTopItemFromStack();
-		if (InventoryItem)
-		{
-			AOWSInventoryItem* InventoryItemRemoved = InventoryItemStack->RemoveFromTopOfStack();
-			UpdateSlotsFilled();
-			return InventoryItemRemoved;
-		}
+	if (!OwningPlayerCharacter || !OwningPlayerCharacter->HasAuthority())
+		return nullptr;
+
+	UWorld* World = OwningPlayerCharacter->GetWorld();
 
+	if (!World)
 		return nullptr;
+
+	FString DroppedCustomData;
+	const FOWSInventoryItemRecord DroppedItems = RemoveItemsFromSlot(Slot, Quantity, DroppedCustomData);
+
+	if (DroppedItems.IsEmpty())
+		return nullptr;
+
+	//This is the only place an inventory creates an item actor
+	UClass* ClassToSpawn = ItemClass ? ItemClass.Get() : AOWSInventoryItem::StaticClass();
+	AOWSInventoryItem* DroppedItem = World->SpawnActorDeferred<AOWSInventoryItem>(ClassToSpawn, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+
+	if (DroppedItem)
+	{
+		DroppedItem->InitFromInventoryRecord(DroppedItems, DroppedCustomData);
+		DroppedItem->FinishSpawning(SpawnTransform);
 	}
 
-	return nullptr;
+	return DroppedItem;
 }
 
-void UOWSInventory::SwapSlots(int32 SlotA, int32 SlotB)
+bool UOWSInventory::SwapSlots(int32 SlotA, int32 SlotB)
 {
-	if (InventoryItemStacks.IsValidIndex(SlotA) && InventoryItemStacks.IsValidIndex(SlotB))
+	if (!InventoryItemRecords.IsValidIndex(SlotA) || !InventoryItemRecords.IsValidIndex(SlotB))
+		return false;
+
+	if (SlotA == SlotB)
+		return true;
+
+	const FIntPoint SizeA = GetSlotFootprint(SlotA);
+	const FIntPoint SizeB = GetSlotFootprint(SlotB);
+
+	//Lift both items off the grid, then place them one at a time so they can't land on top of each other either
+	SlotsFilled.ClearItemAt(SlotA);
+	SlotsFilled.ClearItemAt(SlotB);
+
+	bool bFits = DoesFootprintFitAt(SlotB, SizeA);
+
+	if (bFits)
+	{
+		SlotsFilled.SetItemAt(SlotB, SizeA.X, SizeA.Y);
+		bFits = DoesFootprintFitAt(SlotA, SizeB);
+		SlotsFilled.ClearItemAt(SlotB);
+	}
+
+	SlotsFilled.SetItemAt(SlotA, SizeA.X, SizeA.Y);
+	SlotsFilled.SetItemAt(SlotB, SizeB.X, SizeB.Y);
+
+	if (!bFits)
+	{
+		UE_LOG(OWS, Warning, TEXT("UOWSInventory - SwapSlots - Slots %d and %d in %s can't be swapped, an item would overlap another or run off the grid"), SlotA, SlotB, *InventoryName.ToString());
+		return false;
+	}
+
+	InventoryItemRecords.Swap(SlotA, SlotB);
+
+	RefreshSlot(SlotA);
+	RefreshSlot(SlotB);
+	return true;
+}
+
+bool UOWSInventory::SwapSlotWithInventory(int32 Slot, UOWSInventory* OtherInventory, int32 OtherSlot)
+{
+	if (OtherInventory == this)
 	{
-		//Change the SlotNumber's to their new values
-		InventoryItemStacks[SlotA]->SlotNumber = SlotB;
-		InventoryItemStacks[SlotB]->SlotNumber = SlotA;
-		//Then swap the locations in the TArray
-		InventoryItemStacks.Swap(SlotA, SlotB);
+		return SwapSlots(Slot, OtherSlot);
+	}
+
+	if (!OtherInventory || !InventoryItemRecords.IsValidIndex(Slot) || !OtherInventory->InventoryItemRecords.IsValidIndex(OtherSlot))
+		return false;
+
+	const FIntPoint Size = GetSlotFootprint(Slot);
+	const FIntPoint OtherSize = OtherInventory->GetSlotFootprint(OtherSlot);
+
+	//Each item only has to fit around the other items in the grid it is moving into
+	SlotsFilled.ClearItemAt(Slot);
+	OtherInventory->SlotsFilled.ClearItemAt(OtherSlot);
+
+	const bool bFits = OtherInventory->DoesFootprintFitAt(OtherSlot, Size) && DoesFootprintFitAt(Slot, OtherSize);
+
+	SlotsFilled.SetItemAt(Slot, Size.X, Size.Y);
+	OtherInventory->SlotsFilled.SetItemAt(OtherSlot, OtherSize.X, OtherSize.Y);
+
+	if (!bFits)
+	{
+		UE_LOG(OWS, Warning, TEXT("UOWSInventory - SwapSlotWithInventory - Slot %d in %s can't be swapped with slot %d in %s, an item would overlap another or run off the grid"), Slot, *InventoryName.ToString(), OtherSlot, *OtherInventory->InventoryName.ToString());
+		return false;
+	}
+
+	//Custom data handles are per inventory, so the strings have to move with the records
+	const FString CustomData = ReleasePerInstanceCustomData(Slot);
+	const FString OtherCustomData = OtherInventory->ReleasePerInstanceCustomData(OtherSlot);
+
+	Swap(InventoryItemRecords[Slot], OtherInventory->InventoryItemRecords[OtherSlot]);
+
+	InventoryItemRecords[Slot].CustomDataHandle = AddPerInstanceCustomData(OtherCustomData);
+	OtherInventory->InventoryItemRecords[OtherSlot].CustomDataHandle = OtherInventory->AddPerInstanceCustomData(CustomData);
 
-		UpdateSlotsFilled();
+	RefreshSlot(Slot);
+	OtherInventory->RefreshSlot(OtherSlot);
+	return true;
+}
+
+bool UOWSInventory::MergeSlots(int32 SourceSlot, int32 DestSlot)
+{
+	if (SourceSlot == DestSlot)
+		return false;
+
+	const FOWSInventoryItemRecord* SourceItem = FindItemInSlot(SourceSlot);
+	const FOWSInventoryItemRecord* DestItem = FindItemInSlot(DestSlot);
+
+	if (!SourceItem || !DestItem || !SourceItem->CanStackWith(*DestItem) || DestItem->Quantity >= DestItem->GetMaxStackSize()
+		|| GetPerInstanceCustomData(*SourceItem) != GetPerInstanceCustomData(*DestItem))
+		return false;
+
+	//Top up the destination stack and leave whatever doesn't fit in the source slot
+	const int32 QuantityToMove = FMath::Min(SourceItem->Quantity, DestItem->GetMaxStackSize() - DestItem->Quantity);
+
+	InventoryItemRecords[DestSlot].Quantity += QuantityToMove;
+	RefreshSlot(DestSlot);
+
+	if (QuantityToMove < SourceItem->Quantity)
+	{
+		InventoryItemRecords[SourceSlot].Quantity -= QuantityToMove;
+		RefreshSlot(SourceSlot);
 	}
+	else
+	{
+		RemoveStackFromSlot(SourceSlot);
+	}
+	return true;
 }
 
-UOWSInventoryItemStack* UOWSInventory::GetStackInSlot(int32 SlotNumber)
+const FOWSInventoryItemRecord* UOWSInventory::FindItemInSlot(int32 Slot) const
 {
-	if (InventoryItemStacks.Num() > 0 && InventoryItemStacks.IsValidIndex(SlotNumber))
+	if (InventoryItemRecords.IsValidIndex(Slot) && !InventoryItemRecords[Slot].IsEmpty())
 	{
-		return InventoryItemStacks[SlotNumber];
+		return &InventoryItemRecords[Slot];
 	}
 
 	return nullptr;
 }
 
+bool UOWSInventory::GetItemInSlot(int32 Slot, FOWSInventoryItemRecord& OutItem) const
+{
+	if (const FOWSInventoryItemRecord* FoundItem = FindItemInSlot(Slot))
+	{
+		OutItem = *FoundItem;
+		return true;
+	}
+
+	OutItem = FOWSInventoryItemRecord();
+	return false;
+}
+
+FString UOWSInventory::GetPerInstanceCustomData(const FOWSInventoryItemRecord& Item) const
+{
+	if (PerInstanceCustomData.IsValidIndex(Item.CustomDataHandle))
+	{
+		return PerInstanceCustomData[Item.CustomDataHandle];
+	}
+
+	return FString();
+}
+
+int32 UOWSInventory::AddPerInstanceCustomData(const FString& InPerInstanceCustomData)
+{
+	if (InPerInstanceCustomData.IsEmpty())
+		return INDEX_NONE;
+
+	return PerInstanceCustomData.Add(InPerInstanceCustomData);
+}
+
+FString UOWSInventory::ReleasePerInstanceCustomData(int32 Slot)
+{
+	FString ReleasedCustomData;
+	FOWSInventoryItemRecord& SlotItem = InventoryItemRecords[Slot];
+
+	if (PerInstanceCustomData.IsValidIndex(SlotItem.CustomDataHandle))
+	{
+		ReleasedCustomData = MoveTemp(PerInstanceCustomData[SlotItem.CustomDataHandle]);
+		PerInstanceCustomData.RemoveAt(SlotItem.CustomDataHandle);
+	}
+
+	SlotItem.CustomDataHandle = INDEX_NONE;
+	return ReleasedCustomData;
+}
+
 bool UOWSInventory::IsSlotFilled(int32 Slot)
 {
-	if (Slot < 0 || Slot >= NumberOfSlots)
-		return false;
+	return SlotsFilled.IsCellFilled(Slot);
+}
 
-	return SlotsFilled[Slot];
+void UOWSInventory::RefreshSlot(int32 Slot)
+{
+	UpdateSlotOccupancy(Slot);
+
+	if (IsServerInventory())
+	{
+		UpdateReplicatedSlot(Slot);
+	}
 }
 
-void UOWSInventory::UpdateSlotsFilled()
+void UOWSInventory::UpdateSlotOccupancy(int32 Slot)
 {
-	int32 Slot = 0;
-	for (TArray<UOWSInventoryItemStack*>::TConstIterator StackIter(InventoryItemStacks); StackIter; ++StackIter)
+	//On clients, slots can arrive before the layout.  OnRep_InventoryLayout rebuilds the grid once it does.
+	if (Slot < 0 || Slot >= SlotsFilled.GetNumberOfSlots())
+		return;
+
+	const FOWSInventoryItemRecord* ItemInSlot = FindItemInSlot(Slot);
+
+	if (ItemInSlot)
 	{
-		SlotsFilled[Slot] = false;
-		Slot++;
+		//Items with a width or height of 0 still take up their own slot
+		SlotsFilled.SetItemAt(Slot, FMath::Max<int32>(ItemInSlot->IconSlotWidth, 1), FMath::Max<int32>(ItemInSlot->IconSlotHeight, 1));
 	}
+	else
+	{
+		SlotsFilled.ClearItemAt(Slot);
+	}
+}
 
-	Slot = 0;
-	for (TArray<UOWSInventoryItemStack*>::TConstIterator StackIter(InventoryItemStacks); StackIter; ++StackIter)
+FIntPoint UOWSInventory::GetSlotFootprint(int32 Slot) const
+{
+	const FOWSInventoryItemRecord* ItemInSlot = FindItemInSlot(Slot);
+
+	if (!ItemInSlot)
+		return FIntPoint::ZeroValue;
+
+	//Same sizing as UpdateSlotOccupancy
+	return FIntPoint(FMath::Max<int32>(ItemInSlot->IconSlotWidth, 1), FMath::Max<int32>(ItemInSlot->IconSlotHeight, 1));
+}
+
+bool UOWSInventory::DoesFootprintFitAt(int32 Slot, const FIntPoint& Size) const
+{
+	//An empty slot can always be swapped into
+	return Size == FIntPoint::ZeroValue || SlotsFilled.CanFitAt(Slot, Size.X, Size.Y);
+}
+
+void UOWSInventory::UpdateSlotsFilled()
+{
+	SlotsFilled.Reset(InventoryItemRecords.Num(), NumberOfColumns);
+
+	for (int32 Slot = 0; Slot < InventoryItemRecords.Num(); Slot++)
 	{
-		AOWSInventoryItem* ItemInSlot = (*StackIter)->GetTopItemFromStack();
+		UpdateSlotOccupancy(Slot);
+	}
+}
 
-		if (ItemInSlot)
+bool UOWSInventory::IsServerInventory() const
+{
+	return OwningPlayerCharacter && OwningPlayerCharacter->HasAuthority();
+}
+
+void UOWSInventory::UpdateReplicatedSlot(int32 Slot)
+{
+	const FOWSInventoryItemRecord* ItemInSlot = FindItemInSlot(Slot);
+	const int32* ExistingIndex = ReplicatedSlotIndices.Find(Slot);
+
+	if (!ItemInSlot)
+	{
+		if (ExistingIndex)
 		{
-			SlotsFilled[Slot] = true;
+			const int32 RemovedIndex = *ExistingIndex;
+			ReplicatedSlotIndices.Remove(Slot);
+			ReplicatedSlots.Items.RemoveAtSwap(RemovedIndex);
 
-			if (ItemInSlot->IconSlotWidth > 1 || ItemInSlot->IconSlotHeight)
+			//The last entry moved into the hole
+			if (ReplicatedSlots.Items.IsValidIndex(RemovedIndex))
 			{
-				float SlotNumberDividedByNumberOfColumns = Slot / NumberOfColumns;
-				int32 StartingRow = FMath::FloorToInt(SlotNumberDividedByNumberOfColumns);
-				int32 StartingCol = Slot % NumberOfColumns;
-
-				for (int32 CurRow = StartingRow; CurRow < StartingRow + ItemInSlot->IconSlotHeight; CurRow++) {
-					for (int32 CurCol = StartingCol; CurCol < StartingCol + ItemInSlot->IconSlotWidth; CurCol++) {
-						if (CurRow != StartingRow || CurCol != StartingCol)
-						{
-							//SlotsFilled.EmplaceAt((CurRow * NumberOfColumns) + CurCol, true);
-							int32 SlotToSet = (CurRow * NumberOfColumns) + CurCol;
-							if (SlotToSet < 0 || SlotToSet >= NumberOfSlots)
-								continue;
-
-							SlotsFilled[SlotToSet] = true;
-						}
-					}
-				}
+				ReplicatedSlotIndices.Add(ReplicatedSlots.Items[RemovedIndex].SlotNumber, RemovedIndex);
 			}
+
+			ReplicatedSlots.MarkArrayDirty();
 		}
+		return;
+	}
 
-		Slot++;
+	FOWSInventorySlotEntry* Entry = nullptr;
+	if (ExistingIndex)
+	{
+		Entry = &ReplicatedSlots.Items[*ExistingIndex];
+	}
+	else
+	{
+		Entry = &ReplicatedSlots.Items.AddDefaulted_GetRef();
+		Entry->SlotNumber = Slot;
+		ReplicatedSlotIndices.Add(Slot, ReplicatedSlots.Items.Num() - 1);
 	}
+
+	Entry->Item = *ItemInSlot;
+	Entry->PerInstanceCustomData = GetPerInstanceCustomData(*ItemInSlot);
+	ReplicatedSlots.MarkItemDirty(*Entry);
 }
 
-int32 UOWSInventory::FindFirstEmptySlotToFitItemOfSize(int32 IconSlotWidth, int32 IconSlotHeight)
+void UOWSInventory::OnRep_InventoryLayout()
 {
-	int32 Slot = 0;
-
+	InventoryItemRecords.SetNum(NumberOfSlots);
 	UpdateSlotsFilled();
+}
 
-	Slot = 0;
-	for (TArray<UOWSInventoryItemStack*>::TConstIterator StackIter(InventoryItemStacks); StackIter; ++StackIter)
+void UOWSInventory::OnSlotReplicated(const FOWSInventorySlotEntry& Entry)
+{
+	const int32 Slot = Entry.SlotNumber;
+
+	if (Slot < 0)
+		return;
+
+	if (Slot >= InventoryItemRecords.Num())
 	{
-		AOWSInventoryItem* ItemInSlot = (*StackIter)->GetTopItemFromStack();
+		InventoryItemRecords.SetNum(Slot + 1);
+	}
 
-		bool SlotIsFilled = false;
+	ReleasePerInstanceCustomData(Slot);
 
-		if (!ItemInSlot)
-		{
-			if (SlotsFilled[Slot])
-			{
-				Slot++;
-				continue;
-			}
+	FOWSInventoryItemRecord& SlotItem = InventoryItemRecords[Slot];
+	SlotItem = Entry.Item;
+	SlotItem.CustomDataHandle = AddPerInstanceCustomData(Entry.PerInstanceCustomData);
+	ResolveIconTexture(SlotItem);
 
-			if (IconSlotWidth > 1 || IconSlotHeight)
-			{
-				float SlotDividedByNumberOfColumns = (float)Slot / (float)NumberOfColumns;
-				int32 StartingRow = FMath::FloorToInt(SlotDividedByNumberOfColumns);
-				int32 StartingCol = Slot % NumberOfColumns;
-
-				for (int32 CurRow = StartingRow; CurRow < StartingRow + IconSlotHeight; CurRow++) {
-					for (int32 CurCol = StartingCol; CurCol < StartingCol + IconSlotWidth; CurCol++) {
-						if (CurRow != StartingRow || CurCol != StartingCol)
-						{
-							//We are outside the bounds of the inventory on the right side
-							if (CurCol >= NumberOfColumns)
-							{
-								SlotIsFilled = true;
-								break;
-							}
-
-							//We are outside the bounds of the inventory on the bottom side
-							if (CurRow >= NumberOfColumns)
-							{
-								SlotIsFilled = true;
-								break;
-							}
-
-							int32 SlotToCheck = (CurRow * NumberOfColumns) + CurCol;
-							if (SlotToCheck < 0 || SlotToCheck >= NumberOfSlots)
-							{
-								continue;
-							}
-
-							if (SlotsFilled[SlotToCheck])
-							{
-								SlotIsFilled = true;
-								break;
-							}
-						}
-					}
-				}
-			}
-		}
-		else
-		{
-			Slot++;
-			continue;
-		}
+	UpdateSlotOccupancy(Slot);
+}
 
-		if (!SlotIsFilled)
+void UOWSInventory::OnSlotRemoved(const FOWSInventorySlotEntry& Entry)
+{
+	if (!InventoryItemRecords.IsValidIndex(Entry.SlotNumber))
+		return;
+
+	ReleasePerInstanceCustomData(Entry.SlotNumber);
+	InventoryItemRecords[Entry.SlotNumber] = FOWSInventoryItemRecord();
+	UpdateSlotOccupancy(Entry.SlotNumber);
+}
+
+void UOWSInventory::RefreshItemIcons(FName ItemName)
+{
+	for (FOWSInventoryItemRecord& Item : InventoryItemRecords)
+	{
+		if (!Item.IsEmpty() && Item.ItemName == ItemName)
 		{
-			return Slot;
+			ResolveIconTexture(Item);
 		}
+	}
+}
+
+void UOWSInventory::ResolveIconTexture(FOWSInventoryItemRecord& Item)
+{
+	//Replicated inventories are created with the character as their outer
+	if (!OwningPlayerCharacter)
+	{
+		OwningPlayerCharacter = Cast<AOWSCharacter>(GetOuter());
+	}
 
-		Slot++;
+	if (!OwningPlayerCharacter)
+		return;
+
+	const FInventoryItemStruct* FoundEntry = OwningPlayerCharacter->LocalInventoryItemCatalog.FindItem(OwningPlayerCharacter->LocalInventoryItems, Item.ItemName);
+	AOWSPlayerController* PlayerController = Cast<AOWSPlayerController>(OwningPlayerCharacter->GetController());
+
+	//The definition may not have arrived yet.  AOWSCharacter calls RefreshItemIcons when it does.
+	if (FoundEntry && PlayerController)
+	{
+		Item.IconTexture = PlayerController->LoadTextureReference(FoundEntry->TextureToUseForIcon);
 	}
+}
 
-	return -1; //Inventory is Full
+int32 UOWSInventory::FindFirstEmptySlotToFitItemOfSize(int32 IconSlotWidth, int32 IconSlotHeight)
+{
+	return SlotsFilled.FindFirstFit(IconSlotWidth, IconSlotHeight);
 }
 
 int32 UOWSInventory::FindItemIndex(FString ItemName)
 {
-	int32 Slot = 0;
-	for (TArray<UOWSInventoryItemStack*>::TConstIterator StackIter(InventoryItemStacks); StackIter; ++StackIter)
+	const FName ItemFName(*ItemName);
+	for (int32 Slot = 0; Slot < InventoryItemRecords.Num(); Slot++)
 	{
-		if ((*StackIter)->GetTopItemFromStack() && (*StackIter)->GetTopItemFromStack()->ItemName == ItemName)
+		if (!InventoryItemRecords[Slot].IsEmpty() && InventoryItemRecords[Slot].ItemName == ItemFName)
 		{
 			return Slot;
 		}
-		Slot++;
 	}
 
 	return -1; //Item not found
@@ -0,0 +1,173 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "OWSPlugin.h"
+#include "OWSInventoryOccupancy.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+namespace OWSInventoryBenchmark
+{
+	//The grid placement UOWSInventory used before FOWSInventoryOccupancy: rebuild one bool per slot from scratch, then test every candidate slot cell by cell
+	struct FLegacyInventoryGrid
+	{
+		int32 NumberOfSlots = 0;
+		int32 NumberOfColumns = 1;
+		TArray<FIntPoint> AnchoredItemSizes;
+		TArray<bool> SlotsFilled;
+
+		void Reset(int32 InNumberOfSlots, int32 InNumberOfColumns)
+		{
+			NumberOfSlots = InNumberOfSlots;
+			NumberOfColumns = InNumberOfColumns;
+			AnchoredItemSizes.Init(FIntPoint::ZeroValue, NumberOfSlots);
+			SlotsFilled.Init(false, NumberOfSlots);
+		}
+
+		void UpdateSlotsFilled()
+		{
+			for (int32 Slot = 0; Slot < NumberOfSlots; Slot++)
+			{
+				SlotsFilled[Slot] = false;
+			}
+
+			for (int32 Slot = 0; Slot < NumberOfSlots; Slot++)
+			{
+				const FIntPoint Size = AnchoredItemSizes[Slot];
+				for (int32 Row = Slot / NumberOfColumns; Row < Slot / NumberOfColumns + Size.Y; Row++)
+				{
+					for (int32 Column = Slot % NumberOfColumns; Column < Slot % NumberOfColumns + Size.X; Column++)
+					{
+						const int32 SlotToSet = Row * NumberOfColumns + Column;
+						if (SlotToSet < NumberOfSlots)
+						{
+							SlotsFilled[SlotToSet] = true;
+						}
+					}
+				}
+			}
+		}
+
+		int32 FindFirstFit(int32 Width, int32 Height)
+		{
+			UpdateSlotsFilled();
+
+			const int32 NumberOfRows = FMath::DivideAndRoundUp(NumberOfSlots, NumberOfColumns);
+
+			for (int32 Slot = 0; Slot < NumberOfSlots; Slot++)
+			{
+				bool bSlotIsFilled = false;
+
+				for (int32 Row = Slot / NumberOfColumns; Row < Slot / NumberOfColumns + Height && !bSlotIsFilled; Row++)
+				{
+					for (int32 Column = Slot % NumberOfColumns; Column < Slot % NumberOfColumns + Width; Column++)
+					{
+						const int32 SlotToCheck = Row * NumberOfColumns + Column;
+						if (Column >= NumberOfColumns || Row >= NumberOfRows || SlotToCheck >= NumberOfSlots || SlotsFilled[SlotToCheck])
+						{
+							bSlotIsFilled = true;
+							break;
+						}
+					}
+				}
+
+				if (!bSlotIsFilled)
+				{
+					return Slot;
+				}
+			}
+
+			return INDEX_NONE;
+		}
+
+		void SetItemAt(int32 Slot, int32 Width, int32 Height)
+		{
+			AnchoredItemSizes[Slot] = FIntPoint(Width, Height);
+		}
+	};
+
+	static const FIntPoint LootSizes[] = { FIntPoint(1, 1), FIntPoint(1, 1), FIntPoint(1, 1), FIntPoint(1, 2), FIntPoint(2, 1), FIntPoint(2, 2), FIntPoint(1, 3), FIntPoint(2, 3) };
+
+	//Fills a bag with random loot, then empties a few slots and refills, the way a bag churns during a loot heavy encounter.  Returns the sum of placed slots as a checksum.
+	template<typename GridType>
+	int64 RunBulkLootPickup(GridType& Grid, int32 NumberOfSlots, int32 NumberOfColumns, int32 Pickups, int32 Seed)
+	{
+		FRandomStream RandomStream(Seed);
+		TArray<int32> PlacedSlots;
+		int64 Checksum = 0;
+
+		Grid.Reset(NumberOfSlots, NumberOfColumns);
+
+		for (int32 Pickup = 0; Pickup < Pickups; Pickup++)
+		{
+			const FIntPoint Size = LootSizes[RandomStream.RandHelper(UE_ARRAY_COUNT(LootSizes))];
+			int32 Slot = Grid.FindFirstFit(Size.X, Size.Y);
+
+			if (Slot == INDEX_NONE && PlacedSlots.Num() > 0)
+			{
+				//Bag is full.  Sell something and try again.
+				const int32 SlotToEmpty = PlacedSlots[RandomStream.RandHelper(PlacedSlots.Num())];
+				PlacedSlots.RemoveSingleSwap(SlotToEmpty);
+				Grid.SetItemAt(SlotToEmpty, 0, 0);
+				Slot = Grid.FindFirstFit(Size.X, Size.Y);
+			}
+
+			if (Slot != INDEX_NONE)
+			{
+				Grid.SetItemAt(Slot, Size.X, Size.Y);
+				PlacedSlots.Add(Slot);
+				Checksum += Slot;
+			}
+		}
+
+		return Checksum;
+	}
+
+	static void BenchmarkGridPlacement(const TArray<FString>& Args)
+	{
+		const int32 NumberOfSlots = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 200;
+		const int32 NumberOfColumns = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 10;
+		const int32 Pickups = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 1000;
+		const int32 Iterations = Args.Num() > 3 ? FCString::Atoi(*Args[3]) : 100;
+
+		FLegacyInventoryGrid LegacyGrid;
+		FOWSInventoryOccupancy Occupancy;
+		int64 LegacyChecksum = 0;
+		int64 OccupancyChecksum = 0;
+
+		const double LegacyStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			LegacyChecksum += RunBulkLootPickup(LegacyGrid, NumberOfSlots, NumberOfColumns, Pickups, Iteration);
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - LegacyStart;
+
+		const double OccupancyStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			OccupancyChecksum += RunBulkLootPickup(Occupancy, NumberOfSlots, NumberOfColumns, Pickups, Iteration);
+		}
+		const double OccupancySeconds = FPlatformTime::Seconds() - OccupancyStart;
+
+		const double PickupCount = static_cast<double>(Pickups) * Iterations;
+
+		UE_LOG(OWS, Display, TEXT("OWS.Inventory.BenchmarkGridPlacement - %d slots, %d columns, %d pickups x %d iterations"), NumberOfSlots, NumberOfColumns, Pickups, Iterations);
+		UE_LOG(OWS, Display, TEXT("  Rebuild and scan:   %.3f ms total, %.3f us per pickup"), LegacySeconds * 1000.0, LegacySeconds * 1000000.0 / PickupCount);
+		UE_LOG(OWS, Display, TEXT("  Occupancy bitmask:  %.3f ms total, %.3f us per pickup"), OccupancySeconds * 1000.0, OccupancySeconds * 1000000.0 / PickupCount);
+
+		if (LegacyChecksum != OccupancyChecksum)
+		{
+			UE_LOG(OWS, Error, TEXT("  Placements differ! Rebuild and scan checksum %lld, occupancy bitmask checksum %lld"), LegacyChecksum, OccupancyChecksum);
+		}
+	}
+
+	static FAutoConsoleCommand BenchmarkGridPlacementCommand(
+		TEXT("OWS.Inventory.BenchmarkGridPlacement"),
+		TEXT("Compares inventory grid placement with and without the occupancy bitmask. Args: [Slots=200] [Columns=10] [Pickups=1000] [Iterations=100]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkGridPlacement));
+}
+
+#endif
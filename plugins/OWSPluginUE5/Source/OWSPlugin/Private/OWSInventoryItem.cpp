@@ -27,3 +27,34 @@ void AOWSInventoryItem::Tick(float DeltaTime)
 
 }
 
+
+FOWSInventoryItemRecord AOWSInventoryItem::MakeInventoryRecord() const
+{
+	FOWSInventoryItemRecord Record;
+	Record.ItemName = FName(*ItemName);
+	Record.UniqueItemGUID = UniqueItemGUID;
+	Record.Quantity = FMath::Max(StackSize, 1);
+	Record.Condition = Condition;
+	Record.NumberOfUsesLeft = NumberOfUsesLeft;
+	Record.ItemMeshID = ItemMeshID;
+	Record.IconSlotWidth = static_cast<uint8>(FMath::Clamp(IconSlotWidth, 1, 255));
+	Record.IconSlotHeight = static_cast<uint8>(FMath::Clamp(IconSlotHeight, 1, 255));
+	Record.bCanStack = CanStack;
+	Record.IconTexture = IconTexture;
+	return Record;
+}
+
+void AOWSInventoryItem::InitFromInventoryRecord(const FOWSInventoryItemRecord& Record, const FString& InPerInstanceCustomData)
+{
+	ItemName = Record.ItemName.ToString();
+	UniqueItemGUID = Record.UniqueItemGUID;
+	StackSize = Record.Quantity;
+	Condition = Record.Condition;
+	NumberOfUsesLeft = Record.NumberOfUsesLeft;
+	ItemMeshID = Record.ItemMeshID;
+	IconSlotWidth = Record.IconSlotWidth;
+	IconSlotHeight = Record.IconSlotHeight;
+	CanStack = Record.bCanStack;
+	IconTexture = Record.IconTexture;
+	PerInstanceCustomData = InPerInstanceCustomData;
+}
@@ -0,0 +1,213 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "OWSInventoryOccupancy.h"
+
+static uint64 MakeBitRun(int32 FirstBit, int32 Count)
+{
+	const uint64 Run = Count >= 64 ? ~0ull : ((1ull << Count) - 1);
+	return Run << FirstBit;
+}
+
+void FOWSInventoryOccupancy::Reset(int32 InNumberOfSlots, int32 InNumberOfColumns)
+{
+	NumberOfSlots = FMath::Max(InNumberOfSlots, 0);
+	NumberOfColumns = FMath::Max(InNumberOfColumns, 1);
+	NumberOfRows = FMath::DivideAndRoundUp(NumberOfSlots, NumberOfColumns);
+	WordsPerRow = FMath::DivideAndRoundUp(NumberOfColumns, 64);
+
+	RowBits.Init(0, NumberOfRows * WordsPerRow);
+	CellCoverCounts.Init(0, NumberOfSlots);
+	AnchoredItemSizes.Init(FIntPoint::ZeroValue, NumberOfSlots);
+	FirstFitCache.Reset();
+
+	//Cells past the end of a short last row can never be used
+	for (int32 Cell = NumberOfSlots; Cell < NumberOfRows * NumberOfColumns; Cell++)
+	{
+		const int32 Column = Cell % NumberOfColumns;
+		RowBits[(NumberOfRows - 1) * WordsPerRow + Column / 64] |= MakeBitRun(Column % 64, 1);
+	}
+}
+
+void FOWSInventoryOccupancy::SetItemAt(int32 Slot, int32 Width, int32 Height)
+{
+	if (!AnchoredItemSizes.IsValidIndex(Slot))
+	{
+		return;
+	}
+
+	const FIntPoint NewSize = (Width > 0 && Height > 0) ? FIntPoint(Width, Height) : FIntPoint::ZeroValue;
+	const FIntPoint OldSize = AnchoredItemSizes[Slot];
+
+	if (NewSize == OldSize)
+	{
+		return;
+	}
+
+	const int32 AnchorRow = Slot / NumberOfColumns;
+
+	if (OldSize != FIntPoint::ZeroValue)
+	{
+		AddFootprint(Slot, OldSize, -1);
+		InvalidateFirstFitCache(AnchorRow, FMath::Min(AnchorRow + OldSize.Y, NumberOfRows) - 1, true);
+	}
+
+	if (NewSize != FIntPoint::ZeroValue)
+	{
+		AddFootprint(Slot, NewSize, 1);
+		InvalidateFirstFitCache(AnchorRow, FMath::Min(AnchorRow + NewSize.Y, NumberOfRows) - 1, false);
+	}
+
+	AnchoredItemSizes[Slot] = NewSize;
+}
+
+void FOWSInventoryOccupancy::AddFootprint(int32 Slot, const FIntPoint& Size, int32 Delta)
+{
+	const int32 AnchorRow = Slot / NumberOfColumns;
+	const int32 AnchorColumn = Slot % NumberOfColumns;
+
+	//Anything hanging off the right or bottom edge is clipped
+	const int32 EndRow = FMath::Min(AnchorRow + Size.Y, NumberOfRows);
+	const int32 EndColumn = FMath::Min(AnchorColumn + Size.X, NumberOfColumns);
+
+	for (int32 Row = AnchorRow; Row < EndRow; Row++)
+	{
+		for (int32 Column = AnchorColumn; Column < EndColumn; Column++)
+		{
+			const int32 Cell = Row * NumberOfColumns + Column;
+			if (Cell >= NumberOfSlots)
+			{
+				continue;
+			}
+
+			uint16& CoverCount = CellCoverCounts[Cell];
+			CoverCount = static_cast<uint16>(FMath::Max(static_cast<int32>(CoverCount) + Delta, 0));
+
+			uint64& Word = RowBits[Row * WordsPerRow + Column / 64];
+			const uint64 Bit = MakeBitRun(Column % 64, 1);
+			Word = CoverCount > 0 ? (Word | Bit) : (Word & ~Bit);
+		}
+	}
+}
+
+void FOWSInventoryOccupancy::InvalidateFirstFitCache(int32 FirstRow, int32 LastRow, bool bCellsFreed)
+{
+	for (auto It = FirstFitCache.CreateIterator(); It; ++It)
+	{
+		const int32 Height = It.Key().Y;
+		const int32 CachedSlot = It.Value();
+
+		if (CachedSlot == INDEX_NONE)
+		{
+			//Filling cells can't make room where there was none
+			if (bCellsFreed)
+			{
+				It.RemoveCurrent();
+			}
+			continue;
+		}
+
+		const int32 CachedFirstRow = CachedSlot / NumberOfColumns;
+		const int32 CachedLastRow = CachedFirstRow + Height - 1;
+
+		//Freed cells can open up a spot at or before the cached one, but only if they are in a row the cached item or something anchored above it would cover.
+		//Filled cells only matter if they land on the cached spot.
+		const bool bAffected = bCellsFreed
+			? CachedLastRow >= FirstRow
+			: (CachedLastRow >= FirstRow && CachedFirstRow <= LastRow);
+
+		if (bAffected)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool FOWSInventoryOccupancy::IsRunFree(int32 Row, int32 FirstColumn, int32 Width) const
+{
+	int32 Column = FirstColumn;
+	int32 Remaining = Width;
+
+	while (Remaining > 0)
+	{
+		const int32 BitInWord = Column % 64;
+		const int32 BitsInThisWord = FMath::Min(Remaining, 64 - BitInWord);
+
+		if (RowBits[Row * WordsPerRow + Column / 64] & MakeBitRun(BitInWord, BitsInThisWord))
+		{
+			return false;
+		}
+
+		Column += BitsInThisWord;
+		Remaining -= BitsInThisWord;
+	}
+
+	return true;
+}
+
+bool FOWSInventoryOccupancy::IsCellFilled(int32 Slot) const
+{
+	if (Slot < 0 || Slot >= NumberOfSlots)
+	{
+		return false;
+	}
+
+	const int32 Column = Slot % NumberOfColumns;
+	return (RowBits[(Slot / NumberOfColumns) * WordsPerRow + Column / 64] & MakeBitRun(Column % 64, 1)) != 0;
+}
+
+bool FOWSInventoryOccupancy::CanFitAt(int32 Slot, int32 Width, int32 Height) const
+{
+	if (Slot < 0 || Slot >= NumberOfSlots)
+	{
+		return false;
+	}
+
+	Width = FMath::Max(Width, 1);
+	Height = FMath::Max(Height, 1);
+
+	const int32 AnchorRow = Slot / NumberOfColumns;
+	const int32 AnchorColumn = Slot % NumberOfColumns;
+
+	if (AnchorColumn + Width > NumberOfColumns || AnchorRow + Height > NumberOfRows)
+	{
+		return false;
+	}
+
+	for (int32 Row = AnchorRow; Row < AnchorRow + Height; Row++)
+	{
+		if (!IsRunFree(Row, AnchorColumn, Width))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int32 FOWSInventoryOccupancy::FindFirstFit(int32 Width, int32 Height)
+{
+	const FIntPoint Size(FMath::Max(Width, 1), FMath::Max(Height, 1));
+
+	if (const int32* CachedSlot = FirstFitCache.Find(Size))
+	{
+		return *CachedSlot;
+	}
+
+	int32 FoundSlot = INDEX_NONE;
+
+	for (int32 Row = 0; Row + Size.Y <= NumberOfRows && FoundSlot == INDEX_NONE; Row++)
+	{
+		for (int32 Column = 0; Column + Size.X <= NumberOfColumns; Column++)
+		{
+			const int32 Slot = Row * NumberOfColumns + Column;
+			if (CanFitAt(Slot, Size.X, Size.Y))
+			{
+				FoundSlot = Slot;
+				break;
+			}
+		}
+	}
+
+	FirstFitCache.Add(Size, FoundSlot);
+	return FoundSlot;
+}
@@ -0,0 +1,94 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "OWSItemCatalog.h"
+
+void FOWSItemCatalog::Rebuild(const TArray<FInventoryItemStruct>& Items)
+{
+	ItemIDsByName.Reset();
+	ItemIDsByName.Reserve(Items.Num());
+
+	for (int32 ItemID = 0; ItemID < Items.Num(); ItemID++)
+	{
+		//First definition wins, same as the linear search this replaces
+		const FName ItemName(*Items[ItemID].ItemName);
+		if (!ItemIDsByName.Contains(ItemName))
+		{
+			ItemIDsByName.Add(ItemName, ItemID);
+		}
+	}
+
+	IndexedItemCount = Items.Num();
+}
+
+int32 FOWSItemCatalog::FindItemID(const TArray<FInventoryItemStruct>& Items, const FName ItemName)
+{
+	if (IndexedItemCount != Items.Num())
+	{
+		Rebuild(Items);
+	}
+
+	if (ItemName.IsNone())
+	{
+		return InvalidItemID;
+	}
+
+	const int32* FoundItemID = ItemIDsByName.Find(ItemName);
+
+	//Renaming a definition to ItemName doesn't change the count, so check a miss against the array before trusting it.  Misses are rare.
+	if (!FoundItemID)
+	{
+		const FString ItemNameString = ItemName.ToString();
+		for (const FInventoryItemStruct& Item : Items)
+		{
+			if (Item.ItemName.Equals(ItemNameString, ESearchCase::IgnoreCase))
+			{
+				Rebuild(Items);
+				FoundItemID = ItemIDsByName.Find(ItemName);
+				return FoundItemID ? *FoundItemID : InvalidItemID;
+			}
+		}
+
+		return InvalidItemID;
+	}
+
+	//The array was changed behind our back
+	if (!Items.IsValidIndex(*FoundItemID) || FName(*Items[*FoundItemID].ItemName) != ItemName)
+	{
+		Rebuild(Items);
+		FoundItemID = ItemIDsByName.Find(ItemName);
+		return FoundItemID ? *FoundItemID : InvalidItemID;
+	}
+
+	return *FoundItemID;
+}
+
+FInventoryItemStruct* FOWSItemCatalog::FindItem(TArray<FInventoryItemStruct>& Items, const FName ItemName)
+{
+	const int32 ItemID = FindItemID(Items, ItemName);
+	return ItemID != InvalidItemID ? &Items[ItemID] : nullptr;
+}
+
+const FInventoryItemStruct* FOWSItemCatalog::FindItem(const TArray<FInventoryItemStruct>& Items, const FName ItemName)
+{
+	const int32 ItemID = FindItemID(Items, ItemName);
+	return ItemID != InvalidItemID ? &Items[ItemID] : nullptr;
+}
+
+int32 FOWSItemCatalog::Add(TArray<FInventoryItemStruct>& Items, const FInventoryItemStruct& Item)
+{
+	if (IndexedItemCount != Items.Num())
+	{
+		Rebuild(Items);
+	}
+
+	const int32 ItemID = Items.Add(Item);
+	const FName ItemName(*Item.ItemName);
+
+	if (!ItemIDsByName.Contains(ItemName))
+	{
+		ItemIDsByName.Add(ItemName, ItemID);
+	}
+
+	IndexedItemCount = Items.Num();
+	return ItemID;
+}
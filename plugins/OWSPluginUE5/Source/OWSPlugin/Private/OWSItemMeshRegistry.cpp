@@ -0,0 +1,88 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "OWSItemMeshRegistry.h"
+#include "OWSPlugin.h"
+#include "OWSGameInstance.h"
+#include "Net/UnrealNetwork.h"
+
+void FOWSItemMeshEntry::PostReplicatedAdd(const FOWSItemMeshEntries& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnItemMeshReplicated(*this);
+	}
+}
+
+void FOWSItemMeshEntry::PostReplicatedChange(const FOWSItemMeshEntries& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnItemMeshReplicated(*this);
+	}
+}
+
+AOWSItemMeshRegistry::AOWSItemMeshRegistry()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	//Entries only arrive when a new item is first seen, so there is nothing to check most frames
+	SetNetUpdateFrequency(1.f);
+
+	ItemMeshes.Owner = this;
+}
+
+void AOWSItemMeshRegistry::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AOWSItemMeshRegistry, ItemMeshes);
+}
+
+void AOWSItemMeshRegistry::AddItemMesh(const FString& ItemName, int32 ItemMeshID)
+{
+	if (int32* ExistingIndex = ItemMeshIndices.Find(ItemName))
+	{
+		FOWSItemMeshEntry& Entry = ItemMeshes.Items[*ExistingIndex];
+		if (Entry.ItemMeshID != ItemMeshID)
+		{
+			Entry.ItemMeshID = ItemMeshID;
+			ItemMeshes.MarkItemDirty(Entry);
+			ForceNetUpdate();
+		}
+		return;
+	}
+
+	FOWSItemMeshEntry& Entry = ItemMeshes.Items.AddDefaulted_GetRef();
+	Entry.ItemName = ItemName;
+	Entry.ItemMeshID = ItemMeshID;
+	ItemMeshes.MarkItemDirty(Entry);
+	ItemMeshIndices.Add(ItemName, ItemMeshes.Items.Num() - 1);
+
+	//Clients may need the mesh for the item that was just picked up
+	ForceNetUpdate();
+}
+
+int32 AOWSItemMeshRegistry::FindItemMeshID(const FString& ItemName) const
+{
+	if (const int32* Index = ItemMeshIndices.Find(ItemName))
+	{
+		return ItemMeshes.Items[*Index].ItemMeshID;
+	}
+
+	return INDEX_NONE;
+}
+
+void AOWSItemMeshRegistry::OnItemMeshReplicated(const FOWSItemMeshEntry& Entry)
+{
+	//Entry is always an element of ItemMeshes.Items
+	ItemMeshIndices.Add(Entry.ItemName, UE_PTRDIFF_TO_INT32(&Entry - ItemMeshes.Items.GetData()));
+
+	UOWSGameInstance* GameInstance = Cast<UOWSGameInstance>(GetGameInstance());
+
+	if (!GameInstance)
+		return;
+
+	GameInstance->LocalMeshItemsMap.Add(Entry.ItemName, Entry.ItemMeshID);
+}
@@ -0,0 +1,799 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "OWSJsonStructReader.h"
+#include "OWSPlugin.h"
+#include "UObject/UnrealType.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "Misc/ScopeRWLock.h"
+#include "Containers/StringConv.h"
+
+namespace OWSJsonStructReader
+{
+	//Guards against stack exhaustion on hostile or corrupt responses
+	static constexpr int32 MaxDepth = 64;
+
+	FORCEINLINE uint32 FoldASCIICase(uint32 Char)
+	{
+		return (Char >= 'A' && Char <= 'Z') ? Char + ('a' - 'A') : Char;
+	}
+
+	//FNV-1a with ASCII case folding, so a raw UTF-8 field name and a TCHAR property name hash the same
+	template <typename CharType>
+	uint32 HashName(const CharType* Name, int32 Length)
+	{
+		uint32 Hash = 2166136261u;
+		for (int32 Index = 0; Index < Length; Index++)
+		{
+			Hash = (Hash ^ FoldASCIICase((uint32)Name[Index])) * 16777619u;
+		}
+		return Hash;
+	}
+
+	template <typename CharType>
+	bool NameEquals(const FString& PropertyName, const CharType* Name, int32 Length)
+	{
+		if (PropertyName.Len() != Length)
+		{
+			return false;
+		}
+
+		const TCHAR* PropertyNameChars = *PropertyName;
+		for (int32 Index = 0; Index < Length; Index++)
+		{
+			if (FoldASCIICase((uint32)PropertyNameChars[Index]) != FoldASCIICase((uint32)Name[Index]))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//Name to property lookup for one struct type, built once and shared by every read of that type
+	struct FPropertyCache
+	{
+		TWeakObjectPtr<const UStruct> Struct;
+		TArray<FString> PropertyNames;
+		TArray<FProperty*> Properties;
+		TMultiMap<uint32, int32> PropertyIndicesByHash;
+
+		explicit FPropertyCache(const UStruct* InStruct)
+			: Struct(InStruct)
+		{
+			for (TFieldIterator<FProperty> PropertyIt(InStruct); PropertyIt; ++PropertyIt)
+			{
+				FString PropertyName = PropertyIt->GetName();
+
+				//First property wins if two only differ by case
+				if (FindProperty(*PropertyName, PropertyName.Len()))
+				{
+					continue;
+				}
+
+				const int32 PropertyIndex = Properties.Add(*PropertyIt);
+				PropertyIndicesByHash.Add(HashName(*PropertyName, PropertyName.Len()), PropertyIndex);
+				PropertyNames.Add(MoveTemp(PropertyName));
+			}
+		}
+
+		template <typename CharType>
+		FProperty* FindProperty(const CharType* Name, int32 Length) const
+		{
+			for (TMultiMap<uint32, int32>::TConstKeyIterator It(PropertyIndicesByHash, HashName(Name, Length)); It; ++It)
+			{
+				if (NameEquals(PropertyNames[It.Value()], Name, Length))
+				{
+					return Properties[It.Value()];
+				}
+			}
+			return nullptr;
+		}
+	};
+
+	static FRWLock PropertyCachesLock;
+	static TMap<const UStruct*, TSharedPtr<FPropertyCache, ESPMode::ThreadSafe>> PropertyCaches;
+
+	TSharedPtr<FPropertyCache, ESPMode::ThreadSafe> GetPropertyCache(const UStruct* Struct)
+	{
+		{
+			FReadScopeLock ReadLock(PropertyCachesLock);
+			const TSharedPtr<FPropertyCache, ESPMode::ThreadSafe>* FoundCache = PropertyCaches.Find(Struct);
+			//A struct that was unloaded and had its address reused gets a fresh cache
+			if (FoundCache && (*FoundCache)->Struct.Get() == Struct)
+			{
+				return *FoundCache;
+			}
+		}
+
+		TSharedPtr<FPropertyCache, ESPMode::ThreadSafe> NewCache = MakeShared<FPropertyCache, ESPMode::ThreadSafe>(Struct);
+		FWriteScopeLock WriteLock(PropertyCachesLock);
+		PropertyCaches.Add(Struct, NewCache);
+		return NewCache;
+	}
+
+	//Single pass pull parser over a UTF-8 buffer
+	class FReader
+	{
+	public:
+		FReader(TConstArrayView<uint8> Utf8Json)
+			: Cursor(Utf8Json.GetData())
+			, End(Utf8Json.GetData() + Utf8Json.Num())
+		{
+			//Skip a UTF-8 byte order mark
+			if (End - Cursor >= 3 && Cursor[0] == 0xEF && Cursor[1] == 0xBB && Cursor[2] == 0xBF)
+			{
+				Cursor += 3;
+			}
+		}
+
+		bool ReadStruct(const UStruct* Struct, void* OutStruct, int32 Depth)
+		{
+			if (Depth > MaxDepth || !Consume('{'))
+			{
+				return false;
+			}
+			if (Consume('}'))
+			{
+				return true;
+			}
+
+			const TSharedPtr<FPropertyCache, ESPMode::ThreadSafe> PropertyCache = GetPropertyCache(Struct);
+
+			do
+			{
+				const uint8* Name = nullptr;
+				int32 NameLength = 0;
+				bool bNameHasEscapes = false;
+				if (!ReadRawString(Name, NameLength, bNameHasEscapes) || !Consume(':'))
+				{
+					return false;
+				}
+
+				FProperty* Property = nullptr;
+				if (bNameHasEscapes)
+				{
+					FString DecodedName;
+					DecodeString(Name, NameLength, true, DecodedName);
+					Property = PropertyCache->FindProperty(*DecodedName, DecodedName.Len());
+				}
+				else
+				{
+					Property = PropertyCache->FindProperty(Name, NameLength);
+				}
+
+				const bool bRead = Property
+					? ReadValue(Property, Property->ContainerPtrToValuePtr<void>(OutStruct), Depth + 1)
+					: SkipValue(Depth + 1);
+				if (!bRead)
+				{
+					return false;
+				}
+			} while (Consume(','));
+
+			return Consume('}');
+		}
+
+		bool ReadStructArray(const UStruct* Struct, TFunctionRef<void* ()> AddElement)
+		{
+			if (!Consume('['))
+			{
+				return false;
+			}
+			if (Consume(']'))
+			{
+				return true;
+			}
+
+			do
+			{
+				if (!ReadStruct(Struct, AddElement(), 1))
+				{
+					return false;
+				}
+			} while (Consume(','));
+
+			return Consume(']');
+		}
+
+		bool ReadArrayElements(TArray<FString>& OutElements)
+		{
+			if (!Consume('['))
+			{
+				return false;
+			}
+			if (Consume(']'))
+			{
+				return true;
+			}
+
+			do
+			{
+				SkipWhitespace();
+				const uint8* ElementStart = Cursor;
+				if (!SkipValue(1))
+				{
+					return false;
+				}
+				FUTF8ToTCHAR Element(reinterpret_cast<const ANSICHAR*>(ElementStart), UE_PTRDIFF_TO_INT32(Cursor - ElementStart));
+				OutElements.Emplace(Element.Length(), Element.Get());
+			} while (Consume(','));
+
+			return Consume(']');
+		}
+
+		bool AtEnd()
+		{
+			SkipWhitespace();
+			return Cursor == End;
+		}
+
+	private:
+		const uint8* Cursor;
+		const uint8* End;
+
+		//Reused for string values that don't land directly in an FString property
+		FString ScratchString;
+
+		void SkipWhitespace()
+		{
+			while (Cursor < End && (*Cursor == ' ' || *Cursor == '\t' || *Cursor == '\n' || *Cursor == '\r'))
+			{
+				++Cursor;
+			}
+		}
+
+		uint8 Peek()
+		{
+			SkipWhitespace();
+			return Cursor < End ? *Cursor : 0;
+		}
+
+		bool Consume(uint8 Char)
+		{
+			if (Peek() == Char)
+			{
+				++Cursor;
+				return true;
+			}
+			return false;
+		}
+
+		bool ReadLiteral(const ANSICHAR* Literal)
+		{
+			SkipWhitespace();
+			const uint8* LiteralCursor = Cursor;
+			for (; *Literal; ++Literal, ++LiteralCursor)
+			{
+				if (LiteralCursor >= End || *LiteralCursor != (uint8)*Literal)
+				{
+					return false;
+				}
+			}
+			Cursor = LiteralCursor;
+			return true;
+		}
+
+		//Returns the bytes between the quotes without decoding them
+		bool ReadRawString(const uint8*& OutStart, int32& OutLength, bool& bOutHasEscapes)
+		{
+			if (!Consume('"'))
+			{
+				return false;
+			}
+
+			OutStart = Cursor;
+			bOutHasEscapes = false;
+			while (Cursor < End && *Cursor != '"')
+			{
+				if (*Cursor == '\\')
+				{
+					bOutHasEscapes = true;
+					if (++Cursor >= End)
+					{
+						break;
+					}
+				}
+				++Cursor;
+			}
+
+			if (Cursor >= End)
+			{
+				return false;
+			}
+
+			OutLength = UE_PTRDIFF_TO_INT32(Cursor - OutStart);
+			++Cursor;
+			return true;
+		}
+
+		static void AppendUTF8(const uint8* Start, int32 Length, FString& Out)
+		{
+			if (Length > 0)
+			{
+				FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Start), Length);
+				Out.AppendChars(Converted.Get(), Converted.Length());
+			}
+		}
+
+		static void AppendCodePoint(uint32 CodePoint, FString& Out)
+		{
+			if (sizeof(TCHAR) == 2 && CodePoint > 0xFFFF)
+			{
+				CodePoint -= 0x10000;
+				Out.AppendChar((TCHAR)(0xD800 + (CodePoint >> 10)));
+				Out.AppendChar((TCHAR)(0xDC00 + (CodePoint & 0x3FF)));
+			}
+			else
+			{
+				Out.AppendChar((TCHAR)CodePoint);
+			}
+		}
+
+		static bool ParseHex4(const uint8* Start, const uint8* Limit, uint32& OutValue)
+		{
+			if (Limit - Start < 4)
+			{
+				return false;
+			}
+
+			OutValue = 0;
+			for (int32 Index = 0; Index < 4; Index++)
+			{
+				const uint8 Char = Start[Index];
+				uint32 Digit;
+				if (Char >= '0' && Char <= '9') Digit = Char - '0';
+				else if (Char >= 'a' && Char <= 'f') Digit = Char - 'a' + 10;
+				else if (Char >= 'A' && Char <= 'F') Digit = Char - 'A' + 10;
+				else return false;
+				OutValue = (OutValue << 4) | Digit;
+			}
+			return true;
+		}
+
+		static void DecodeString(const uint8* Start, int32 Length, bool bHasEscapes, FString& Out)
+		{
+			Out.Reset(Length);
+
+			if (!bHasEscapes)
+			{
+				AppendUTF8(Start, Length, Out);
+				return;
+			}
+
+			const uint8* Limit = Start + Length;
+			const uint8* RunStart = Start;
+			const uint8* Char = Start;
+			while (Char < Limit)
+			{
+				if (*Char != '\\' || Char + 1 >= Limit)
+				{
+					++Char;
+					continue;
+				}
+
+				AppendUTF8(RunStart, UE_PTRDIFF_TO_INT32(Char - RunStart), Out);
+
+				const uint8 Escape = Char[1];
+				Char += 2;
+				switch (Escape)
+				{
+				case 'b': Out.AppendChar(TEXT('\b')); break;
+				case 'f': Out.AppendChar(TEXT('\f')); break;
+				case 'n': Out.AppendChar(TEXT('\n')); break;
+				case 'r': Out.AppendChar(TEXT('\r')); break;
+				case 't': Out.AppendChar(TEXT('\t')); break;
+				case 'u':
+				{
+					uint32 CodePoint = 0;
+					if (!ParseHex4(Char, Limit, CodePoint))
+					{
+						break;
+					}
+					Char += 4;
+
+					//Combine surrogate pairs into one code point
+					uint32 LowSurrogate = 0;
+					if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && Limit - Char >= 6 && Char[0] == '\\' && Char[1] == 'u'
+						&& ParseHex4(Char + 2, Limit, LowSurrogate) && LowSurrogate >= 0xDC00 && LowSurrogate <= 0xDFFF)
+					{
+						CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+						Char += 6;
+					}
+					AppendCodePoint(CodePoint, Out);
+					break;
+				}
+				default: Out.AppendChar((TCHAR)Escape); break;
+				}
+
+				RunStart = Char;
+			}
+
+			AppendUTF8(RunStart, UE_PTRDIFF_TO_INT32(Limit - RunStart), Out);
+		}
+
+		bool ReadString(FString& Out)
+		{
+			const uint8* Start = nullptr;
+			int32 Length = 0;
+			bool bHasEscapes = false;
+			if (!ReadRawString(Start, Length, bHasEscapes))
+			{
+				return false;
+			}
+			DecodeString(Start, Length, bHasEscapes, Out);
+			return true;
+		}
+
+		bool ReadNumber(const uint8*& OutStart, int32& OutLength, bool& bOutIsInteger)
+		{
+			SkipWhitespace();
+			OutStart = Cursor;
+			bOutIsInteger = true;
+			while (Cursor < End)
+			{
+				const uint8 Char = *Cursor;
+				if (Char == '.' || Char == 'e' || Char == 'E')
+				{
+					bOutIsInteger = false;
+				}
+				else if (!((Char >= '0' && Char <= '9') || Char == '-' || Char == '+'))
+				{
+					break;
+				}
+				++Cursor;
+			}
+			OutLength = UE_PTRDIFF_TO_INT32(Cursor - OutStart);
+			return OutLength > 0;
+		}
+
+		static double NumberToDouble(const uint8* Start, int32 Length)
+		{
+			TCHAR Buffer[64];
+			const int32 CopyLength = FMath::Min(Length, (int32)UE_ARRAY_COUNT(Buffer) - 1);
+			for (int32 Index = 0; Index < CopyLength; Index++)
+			{
+				Buffer[Index] = (TCHAR)Start[Index];
+			}
+			Buffer[CopyLength] = TEXT('\0');
+			return FCString::Atod(Buffer);
+		}
+
+		static int64 NumberToInt64(const uint8* Start, int32 Length, bool bIsInteger)
+		{
+			if (!bIsInteger)
+			{
+				return (int64)NumberToDouble(Start, Length);
+			}
+
+			const bool bNegative = Length > 0 && Start[0] == '-';
+			uint64 Value = 0;
+			for (int32 Index = bNegative ? 1 : 0; Index < Length; Index++)
+			{
+				Value = Value * 10 + (Start[Index] - '0');
+			}
+			return bNegative ? -(int64)Value : (int64)Value;
+		}
+
+		bool SkipValue(int32 Depth)
+		{
+			if (Depth > MaxDepth)
+			{
+				return false;
+			}
+
+			switch (Peek())
+			{
+			case '"':
+			{
+				const uint8* Start = nullptr;
+				int32 Length = 0;
+				bool bHasEscapes = false;
+				return ReadRawString(Start, Length, bHasEscapes);
+			}
+			case '{':
+				++Cursor;
+				if (Consume('}'))
+				{
+					return true;
+				}
+				do
+				{
+					const uint8* Name = nullptr;
+					int32 NameLength = 0;
+					bool bNameHasEscapes = false;
+					if (!ReadRawString(Name, NameLength, bNameHasEscapes) || !Consume(':') || !SkipValue(Depth + 1))
+					{
+						return false;
+					}
+				} while (Consume(','));
+				return Consume('}');
+			case '[':
+				++Cursor;
+				if (Consume(']'))
+				{
+					return true;
+				}
+				do
+				{
+					if (!SkipValue(Depth + 1))
+					{
+						return false;
+					}
+				} while (Consume(','));
+				return Consume(']');
+			case 't':
+				return ReadLiteral("true");
+			case 'f':
+				return ReadLiteral("false");
+			case 'n':
+				return ReadLiteral("null");
+			default:
+			{
+				const uint8* Start = nullptr;
+				int32 Length = 0;
+				bool bIsInteger = false;
+				return ReadNumber(Start, Length, bIsInteger);
+			}
+			}
+		}
+
+		bool ReadValue(FProperty* Property, void* ValuePtr, int32 Depth)
+		{
+			if (Depth > MaxDepth)
+			{
+				return false;
+			}
+
+			const uint8 Next = Peek();
+
+			//Null leaves the property at its default
+			if (Next == 'n')
+			{
+				return ReadLiteral("null");
+			}
+
+			if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+			{
+				if (Next != '[')
+				{
+					UE_LOG(OWS, Verbose, TEXT("FOWSJsonStructReader - Expected an array for %s, skipping."), *Property->GetName());
+					return SkipValue(Depth);
+				}
+
+				FScriptArrayHelper ArrayHelper(ArrayProperty, ValuePtr);
+				ArrayHelper.EmptyValues();
+				++Cursor;
+				if (Consume(']'))
+				{
+					return true;
+				}
+				do
+				{
+					const int32 ElementIndex = ArrayHelper.AddValue();
+					if (!ReadValue(ArrayProperty->Inner, ArrayHelper.GetRawPtr(ElementIndex), Depth + 1))
+					{
+						return false;
+					}
+				} while (Consume(','));
+				return Consume(']');
+			}
+
+			if (FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+			{
+				if (Next == '{')
+				{
+					return ReadStruct(StructProperty->Struct, ValuePtr, Depth + 1);
+				}
+				if (Next == '"')
+				{
+					if (!ReadString(ScratchString))
+					{
+						return false;
+					}
+					if (StructProperty->Struct == TBaseStructure<FDateTime>::Get())
+					{
+						FDateTime& DateTime = *static_cast<FDateTime*>(ValuePtr);
+						if (!FDateTime::ParseIso8601(*ScratchString, DateTime))
+						{
+							FDateTime::Parse(ScratchString, DateTime);
+						}
+					}
+					else
+					{
+						StructProperty->ImportText_Direct(*ScratchString, ValuePtr, nullptr, PPF_None);
+					}
+					return true;
+				}
+
+				UE_LOG(OWS, Verbose, TEXT("FOWSJsonStructReader - Expected an object for %s, skipping."), *Property->GetName());
+				return SkipValue(Depth);
+			}
+
+			if (Next == '"')
+			{
+				//Strings go straight into FString properties without a temporary
+				if (FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+				{
+					return ReadString(*StrProperty->GetPropertyValuePtr(ValuePtr));
+				}
+				if (!ReadString(ScratchString))
+				{
+					return false;
+				}
+				SetFromString(Property, ValuePtr, ScratchString);
+				return true;
+			}
+
+			if (Next == 't' || Next == 'f')
+			{
+				const bool bValue = Next == 't';
+				if (!ReadLiteral(bValue ? "true" : "false"))
+				{
+					return false;
+				}
+				SetFromBool(Property, ValuePtr, bValue);
+				return true;
+			}
+
+			if (Next == '-' || (Next >= '0' && Next <= '9'))
+			{
+				const uint8* Start = nullptr;
+				int32 Length = 0;
+				bool bIsInteger = false;
+				if (!ReadNumber(Start, Length, bIsInteger))
+				{
+					return false;
+				}
+				SetFromNumber(Property, ValuePtr, Start, Length, bIsInteger);
+				return true;
+			}
+
+			if (Next == '{' || Next == '[')
+			{
+				UE_LOG(OWS, Verbose, TEXT("FOWSJsonStructReader - Unexpected object or array for %s, skipping."), *Property->GetName());
+				return SkipValue(Depth);
+			}
+
+			return false;
+		}
+
+		static bool SetEnumFromString(const UEnum* Enum, FNumericProperty* UnderlyingProperty, void* ValuePtr, const FString& Value)
+		{
+			const int64 EnumValue = Enum->GetValueByNameString(Value);
+			if (EnumValue == INDEX_NONE)
+			{
+				return false;
+			}
+			UnderlyingProperty->SetIntPropertyValue(ValuePtr, EnumValue);
+			return true;
+		}
+
+		static void SetFromString(FProperty* Property, void* ValuePtr, const FString& Value)
+		{
+			if (FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+			{
+				NameProperty->SetPropertyValue(ValuePtr, FName(*Value));
+			}
+			else if (FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+			{
+				TextProperty->SetPropertyValue(ValuePtr, FText::FromString(Value));
+			}
+			else if (FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+			{
+				SetEnumFromString(EnumProperty->GetEnum(), EnumProperty->GetUnderlyingProperty(), ValuePtr, Value);
+			}
+			else if (FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+			{
+				BoolProperty->SetPropertyValue(ValuePtr, Value.ToBool());
+			}
+			else if (FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+			{
+				if (NumericProperty->GetIntPropertyEnum() && SetEnumFromString(NumericProperty->GetIntPropertyEnum(), NumericProperty, ValuePtr, Value))
+				{
+					return;
+				}
+				if (NumericProperty->IsFloatingPoint())
+				{
+					NumericProperty->SetFloatingPointPropertyValue(ValuePtr, FCString::Atod(*Value));
+				}
+				else
+				{
+					NumericProperty->SetIntPropertyValue(ValuePtr, FCString::Atoi64(*Value));
+				}
+			}
+			else
+			{
+				Property->ImportText_Direct(*Value, ValuePtr, nullptr, PPF_None);
+			}
+		}
+
+		static void SetFromBool(FProperty* Property, void* ValuePtr, bool bValue)
+		{
+			if (FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+			{
+				BoolProperty->SetPropertyValue(ValuePtr, bValue);
+			}
+			else if (FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+			{
+				NumericProperty->SetIntPropertyValue(ValuePtr, (int64)(bValue ? 1 : 0));
+			}
+			else if (FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+			{
+				StrProperty->SetPropertyValue(ValuePtr, bValue ? TEXT("true") : TEXT("false"));
+			}
+		}
+
+		static void SetFromNumber(FProperty* Property, void* ValuePtr, const uint8* Start, int32 Length, bool bIsInteger)
+		{
+			if (FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+			{
+				if (NumericProperty->IsFloatingPoint())
+				{
+					NumericProperty->SetFloatingPointPropertyValue(ValuePtr, NumberToDouble(Start, Length));
+				}
+				else
+				{
+					NumericProperty->SetIntPropertyValue(ValuePtr, NumberToInt64(Start, Length, bIsInteger));
+				}
+			}
+			else if (FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+			{
+				EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(ValuePtr, NumberToInt64(Start, Length, bIsInteger));
+			}
+			else if (FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+			{
+				BoolProperty->SetPropertyValue(ValuePtr, NumberToDouble(Start, Length) != 0.0);
+			}
+			else
+			{
+				FString NumberText;
+				AppendUTF8(Start, Length, NumberText);
+				SetFromString(Property, ValuePtr, NumberText);
+			}
+		}
+	};
+}
+
+bool FOWSJsonStructReader::ReadStruct(TConstArrayView<uint8> Utf8Json, const UStruct* StructDefinition, void* OutStruct)
+{
+	check(StructDefinition && OutStruct);
+
+	OWSJsonStructReader::FReader Reader(Utf8Json);
+	return Reader.ReadStruct(StructDefinition, OutStruct, 0) && Reader.AtEnd();
+}
+
+bool FOWSJsonStructReader::ReadStructArray(TConstArrayView<uint8> Utf8Json, const UStruct* StructDefinition, TFunctionRef<void* ()> AddElement)
+{
+	check(StructDefinition);
+
+	OWSJsonStructReader::FReader Reader(Utf8Json);
+	return Reader.ReadStructArray(StructDefinition, AddElement) && Reader.AtEnd();
+}
+
+bool FOWSJsonStructReader::ReadArrayElements(TConstArrayView<uint8> Utf8Json, TArray<FString>& OutElements)
+{
+	OutElements.Reset();
+
+	OWSJsonStructReader::FReader Reader(Utf8Json);
+	return Reader.ReadArrayElements(OutElements) && Reader.AtEnd();
+}
+
+bool FOWSJsonStructReader::ReadResponseContent(FHttpResponsePtr Response, bool bWasSuccessful, const FString& CallingMethodName, FString& ErrorMsg, TFunctionRef<bool(TConstArrayView<uint8>)> ReadContent)
+{
+	if (!bWasSuccessful || !Response.IsValid())
+	{
+		UE_LOG(OWS, Error, TEXT("%s - Response was unsuccessful or invalid!"), *CallingMethodName);
+		ErrorMsg = CallingMethodName + " - Response was unsuccessful or invalid!";
+		return false;
+	}
+
+	if (!ReadContent(Response->GetContent()))
+	{
+		UE_LOG(OWS, Error, TEXT("%s - Error Deserializing JsonObject!"), *CallingMethodName);
+		ErrorMsg = CallingMethodName + " - Error Deserializing JsonObject!";
+		return false;
+	}
+
+	ErrorMsg = "";
+	return true;
+}
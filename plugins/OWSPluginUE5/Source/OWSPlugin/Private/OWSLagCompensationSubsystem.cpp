@@ -0,0 +1,433 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "OWSLagCompensationSubsystem.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/SpectatorPawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "Components/PrimitiveComponent.h"
+#include "Runtime/Core/Public/Misc/ConfigCacheIni.h"
+
+namespace OWSLagCompensation
+{
+	//Distance along the ray (Start + Direction * t) to where it enters the capsule with segment A-B and radius Radius.
+	//Returns false if it misses within MaxDistance.  A start inside the capsule is a hit at zero.
+	bool IntersectCapsule(const FVector& Start, const FVector& Direction, double MaxDistance, const FVector& A, const FVector& B, double Radius, double& OutDistance)
+	{
+		const double RadiusSquared = Radius * Radius;
+
+		if (FMath::PointDistToSegmentSquared(Start, A, B) <= RadiusSquared)
+		{
+			OutDistance = 0.0;
+			return true;
+		}
+
+		double BestDistance = MaxDistance + 1.0;
+
+		//Cylinder body
+		const FVector AxisVector = B - A;
+		const FVector StartFromA = Start - A;
+		const double AxisDotAxis = AxisVector | AxisVector;
+		const double AxisDotDirection = AxisVector | Direction;
+		const double AxisDotStart = AxisVector | StartFromA;
+		const double QuadA = AxisDotAxis - AxisDotDirection * AxisDotDirection;
+
+		//A capsule that is really a sphere, or a ray parallel to the axis, can only enter through the caps
+		if (QuadA > UE_KINDA_SMALL_NUMBER * AxisDotAxis)
+		{
+			const double QuadB = AxisDotAxis * (Direction | StartFromA) - AxisDotStart * AxisDotDirection;
+			const double QuadC = AxisDotAxis * (StartFromA | StartFromA) - AxisDotStart * AxisDotStart - RadiusSquared * AxisDotAxis;
+			const double Discriminant = QuadB * QuadB - QuadA * QuadC;
+			if (Discriminant >= 0.0)
+			{
+				const double Distance = (-QuadB - FMath::Sqrt(Discriminant)) / QuadA;
+				const double AlongAxis = AxisDotStart + Distance * AxisDotDirection;
+				if (Distance >= 0.0 && AlongAxis > 0.0 && AlongAxis < AxisDotAxis)
+				{
+					BestDistance = Distance;
+				}
+			}
+		}
+
+		//Hemisphere caps
+		for (const FVector& CapCenter : { A, B })
+		{
+			const FVector StartFromCap = Start - CapCenter;
+			const double HalfB = Direction | StartFromCap;
+			const double Discriminant = HalfB * HalfB - ((StartFromCap | StartFromCap) - RadiusSquared);
+			if (Discriminant >= 0.0)
+			{
+				const double Distance = -HalfB - FMath::Sqrt(Discriminant);
+				if (Distance >= 0.0 && Distance < BestDistance)
+				{
+					BestDistance = Distance;
+				}
+			}
+		}
+
+		if (BestDistance <= MaxDistance)
+		{
+			OutDistance = BestDistance;
+			return true;
+		}
+		return false;
+	}
+
+	void GetCapsuleSegment(const FOWSLagCompensationSample& Sample, FVector& OutA, FVector& OutB)
+	{
+		const FVector Up = FVector(FQuat(Sample.Rotation).GetUpVector());
+		const double SegmentHalfLength = FMath::Max(0.f, Sample.CapsuleHalfHeight - Sample.CapsuleRadius);
+		OutA = Sample.Location - Up * SegmentHalfLength;
+		OutB = Sample.Location + Up * SegmentHalfLength;
+	}
+}
+
+FHitResult FOWSLagCompensationHit::ToHitResult(const FVector& TraceStart, const FVector& TraceEnd) const
+{
+	FHitResult HitResult(Pawn, Pawn ? Cast<UPrimitiveComponent>(Pawn->GetRootComponent()) : nullptr, Location, ImpactNormal);
+	HitResult.ImpactPoint = ImpactPoint;
+	HitResult.ImpactNormal = ImpactNormal;
+	HitResult.TraceStart = TraceStart;
+	HitResult.TraceEnd = TraceEnd;
+	HitResult.Distance = Distance;
+	const double TraceLength = (TraceEnd - TraceStart).Size();
+	HitResult.Time = TraceLength > 0.0 ? Distance / TraceLength : 0.f;
+	HitResult.bBlockingHit = true;
+	return HitResult;
+}
+
+void UOWSLagCompensationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	HistoryFrames = 64;
+	MaxRewindSeconds = 0.5f;
+	RecordedFrames = 0;
+
+	GConfig->GetInt(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSLagCompensationHistoryFrames"),
+		HistoryFrames,
+		GGameIni
+	);
+
+	GConfig->GetFloat(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSLagCompensationMaxRewindSeconds"),
+		MaxRewindSeconds,
+		GGameIni
+	);
+
+	HistoryFrames = FMath::Max(HistoryFrames, 2);
+	FrameTimes.SetNumZeroed(HistoryFrames);
+}
+
+void UOWSLagCompensationSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+
+	Samples.Empty();
+	Slots.Empty();
+	FreeSlots.Empty();
+	SlotsByPawn.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UOWSLagCompensationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UOWSLagCompensationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOWSLagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+void UOWSLagCompensationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	//Clients never validate hits
+	if (InWorld.GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	for (TActorIterator<APawn> PawnIt(&InWorld); PawnIt; ++PawnIt)
+	{
+		RegisterPawn(*PawnIt);
+	}
+
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UOWSLagCompensationSubsystem::OnActorSpawned));
+}
+
+void UOWSLagCompensationSubsystem::OnActorSpawned(AActor* Actor)
+{
+	if (APawn* Pawn = Cast<APawn>(Actor))
+	{
+		RegisterPawn(Pawn);
+	}
+}
+
+void UOWSLagCompensationSubsystem::RegisterPawn(APawn* Pawn)
+{
+	if (!Pawn || Pawn->IsA<ASpectatorPawn>() || SlotsByPawn.Contains(Pawn))
+	{
+		return;
+	}
+
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Slot = Slots.AddDefaulted();
+		Samples.AddDefaulted(HistoryFrames);
+	}
+
+	Slots[Slot].Pawn = Pawn;
+	Slots[Slot].FirstRecordedFrame = RecordedFrames;
+	SlotsByPawn.Add(Pawn, Slot);
+}
+
+void UOWSLagCompensationSubsystem::UnregisterPawn(APawn* Pawn)
+{
+	int32 Slot;
+	if (SlotsByPawn.RemoveAndCopyValue(Pawn, Slot))
+	{
+		Slots[Slot].Pawn.Reset();
+		FreeSlots.Add(Slot);
+	}
+}
+
+bool UOWSLagCompensationSubsystem::IsTrackingPawn(const APawn* Pawn) const
+{
+	return Pawn && SlotsByPawn.Contains(Pawn);
+}
+
+double UOWSLagCompensationSubsystem::GetServerTime() const
+{
+	return GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+}
+
+float UOWSLagCompensationSubsystem::GetRewindSeconds(const AController* Shooter) const
+{
+	const APlayerController* PlayerController = Cast<APlayerController>(Shooter);
+
+	if (!PlayerController || PlayerController->IsLocalController() || !PlayerController->PlayerState)
+	{
+		return 0.f;
+	}
+
+	return FMath::Clamp(PlayerController->PlayerState->GetPingInMilliseconds() * 0.001f, 0.f, MaxRewindSeconds);
+}
+
+void UOWSLagCompensationSubsystem::RecordSample(int32 Slot, int32 RingIndex)
+{
+	const APawn* Pawn = Slots[Slot].Pawn.Get();
+	FOWSLagCompensationSample& Sample = Samples[Slot * HistoryFrames + RingIndex];
+
+	Sample.Location = Pawn->GetActorLocation();
+	Sample.Rotation = FQuat4f(Pawn->GetActorQuat());
+	Pawn->GetSimpleCollisionCylinder(Sample.CapsuleRadius, Sample.CapsuleHalfHeight);
+}
+
+void UOWSLagCompensationSubsystem::Tick(float DeltaTime)
+{
+	if (Slots.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 RingIndex = (int32)(RecordedFrames % HistoryFrames);
+	FrameTimes[RingIndex] = GetServerTime();
+
+	for (int32 Slot = 0; Slot < Slots.Num(); Slot++)
+	{
+		FOWSLagCompensatedPawn& TrackedPawn = Slots[Slot];
+
+		if (TrackedPawn.Pawn.IsValid())
+		{
+			RecordSample(Slot, RingIndex);
+		}
+		else if (SlotsByPawn.Remove(TrackedPawn.Pawn) > 0)
+		{
+			//Destroyed since the last frame
+			TrackedPawn.Pawn.Reset();
+			FreeSlots.Add(Slot);
+		}
+	}
+
+	RecordedFrames++;
+}
+
+bool UOWSLagCompensationSubsystem::FindRewindFrames(double ServerTime, FRewindFrames& OutFrames) const
+{
+	if (RecordedFrames == 0)
+	{
+		return false;
+	}
+
+	const int64 NewestFrame = RecordedFrames - 1;
+	const int64 OldestFrame = FMath::Max<int64>(0, RecordedFrames - HistoryFrames);
+	auto FrameTime = [this](int64 Frame) { return FrameTimes[(int32)(Frame % HistoryFrames)]; };
+
+	if (ServerTime >= FrameTime(NewestFrame))
+	{
+		OutFrames = { NewestFrame, NewestFrame, 0.f };
+		return true;
+	}
+	if (ServerTime <= FrameTime(OldestFrame))
+	{
+		OutFrames = { OldestFrame, OldestFrame, 0.f };
+		return true;
+	}
+
+	//Newest frame recorded at or before ServerTime
+	int64 Low = OldestFrame;
+	int64 High = NewestFrame;
+	while (High - Low > 1)
+	{
+		const int64 Middle = Low + (High - Low) / 2;
+		if (FrameTime(Middle) <= ServerTime)
+		{
+			Low = Middle;
+		}
+		else
+		{
+			High = Middle;
+		}
+	}
+
+	const double LowTime = FrameTime(Low);
+	const double HighTime = FrameTime(High);
+	OutFrames.OlderFrame = Low;
+	OutFrames.NewerFrame = High;
+	OutFrames.Alpha = HighTime > LowTime ? (float)((ServerTime - LowTime) / (HighTime - LowTime)) : 0.f;
+	return true;
+}
+
+void UOWSLagCompensationSubsystem::SampleSlot(int32 Slot, const FRewindFrames& Frames, FOWSLagCompensationSample& OutSample) const
+{
+	//Pawns registered partway through the history only have their own frames
+	const int64 FirstFrame = Slots[Slot].FirstRecordedFrame;
+	const int64 OlderFrame = FMath::Max(Frames.OlderFrame, FirstFrame);
+	const int64 NewerFrame = FMath::Max(Frames.NewerFrame, FirstFrame);
+
+	const FOWSLagCompensationSample* SlotSamples = &Samples[Slot * HistoryFrames];
+	const FOWSLagCompensationSample& Older = SlotSamples[OlderFrame % HistoryFrames];
+	const FOWSLagCompensationSample& Newer = SlotSamples[NewerFrame % HistoryFrames];
+
+	if (OlderFrame == NewerFrame)
+	{
+		OutSample = Older;
+		return;
+	}
+
+	OutSample.Location = FMath::Lerp(Older.Location, Newer.Location, (double)Frames.Alpha);
+	OutSample.Rotation = FQuat4f::Slerp(Older.Rotation, Newer.Rotation, Frames.Alpha);
+	OutSample.CapsuleRadius = FMath::Lerp(Older.CapsuleRadius, Newer.CapsuleRadius, Frames.Alpha);
+	OutSample.CapsuleHalfHeight = FMath::Lerp(Older.CapsuleHalfHeight, Newer.CapsuleHalfHeight, Frames.Alpha);
+}
+
+bool UOWSLagCompensationSubsystem::GetRewoundSample(const APawn* Pawn, double ServerTime, FOWSLagCompensationSample& OutSample) const
+{
+	const int32* Slot = SlotsByPawn.Find(Pawn);
+	FRewindFrames Frames;
+
+	//Not recorded yet if it was registered this frame
+	if (!Slot || !FindRewindFrames(ServerTime, Frames) || Slots[*Slot].FirstRecordedFrame >= RecordedFrames)
+	{
+		return false;
+	}
+
+	SampleSlot(*Slot, Frames, OutSample);
+	return true;
+}
+
+bool UOWSLagCompensationSubsystem::GetRewoundPawnLocation(APawn* Pawn, float RewindSeconds, FVector& OutLocation, FRotator& OutRotation) const
+{
+	FOWSLagCompensationSample Sample;
+	if (!GetRewoundSample(Pawn, GetServerTime() - RewindSeconds, Sample))
+	{
+		return false;
+	}
+
+	OutLocation = Sample.Location;
+	OutRotation = FRotator(FQuat(Sample.Rotation));
+	return true;
+}
+
+bool UOWSLagCompensationSubsystem::SweepRewoundPawns(const FVector& Start, const FVector& End, float SweepRadius, double ServerTime, TFunctionRef<bool(APawn*)> ShouldConsiderPawn, FOWSLagCompensationHit& OutHit) const
+{
+	FRewindFrames Frames;
+	if (!FindRewindFrames(ServerTime, Frames))
+	{
+		return false;
+	}
+
+	const FVector Delta = End - Start;
+	const double TraceLength = Delta.Size();
+	const FVector Direction = TraceLength > 0.0 ? Delta / TraceLength : FVector::UpVector;
+	const FBox TraceBounds = FBox(Start.ComponentMin(End), Start.ComponentMax(End)).ExpandBy(SweepRadius);
+
+	bool bFoundHit = false;
+	double ClosestDistance = TraceLength;
+
+	for (int32 Slot = 0; Slot < Slots.Num(); Slot++)
+	{
+		APawn* Pawn = Slots[Slot].Pawn.Get();
+		if (!Pawn || Slots[Slot].FirstRecordedFrame >= RecordedFrames)
+		{
+			continue;
+		}
+
+		FOWSLagCompensationSample Sample;
+		SampleSlot(Slot, Frames, Sample);
+
+		//Cheap reject before the exact test
+		const double BoundsRadius = FMath::Max(Sample.CapsuleRadius, Sample.CapsuleHalfHeight);
+		if (!TraceBounds.Intersect(FBox::BuildAABB(Sample.Location, FVector(BoundsRadius))))
+		{
+			continue;
+		}
+
+		FVector CapsuleA, CapsuleB;
+		OWSLagCompensation::GetCapsuleSegment(Sample, CapsuleA, CapsuleB);
+
+		double Distance;
+		if (!OWSLagCompensation::IntersectCapsule(Start, Direction, ClosestDistance, CapsuleA, CapsuleB, Sample.CapsuleRadius + SweepRadius, Distance)
+			|| (bFoundHit && Distance >= ClosestDistance)
+			|| !ShouldConsiderPawn(Pawn))
+		{
+			continue;
+		}
+
+		const FVector HitLocation = Start + Direction * Distance;
+		const FVector ClosestOnAxis = FMath::ClosestPointOnSegment(HitLocation, CapsuleA, CapsuleB);
+		FVector Normal = (HitLocation - ClosestOnAxis).GetSafeNormal();
+		if (Normal.IsZero())
+		{
+			Normal = -Direction;
+		}
+
+		bFoundHit = true;
+		ClosestDistance = Distance;
+		OutHit.Pawn = Pawn;
+		OutHit.Distance = Distance;
+		OutHit.Location = HitLocation;
+		OutHit.ImpactPoint = HitLocation - Normal * SweepRadius;
+		OutHit.ImpactNormal = Normal;
+		OutHit.RewoundPawnLocation = Sample.Location;
+	}
+
+	return bFoundHit;
+}
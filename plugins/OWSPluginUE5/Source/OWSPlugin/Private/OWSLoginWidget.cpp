@@ -2,6 +2,7 @@
 
 #include "OWSLoginWidget.h"
 #include "OWSPlugin.h"
+#include "OWSJsonStructReader.h"
 #include "Runtime/Online/HTTP/Public/Http.h"
 #include "OWSPlayerController.h"
 #include "Runtime/Core/Public/Misc/ConfigCacheIni.h"
@@ -82,16 +83,13 @@ void UOWSLoginWidget::LoginAndCreateSession(FString Email, FString Password)
 void UOWSLoginWidget::OnLoginAndCreateSessionResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
 	FString ErrorMsg;
-	TSharedPtr<FJsonObject> JsonObject;
-	GetJsonObjectFromResponse(Request, Response, bWasSuccessful, "OnLoginAndCreateSessionResponseReceived", ErrorMsg, JsonObject);
+	TSharedPtr<FLoginAndCreateSession> LoginAndCreateSession = FOWSJsonStructReader::ReadResponse<FLoginAndCreateSession>(Response, bWasSuccessful, "OnLoginAndCreateSessionResponseReceived", ErrorMsg);
 	if (!ErrorMsg.IsEmpty())
 	{
 		ErrorLoginAndCreateSession(ErrorMsg);
 		return;
 	}
 
-	TSharedPtr<FLoginAndCreateSession> LoginAndCreateSession = GetStructFromJsonObject<FLoginAndCreateSession>(JsonObject);
-
 	if (!LoginAndCreateSession->ErrorMessage.IsEmpty())
 	{
 		ErrorLoginAndCreateSession(*LoginAndCreateSession->ErrorMessage);
@@ -125,16 +123,13 @@ void UOWSLoginWidget::ExternalLoginAndCreateSession(FString Email, FString Passw
 void UOWSLoginWidget::OnExternalLoginAndCreateSessionResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
 	FString ErrorMsg;
-	TSharedPtr<FJsonObject> JsonObject;
-	GetJsonObjectFromResponse(Request, Response, bWasSuccessful, "OnExternalLoginAndCreateSessionResponseReceived", ErrorMsg, JsonObject);
+	TSharedPtr<FLoginAndCreateSession> LoginAndCreateSession = FOWSJsonStructReader::ReadResponse<FLoginAndCreateSession>(Response, bWasSuccessful, "OnExternalLoginAndCreateSessionResponseReceived", ErrorMsg);
 	if (!ErrorMsg.IsEmpty())
 	{
 		ErrorExternalLoginAndCreateSession(ErrorMsg);
 		return;
 	}
 
-	TSharedPtr<FLoginAndCreateSession> LoginAndCreateSession = GetStructFromJsonObject<FLoginAndCreateSession>(JsonObject);
-
 	if (!LoginAndCreateSession->ErrorMessage.IsEmpty())
 	{
 		ErrorExternalLoginAndCreateSession(*LoginAndCreateSession->ErrorMessage);
@@ -163,16 +158,13 @@ void UOWSLoginWidget::Register(FString Email, FString Password, FString FirstNam
 void UOWSLoginWidget::OnRegisterResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
 	FString ErrorMsg;
-	TSharedPtr<FJsonObject> JsonObject;
-	GetJsonObjectFromResponse(Request, Response, bWasSuccessful, "OnRegisterResponseReceived", ErrorMsg, JsonObject);
+	TSharedPtr<FLoginAndCreateSession> RegisterAndCreateSession = FOWSJsonStructReader::ReadResponse<FLoginAndCreateSession>(Response, bWasSuccessful, "OnRegisterResponseReceived", ErrorMsg);
 	if (!ErrorMsg.IsEmpty())
 	{
 		ErrorRegister(ErrorMsg);
 		return;
 	}
 
-	TSharedPtr<FLoginAndCreateSession> RegisterAndCreateSession = GetStructFromJsonObject<FLoginAndCreateSession>(JsonObject);
-
 	if (!RegisterAndCreateSession->ErrorMessage.IsEmpty())
 	{
 		ErrorRegister(*RegisterAndCreateSession->ErrorMessage);
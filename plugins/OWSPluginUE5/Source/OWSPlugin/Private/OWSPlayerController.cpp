@@ -9,6 +9,8 @@
 #include "OWSCharacter.h"
 #include "OWSGameMode.h"
 #include "OWSGameInstance.h"
+#include "OWSChatManager.h"
+#include "EngineUtils.h"
 #include "GameFramework/PlayerInput.h"
 #include "Runtime/Engine/Classes/GameFramework/PlayerState.h"
 #include "Runtime/Core/Public/Misc/ConfigCacheIni.h"
@@ -39,6 +41,20 @@ AOWSPlayerController::AOWSPlayerController()
 		GGameIni
 	);
 
+	GConfig->GetFloat(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSChatMessagesPerSecond"),
+		ChatMessagesPerSecond,
+		GGameIni
+	);
+
+	GConfig->GetFloat(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSChatMessageBurst"),
+		ChatMessageBurst,
+		GGameIni
+	);
+
 	MaxPredictionPing = 120.f;
 	bEnableClickEvents = true;
 
@@ -73,7 +89,7 @@ AOWSPlayerController::AOWSPlayerController()
 	OWSPlayerControllerComponent->OnErrorRemoveCharacterDelegate.BindUObject(this, &AOWSPlayerController::ErrorRemoveCharacter);
 	OWSPlayerControllerComponent->OnNotifyGetZoneServerToTravelToDelegate.BindUObject(this, &AOWSPlayerController::NotifyMapServerToTravelTo);
 	OWSPlayerControllerComponent->OnErrorGetZoneServerToTravelToDelegate.BindUObject(this, &AOWSPlayerController::ErrorMapServerToTravelTo);
-	OWSPlayerControllerComponent->OnNotifyGetPlayerGroupsCharacterIsInDelegate.BindUObject(this, &AOWSPlayerController::NotifyGetPlayerGroupsCharacterIsIn);
+	OWSPlayerControllerComponent->OnNotifyGetPlayerGroupsCharacterIsInDelegate.BindUObject(this, &AOWSPlayerController::OnGetPlayerGroupsCharacterIsIn);
 	OWSPlayerControllerComponent->OnErrorGetPlayerGroupsCharacterIsInDelegate.BindUObject(this, &AOWSPlayerController::ErrorGetPlayerGroupsCharacterIsIn);
 	OWSPlayerControllerComponent->OnNotifyLaunchZoneInstanceDelegate.BindUObject(this, &AOWSPlayerController::NotifyLaunchDungeon);
 	OWSPlayerControllerComponent->OnErrorLaunchZoneInstanceDelegate.BindUObject(this, &AOWSPlayerController::ErrorLaunchDungeon);
@@ -384,6 +400,12 @@ AOWSPlayerState* AOWSPlayerController::GetOWSPlayerState() const
 	return GetPlayerState<AOWSPlayerState>();
 }
 
+UOWSReplicationGraph* AOWSPlayerController::GetReplicationGraph() const
+{
+	UNetDriver* NetDriver = GetNetDriver();
+	return NetDriver ? Cast<UOWSReplicationGraph>(NetDriver->GetReplicationDriver()) : nullptr;
+}
+
 bool AOWSPlayerController::InputAxis(FKey Key, float Delta, float DeltaTime, int32 NumSamples, bool bGamepad)
 {
 	bool bResult = false;
@@ -831,9 +853,39 @@ void AOWSPlayerController::GetPlayerGroupsCharacterIsIn(FString UserSessionGUID,
 	Request->ProcessRequest();
 	*/
 
+	PlayerGroupTypeIDRequested = PlayerGroupTypeID;
 	OWSPlayerControllerComponent->GetPlayerGroupsCharacterIsIn(UserSessionGUID, CharacterName, PlayerGroupTypeID);
 }
 
+void AOWSPlayerController::OnGetPlayerGroupsCharacterIsIn(const TArray<FPlayerGroup>& PlayerGroups)
+{
+	//Only the server has a replication graph
+	UOWSReplicationGraph* ReplicationGraph = GetReplicationGraph();
+	AOWSPlayerState* OWSPlayerState = GetOWSPlayerState();
+
+	if (ReplicationGraph && OWSPlayerState)
+	{
+		const FPlayerGroup* Party = PlayerGroups.FindByPredicate([](const FPlayerGroup& PlayerGroup)
+		{
+			return PlayerGroup.PlayerGroupTypeID == ERPGPlayerGroupType::Party;
+		});
+
+		if (Party)
+		{
+			//AddPlayerToParty leaves any party the player was already in
+			OWSPlayerState->AlwaysRelevantPartyID = Party->PlayerGroupID;
+			ReplicationGraph->AddPlayerToParty(OWSPlayerState);
+		}
+		//A PlayerGroupTypeID of 0 returns every group type, so no party in the result means the player has left it
+		else if (OWSPlayerState->AlwaysRelevantPartyID != 0 && (PlayerGroupTypeIDRequested == 0 || PlayerGroupTypeIDRequested == ERPGPlayerGroupType::Party))
+		{
+			ReplicationGraph->RemovePlayerFromParty(OWSPlayerState);
+		}
+	}
+
+	NotifyGetPlayerGroupsCharacterIsIn(PlayerGroups);
+}
+
 void AOWSPlayerController::GetMapServerToTravelTo(FString ZoneName)
 {
 	FString CharacterName = PlayerState->GetPlayerName();
@@ -855,45 +907,87 @@ AOWSGameMode* AOWSPlayerController::GetGameMode()
 
 void AOWSPlayerController::SynchUpLocalMeshItemsMap()
 {
-	UOWSGameInstance* GameInstance = Cast<UOWSGameInstance>(GetWorld()->GetGameInstance());
-
-	if (!GameInstance)
-		return;
+	//Nothing to do.  The registry's initial bunch already carries every mapping.
+}
 
+void AOWSPlayerController::AddItemToLocalMeshItemsMap(const FString& ItemName, const int32 ItemMeshID)
+{
 	AOWSGameMode* OWSGameMode = GetGameMode();
 
 	if (!OWSGameMode)
 		return;
 
-	for (auto& MapItem : OWSGameMode->MeshItemsMap)
-	{
-		AddItemToLocalMeshItemsMap(MapItem.Key, MapItem.Value);
-	}
+	OWSGameMode->AddItemMeshToAllPlayers(ItemName, ItemMeshID);
 }
 
-void AOWSPlayerController::AddItemToLocalMeshItemsMap(const FString& ItemName, const int32 ItemMeshID)
+bool AOWSPlayerController::Server_SendChatMessage_Validate(const FString& Message, const FString& SendToCharacterName, const FString& ChatGroupName)
 {
-	UOWSGameInstance* GameInstance = Cast<UOWSGameInstance>(GetWorld()->GetGameInstance());
+	return Message.Len() <= MaxChatMessageLength && SendToCharacterName.Len() <= MaxChatNameLength && ChatGroupName.Len() <= MaxChatNameLength;
+}
 
-	if (!GameInstance)
+void AOWSPlayerController::Server_SendChatMessage_Implementation(const FString& Message, const FString& SendToCharacterName, const FString& ChatGroupName)
+{
+	TActorIterator<AOWSChatManager> ChatManager(GetWorld());
+
+	if (!ChatManager || !PlayerState)
+	{
+		UE_LOG(OWS, Error, TEXT("Server_SendChatMessage - No AOWSChatManager in this zone!"));
 		return;
+	}
 
-	if (!LocalMeshItemsMap.Contains(ItemName))
+	if (Message.IsEmpty())
 	{
-		LocalMeshItemsMap.Add(ItemName, ItemMeshID);
+		return;
+	}
 
-		Client_AddItemToLocalMeshItemsMap(ItemName, ItemMeshID);
+	if (!TakeChatMessageAllowance())
+	{
+		UE_LOG(OWS, Warning, TEXT("Server_SendChatMessage - Dropped a message from %s for sending faster than %.1f messages per second"), *PlayerState->GetPlayerName(), ChatMessagesPerSecond);
+		return;
 	}
+
+	FChatMessage ChatMessage;
+	ChatMessage.ChatMessage = Message;
+	ChatMessage.SentByCharName = PlayerState->GetPlayerName();
+	ChatMessage.SentToCharName = SendToCharacterName;
+	ChatMessage.ChatGroupName = ChatGroupName;
+
+	ChatManager->QueueOutgoingChatMessage(ChatMessage);
 }
 
-void AOWSPlayerController::Client_AddItemToLocalMeshItemsMap_Implementation(const FString& ItemName, const int32 ItemMeshID)
+bool AOWSPlayerController::TakeChatMessageAllowance()
 {
-	UOWSGameInstance* GameInstance = Cast<UOWSGameInstance>(GetWorld()->GetGameInstance());
+	const double Now = FPlatformTime::Seconds();
 
-	if (!GameInstance)
+	//The first message starts with a full burst
+	if (LastChatMessageAllowanceTime <= 0.0)
+	{
+		ChatMessageAllowance = ChatMessageBurst;
+	}
+	else
+	{
+		ChatMessageAllowance = FMath::Min(ChatMessageBurst, ChatMessageAllowance + static_cast<float>(Now - LastChatMessageAllowanceTime) * ChatMessagesPerSecond);
+	}
+
+	LastChatMessageAllowanceTime = Now;
+
+	if (ChatMessageAllowance < 1.f)
+	{
+		return false;
+	}
+
+	ChatMessageAllowance -= 1.f;
+	return true;
+}
+
+void AOWSPlayerController::Client_ReceiveChatMessages_Implementation(const TArray<FChatMessage>& ChatMessages)
+{
+	TActorIterator<AOWSChatManager> ChatManager(GetWorld());
+
+	if (!ChatManager)
 		return;
 
-	GameInstance->LocalMeshItemsMap.Add(ItemName, ItemMeshID);
+	ChatManager->ReceiveChatMessages(ChatMessages);
 }
 
 void AOWSPlayerController::GetLifetimeReplicatedProps(TArray< FLifetimeProperty > & OutLifetimeProps) const
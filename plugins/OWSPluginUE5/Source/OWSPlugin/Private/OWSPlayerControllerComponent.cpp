@@ -5,6 +5,7 @@
 #include "OWSGameInstance.h"
 #include "OWSAPISubsystem.h"
 #include "OWS2API.h"
+#include "OWSJsonStructReader.h"
 #include "Runtime/Engine/Classes/Kismet/GameplayStatics.h"
 
 
@@ -469,10 +470,10 @@ void UOWSPlayerControllerComponent::GetAllCharacters(FString UserSessionGUID)
 
 void UOWSPlayerControllerComponent::OnGetAllCharactersResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
-	if (bWasSuccessful)
+	if (bWasSuccessful && Response.IsValid())
 	{
 		TArray<FUserCharacter> UsersCharactersData;
-		if (FJsonObjectConverter::JsonArrayStringToUStruct(Response->GetContentAsString(), &UsersCharactersData, 0, 0))
+		if (FOWSJsonStructReader::ReadStructArray(Response->GetContent(), UsersCharactersData))
 		{
 			OnNotifyGetAllCharactersDelegate.ExecuteIfBound(UsersCharactersData);
 		}
@@ -523,6 +524,90 @@ void UOWSPlayerControllerComponent::OnGetCharacterStatsResponseReceived(FHttpReq
 	}
 }
 
+//GetCharacterBootstrap
+void UOWSPlayerControllerComponent::GetCharacterBootstrap(FString CharName)
+{
+	FCharacterNameJSONPost CharacterNameJSONPost;
+	CharacterNameJSONPost.CharacterName = CharName;
+	FString PostParameters = "";
+	if (FJsonObjectConverter::UStructToJsonObjectString(CharacterNameJSONPost, PostParameters))
+	{
+		ProcessOWS2POSTRequest("CharacterPersistenceAPI", "api/Characters/GetBootstrap", PostParameters, &UOWSPlayerControllerComponent::OnGetCharacterBootstrapResponseReceived);
+	}
+	else
+	{
+		UE_LOG(OWS, Error, TEXT("GetCharacterBootstrap Error serializing CharacterNameJSONPost!"));
+	}
+}
+
+void UOWSPlayerControllerComponent::OnGetCharacterBootstrapResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	TSharedPtr<FJsonObject> JsonObject;
+
+	if (bWasSuccessful && Response.IsValid())
+	{
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+		FJsonSerializer::Deserialize(Reader, JsonObject);
+	}
+
+	if (!JsonObject.IsValid())
+	{
+		const FString ErrorMsg = TEXT("OnGetCharacterBootstrapResponseReceived Error accessing server!");
+		UE_LOG(OWS, Error, TEXT("%s"), *ErrorMsg);
+		OnErrorGetCharacterStatsDelegate.ExecuteIfBound(ErrorMsg);
+		OnErrorGetCustomCharacterDataDelegate.ExecuteIfBound(ErrorMsg);
+		OnErrorGetCharacterAbilitiesDelegate.ExecuteIfBound(ErrorMsg);
+		OnErrorGetAbilityBarsDelegate.ExecuteIfBound(ErrorMsg);
+		OnErrorGetCharacterBootstrapDelegate.ExecuteIfBound(ErrorMsg);
+		return;
+	}
+
+	//Each part is the same document the single endpoint returns, so hand it to the same delegate
+	const TSharedPtr<FJsonObject>* CharacterData;
+	if (JsonObject->TryGetObjectField(TEXT("CharacterData"), CharacterData))
+	{
+		OnNotifyGetCharacterStatsDelegate.ExecuteIfBound(*CharacterData);
+	}
+	else
+	{
+		OnErrorGetCharacterStatsDelegate.ExecuteIfBound(TEXT("OnGetCharacterBootstrapResponseReceived Server returned no character data!"));
+	}
+
+	const TSharedPtr<FJsonObject>* CustomCharacterData;
+	if (JsonObject->TryGetObjectField(TEXT("CustomCharacterData"), CustomCharacterData))
+	{
+		OnNotifyGetCustomCharacterDataDelegate.ExecuteIfBound(*CustomCharacterData);
+	}
+	else
+	{
+		OnErrorGetCustomCharacterDataDelegate.ExecuteIfBound(TEXT("OnGetCharacterBootstrapResponseReceived Server returned no custom data!"));
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* AbilitiesJson;
+	TArray<FAbility> Abilities;
+	if (JsonObject->TryGetArrayField(TEXT("Abilities"), AbilitiesJson) && FJsonObjectConverter::JsonArrayToUStruct(*AbilitiesJson, &Abilities, 0, 0))
+	{
+		OnNotifyGetCharacterAbilitiesDelegate.ExecuteIfBound(Abilities);
+	}
+	else
+	{
+		OnErrorGetCharacterAbilitiesDelegate.ExecuteIfBound(TEXT("OnGetCharacterBootstrapResponseReceived Server returned no abilities!"));
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* AbilityBarsJson;
+	TArray<FAbilityBar> AbilityBars;
+	if (JsonObject->TryGetArrayField(TEXT("AbilityBars"), AbilityBarsJson) && FJsonObjectConverter::JsonArrayToUStruct(*AbilityBarsJson, &AbilityBars, 0, 0))
+	{
+		OnNotifyGetAbilityBarsDelegate.ExecuteIfBound(AbilityBars);
+	}
+	else
+	{
+		OnErrorGetAbilityBarsDelegate.ExecuteIfBound(TEXT("OnGetCharacterBootstrapResponseReceived Server returned no ability bars!"));
+	}
+
+	OnNotifyGetCharacterBootstrapDelegate.ExecuteIfBound();
+}
+
 //GetCharacterDataAndCustomData - This makes a call to the OWS Public API and is usable from the Character Selection screen.
 void UOWSPlayerControllerComponent::GetCharacterDataAndCustomData(FString UserSessionGUID, FString CharName)
 {
@@ -568,16 +653,13 @@ void UOWSPlayerControllerComponent::UpdateCharacterStats(FString JSONString)
 void UOWSPlayerControllerComponent::OnUpdateCharacterStatsResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
 	FString ErrorMsg;
-	TSharedPtr<FJsonObject> JsonObject;
-	GetJsonObjectFromResponse(Request, Response, bWasSuccessful, "OnUpdateCharacterStatsResponseReceived", ErrorMsg, JsonObject);
+	TSharedPtr<FSuccessAndErrorMessage> SuccessAndErrorMessage = FOWSJsonStructReader::ReadResponse<FSuccessAndErrorMessage>(Response, bWasSuccessful, "OnUpdateCharacterStatsResponseReceived", ErrorMsg);
 	if (!ErrorMsg.IsEmpty())
 	{
 		OnErrorUpdateCharacterStatsDelegate.ExecuteIfBound(ErrorMsg);
 		return;
 	}
 
-	TSharedPtr<FSuccessAndErrorMessage> SuccessAndErrorMessage = GetStructFromJsonObject<FSuccessAndErrorMessage>(JsonObject);
-
 	if (!SuccessAndErrorMessage->ErrorMessage.IsEmpty())
 	{
 		OnErrorUpdateCharacterStatsDelegate.ExecuteIfBound(*SuccessAndErrorMessage->ErrorMessage);
@@ -587,6 +669,31 @@ void UOWSPlayerControllerComponent::OnUpdateCharacterStatsResponseReceived(FHttp
 	OnNotifyUpdateCharacterStatsDelegate.ExecuteIfBound();
 }
 
+//Update Character Stats Delta
+void UOWSPlayerControllerComponent::UpdateCharacterStatsDelta(FString JSONString)
+{
+	ProcessOWS2POSTRequest("CharacterPersistenceAPI", "api/Characters/UpdateCharacterStatsDelta", JSONString, &UOWSPlayerControllerComponent::OnUpdateCharacterStatsDeltaResponseReceived);
+}
+
+void UOWSPlayerControllerComponent::OnUpdateCharacterStatsDeltaResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+{
+	FString ErrorMsg;
+	TSharedPtr<FSuccessAndErrorMessage> SuccessAndErrorMessage = FOWSJsonStructReader::ReadResponse<FSuccessAndErrorMessage>(Response, bWasSuccessful, "OnUpdateCharacterStatsDeltaResponseReceived", ErrorMsg);
+	if (!ErrorMsg.IsEmpty())
+	{
+		OnErrorUpdateCharacterStatsDeltaDelegate.ExecuteIfBound(ErrorMsg);
+		return;
+	}
+
+	if (!SuccessAndErrorMessage->ErrorMessage.IsEmpty())
+	{
+		OnErrorUpdateCharacterStatsDeltaDelegate.ExecuteIfBound(*SuccessAndErrorMessage->ErrorMessage);
+		return;
+	}
+
+	OnNotifyUpdateCharacterStatsDeltaDelegate.ExecuteIfBound();
+}
+
 //GetCustomCharacterData
 void UOWSPlayerControllerComponent::GetCustomCharacterData(FString CharName)
 {
@@ -632,7 +739,9 @@ void UOWSPlayerControllerComponent::AddOrUpdateCustomCharacterData(FString CharN
 	FString PostParameters = "";
 	if (FJsonObjectConverter::UStructToJsonObjectString(AddOrUpdateCustomCharacterDataJSONPost, PostParameters))
 	{
-		ProcessOWS2POSTRequest("CharacterPersistenceAPI", "api/Characters/AddOrUpdateCustomData", PostParameters, &UOWSPlayerControllerComponent::OnAddOrUpdateCustomCharacterDataResponseReceived);
+		UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(this);
+		GameInstance->GetSubsystem<UOWSAPISubsystem>()->QueueOWS2POSTRequest("CharacterPersistenceAPI", "api/Characters/AddOrUpdateCustomData", PostParameters,
+			FOWSQueuedRequestCompleteDelegate::CreateUObject(this, &UOWSPlayerControllerComponent::OnAddOrUpdateCustomCharacterDataResponseReceived), TEXT("CustomData:") + CharName);
 	}
 	else
 	{
@@ -640,16 +749,17 @@ void UOWSPlayerControllerComponent::AddOrUpdateCustomCharacterData(FString CharN
 	}
 }
 
-void UOWSPlayerControllerComponent::OnAddOrUpdateCustomCharacterDataResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void UOWSPlayerControllerComponent::OnAddOrUpdateCustomCharacterDataResponseReceived(bool bWasSuccessful, const FString& ResponseContent)
 {
-	if (bWasSuccessful)
+	FString ErrorMsg;
+	if (UOWSAPISubsystem::ReadQueuedRequestResult(bWasSuccessful, ResponseContent, ErrorMsg))
 	{
 		OnNotifyAddOrUpdateCustomCharacterDataDelegate.ExecuteIfBound();
 	}
 	else
 	{
-		UE_LOG(OWS, Error, TEXT("OnAddOrUpdateCustomCharacterDataResponseReceived Error accessing login server!"));
-		OnErrorAddOrUpdateCustomCharacterDataDelegate.ExecuteIfBound(TEXT("Unknown error connecting to server!"));
+		UE_LOG(OWS, Error, TEXT("OnAddOrUpdateCustomCharacterDataResponseReceived Error: %s"), *ErrorMsg);
+		OnErrorAddOrUpdateCustomCharacterDataDelegate.ExecuteIfBound(ErrorMsg);
 	}
 }
 
@@ -757,7 +867,9 @@ void UOWSPlayerControllerComponent::AddAbilityToCharacter(FString CharName, FStr
 	FString PostParameters = "";
 	if (FJsonObjectConverter::UStructToJsonObjectString(AddAbilityToCharacterJSONPost, PostParameters))
 	{
-		ProcessOWS2POSTRequest("CharacterPersistenceAPI", "api/Abilities/AddAbilityToCharacter", PostParameters, &UOWSPlayerControllerComponent::OnAddAbilityToCharacterResponseReceived);
+		UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(this);
+		GameInstance->GetSubsystem<UOWSAPISubsystem>()->QueueOWS2POSTRequest("CharacterPersistenceAPI", "api/Abilities/AddAbilityToCharacter", PostParameters,
+			FOWSQueuedRequestCompleteDelegate::CreateUObject(this, &UOWSPlayerControllerComponent::OnAddAbilityToCharacterResponseReceived), TEXT("Abilities:") + CharName);
 	}
 	else
 	{
@@ -765,16 +877,17 @@ void UOWSPlayerControllerComponent::AddAbilityToCharacter(FString CharName, FStr
 	}
 }
 
-void UOWSPlayerControllerComponent::OnAddAbilityToCharacterResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void UOWSPlayerControllerComponent::OnAddAbilityToCharacterResponseReceived(bool bWasSuccessful, const FString& ResponseContent)
 {
-	if (bWasSuccessful)
+	FString ErrorMsg;
+	if (UOWSAPISubsystem::ReadQueuedRequestResult(bWasSuccessful, ResponseContent, ErrorMsg))
 	{
 		OnNotifyAddAbilityToCharacterDelegate.ExecuteIfBound();
 	}
 	else
 	{
-		UE_LOG(OWS, Error, TEXT("OnAddAbilityToCharacterResponseReceived Error accessing server!"));
-		OnErrorAddAbilityToCharacterDelegate.ExecuteIfBound(TEXT("Unknown error connecting to server!"));
+		UE_LOG(OWS, Error, TEXT("OnAddAbilityToCharacterResponseReceived Error: %s"), *ErrorMsg);
+		OnErrorAddAbilityToCharacterDelegate.ExecuteIfBound(ErrorMsg);
 	}
 }
 
@@ -796,17 +909,12 @@ void UOWSPlayerControllerComponent::GetCharacterAbilities(FString CharName)
 
 void UOWSPlayerControllerComponent::OnGetCharacterAbilitiesResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
-	if (bWasSuccessful)
+	if (bWasSuccessful && Response.IsValid())
 	{
-		TArray<TSharedPtr<FJsonValue>> JsonArray;
-		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+		TArray<FAbility> Abilities;
 
-		if (FJsonSerializer::Deserialize(Reader, JsonArray))
+		if (FOWSJsonStructReader::ReadStructArray(Response->GetContent(), Abilities))
 		{
-			TArray<FAbility> Abilities;
-
-			FJsonObjectConverter::JsonArrayToUStruct(JsonArray, &Abilities, 0, 0);
-
 			OnNotifyGetCharacterAbilitiesDelegate.ExecuteIfBound(Abilities);
 		}
 		else
@@ -840,17 +948,12 @@ void UOWSPlayerControllerComponent::GetAbilityBars(FString CharName)
 
 void UOWSPlayerControllerComponent::OnGetAbilityBarsResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
-	if (bWasSuccessful)
+	if (bWasSuccessful && Response.IsValid())
 	{
-		TArray<TSharedPtr<FJsonValue>> JsonArray;
-		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+		TArray<FAbilityBar> AbilityBars;
 
-		if (FJsonSerializer::Deserialize(Reader, JsonArray))
+		if (FOWSJsonStructReader::ReadStructArray(Response->GetContent(), AbilityBars))
 		{
-			TArray<FAbilityBar> AbilityBars;
-
-			FJsonObjectConverter::JsonArrayToUStruct(JsonArray, &AbilityBars, 0, 0);
-
 			OnNotifyGetAbilityBarsDelegate.ExecuteIfBound(AbilityBars);
 		}
 		else
@@ -877,7 +980,9 @@ void UOWSPlayerControllerComponent::UpdateAbilityOnCharacter(FString CharName, F
 	FString PostParameters = "";
 	if (FJsonObjectConverter::UStructToJsonObjectString(UpdateAbilityOnCharacterJSONPost, PostParameters))
 	{
-		ProcessOWS2POSTRequest("CharacterPersistenceAPI", "api/Abilities/UpdateAbilityOnCharacter", PostParameters, &UOWSPlayerControllerComponent::OnUpdateAbilityOnCharacterResponseReceived);
+		UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(this);
+		GameInstance->GetSubsystem<UOWSAPISubsystem>()->QueueOWS2POSTRequest("CharacterPersistenceAPI", "api/Abilities/UpdateAbilityOnCharacter", PostParameters,
+			FOWSQueuedRequestCompleteDelegate::CreateUObject(this, &UOWSPlayerControllerComponent::OnUpdateAbilityOnCharacterResponseReceived), TEXT("Abilities:") + CharName);
 	}
 	else
 	{
@@ -885,16 +990,17 @@ void UOWSPlayerControllerComponent::UpdateAbilityOnCharacter(FString CharName, F
 	}
 }
 
-void UOWSPlayerControllerComponent::OnUpdateAbilityOnCharacterResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void UOWSPlayerControllerComponent::OnUpdateAbilityOnCharacterResponseReceived(bool bWasSuccessful, const FString& ResponseContent)
 {
-	if (bWasSuccessful)
+	FString ErrorMsg;
+	if (UOWSAPISubsystem::ReadQueuedRequestResult(bWasSuccessful, ResponseContent, ErrorMsg))
 	{
 		OnNotifyAddAbilityToCharacterDelegate.ExecuteIfBound();
 	}
 	else
 	{
-		UE_LOG(OWS, Error, TEXT("OnUpdateAbilityOnCharacterResponseReceived Error accessing server!"));
-		OnErrorAddAbilityToCharacterDelegate.ExecuteIfBound(TEXT("Unknown error accessing API server!"));
+		UE_LOG(OWS, Error, TEXT("OnUpdateAbilityOnCharacterResponseReceived Error: %s"), *ErrorMsg);
+		OnErrorAddAbilityToCharacterDelegate.ExecuteIfBound(ErrorMsg);
 	}
 }
 
@@ -907,7 +1013,10 @@ void UOWSPlayerControllerComponent::RemoveAbilityFromCharacter(FString CharName,
 	FString PostParameters = "";
 	if (FJsonObjectConverter::UStructToJsonObjectString(RemoveAbilityFromCharacterJSONPost, PostParameters))
 	{
-		ProcessOWS2POSTRequest("CharacterPersistenceAPI", "api/Abilities/RemoveAbilityFromCharacter", PostParameters, &UOWSPlayerControllerComponent::OnRemoveAbilityFromCharacterResponseReceived);
+		//Goes through the same ordered queue as Add and Update so a remove can't overtake an earlier add of the same ability
+		UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(this);
+		GameInstance->GetSubsystem<UOWSAPISubsystem>()->QueueOWS2POSTRequest("CharacterPersistenceAPI", "api/Abilities/RemoveAbilityFromCharacter", PostParameters,
+			FOWSQueuedRequestCompleteDelegate::CreateUObject(this, &UOWSPlayerControllerComponent::OnRemoveAbilityFromCharacterResponseReceived), TEXT("Abilities:") + CharName);
 	}
 	else
 	{
@@ -915,16 +1024,17 @@ void UOWSPlayerControllerComponent::RemoveAbilityFromCharacter(FString CharName,
 	}
 }
 
-void UOWSPlayerControllerComponent::OnRemoveAbilityFromCharacterResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
+void UOWSPlayerControllerComponent::OnRemoveAbilityFromCharacterResponseReceived(bool bWasSuccessful, const FString& ResponseContent)
 {
-	if (bWasSuccessful)
+	FString ErrorMsg;
+	if (UOWSAPISubsystem::ReadQueuedRequestResult(bWasSuccessful, ResponseContent, ErrorMsg))
 	{
 		OnNotifyRemoveAbilityFromCharacterDelegate.ExecuteIfBound();
 	}
 	else
 	{
-		UE_LOG(OWS, Error, TEXT("OnRemoveAbilityFromCharacterResponseReceived Error accessing server!"));
-		OnErrorRemoveAbilityFromCharacterDelegate.ExecuteIfBound(TEXT("Unknown error accessing API server!"));
+		UE_LOG(OWS, Error, TEXT("OnRemoveAbilityFromCharacterResponseReceived Error: %s"), *ErrorMsg);
+		OnErrorRemoveAbilityFromCharacterDelegate.ExecuteIfBound(ErrorMsg);
 	}
 }
 
@@ -995,13 +1105,11 @@ void UOWSPlayerControllerComponent::CreateCharacter(FString UserSessionGUID, FSt
 
 void UOWSPlayerControllerComponent::OnCreateCharacterResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
-	if (bWasSuccessful)
+	if (bWasSuccessful && Response.IsValid())
 	{
-		FString ResponseString = Response->GetContentAsString();
-
 		FCreateCharacter CreateCharacter;
 
-		if (!FJsonObjectConverter::JsonObjectStringToUStruct(ResponseString, &CreateCharacter, 0, 0))
+		if (!FOWSJsonStructReader::ReadStruct(Response->GetContent(), CreateCharacter))
 		{
 			OnErrorCreateCharacterDelegate.ExecuteIfBound(TEXT("Could not deserialize CreateCharacter JSON to CreateCharacter struct!"));
 			return;
@@ -1056,11 +1164,10 @@ void UOWSPlayerControllerComponent::RemoveCharacter(FString UserSessionGUID, FSt
 
 void UOWSPlayerControllerComponent::OnRemoveCharacterResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful)
 {
-	if (bWasSuccessful)
+	if (bWasSuccessful && Response.IsValid())
 	{
-		FString ResponseString = Response->GetContentAsString();
 		FSuccessAndErrorMessage SuccessAndErrorMessage;
-		if (!FJsonObjectConverter::JsonObjectStringToUStruct(ResponseString, &SuccessAndErrorMessage, 0, 0))
+		if (!FOWSJsonStructReader::ReadStruct(Response->GetContent(), SuccessAndErrorMessage))
 		{
 			UE_LOG(OWS, Error, TEXT("OnRemoveCharacterResponseReceived Error deserializing SuccessAndErrorMessage!"));
 			OnErrorRemoveCharacterDelegate.ExecuteIfBound(TEXT("OnRemoveCharacterResponseReceived Error deserializing SuccessAndErrorMessage!"));
@@ -0,0 +1,186 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "OWSPlugin.h"
+#include "OWSBenchmarkFrameTimes.h"
+#include "OWSAdvancedProjectile.h"
+#include "OWSProjectilePoolSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace OWSProjectilePoolBenchmark
+{
+	struct FStressPass
+	{
+		TWeakObjectPtr<UWorld> World;
+		TWeakObjectPtr<APawn> Instigator;
+		TSubclassOf<AOWSAdvancedProjectile> ProjectileClass;
+		FRandomStream Random;
+		bool bUsePool = true;
+		float ProjectilesPerSecond = 0.f;
+		float Seconds = 0.f;
+		float LifeSpan = 0.5f;
+		float Elapsed = 0.f;
+		float SpawnBudget = 0.f;
+		int32 ProjectilesFired = 0;
+		int32 StartSpawned = 0;
+		int32 StartReused = 0;
+		double SpawnSeconds = 0.0;
+		double WorstFrameSpawnSeconds = 0.0;
+		double GCStartTime = 0.0;
+		double GCSeconds = 0.0;
+		int32 GCPasses = 0;
+		FDelegateHandle PreGCHandle;
+		FDelegateHandle PostGCHandle;
+		FOWSBenchmarkFrameTimes FrameTimes;
+	};
+
+	static void EndPass(const TSharedRef<FStressPass>& Pass)
+	{
+		FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(Pass->PreGCHandle);
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(Pass->PostGCHandle);
+	}
+
+	//Fires ProjectilesPerSecond short lived projectiles from random points high above the map for Seconds, either through UOWSProjectilePoolSubsystem or straight
+	//SpawnActor, then logs the time spent spawning and collecting garbage.  Run it once with the pool and once without to compare.
+	static void StressTest(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(OWS, Display, TEXT("OWS.Projectiles.PoolStress needs to run in a standalone game or on the server"));
+			return;
+		}
+
+		UOWSProjectilePoolSubsystem* ProjectilePool = World->GetSubsystem<UOWSProjectilePoolSubsystem>();
+		if (!ProjectilePool)
+		{
+			UE_LOG(OWS, Display, TEXT("OWS.Projectiles.PoolStress needs a game or PIE world"));
+			return;
+		}
+
+		TSharedRef<FStressPass> Pass = MakeShared<FStressPass>();
+		Pass->World = World;
+		Pass->ProjectilesPerSecond = Args.Num() > 0 ? FMath::Max(FCString::Atof(*Args[0]), 1.f) : 5000.f;
+		Pass->Seconds = Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 1.f) : 10.f;
+		Pass->bUsePool = Args.Num() > 2 ? FCString::Atoi(*Args[2]) != 0 : true;
+		Pass->ProjectileClass = Args.Num() > 3 ? LoadClass<AOWSAdvancedProjectile>(nullptr, *Args[3]) : AOWSAdvancedProjectile::StaticClass();
+		Pass->Random.Initialize(1234);
+
+		if (!Pass->ProjectileClass)
+		{
+			UE_LOG(OWS, Display, TEXT("OWS.Projectiles.PoolStress could not load projectile class %s"), *Args[3]);
+			return;
+		}
+
+		if (Pass->bUsePool && !ProjectilePool->CanPool(Pass->ProjectileClass, false))
+		{
+			UE_LOG(OWS, Display, TEXT("OWS.Projectiles.PoolStress: %s can't be pooled in this net mode, so both passes will spawn"), *GetNameSafe(Pass->ProjectileClass));
+		}
+
+		APlayerController* PlayerController = World->GetFirstPlayerController();
+		Pass->Instigator = PlayerController ? PlayerController->GetPawn() : nullptr;
+
+		if (Pass->bUsePool)
+		{
+			ProjectilePool->WarmUp(Pass->ProjectileClass, FMath::CeilToInt32(Pass->ProjectilesPerSecond * Pass->LifeSpan));
+		}
+
+		Pass->StartSpawned = ProjectilePool->GetNumSpawned();
+		Pass->StartReused = ProjectilePool->GetNumReused();
+		Pass->FrameTimes.Reserve(Pass->Seconds);
+
+		Pass->PreGCHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddLambda([Pass]()
+		{
+			Pass->GCStartTime = FPlatformTime::Seconds();
+		});
+		Pass->PostGCHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddLambda([Pass]()
+		{
+			Pass->GCSeconds += FPlatformTime::Seconds() - Pass->GCStartTime;
+			Pass->GCPasses++;
+		});
+
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Pass](float DeltaTime)
+		{
+			UWorld* World = Pass->World.Get();
+			UOWSProjectilePoolSubsystem* ProjectilePool = World ? World->GetSubsystem<UOWSProjectilePoolSubsystem>() : nullptr;
+			if (!ProjectilePool)
+			{
+				EndPass(Pass);
+				return false;
+			}
+
+			Pass->Elapsed += DeltaTime;
+			Pass->FrameTimes.Add(DeltaTime);
+
+			const double FrameSpawnStart = FPlatformTime::Seconds();
+			Pass->SpawnBudget += Pass->ProjectilesPerSecond * DeltaTime;
+			while (Pass->SpawnBudget >= 1.f)
+			{
+				Pass->SpawnBudget -= 1.f;
+
+				//High enough above the map that nothing is hit before the lifespan runs out
+				const FVector Location(Pass->Random.FRandRange(-20000.f, 20000.f), Pass->Random.FRandRange(-20000.f, 20000.f), 100000.f);
+				const FTransform SpawnTransform(FRotator(0.f, Pass->Random.FRandRange(0.f, 360.f), 0.f), Location);
+
+				AOWSAdvancedProjectile* Projectile = nullptr;
+				if (Pass->bUsePool)
+				{
+					Projectile = ProjectilePool->AcquireProjectile(Pass->ProjectileClass, SpawnTransform, Pass->Instigator.Get(), false);
+				}
+				else
+				{
+					FActorSpawnParameters Params;
+					Params.Instigator = Pass->Instigator.Get();
+					Params.Owner = Pass->Instigator.Get();
+					Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+					Projectile = World->SpawnActor<AOWSAdvancedProjectile>(Pass->ProjectileClass, SpawnTransform, Params);
+				}
+
+				if (Projectile)
+				{
+					Projectile->SetLifeSpan(Pass->LifeSpan);
+					Pass->ProjectilesFired++;
+				}
+			}
+			const double FrameSpawnSeconds = FPlatformTime::Seconds() - FrameSpawnStart;
+			Pass->SpawnSeconds += FrameSpawnSeconds;
+			Pass->WorstFrameSpawnSeconds = FMath::Max(Pass->WorstFrameSpawnSeconds, FrameSpawnSeconds);
+
+			if (Pass->Elapsed < Pass->Seconds)
+			{
+				return true;
+			}
+
+			EndPass(Pass);
+
+			//Collect whatever the pass left behind so both runs pay for their garbage
+			const double PurgeStart = FPlatformTime::Seconds();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			const double PurgeSeconds = FPlatformTime::Seconds() - PurgeStart;
+
+			UE_LOG(OWS, Display, TEXT("OWS.Projectiles.PoolStress - %s, %s at %.0f projectiles/s for %.1f s, %d fired, %d spawned, %d reused"),
+				Pass->bUsePool ? TEXT("pooled") : TEXT("SpawnActor"), *GetNameSafe(Pass->ProjectileClass), Pass->ProjectilesPerSecond, Pass->Elapsed, Pass->ProjectilesFired,
+				Pass->bUsePool ? ProjectilePool->GetNumSpawned() - Pass->StartSpawned : Pass->ProjectilesFired, ProjectilePool->GetNumReused() - Pass->StartReused);
+			UE_LOG(OWS, Display, TEXT("  Spawn cost: %.3f ms total, %.2f us per projectile, worst frame %.3f ms"),
+				Pass->SpawnSeconds * 1000.0, Pass->ProjectilesFired > 0 ? Pass->SpawnSeconds * 1000000.0 / Pass->ProjectilesFired : 0.0, Pass->WorstFrameSpawnSeconds * 1000.0);
+			UE_LOG(OWS, Display, TEXT("  GC: %d passes taking %.3f ms during the run, %.3f ms for the final purge"),
+				Pass->GCPasses, Pass->GCSeconds * 1000.0, PurgeSeconds * 1000.0);
+			Pass->FrameTimes.LogAndReset();
+			return false;
+		}));
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs StressTestCommand(
+		TEXT("OWS.Projectiles.PoolStress"),
+		TEXT("Fires short lived projectiles high above the map and logs spawn and GC time. Run with and without the pool to compare. Args: [ProjectilesPerSecond=5000] [Seconds=10] [UsePool=1] [ProjectileClassPath]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&StressTest));
+}
+
+#endif
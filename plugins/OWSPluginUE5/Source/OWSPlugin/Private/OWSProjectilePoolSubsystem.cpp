@@ -0,0 +1,155 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "OWSProjectilePoolSubsystem.h"
+#include "Engine/World.h"
+#include "OWSAdvancedProjectile.h"
+#include "Runtime/Core/Public/Misc/ConfigCacheIni.h"
+
+void UOWSProjectilePoolSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	MaxIdleProjectilesPerClass = 256;
+	NumSpawned = 0;
+	NumReused = 0;
+
+	GConfig->GetInt(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSProjectilePoolMaxIdlePerClass"),
+		MaxIdleProjectilesPerClass,
+		GGameIni
+	);
+
+	MaxIdleProjectilesPerClass = FMath::Max(MaxIdleProjectilesPerClass, 0);
+}
+
+bool UOWSProjectilePoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UOWSProjectilePoolSubsystem::CanPool(TSubclassOf<AOWSAdvancedProjectile> ProjectileClass, bool bFakeClientProjectile) const
+{
+	const AOWSAdvancedProjectile* DefaultProjectile = ProjectileClass ? ProjectileClass->GetDefaultObject<AOWSAdvancedProjectile>() : nullptr;
+	if (!DefaultProjectile || !DefaultProjectile->bUseProjectilePool || MaxIdleProjectilesPerClass == 0)
+	{
+		return false;
+	}
+
+	const ENetMode NetMode = GetWorld()->GetNetMode();
+	if (NetMode == NM_Standalone)
+	{
+		return true;
+	}
+
+	//Fakes are spawned locally on the predicting client and never replicated.  Anything else on a client belongs to the server.
+	if (NetMode == NM_Client)
+	{
+		return bFakeClientProjectile;
+	}
+
+	//A net temporary actor is only ever sent to a connection once, so a reused one would stay invisible to clients
+	return !DefaultProjectile->GetIsReplicated() || !DefaultProjectile->bNetTemporary;
+}
+
+int32 UOWSProjectilePoolSubsystem::GetNumIdle(TSubclassOf<AOWSAdvancedProjectile> ProjectileClass) const
+{
+	const FOWSProjectilePoolList* Pool = IdleProjectiles.Find(ProjectileClass.Get());
+	return Pool ? Pool->Projectiles.Num() : 0;
+}
+
+void UOWSProjectilePoolSubsystem::WarmUp(TSubclassOf<AOWSAdvancedProjectile> ProjectileClass, int32 Count)
+{
+	if (!CanPool(ProjectileClass, GetWorld()->GetNetMode() == NM_Client))
+	{
+		return;
+	}
+
+	FOWSProjectilePoolList& Pool = IdleProjectiles.FindOrAdd(ProjectileClass.Get());
+	const int32 NumToSpawn = FMath::Min(Count, MaxIdleProjectilesPerClass) - Pool.Projectiles.Num();
+	for (int32 i = 0; i < NumToSpawn; i++)
+	{
+		AOWSAdvancedProjectile* Projectile = GetWorld()->SpawnActorDeferred<AOWSAdvancedProjectile>(ProjectileClass, FTransform::Identity, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (!Projectile)
+		{
+			UE_LOG(OWS, Warning, TEXT("UOWSProjectilePoolSubsystem::WarmUp failed to spawn %s"), *GetNameSafe(ProjectileClass));
+			return;
+		}
+
+		//Keep it from overlapping anything before it is parked
+		Projectile->SetActorEnableCollision(false);
+		Projectile->FinishSpawning(FTransform::Identity);
+		Projectile->MarkPooled();
+		Projectile->ResetForPool();
+		Pool.Projectiles.Add(Projectile);
+		NumSpawned++;
+	}
+}
+
+AOWSAdvancedProjectile* UOWSProjectilePoolSubsystem::AcquireProjectile(TSubclassOf<AOWSAdvancedProjectile> ProjectileClass, const FTransform& SpawnTransform, APawn* Instigator, bool bFakeClientProjectile)
+{
+	if (!ProjectileClass)
+	{
+		return nullptr;
+	}
+
+	const bool bPooled = CanPool(ProjectileClass, bFakeClientProjectile);
+	if (bPooled)
+	{
+		if (FOWSProjectilePoolList* Pool = IdleProjectiles.Find(ProjectileClass.Get()))
+		{
+			while (Pool->Projectiles.Num() > 0)
+			{
+				AOWSAdvancedProjectile* Projectile = Pool->Projectiles.Pop(EAllowShrinking::No);
+
+				//Idle projectiles can still be destroyed with their level
+				if (IsValid(Projectile))
+				{
+					Projectile->ActivateFromPool(SpawnTransform, Instigator);
+					NumReused++;
+					return Projectile;
+				}
+			}
+		}
+	}
+
+	return SpawnProjectile(ProjectileClass, SpawnTransform, Instigator, bPooled);
+}
+
+AOWSAdvancedProjectile* UOWSProjectilePoolSubsystem::SpawnProjectile(UClass* ProjectileClass, const FTransform& SpawnTransform, APawn* Instigator, bool bPooled)
+{
+	FActorSpawnParameters Params;
+	Params.Instigator = Instigator;
+	Params.Owner = Instigator;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AOWSAdvancedProjectile* Projectile = GetWorld()->SpawnActor<AOWSAdvancedProjectile>(ProjectileClass, SpawnTransform, Params);
+	if (Projectile)
+	{
+		NumSpawned++;
+		if (bPooled)
+		{
+			Projectile->MarkPooled();
+		}
+	}
+
+	return Projectile;
+}
+
+void UOWSProjectilePoolSubsystem::ReleaseProjectile(AOWSAdvancedProjectile* Projectile)
+{
+	if (!IsValid(Projectile) || Projectile->IsInProjectilePool())
+	{
+		return;
+	}
+
+	FOWSProjectilePoolList& Pool = IdleProjectiles.FindOrAdd(Projectile->GetClass());
+	if (Pool.Projectiles.Num() >= MaxIdleProjectilesPerClass)
+	{
+		Projectile->Destroy();
+		return;
+	}
+
+	Projectile->ResetForPool();
+	Pool.Projectiles.Add(Projectile);
+}
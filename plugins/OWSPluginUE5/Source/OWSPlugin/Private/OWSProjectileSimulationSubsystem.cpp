@@ -0,0 +1,360 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "OWSProjectileSimulationSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "OWSAdvancedProjectile.h"
+
+namespace OWSProjectileSimulation
+{
+	//Below this many projectiles the sweeps run on the game thread
+	const int32 MinProjectilesForParallelSweeps = 64;
+
+	const uint8 CollisionCompOverlaps = 1;
+	const uint8 PawnOverlapSphereOverlaps = 2;
+}
+
+void UOWSProjectileSimulationSubsystem::Deinitialize()
+{
+	for (const TWeakObjectPtr<AOWSAdvancedProjectile>& Projectile : Projectiles)
+	{
+		if (Projectile.IsValid())
+		{
+			Projectile->BatchedSimulationIndex = INDEX_NONE;
+		}
+	}
+
+	Projectiles.Empty();
+	SavedOverlapFlags.Empty();
+	Locations.Empty();
+	Velocities.Empty();
+	Accelerations.Empty();
+	Results.Empty();
+	NumSimulated = 0;
+
+	Super::Deinitialize();
+}
+
+bool UOWSProjectileSimulationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UOWSProjectileSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOWSProjectileSimulationSubsystem, STATGROUP_Tickables);
+}
+
+bool UOWSProjectileSimulationSubsystem::CanSimulate(const AOWSAdvancedProjectile* Projectile)
+{
+	if (!Projectile || !Projectile->CollisionComp || Projectile->GetNetMode() == NM_Client)
+	{
+		return false;
+	}
+
+	//Subclasses such as UOWSProjectileMovementComponent change how velocity and impacts are computed
+	const UProjectileMovementComponent* ProjectileMovement = Projectile->ProjectileMovement;
+	return ProjectileMovement
+		&& ProjectileMovement->GetClass() == UProjectileMovementComponent::StaticClass()
+		&& ProjectileMovement->UpdatedComponent == Projectile->CollisionComp
+		&& ProjectileMovement->IsActive()
+		&& !ProjectileMovement->HasStoppedSimulation()
+		&& !ProjectileMovement->bShouldBounce
+		&& !ProjectileMovement->bInterpMovement
+		&& !Projectile->CollisionComp->IsSimulatingPhysics();
+}
+
+bool UOWSProjectileSimulationSubsystem::RegisterProjectile(AOWSAdvancedProjectile* Projectile)
+{
+	if (!CanSimulate(Projectile))
+	{
+		return false;
+	}
+
+	if (Projectile->BatchedSimulationIndex != INDEX_NONE)
+	{
+		return true;
+	}
+
+	//Overlaps come from the batched sweeps instead of from moving the components
+	uint8 OverlapFlags = 0;
+	if (Projectile->CollisionComp->GetGenerateOverlapEvents())
+	{
+		OverlapFlags |= OWSProjectileSimulation::CollisionCompOverlaps;
+		Projectile->CollisionComp->SetGenerateOverlapEvents(false);
+	}
+	if (Projectile->PawnOverlapSphere && Projectile->PawnOverlapSphere->GetGenerateOverlapEvents())
+	{
+		OverlapFlags |= OWSProjectileSimulation::PawnOverlapSphereOverlaps;
+		Projectile->PawnOverlapSphere->SetGenerateOverlapEvents(false);
+	}
+	Projectile->ProjectileMovement->SetComponentTickEnabled(false);
+
+	Projectile->BatchedSimulationIndex = Projectiles.Add(Projectile);
+	SavedOverlapFlags.Add(OverlapFlags);
+	NumSimulated++;
+	return true;
+}
+
+void UOWSProjectileSimulationSubsystem::UnregisterProjectile(AOWSAdvancedProjectile* Projectile)
+{
+	const int32 Index = Projectile ? Projectile->BatchedSimulationIndex : INDEX_NONE;
+	if (!Projectiles.IsValidIndex(Index) || Projectiles[Index].Get() != Projectile)
+	{
+		return;
+	}
+
+	RestoreProjectile(Projectile, SavedOverlapFlags[Index]);
+	Projectiles[Index] = nullptr;
+	Projectile->BatchedSimulationIndex = INDEX_NONE;
+	NumSimulated--;
+}
+
+void UOWSProjectileSimulationSubsystem::RestoreProjectile(AOWSAdvancedProjectile* Projectile, uint8 OverlapFlags)
+{
+	if (OverlapFlags & OWSProjectileSimulation::CollisionCompOverlaps)
+	{
+		Projectile->CollisionComp->SetGenerateOverlapEvents(true);
+	}
+	if ((OverlapFlags & OWSProjectileSimulation::PawnOverlapSphereOverlaps) && Projectile->PawnOverlapSphere)
+	{
+		Projectile->PawnOverlapSphere->SetGenerateOverlapEvents(true);
+	}
+
+	UProjectileMovementComponent* ProjectileMovement = Projectile->ProjectileMovement;
+	ProjectileMovement->SetComponentTickEnabled(ProjectileMovement->IsActive() && !ProjectileMovement->HasStoppedSimulation());
+}
+
+void UOWSProjectileSimulationSubsystem::CompactProjectiles()
+{
+	for (int32 Index = Projectiles.Num() - 1; Index >= 0; Index--)
+	{
+		AOWSAdvancedProjectile* Projectile = Projectiles[Index].Get();
+		if (Projectile && Projectile->BatchedSimulationIndex == Index)
+		{
+			continue;
+		}
+
+		//Destroyed without unregistering, e.g. with a streamed out level
+		if (Projectiles[Index].IsStale())
+		{
+			NumSimulated--;
+		}
+
+		Projectiles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		SavedOverlapFlags.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		if (Projectiles.IsValidIndex(Index))
+		{
+			if (AOWSAdvancedProjectile* MovedProjectile = Projectiles[Index].Get())
+			{
+				MovedProjectile->BatchedSimulationIndex = Index;
+			}
+		}
+	}
+}
+
+void UOWSProjectileSimulationSubsystem::Tick(float DeltaTime)
+{
+	CompactProjectiles();
+
+	const int32 NumProjectiles = Projectiles.Num();
+	if (NumProjectiles == 0 || DeltaTime <= 0.f)
+	{
+		return;
+	}
+
+	Locations.SetNumUninitialized(NumProjectiles, EAllowShrinking::No);
+	Velocities.SetNumUninitialized(NumProjectiles, EAllowShrinking::No);
+	Accelerations.SetNumUninitialized(NumProjectiles, EAllowShrinking::No);
+	Results.SetNum(NumProjectiles, EAllowShrinking::No);
+
+	//Gather on the game thread.  Velocity is read back every frame so catchup ticks, PostNetReceiveVelocity and Blueprint changes are kept.
+	const float WorldGravityZ = GetWorld()->GetGravityZ();
+	for (int32 Index = 0; Index < NumProjectiles; Index++)
+	{
+		AOWSAdvancedProjectile* Projectile = Projectiles[Index].Get();
+		UProjectileMovementComponent* ProjectileMovement = Projectile->ProjectileMovement;
+
+		//ShutDown or a Blueprint turned the movement off since the last frame
+		if (!ProjectileMovement->IsActive() || ProjectileMovement->HasStoppedSimulation() || Projectile->bExploded)
+		{
+			UnregisterProjectile(Projectile);
+			continue;
+		}
+
+		const FVector Location = Projectile->CollisionComp->GetComponentLocation();
+		FVector Acceleration(0.f, 0.f, WorldGravityZ * ProjectileMovement->ProjectileGravityScale);
+
+		//Same as UProjectileMovementComponent::ComputeHomingAcceleration
+		USceneComponent* HomingTarget = ProjectileMovement->bIsHomingProjectile ? ProjectileMovement->HomingTargetComponent.Get() : nullptr;
+		if (HomingTarget)
+		{
+			Acceleration += (HomingTarget->GetComponentLocation() - Location).GetSafeNormal() * ProjectileMovement->HomingAccelerationMagnitude;
+		}
+
+		Locations[Index] = Location;
+		Velocities[Index] = ProjectileMovement->Velocity;
+		Accelerations[Index] = Acceleration;
+	}
+
+	ParallelFor(NumProjectiles, [this, DeltaTime](int32 Index)
+	{
+		SimulateProjectile(Index, DeltaTime);
+	}, NumProjectiles < OWSProjectileSimulation::MinProjectilesForParallelSweeps ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	//Hit callbacks can unregister, pool or destroy projectiles, or register new ones past NumProjectiles
+	for (int32 Index = 0; Index < NumProjectiles; Index++)
+	{
+		ApplyMove(Index);
+	}
+}
+
+void UOWSProjectileSimulationSubsystem::SimulateProjectile(int32 Index, float DeltaTime)
+{
+	FOWSProjectileMoveResult& Result = Results[Index];
+	Result.bBlockingHit = false;
+	Result.CollisionTouches.Reset();
+	Result.PawnTouches.Reset();
+
+	AOWSAdvancedProjectile* Projectile = Projectiles[Index].Get();
+	if (!Projectile || Projectile->BatchedSimulationIndex != Index)
+	{
+		return;
+	}
+
+	const UProjectileMovementComponent* ProjectileMovement = Projectile->ProjectileMovement;
+	const FVector Start = Locations[Index];
+	const FVector Acceleration = Accelerations[Index];
+	FVector Velocity = Velocities[Index];
+
+	//Substep the integration the same way UProjectileMovementComponent::GetSimulationTimeStep would, but sweep the whole move once
+	const int32 NumSteps = ProjectileMovement->MaxSimulationTimeStep > 0.f
+		? FMath::Clamp(FMath::CeilToInt32(DeltaTime / ProjectileMovement->MaxSimulationTimeStep), 1, FMath::Max(ProjectileMovement->MaxSimulationIterations, 1))
+		: 1;
+	const float StepTime = DeltaTime / NumSteps;
+	FVector MoveDelta = FVector::ZeroVector;
+	for (int32 Step = 0; Step < NumSteps; Step++)
+	{
+		const FVector NewVelocity = ProjectileMovement->LimitVelocity(Velocity + Acceleration * StepTime);
+		MoveDelta += (Velocity * StepTime) + (NewVelocity - Velocity) * (0.5f * StepTime);
+		Velocity = NewVelocity;
+	}
+
+	FVector Direction = Velocity;
+	if (ProjectileMovement->bRotationRemainsVertical)
+	{
+		Direction.Z = 0.f;
+	}
+	const FQuat Rotation = (ProjectileMovement->bRotationFollowsVelocity && !Direction.IsNearlyZero(0.01f))
+		? Direction.ToOrientationQuat()
+		: Projectile->CollisionComp->GetComponentQuat();
+
+	FVector End = Start + MoveDelta;
+	Result.Velocity = Velocity;
+	Result.Rotation = Rotation;
+	Result.Location = End;
+
+	if (MoveDelta.IsNearlyZero())
+	{
+		return;
+	}
+
+	UWorld* World = Projectile->GetWorld();
+	TArray<FHitResult, TInlineAllocator<4>> Hits;
+
+	if (ProjectileMovement->bSweepCollision)
+	{
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(OWSProjectileSweep), false, Projectile);
+		FCollisionResponseParams ResponseParams;
+		Projectile->CollisionComp->InitSweepCollisionParams(QueryParams, ResponseParams);
+		World->SweepMultiByChannel(Hits, Start, End, Rotation, Projectile->CollisionComp->GetCollisionObjectType(), Projectile->CollisionComp->GetCollisionShape(), QueryParams, ResponseParams);
+
+		//Touches come back sorted by distance with the blocking hit, if any, last
+		for (const FHitResult& Hit : Hits)
+		{
+			if (Hit.bBlockingHit)
+			{
+				Result.bBlockingHit = true;
+				Result.BlockingHit = Hit;
+
+				//Stop just short of the hit, the same as UPrimitiveComponent::MoveComponent pulling the hit back
+				const float MoveDistance = MoveDelta.Size();
+				const float TimeBack = FMath::Clamp(0.1f, 0.1f / MoveDistance, 1.f / MoveDistance) + UE_KINDA_SMALL_NUMBER;
+				End = Start + MoveDelta * FMath::Clamp(Hit.Time - TimeBack, 0.f, 1.f);
+				Result.Location = End;
+			}
+			else if (Hit.GetActor())
+			{
+				Result.CollisionTouches.Add(Hit);
+			}
+		}
+	}
+
+	USphereComponent* PawnOverlapSphere = Projectile->PawnOverlapSphere;
+	if (PawnOverlapSphere && PawnOverlapSphere->IsCollisionEnabled())
+	{
+		Hits.Reset();
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(OWSProjectilePawnSweep), false, Projectile);
+		FCollisionResponseParams ResponseParams;
+		PawnOverlapSphere->InitSweepCollisionParams(QueryParams, ResponseParams);
+		World->SweepMultiByChannel(Hits, Start, End, Rotation, PawnOverlapSphere->GetCollisionObjectType(), PawnOverlapSphere->GetCollisionShape(), QueryParams, ResponseParams);
+
+		for (const FHitResult& Hit : Hits)
+		{
+			if (Hit.GetActor())
+			{
+				Result.PawnTouches.Add(Hit);
+			}
+		}
+	}
+}
+
+void UOWSProjectileSimulationSubsystem::ApplyMove(int32 Index)
+{
+	AOWSAdvancedProjectile* Projectile = Projectiles[Index].Get();
+	if (!Projectile || Projectile->BatchedSimulationIndex != Index)
+	{
+		return;
+	}
+
+	const FOWSProjectileMoveResult& Result = Results[Index];
+	UProjectileMovementComponent* ProjectileMovement = Projectile->ProjectileMovement;
+
+	//Overlap events are off on the spheres while simulated here, so this skips the overlap update a swept MoveComponent would do
+	Projectile->CollisionComp->SetWorldLocationAndRotation(Result.Location, Result.Rotation, false, nullptr, ETeleportType::None);
+	ProjectileMovement->Velocity = Result.Velocity;
+	ProjectileMovement->UpdateComponentVelocity();
+
+	//Same order as a swept move: overlaps along the way, then the blocking hit
+	auto IsStillFlying = [Projectile, Index]()
+	{
+		return IsValid(Projectile) && Projectile->BatchedSimulationIndex == Index && !Projectile->bExploded;
+	};
+
+	for (const FHitResult& Touch : Result.CollisionTouches)
+	{
+		if (!IsStillFlying())
+		{
+			return;
+		}
+		Projectile->OnOverlapBegin(Projectile->CollisionComp, Touch.GetActor(), Touch.GetComponent(), Touch.Item, true, Touch);
+	}
+
+	for (const FHitResult& Touch : Result.PawnTouches)
+	{
+		if (!IsStillFlying() || !Projectile->PawnOverlapSphere)
+		{
+			return;
+		}
+		Projectile->OnPawnSphereOverlapBegin(Projectile->PawnOverlapSphere, Touch.GetActor(), Touch.GetComponent(), Touch.Item, true, Touch);
+	}
+
+	if (Result.bBlockingHit && IsStillFlying())
+	{
+		//StopSimulating broadcasts OnProjectileStop, which is AOWSAdvancedProjectile::OnStop and ProcessHit
+		UnregisterProjectile(Projectile);
+		ProjectileMovement->StopSimulating(Result.BlockingHit);
+	}
+}
@@ -0,0 +1,1035 @@
+// Copyright 2018 Sabre Dart Studios
+
+#include "OWSReplicationGraph.h"
+#include "OWSPlugin.h"
+#include "Net/UnrealNetwork.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/LevelBounds.h"
+#include "EngineUtils.h"
+#include "CoreGlobals.h"
+#include "UObject/UObjectIterator.h"
+#include "Engine/NetConnection.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "OWSCharacter.h"
+#include "OWSAdvancedProjectile.h"
+#include "OWSInventoryItem.h"
+#include "OWSAbilityActor.h"
+#include "OWSEnvironmentAbilityActor.h"
+
+UOWSReplicationGraph::UOWSReplicationGraph()
+{
+	// Defaults for the plugin's own classes.  ClassReplicationRules in DefaultEngine.ini replaces these.
+	ClassReplicationRules.Emplace(AOWSCharacter::StaticClass(), EOWSClassRepNodeMapping::Spatialize_Dynamic, -1.f, -1, -1.f);
+	ClassReplicationRules.Emplace(AOWSAdvancedProjectile::StaticClass(), EOWSClassRepNodeMapping::Spatialize_Dynamic, -1.f, 1, 2.f);
+	ClassReplicationRules.Emplace(AOWSInventoryItem::StaticClass(), EOWSClassRepNodeMapping::RelevantToOwner, -1.f, -1, -1.f);
+	ClassReplicationRules.Emplace(AOWSAbilityActor::StaticClass(), EOWSClassRepNodeMapping::Spatialize_Dormancy, -1.f, -1, -1.f);
+	ClassReplicationRules.Emplace(AOWSEnvironmentAbilityActor::StaticClass(), EOWSClassRepNodeMapping::Spatialize_Static, -1.f, -1, -1.f);
+}
+
+void UOWSReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// Resolve the rule table once up front rather than per class
+	TMap<UClass*, const FOWSClassReplicationRule*> RulesByClass;
+	for (const FOWSClassReplicationRule& Rule : ClassReplicationRules)
+	{
+		if (UClass* RuleClass = Rule.ActorClass.LoadSynchronous())
+		{
+			RulesByClass.Add(RuleClass, &Rule);
+		}
+		else
+		{
+			UE_LOG(LogNet, Warning, TEXT("UOWSReplicationGraph: Could not load class %s from ClassReplicationRules."), *Rule.ActorClass.ToString());
+		}
+	}
+
+	auto FindRule = [&RulesByClass](UClass* Class) -> const FOWSClassReplicationRule*
+	{
+		for (UClass* RuleClass = Class; RuleClass; RuleClass = RuleClass->GetSuperClass())
+		{
+			if (const FOWSClassReplicationRule* Rule = RulesByClass.FindRef(RuleClass))
+			{
+				return Rule;
+			}
+		}
+		return nullptr;
+	};
+
+	// Player states are routed to UOWSReplicationGraphNode_PlayerStateFrequencyLimiter, and subclasses inherit these settings
+	FClassReplicationInfo PlayerStateRepInfo;
+	PlayerStateRepInfo.DistancePriorityScale = 0.f;
+	PlayerStateRepInfo.ActorChannelFrameTimeout = 0;
+	GlobalActorReplicationInfoMap.SetClassInfo(APlayerState::StaticClass(), PlayerStateRepInfo);
+
+	// ReplicationGraph stores internal associative data for actor classes. 
+	// We build this data here based on actor CDO values.
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+		if (!ActorCDO || !ActorCDO->GetIsReplicated() || Class->IsChildOf(APlayerState::StaticClass()))
+		{
+			continue;
+		}
+
+		// Skip SKEL and REINST classes.
+		if (Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		const FOWSClassReplicationRule* Rule = FindRule(Class);
+
+		EOWSClassRepNodeMapping NodeMapping;
+		if (Rule)
+		{
+			NodeMapping = Rule->NodeMapping;
+		}
+		else if (ActorCDO->bAlwaysRelevant)
+		{
+			NodeMapping = EOWSClassRepNodeMapping::RelevantAllConnections;
+		}
+		else if (ActorCDO->bOnlyRelevantToOwner)
+		{
+			NodeMapping = EOWSClassRepNodeMapping::RelevantToOwner;
+		}
+		else if (ActorCDO->GetRootComponent() && ActorCDO->GetRootComponent()->Mobility == EComponentMobility::Static)
+		{
+			//Static actors are added to their cells once and never re-bucketed
+			NodeMapping = EOWSClassRepNodeMapping::Spatialize_Static;
+		}
+		else
+		{
+			NodeMapping = EOWSClassRepNodeMapping::Spatialize_Dormancy;
+		}
+
+		ClassRepNodePolicies.Set(Class, NodeMapping);
+
+		FClassReplicationInfo ClassInfo;
+
+		// Replication Graph is frame based. Convert NetUpdateFrequency to ReplicationPeriodFrame based on Server MaxTickRate.
+		if (Rule && Rule->ReplicationPeriodFrame >= 0)
+		{
+			ClassInfo.ReplicationPeriodFrame = FMath::Max(Rule->ReplicationPeriodFrame, 1);
+		}
+		else
+		{
+			ClassInfo.ReplicationPeriodFrame = FMath::Max<uint32>((uint32)FMath::RoundToFloat(NetDriver->GetNetServerMaxTickRate() / ActorCDO->GetNetUpdateFrequency()), 1);
+		}
+
+		if (NodeMapping == EOWSClassRepNodeMapping::RelevantAllConnections || NodeMapping == EOWSClassRepNodeMapping::RelevantToOwner)
+		{
+			ClassInfo.SetCullDistanceSquared(0.f);
+		}
+		else if (Rule && Rule->CullDistance >= 0.f)
+		{
+			ClassInfo.SetCullDistanceSquared(FMath::Square(Rule->CullDistance));
+		}
+		else
+		{
+			ClassInfo.SetCullDistanceSquared(ActorCDO->GetNetCullDistanceSquared());
+		}
+
+		if (Rule && Rule->StarvationPriorityScale >= 0.f)
+		{
+			ClassInfo.StarvationPriorityScale = Rule->StarvationPriorityScale;
+		}
+
+		//Distant characters are only gathered every DistantCharacterReplicationPeriodFrames, so keep their channels open in between
+		if (DistantCharacterCullDistance > 0.f && Class->IsChildOf(AOWSCharacter::StaticClass()))
+		{
+			ClassInfo.ActorChannelFrameTimeout = (uint8)FMath::Clamp<int32>(DistantCharacterReplicationPeriodFrames * 2, ClassInfo.ActorChannelFrameTimeout, MAX_uint8);
+		}
+
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+}
+
+EOWSClassRepNodeMapping UOWSReplicationGraph::GetMappingPolicy(UClass* Class)
+{
+	// Classes loaded after InitGlobalActorClassSettings use their closest parent's policy
+	if (const EOWSClassRepNodeMapping* Policy = ClassRepNodePolicies.Get(Class))
+	{
+		return *Policy;
+	}
+	return EOWSClassRepNodeMapping::Spatialize_Dormancy;
+}
+
+void UOWSReplicationGraph::InitGlobalGraphNodes()
+{
+	// -----------------------------------------------
+	//	Spatial Actors
+	// -----------------------------------------------
+
+	// Resized to the zone's bounds in ApplyZoneSpatialSettings
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = DefaultGridCellSize;
+	GridNode->SpatialBias = FVector2D(-UE_OLD_WORLD_MAX, -UE_OLD_WORLD_MAX);
+
+	AddGlobalGraphNode(GridNode);
+
+	// -----------------------------------------------
+	//	Always Relevant (to everyone) Actors
+	// -----------------------------------------------
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+
+	// -----------------------------------------------
+	//	Player State specialization. This will return a rolling subset of the player states to replicate
+	// -----------------------------------------------
+	PlayerStateNode = CreateNewNode<UOWSReplicationGraphNode_PlayerStateFrequencyLimiter>();
+	AddGlobalGraphNode(PlayerStateNode);
+
+	// -----------------------------------------------
+	//	Characters past their class cull distance, at a reduced rate per connection
+	// -----------------------------------------------
+	if (DistantCharacterCullDistance > 0.f)
+	{
+		DistantCharacterNode = CreateNewNode<UOWSReplicationGraphNode_DistantCharacters>();
+		DistantCharacterNode->CellSize = DistantCharacterCullDistance;
+		DistantCharacterNode->ReplicationPeriodFrames = FMath::Max(DistantCharacterReplicationPeriodFrames, 1);
+		AddGlobalGraphNode(DistantCharacterNode);
+	}
+}
+
+void UOWSReplicationGraph::ApplyZoneSpatialSettings(const FString& ZoneName, const FString& MapName)
+{
+	if (!GridNode)
+	{
+		return;
+	}
+
+	const FOWSZoneSpatialSettings* Settings = ZoneSpatialSettings.FindByPredicate([&ZoneName](const FOWSZoneSpatialSettings& Entry) { return !ZoneName.IsEmpty() && Entry.ZoneName == ZoneName; });
+	if (!Settings)
+	{
+		Settings = ZoneSpatialSettings.FindByPredicate([&MapName](const FOWSZoneSpatialSettings& Entry) { return !MapName.IsEmpty() && Entry.ZoneName == MapName; });
+	}
+
+	if (Settings)
+	{
+		SetGridSpatialBounds(FBox2D(Settings->BoundsMin, Settings->BoundsMax), Settings->CellSize);
+		return;
+	}
+
+	// No entry for this zone, so fall back to everything placed in the persistent level
+	UWorld* World = GetWorld();
+	if (World && World->PersistentLevel)
+	{
+		const FBox LevelBounds = ALevelBounds::CalculateLevelBounds(World->PersistentLevel);
+		if (LevelBounds.IsValid)
+		{
+			SetGridSpatialBounds(FBox2D(FVector2D(LevelBounds.Min), FVector2D(LevelBounds.Max)), 0.f);
+			return;
+		}
+	}
+
+	UE_LOG(OWS, Warning, TEXT("UOWSReplicationGraph: No spatial bounds for zone %s, keeping a grid cell size of %.0f."), *ZoneName, GridNode->CellSize);
+}
+
+void UOWSReplicationGraph::SetGridSpatialBounds(const FBox2D& Bounds, float CellSize)
+{
+	const FVector2D Size = Bounds.GetSize();
+	if (!Bounds.bIsValid || Size.X <= 0.f || Size.Y <= 0.f)
+	{
+		UE_LOG(OWS, Warning, TEXT("UOWSReplicationGraph: Ignoring empty spatial bounds %s."), *Bounds.ToString());
+		return;
+	}
+
+	if (CellSize <= 0.f)
+	{
+		CellSize = FMath::Clamp(static_cast<float>(Size.GetMax()) / FMath::Max(TargetGridCellsPerAxis, 1), MinGridCellSize, MaxGridCellSize);
+	}
+
+	// One cell of margin so actors standing on the edge of the map don't all land in the clamped border cells
+	const FVector2D SpatialBias = Bounds.Min - FVector2D(CellSize, CellSize);
+
+	if (FMath::IsNearlyEqual(GridNode->CellSize, CellSize) && GridNode->SpatialBias.Equals(SpatialBias))
+	{
+		return;
+	}
+
+	UE_LOG(OWS, Display, TEXT("UOWSReplicationGraph: Grid cell size %.0f, spatial bias %s, %d x %d cells."), CellSize, *SpatialBias.ToString(),
+		FMath::CeilToInt32(Size.X / CellSize) + 2, FMath::CeilToInt32(Size.Y / CellSize) + 2);
+
+	GridNode->CellSize = CellSize;
+	GridNode->SpatialBias = SpatialBias;
+
+	// Re-buckets the actors that were added under the default grid on the next replication frame
+	GridNode->ForceRebuild();
+}
+
+void UOWSReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantNodeForConnection = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(AlwaysRelevantNodeForConnection, RepGraphConnection);
+
+	AlwaysRelevantForConnectionMap.Add(RepGraphConnection->NetConnection, AlwaysRelevantNodeForConnection);
+}
+
+void UOWSReplicationGraph::RemoveClientConnection(UNetConnection* NetConnection)
+{
+	// Leave the party while the connection manager still exists, so the party node can be detached from it
+	if (AOWSPlayerState* PS = PartyMembersByConnection.FindRef(NetConnection))
+	{
+		RemovePlayerFromParty(PS);
+	}
+
+	AlwaysRelevantForConnectionMap.Remove(NetConnection);
+
+	Super::RemoveClientConnection(NetConnection);
+}
+
+void UOWSReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	// Player states are always relevant, but replicate through the frequency limiter rather than to everyone every frame
+	if (ActorInfo.Actor->IsA<APlayerState>())
+	{
+		PlayerStateNode->NotifyAddNetworkActor(ActorInfo);
+		return;
+	}
+
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case EOWSClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+
+	case EOWSClassRepNodeMapping::RelevantToOwner:
+		ActorsWithoutNetConnection.Add(ActorInfo.Actor);
+		break;
+
+	case EOWSClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+
+	case EOWSClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		if (DistantCharacterNode && ActorInfo.Actor->IsA<AOWSCharacter>())
+		{
+			DistantCharacterNode->NotifyAddNetworkActor(ActorInfo);
+		}
+		break;
+
+	case EOWSClassRepNodeMapping::Spatialize_Dormancy:
+		// Treated as possibly dynamic (moving) when not dormant, and as static (not moving) when dormant.
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+
+	default:
+		break;
+	}
+}
+
+void UOWSReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	if (ActorInfo.Actor->IsA<APlayerState>())
+	{
+		// Covers players leaving the zone without RemovePlayerFromParty or a connection teardown being seen first
+		AOWSPlayerState* OWSPlayerState = Cast<AOWSPlayerState>(ActorInfo.Actor);
+		if (OWSPlayerState && PlayerPartyNodes.Contains(OWSPlayerState))
+		{
+			RemovePlayerFromParty(OWSPlayerState);
+		}
+
+		PlayerStateNode->NotifyRemoveNetworkActor(ActorInfo);
+		return;
+	}
+
+	switch (GetMappingPolicy(ActorInfo.Class))
+	{
+	case EOWSClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+
+	case EOWSClassRepNodeMapping::RelevantToOwner:
+		if (ActorInfo.Actor->GetNetConnection())
+		{
+			if (UReplicationGraphNode* Node = GetAlwaysRelevantNodeForConnection(ActorInfo.Actor->GetNetConnection()))
+			{
+				Node->NotifyRemoveNetworkActor(ActorInfo);
+			}
+		}
+		ActorsWithoutNetConnection.RemoveSwap(ActorInfo.Actor);
+		break;
+
+	case EOWSClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+
+	case EOWSClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		if (DistantCharacterNode && ActorInfo.Actor->IsA<AOWSCharacter>())
+		{
+			DistantCharacterNode->NotifyRemoveNetworkActor(ActorInfo);
+		}
+		break;
+
+	case EOWSClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+
+	default:
+		break;
+	}
+}
+
+UReplicationGraphNode_AlwaysRelevant_ForConnection* UOWSReplicationGraph::GetAlwaysRelevantNodeForConnection(UNetConnection* Connection)
+{
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* Node = nullptr;
+	if (Connection)
+	{
+		if (UReplicationGraphNode_AlwaysRelevant_ForConnection** FoundNode = AlwaysRelevantForConnectionMap.Find(Connection))
+		{
+			if (*FoundNode)
+			{
+				Node = *FoundNode;
+			}
+			else
+			{
+				UE_LOG(LogNet, Warning, TEXT("AlwaysRelevantNode for connection %s is null."), *GetNameSafe(Connection));
+			}
+		}
+		else
+		{
+			UE_LOG(LogNet, Warning, TEXT("Could not find AlwaysRelevantNode for connection %s. This should have been created in UBasicReplicationGraph::InitConnectionGraphNodes."), *GetNameSafe(Connection));
+		}
+	}
+	else
+	{
+		// Basic implementation requires owner is set on spawn that never changes. A more robust graph would have methods or ways of listening for owner to change
+		UE_LOG(LogNet, Warning, TEXT("Actor is bOnlyRelevantToOwner but does not have an owning Netconnection. It will not be replicated"));
+	}
+
+	return Node;
+}
+
+int32 UOWSReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	// Route Actors needing owning net connections to appropriate nodes
+	for (int32 idx = ActorsWithoutNetConnection.Num() - 1; idx >= 0; --idx)
+	{
+		bool bRemove = false;
+		if (AActor* Actor = ActorsWithoutNetConnection[idx])
+		{
+			if (UNetConnection* Connection = Actor->GetNetConnection())
+			{
+				bRemove = true;
+				if (Connection)
+				{
+					if (UReplicationGraphNode_AlwaysRelevant_ForConnection* Node = GetAlwaysRelevantNodeForConnection(Actor->GetNetConnection()))
+					{
+						Node->NotifyAddNetworkActor(FNewReplicatedActorInfo(Actor));
+					}
+				}
+			}
+		}
+		else
+		{
+			bRemove = true;
+		}
+
+		if (bRemove)
+		{
+			ActorsWithoutNetConnection.RemoveAtSwap(idx, EAllowShrinking::No);
+		}
+	}
+
+
+	return Super::ServerReplicateActors(DeltaSeconds);
+}
+
+UOWSReplicationGraphNode_AlwaysRelevantToParty* UOWSReplicationGraph::GetNodeForParty(int32 PartyID)
+{
+	UOWSReplicationGraphNode_AlwaysRelevantToParty* PartyNode = PartyMap.FindRef(PartyID);
+	if (PartyNode == nullptr)
+	{
+		PartyNode = PartyNodePool.Num() > 0 ? PartyNodePool.Pop(EAllowShrinking::No) : CreateNewNode<UOWSReplicationGraphNode_AlwaysRelevantToParty>();
+		PartyNode->PartyID = PartyID;
+		PartyMap.Add(PartyID, PartyNode);
+	}
+
+	return PartyNode;
+}
+
+void UOWSReplicationGraph::ReleasePartyNode(UOWSReplicationGraphNode_AlwaysRelevantToParty* PartyNode)
+{
+	PartyMap.Remove(PartyNode->PartyID);
+	PartyNode->PartyID = 0;
+	PartyNodePool.Add(PartyNode);
+}
+
+UNetReplicationGraphConnection* UOWSReplicationGraph::GetConnectionManager(UNetConnection* NetConnection)
+{
+	// Unlike FindOrAddConnectionManager, this never creates a manager for a connection that is going away
+	return NetConnection ? Cast<UNetReplicationGraphConnection>(NetConnection->GetReplicationConnectionDriver()) : nullptr;
+}
+
+void UOWSReplicationGraph::RestoreCullDistance(UNetConnection* NetConnection, AActor* Actor)
+{
+	UNetReplicationGraphConnection* ConnectionManager = GetConnectionManager(NetConnection);
+	if (ConnectionManager && Actor)
+	{
+		if (FConnectionReplicationActorInfo* ConnectionActorInfo = ConnectionManager->ActorInfoMap.Find(Actor))
+		{
+			ConnectionActorInfo->SetCullDistanceSquared(GlobalActorReplicationInfoMap.Get(Actor).Settings.GetCullDistanceSquared());
+		}
+	}
+}
+
+void UOWSReplicationGraph::RemovePartyMember(UOWSReplicationGraphNode_AlwaysRelevantToParty* PartyNode, int32 MemberIndex)
+{
+	AOWSPlayerState* PS = PartyNode->PlayerStates[MemberIndex];
+	UNetConnection* NetConnection = PartyNode->NetConnections[MemberIndex];
+
+	PartyNode->PlayerStates.RemoveAtSwap(MemberIndex, EAllowShrinking::No);
+	PartyNode->NetConnections.RemoveAtSwap(MemberIndex, EAllowShrinking::No);
+	PartyMembersByConnection.Remove(NetConnection);
+
+	// Party members were relevant to each other at any distance, so put the class cull distance back both ways
+	AActor* Pawn = PS->GetPawn();
+	for (int32 Index = 0; Index < PartyNode->PlayerStates.Num(); ++Index)
+	{
+		if (AOWSPlayerState* OtherPS = PartyNode->PlayerStates[Index])
+		{
+			RestoreCullDistance(NetConnection, OtherPS->GetPawn());
+		}
+		RestoreCullDistance(PartyNode->NetConnections[Index], Pawn);
+	}
+
+	if (UNetReplicationGraphConnection* ConnectionManager = GetConnectionManager(NetConnection))
+	{
+		RemoveConnectionGraphNode(PartyNode, ConnectionManager);
+	}
+}
+
+#if WITH_EDITOR
+#define CHECK_WORLDS(X) if (X->GetWorld() != GetWorld()) return;
+#else
+#define CHECK_WORLDS(X)
+#endif
+
+void UOWSReplicationGraph::AddPlayerToParty(AOWSPlayerState* PS)
+{	
+	if (PS)
+	{
+		CHECK_WORLDS(PS)
+
+		// Joining another party leaves the current one first
+		UOWSReplicationGraphNode_AlwaysRelevantToParty* CurrentPartyNode = PlayerPartyNodes.FindRef(PS);
+		if (CurrentPartyNode && CurrentPartyNode->PartyID != PS->AlwaysRelevantPartyID)
+		{
+			const int32 NewPartyID = PS->AlwaysRelevantPartyID;
+			RemovePlayerFromParty(PS);
+			PS->AlwaysRelevantPartyID = NewPartyID;
+			CurrentPartyNode = nullptr;
+		}
+
+		UNetConnection* NetConnection = PS->GetNetConnection();
+		if (!CurrentPartyNode && NetConnection && PS->AlwaysRelevantPartyID != 0)
+		{
+			UOWSReplicationGraphNode_AlwaysRelevantToParty* PartyNode = GetNodeForParty(PS->AlwaysRelevantPartyID);
+			PartyNode->PlayerStates.Add(PS);
+			PartyNode->NetConnections.Add(NetConnection);
+			AddConnectionGraphNode(PartyNode, NetConnection);
+
+			PlayerPartyNodes.Add(PS, PartyNode);
+			PartyMembersByConnection.Add(NetConnection, PS);
+		}
+
+		PlayerStateNode->NotifyPartyChanged(PS);
+	}
+}
+
+void UOWSReplicationGraph::RemovePlayerFromParty(AOWSPlayerState* PS)
+{
+	if (PS)
+	{
+		CHECK_WORLDS(PS)
+
+		UOWSReplicationGraphNode_AlwaysRelevantToParty* PartyNode = nullptr;
+		if (PlayerPartyNodes.RemoveAndCopyValue(PS, PartyNode))
+		{
+			RemovePartyMember(PartyNode, PartyNode->PlayerStates.IndexOfByKey(PS));
+
+			if (PartyNode->PlayerStates.Num() == 0)
+			{
+				ReleasePartyNode(PartyNode);
+			}
+		}
+
+		PS->AlwaysRelevantPartyID = 0;
+		PlayerStateNode->NotifyPartyChanged(PS);
+	}
+}
+
+void UOWSReplicationGraph::DisbandParty(int32 PartyID)
+{
+	UOWSReplicationGraphNode_AlwaysRelevantToParty* PartyNode = PartyMap.FindRef(PartyID);
+	if (!PartyNode)
+	{
+		return;
+	}
+
+	for (int32 Index = PartyNode->PlayerStates.Num() - 1; Index >= 0; --Index)
+	{
+		AOWSPlayerState* PS = PartyNode->PlayerStates[Index];
+		PlayerPartyNodes.Remove(PS);
+		RemovePartyMember(PartyNode, Index);
+
+		PS->AlwaysRelevantPartyID = 0;
+		PlayerStateNode->NotifyPartyChanged(PS);
+	}
+
+	ReleasePartyNode(PartyNode);
+}
+
+
+
+UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::UOWSReplicationGraphNode_PlayerStateFrequencyLimiter()
+{
+	bRequiresPrepareForReplicationCall = true;
+}
+
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	APlayerState* PS = Cast<APlayerState>(ActorInfo.Actor);
+	if (PS && !PlayerStateIndices.Contains(PS))
+	{
+		PlayerStateIndices.Add(PS, PlayerStates.Add(PS));
+		bBucketsDirty = true;
+		bPartyListsDirty = true;
+	}
+}
+
+bool UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	APlayerState* PS = Cast<APlayerState>(ActorInfo.Actor);
+
+	int32 Index;
+	if (!PS || !PlayerStateIndices.RemoveAndCopyValue(PS, Index))
+	{
+		return false;
+	}
+
+	// Keep the list compact by moving the last player state into the hole
+	PlayerStates.RemoveAtSwap(Index, EAllowShrinking::No);
+	if (Index < PlayerStates.Num())
+	{
+		PlayerStateIndices[PlayerStates[Index]] = Index;
+	}
+
+	bBucketsDirty = true;
+	bPartyListsDirty = true;
+
+	// The cells are only refreshed periodically, so drop it from its cell now rather than hand a destroyed actor to the driver
+	for (TPair<FIntPoint, FActorRepListRefView>& Cell : NearbyCells)
+	{
+		Cell.Value.RemoveFast(PS);
+	}
+
+	return true;
+}
+
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyResetAllNetworkActors()
+{
+	PlayerStates.Reset();
+	PlayerStateIndices.Reset();
+	ReplicationActorLists.Reset();
+	PartyLists.Reset();
+	NearbyCells.Reset();
+	bBucketsDirty = true;
+	bPartyListsDirty = true;
+}
+
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::NotifyPartyChanged(APlayerState* PlayerState)
+{
+	if (PlayerStateIndices.Contains(PlayerState))
+	{
+		bPartyListsDirty = true;
+	}
+}
+
+FIntPoint UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / NearbyCellSize), FMath::FloorToInt32(Location.Y / NearbyCellSize));
+}
+
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::RebuildBuckets()
+{
+	// Spread the player states evenly so every bucket holds about TargetActorsPerFrame of them
+	const int32 NumBuckets = FMath::Max(1, FMath::DivideAndRoundUp(PlayerStates.Num(), TargetActorsPerFrame));
+
+	ReplicationActorLists.SetNum(NumBuckets);
+	for (FActorRepListRefView& List : ReplicationActorLists)
+	{
+		List.Reset();
+	}
+
+	for (int32 Index = 0; Index < PlayerStates.Num(); ++Index)
+	{
+		ReplicationActorLists[Index % NumBuckets].Add(PlayerStates[Index]);
+	}
+}
+
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::RebuildPartyLists()
+{
+	for (TPair<int32, FActorRepListRefView>& Party : PartyLists)
+	{
+		Party.Value.Reset();
+	}
+
+	for (APlayerState* PS : PlayerStates)
+	{
+		AOWSPlayerState* OWSPlayerState = Cast<AOWSPlayerState>(PS);
+		if (OWSPlayerState && OWSPlayerState->AlwaysRelevantPartyID != 0)
+		{
+			PartyLists.FindOrAdd(OWSPlayerState->AlwaysRelevantPartyID).Add(PS);
+		}
+	}
+
+	// Disbanded parties would otherwise keep an empty list forever
+	for (auto It = PartyLists.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::RebuildNearbyCells()
+{
+	for (TPair<FIntPoint, FActorRepListRefView>& Cell : NearbyCells)
+	{
+		Cell.Value.Reset();
+	}
+
+	for (APlayerState* PS : PlayerStates)
+	{
+		if (APawn* Pawn = PS->GetPawn())
+		{
+			NearbyCells.FindOrAdd(GetCell(Pawn->GetActorLocation())).Add(PS);
+		}
+	}
+}
+
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::PrepareForReplication()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(UOWSReplicationGraphNode_PlayerStateFrequencyLimiter_GlobalPrepareForReplication);
+
+	// Nothing to do on frames where no player joined, left or changed party, except the periodic nearby refresh
+
+	if (bBucketsDirty)
+	{
+		RebuildBuckets();
+		bBucketsDirty = false;
+	}
+
+	if (bPartyListsDirty)
+	{
+		RebuildPartyLists();
+		bPartyListsDirty = false;
+	}
+
+	if (PreparedFrames++ % FMath::Max(NearbyReplicationPeriodFrames, 1) == 0)
+	{
+		RebuildNearbyCells();
+	}
+}
+
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	if (ReplicationActorLists.Num() == 0)
+	{
+		return;
+	}
+
+	// Party members first, then nearby players.  The driver skips anything already replicated to this connection this frame.
+	const APlayerController* ViewingController = Params.ConnectionManager.NetConnection ? Params.ConnectionManager.NetConnection->PlayerController : nullptr;
+	const AOWSPlayerState* ViewingPlayerState = ViewingController ? Cast<AOWSPlayerState>(ViewingController->PlayerState) : nullptr;
+	if (ViewingPlayerState && ViewingPlayerState->AlwaysRelevantPartyID != 0)
+	{
+		if (const FActorRepListRefView* PartyList = PartyLists.Find(ViewingPlayerState->AlwaysRelevantPartyID))
+		{
+			if (PartyList->Num() > 0)
+			{
+				Params.OutGatheredReplicationLists.AddReplicationActorList(*PartyList);
+			}
+		}
+	}
+
+	if (Params.ReplicationFrameNum % FMath::Max(NearbyReplicationPeriodFrames, 1) == 0 && Params.Viewers.Num() > 0)
+	{
+		if (const FActorRepListRefView* CellList = NearbyCells.Find(GetCell(Params.Viewers[0].ViewLocation)))
+		{
+			if (CellList->Num() > 0)
+			{
+				Params.OutGatheredReplicationLists.AddReplicationActorList(*CellList);
+			}
+		}
+	}
+
+	const int32 ListIdx = Params.ReplicationFrameNum % ReplicationActorLists.Num();
+	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorLists[ListIdx]);
+
+	if (ForceNetUpdateReplicationActorList.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(ForceNetUpdateReplicationActorList);
+	}
+}
+
+void UOWSReplicationGraphNode_PlayerStateFrequencyLimiter::LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const
+{
+	DebugInfo.Log(NodeName);
+	DebugInfo.PushIndent();
+
+	int32 i = 0;
+	for (const FActorRepListRefView& List : ReplicationActorLists)
+	{
+		LogActorRepList(DebugInfo, FString::Printf(TEXT("Bucket[%d]"), i++), List);
+	}
+
+	for (const TPair<int32, FActorRepListRefView>& Party : PartyLists)
+	{
+		LogActorRepList(DebugInfo, FString::Printf(TEXT("Party[%d]"), Party.Key), Party.Value);
+	}
+
+	DebugInfo.PopIndent();
+}
+
+
+
+UOWSReplicationGraphNode_DistantCharacters::UOWSReplicationGraphNode_DistantCharacters()
+{
+	bRequiresPrepareForReplicationCall = true;
+}
+
+void UOWSReplicationGraphNode_DistantCharacters::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	AActor* Character = ActorInfo.Actor;
+	if (Character && !CharacterIndices.Contains(Character))
+	{
+		CharacterIndices.Add(Character, Characters.Add(Character));
+	}
+}
+
+bool UOWSReplicationGraphNode_DistantCharacters::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	int32 Index;
+	if (!ActorInfo.Actor || !CharacterIndices.RemoveAndCopyValue(ActorInfo.Actor, Index))
+	{
+		return false;
+	}
+
+	Characters.RemoveAtSwap(Index, EAllowShrinking::No);
+	if (Index < Characters.Num())
+	{
+		CharacterIndices[Characters[Index]] = Index;
+	}
+
+	// Same as the player state cells, don't hand a destroyed actor to the driver before the next rebuild
+	for (TPair<FIntPoint, FActorRepListRefView>& Cell : Cells)
+	{
+		Cell.Value.RemoveFast(ActorInfo.Actor);
+	}
+
+	for (TPair<TObjectKey<UNetReplicationGraphConnection>, TSet<AActor*>>& WidenedActors : WidenedActorsByConnection)
+	{
+		WidenedActors.Value.Remove(ActorInfo.Actor);
+	}
+
+	return true;
+}
+
+void UOWSReplicationGraphNode_DistantCharacters::NotifyResetAllNetworkActors()
+{
+	Characters.Reset();
+	CharacterIndices.Reset();
+	Cells.Reset();
+	WidenedActorsByConnection.Reset();
+}
+
+FIntPoint UOWSReplicationGraphNode_DistantCharacters::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+void UOWSReplicationGraphNode_DistantCharacters::RebuildCells()
+{
+	for (TPair<FIntPoint, FActorRepListRefView>& Cell : Cells)
+	{
+		Cell.Value.Reset();
+	}
+
+	for (AActor* Character : Characters)
+	{
+		Cells.FindOrAdd(GetCell(Character->GetActorLocation())).Add(Character);
+	}
+
+	// Drop cells nobody has stood in since the last rebuild so the map follows where the players are
+	for (auto It = Cells.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Num() == 0)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UOWSReplicationGraphNode_DistantCharacters::PrepareForReplication()
+{
+	QUICK_SCOPE_CYCLE_COUNTER(UOWSReplicationGraphNode_DistantCharacters_GlobalPrepareForReplication);
+
+	if (PreparedFrames++ % ReplicationPeriodFrames == 0)
+	{
+		RebuildCells();
+
+		// Forget connections that have closed
+		for (auto It = WidenedActorsByConnection.CreateIterator(); It; ++It)
+		{
+			if (!It->Key.ResolveObjectPtr())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+void UOWSReplicationGraphNode_DistantCharacters::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	if (Cells.Num() == 0 || Params.Viewers.Num() == 0)
+	{
+		return;
+	}
+
+	// Spread connections over the period so each frame only gathers for a slice of them
+	const uint32 ConnectionOffset = PointerHash(Params.ConnectionManager.NetConnection);
+	if ((Params.ReplicationFrameNum + ConnectionOffset) % ReplicationPeriodFrames != 0)
+	{
+		return;
+	}
+
+	const FIntPoint ViewerCell = GetCell(Params.Viewers[0].ViewLocation);
+	const float CullDistanceSquared = FMath::Square(CellSize);
+
+	TSet<AActor*>& WidenedActors = WidenedActorsByConnection.FindOrAdd(&Params.ConnectionManager);
+	TSet<AActor*> PreviouslyWidenedActors = MoveTemp(WidenedActors);
+	WidenedActors.Reset();
+
+	for (int32 Y = ViewerCell.Y - 1; Y <= ViewerCell.Y + 1; ++Y)
+	{
+		for (int32 X = ViewerCell.X - 1; X <= ViewerCell.X + 1; ++X)
+		{
+			const FActorRepListRefView* CellList = Cells.Find(FIntPoint(X, Y));
+			if (!CellList || CellList->Num() == 0)
+			{
+				continue;
+			}
+
+			// The driver culls with the per-connection cull distance, so widen it for the characters this node hands out
+			for (FActorRepListType Actor : *CellList)
+			{
+				if (PreviouslyWidenedActors.Remove(Actor) > 0)
+				{
+					WidenedActors.Add(Actor);
+					continue;
+				}
+
+				FConnectionReplicationActorInfo& ConnectionActorInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd(Actor);
+				// Zero is no cull distance at all, e.g. party members
+				if (ConnectionActorInfo.GetCullDistanceSquared() > 0.f && ConnectionActorInfo.GetCullDistanceSquared() < CullDistanceSquared)
+				{
+					ConnectionActorInfo.SetCullDistanceSquared(CullDistanceSquared);
+					WidenedActors.Add(Actor);
+				}
+			}
+
+			Params.OutGatheredReplicationLists.AddReplicationActorList(*CellList);
+		}
+	}
+
+	// Characters that left the 3x3 cells go back to their class cull distance, unless something else (a party) has changed it since
+	for (AActor* Actor : PreviouslyWidenedActors)
+	{
+		FConnectionReplicationActorInfo* ConnectionActorInfo = Params.ConnectionManager.ActorInfoMap.Find(Actor);
+		FGlobalActorReplicationInfo* GlobalActorInfo = GraphGlobals.IsValid() ? GraphGlobals->GlobalActorReplicationInfoMap->Find(Actor) : nullptr;
+		if (ConnectionActorInfo && GlobalActorInfo && ConnectionActorInfo->GetCullDistanceSquared() == CullDistanceSquared)
+		{
+			ConnectionActorInfo->SetCullDistanceSquared(GlobalActorInfo->Settings.GetCullDistanceSquared());
+		}
+	}
+}
+
+void UOWSReplicationGraphNode_DistantCharacters::LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const
+{
+	DebugInfo.Log(NodeName);
+	DebugInfo.PushIndent();
+
+	for (const TPair<FIntPoint, FActorRepListRefView>& Cell : Cells)
+	{
+		LogActorRepList(DebugInfo, FString::Printf(TEXT("Cell[%d, %d]"), Cell.Key.X, Cell.Key.Y), Cell.Value);
+	}
+
+	DebugInfo.PopIndent();
+}
+
+UOWSReplicationGraphNode_AlwaysRelevantToParty::UOWSReplicationGraphNode_AlwaysRelevantToParty()
+{
+	bRequiresPrepareForReplicationCall = true;
+}
+
+void UOWSReplicationGraphNode_AlwaysRelevantToParty::PrepareForReplication()
+{
+	// Pooled nodes have no members and nothing to do
+	if (PlayerStates.Num() == 0 && ReplicationActorList.Num() == 0)
+	{
+		UpdatePerConnectionCullDistance = false;
+		return;
+	}
+
+	const int32 PreviousNum = ReplicationActorList.Num();
+
+	// A party of one has nobody else to keep relevant
+	ReplicationActorList.Reset();
+	if (PlayerStates.Num() > 1)
+	{
+		for (AOWSPlayerState* PS : PlayerStates)
+		{
+			if (PS)
+			{
+				if (AOWSCharacter* Pawn = PS->GetCurrentPawn())
+				{
+					ReplicationActorList.Add(Pawn);
+				}
+			}
+		}
+	}
+
+	UpdatePerConnectionCullDistance = PreviousNum != ReplicationActorList.Num();
+}
+
+void UOWSReplicationGraphNode_AlwaysRelevantToParty::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorList);
+
+	if (UpdatePerConnectionCullDistance)
+	{
+		for (FActorRepListType Actor : ReplicationActorList)
+		{
+			FConnectionReplicationActorInfo& ConnectionActorInfo = Params.ConnectionManager.ActorInfoMap.FindOrAdd( Actor );
+			ConnectionActorInfo.SetCullDistanceSquared(0.f);
+		}
+	}
+}
+
+void UOWSReplicationGraphNode_AlwaysRelevantToParty::LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const
+{
+	DebugInfo.Log(NodeName);
+	DebugInfo.PushIndent();
+	LogActorRepList(DebugInfo, FString::Printf(TEXT("Party: %u"), PartyID), ReplicationActorList);
+	DebugInfo.PopIndent();
+}
\ No newline at end of file
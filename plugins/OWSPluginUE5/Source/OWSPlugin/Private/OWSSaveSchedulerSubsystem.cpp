@@ -0,0 +1,222 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "OWSSaveSchedulerSubsystem.h"
+#include "OWSGameMode.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+
+void UOWSSaveSchedulerSubsystem::Deinitialize()
+{
+	for (TPair<TWeakObjectPtr<APlayerController>, FOWSPlayerSaveState>& Player : Players)
+	{
+		StopWatchingPawn(Player.Value);
+	}
+
+	Players.Empty();
+	DirtyPlayers.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UOWSSaveSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOWSSaveSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+bool UOWSSaveSchedulerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+AOWSGameMode* UOWSSaveSchedulerSubsystem::GetOWSGameMode() const
+{
+	//Only exists on the server
+	return GetWorld() ? GetWorld()->GetAuthGameMode<AOWSGameMode>() : nullptr;
+}
+
+void UOWSSaveSchedulerSubsystem::RegisterPlayer(APlayerController* PlayerController)
+{
+	AOWSGameMode* GameMode = GetOWSGameMode();
+
+	if (!PlayerController || !GameMode || !GameMode->IsUsingSaveScheduler() || Players.Contains(PlayerController))
+	{
+		return;
+	}
+
+	FOWSPlayerSaveState& SaveState = Players.Add(PlayerController);
+	SaveState.LastSaveTime = FPlatformTime::Seconds();
+	SaveState.NewPawnHandle = PlayerController->GetOnNewPawnNotifier().AddUObject(this, &UOWSSaveSchedulerSubsystem::OnNewPawn, TWeakObjectPtr<APlayerController>(PlayerController));
+
+	WatchPawn(PlayerController, PlayerController->GetPawn());
+}
+
+void UOWSSaveSchedulerSubsystem::UnregisterPlayer(APlayerController* PlayerController)
+{
+	FOWSPlayerSaveState SaveState;
+
+	if (!PlayerController || !Players.RemoveAndCopyValue(PlayerController, SaveState))
+	{
+		return;
+	}
+
+	StopWatchingPawn(SaveState);
+	PlayerController->GetOnNewPawnNotifier().Remove(SaveState.NewPawnHandle);
+
+	if (AOWSGameMode* GameMode = GetOWSGameMode())
+	{
+		GameMode->FlushPlayerLocation(PlayerController);
+	}
+
+	//Its entry in DirtyPlayers, if any, is skipped when it reaches the top
+}
+
+void UOWSSaveSchedulerSubsystem::MarkPlayerDirty(APlayerController* PlayerController)
+{
+	FOWSPlayerSaveState* SaveState = Players.Find(PlayerController);
+
+	if (!SaveState || SaveState->bDirty)
+	{
+		return;
+	}
+
+	SaveState->bDirty = true;
+	DirtyPlayers.HeapPush(FOWSDirtyPlayer{ SaveState->LastSaveTime, PlayerController });
+}
+
+void UOWSSaveSchedulerSubsystem::FlushPlayer(APlayerController* PlayerController)
+{
+	AOWSGameMode* GameMode = GetOWSGameMode();
+
+	if (!PlayerController || !GameMode || !GameMode->IsUsingSaveScheduler())
+	{
+		return;
+	}
+
+	GameMode->FlushPlayerLocation(PlayerController);
+
+	if (FOWSPlayerSaveState* SaveState = Players.Find(PlayerController))
+	{
+		//Its entry in DirtyPlayers, if any, no longer matches and is skipped when it reaches the top
+		SaveState->LastSaveTime = FPlatformTime::Seconds();
+		SaveState->bDirty = false;
+	}
+}
+
+void UOWSSaveSchedulerSubsystem::FlushAllPlayers()
+{
+	TArray<TWeakObjectPtr<APlayerController>> PlayerControllers;
+	Players.GetKeys(PlayerControllers);
+
+	for (const TWeakObjectPtr<APlayerController>& PlayerController : PlayerControllers)
+	{
+		FlushPlayer(PlayerController.Get());
+	}
+}
+
+void UOWSSaveSchedulerSubsystem::WatchPawn(APlayerController* PlayerController, APawn* Pawn)
+{
+	FOWSPlayerSaveState* SaveState = Players.Find(PlayerController);
+
+	if (!SaveState)
+	{
+		return;
+	}
+
+	StopWatchingPawn(*SaveState);
+
+	if (Pawn && Pawn->GetRootComponent())
+	{
+		SaveState->WatchedRootComponent = Pawn->GetRootComponent();
+		SaveState->TransformUpdatedHandle = Pawn->GetRootComponent()->TransformUpdated.AddUObject(this, &UOWSSaveSchedulerSubsystem::OnPawnTransformUpdated, TWeakObjectPtr<APlayerController>(PlayerController));
+	}
+}
+
+void UOWSSaveSchedulerSubsystem::StopWatchingPawn(FOWSPlayerSaveState& SaveState)
+{
+	if (USceneComponent* WatchedRootComponent = SaveState.WatchedRootComponent.Get())
+	{
+		WatchedRootComponent->TransformUpdated.Remove(SaveState.TransformUpdatedHandle);
+	}
+
+	SaveState.WatchedRootComponent.Reset();
+	SaveState.TransformUpdatedHandle.Reset();
+}
+
+void UOWSSaveSchedulerSubsystem::OnNewPawn(APawn* NewPawn, TWeakObjectPtr<APlayerController> PlayerController)
+{
+	if (PlayerController.IsValid())
+	{
+		WatchPawn(PlayerController.Get(), NewPawn);
+		MarkPlayerDirty(PlayerController.Get());
+	}
+}
+
+void UOWSSaveSchedulerSubsystem::OnPawnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, TWeakObjectPtr<APlayerController> PlayerController)
+{
+	MarkPlayerDirty(PlayerController.Get());
+}
+
+void UOWSSaveSchedulerSubsystem::Tick(float DeltaTime)
+{
+	AOWSGameMode* GameMode = GetOWSGameMode();
+
+	if (!GameMode || !GameMode->IsUsingSaveScheduler() || DirtyPlayers.Num() == 0)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double BudgetInSeconds = GameMode->SaveSchedulerBudgetMilliseconds / 1000.0;
+	const double SaveInterval = GameMode->SaveIntervalInSeconds;
+
+	TArray<uint8> Records;
+	TMap<FString, FOWSSavedPlayerPosition> SentPlayerPositions;
+	TArray<TWeakObjectPtr<APlayerController>> DeferredPlayers;
+
+	while (DirtyPlayers.Num() > 0 && FPlatformTime::Seconds() - StartTime < BudgetInSeconds)
+	{
+		//The stalest dirty player was saved too recently, so everyone behind them was too
+		if (DirtyPlayers.HeapTop().LastSaveTime + SaveInterval > StartTime)
+		{
+			break;
+		}
+
+		FOWSDirtyPlayer DirtyPlayer;
+		DirtyPlayers.HeapPop(DirtyPlayer, false);
+
+		FOWSPlayerSaveState* SaveState = Players.Find(DirtyPlayer.PlayerController);
+
+		if (!SaveState || !DirtyPlayer.PlayerController.IsValid())
+		{
+			continue;
+		}
+
+		//Left behind by FlushPlayer.  The player was saved since this entry was pushed, and any newer change pushed its own entry.
+		if (!SaveState->bDirty || SaveState->LastSaveTime != DirtyPlayer.LastSaveTime)
+		{
+			continue;
+		}
+
+		SaveState->bDirty = false;
+
+		if (GameMode->AppendPlayerLocationRecord(DirtyPlayer.PlayerController.Get(), Records, SentPlayerPositions, false))
+		{
+			SaveState->LastSaveTime = StartTime;
+		}
+		else
+		{
+			DeferredPlayers.Add(DirtyPlayer.PlayerController);
+		}
+	}
+
+	//Their previous save is still in flight.  They keep their place and are tried again next frame.
+	for (const TWeakObjectPtr<APlayerController>& DeferredPlayer : DeferredPlayers)
+	{
+		MarkPlayerDirty(DeferredPlayer.Get());
+	}
+
+	if (SentPlayerPositions.Num() > 0)
+	{
+		GameMode->SendPlayerLocationRecords(Records, MoveTemp(SentPlayerPositions));
+	}
+}
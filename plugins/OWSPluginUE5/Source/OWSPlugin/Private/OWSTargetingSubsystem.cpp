@@ -0,0 +1,391 @@
+// Copyright 2022 Sabre Dart Studios
+
+#include "OWSTargetingSubsystem.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/SpectatorPawn.h"
+#include "OWSCharacter.h"
+#include "OWSGameplayAbilityTargetDataFilter.h"
+#include "Runtime/Core/Public/Misc/ConfigCacheIni.h"
+
+namespace OWSTargeting
+{
+	//One pawn's state for this frame, before it is sorted into the grid
+	struct FPawnSample
+	{
+		FIntPoint Cell;
+		FVector3f Location;
+		float Radius;
+		int32 TeamNumber;
+		APawn* Pawn;
+	};
+}
+
+FOWSTargetingQuery FOWSTargetingQuery::MakeSphere(const FVector& Origin, float Radius)
+{
+	FOWSTargetingQuery Query;
+	Query.Shape = EOWSTargetingShape::Sphere;
+	Query.Origin = Origin;
+	Query.Radius = Radius;
+	return Query;
+}
+
+FOWSTargetingQuery FOWSTargetingQuery::MakeCone(const FVector& Origin, const FVector& Forward, float Radius, float HalfAngleDegrees)
+{
+	FOWSTargetingQuery Query;
+	Query.Shape = EOWSTargetingShape::Cone;
+	Query.Origin = Origin;
+	Query.Radius = Radius;
+	Query.Forward = Forward.GetSafeNormal();
+	Query.CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.f, 180.f)));
+	return Query;
+}
+
+FOWSTargetingQuery FOWSTargetingQuery::MakeBox(const FVector& Origin, const FQuat& Rotation, const FVector& BoxExtent)
+{
+	FOWSTargetingQuery Query;
+	Query.Shape = EOWSTargetingShape::Box;
+	Query.Origin = Origin;
+	Query.Rotation = Rotation;
+	Query.BoxExtent = BoxExtent.GetAbs();
+	return Query;
+}
+
+void FOWSTargetingQuery::SetTeamFilter(const FOWSGameplayTargetDataFilter& Filter)
+{
+	//A reversed filter keeps the team instead, so leave that to FilterPassesForActor
+	ExcludedTeamNumber = Filter.bReverseFilter ? 0 : Filter.TeamNumber;
+}
+
+void UOWSTargetingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	CellSize = 2000.f;
+	bTrackingPawns = false;
+	MaxPawnRadius = 0.f;
+
+	GConfig->GetFloat(
+		TEXT("/Script/EngineSettings.GeneralProjectSettings"),
+		TEXT("OWSTargetingCellSize"),
+		CellSize,
+		GGameIni
+	);
+
+	CellSize = FMath::Max(CellSize, 100.f);
+}
+
+void UOWSTargetingSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+
+	TrackedPawns.Empty();
+	SortedPawns.Empty();
+	PositionsX.Empty();
+	PositionsY.Empty();
+	PositionsZ.Empty();
+	Radii.Empty();
+	TeamNumbers.Empty();
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UOWSTargetingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UOWSTargetingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UOWSTargetingSubsystem, STATGROUP_Tickables);
+}
+
+void UOWSTargetingSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	//Targeting is resolved on the server
+	if (InWorld.GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	bTrackingPawns = true;
+
+	for (TActorIterator<APawn> PawnIt(&InWorld); PawnIt; ++PawnIt)
+	{
+		RegisterPawn(*PawnIt);
+	}
+
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UOWSTargetingSubsystem::OnActorSpawned));
+}
+
+void UOWSTargetingSubsystem::OnActorSpawned(AActor* Actor)
+{
+	if (APawn* Pawn = Cast<APawn>(Actor))
+	{
+		RegisterPawn(Pawn);
+	}
+}
+
+void UOWSTargetingSubsystem::RegisterPawn(APawn* Pawn)
+{
+	if (!Pawn || Pawn->IsA<ASpectatorPawn>())
+	{
+		return;
+	}
+
+	TrackedPawns.AddUnique(Pawn);
+}
+
+void UOWSTargetingSubsystem::UnregisterPawn(APawn* Pawn)
+{
+	TrackedPawns.RemoveSingleSwap(Pawn, EAllowShrinking::No);
+}
+
+FIntPoint UOWSTargetingSubsystem::GetCell(float X, float Y) const
+{
+	return FIntPoint(FMath::FloorToInt32(X / CellSize), FMath::FloorToInt32(Y / CellSize));
+}
+
+void UOWSTargetingSubsystem::Tick(float DeltaTime)
+{
+	TArray<OWSTargeting::FPawnSample> Samples;
+	Samples.Reserve(TrackedPawns.Num());
+
+	for (int32 PawnIndex = TrackedPawns.Num() - 1; PawnIndex >= 0; PawnIndex--)
+	{
+		APawn* Pawn = TrackedPawns[PawnIndex].Get();
+
+		//Destroyed since the last frame
+		if (!Pawn)
+		{
+			TrackedPawns.RemoveAtSwap(PawnIndex, EAllowShrinking::No);
+			continue;
+		}
+
+		float CollisionRadius;
+		float CollisionHalfHeight;
+		Pawn->GetSimpleCollisionCylinder(CollisionRadius, CollisionHalfHeight);
+
+		const AOWSCharacter* OWSCharacter = Cast<AOWSCharacter>(Pawn);
+		const FVector3f Location(Pawn->GetActorLocation());
+
+		Samples.Add({ GetCell(Location.X, Location.Y), Location, CollisionRadius, OWSCharacter ? OWSCharacter->TeamNumber : 0, Pawn });
+	}
+
+	Samples.Sort([](const OWSTargeting::FPawnSample& A, const OWSTargeting::FPawnSample& B)
+	{
+		return A.Cell.X != B.Cell.X ? A.Cell.X < B.Cell.X : A.Cell.Y < B.Cell.Y;
+	});
+
+	const int32 NumPawns = Samples.Num();
+	SortedPawns.SetNum(NumPawns, EAllowShrinking::No);
+	PositionsX.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+	PositionsY.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+	PositionsZ.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+	Radii.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+	TeamNumbers.SetNumUninitialized(NumPawns, EAllowShrinking::No);
+	Cells.Reset();
+	MaxPawnRadius = 0.f;
+
+	for (int32 Index = 0; Index < NumPawns; Index++)
+	{
+		const OWSTargeting::FPawnSample& Sample = Samples[Index];
+
+		SortedPawns[Index] = Sample.Pawn;
+		PositionsX[Index] = Sample.Location.X;
+		PositionsY[Index] = Sample.Location.Y;
+		PositionsZ[Index] = Sample.Location.Z;
+		Radii[Index] = Sample.Radius;
+		TeamNumbers[Index] = Sample.TeamNumber;
+		MaxPawnRadius = FMath::Max(MaxPawnRadius, Sample.Radius);
+
+		//Samples are sorted, so each cell is one run
+		FOWSTargetingCell& Cell = Cells.FindOrAdd(Sample.Cell);
+		if (Cell.Num == 0)
+		{
+			Cell.Start = Index;
+		}
+		Cell.Num++;
+	}
+}
+
+void UOWSTargetingSubsystem::TestRange(const FOWSTargetingQuery& Query, int32 Start, int32 Num, TArray<int32>& OutIndices) const
+{
+	const float* X = PositionsX.GetData() + Start;
+	const float* Y = PositionsY.GetData() + Start;
+	const float* Z = PositionsZ.GetData() + Start;
+	const float* R = Radii.GetData() + Start;
+	const int32* Teams = TeamNumbers.GetData() + Start;
+
+	const float OriginX = (float)Query.Origin.X;
+	const float OriginY = (float)Query.Origin.Y;
+	const float OriginZ = (float)Query.Origin.Z;
+	const int32 SkipTeam = Query.ExcludedTeamNumber > 0 ? Query.ExcludedTeamNumber : MIN_int32;
+
+	switch (Query.Shape)
+	{
+	case EOWSTargetingShape::Sphere:
+	{
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const float DX = X[Index] - OriginX;
+			const float DY = Y[Index] - OriginY;
+			const float DZ = Z[Index] - OriginZ;
+			const float Reach = Query.Radius + R[Index];
+
+			if (DX * DX + DY * DY + DZ * DZ <= Reach * Reach && Teams[Index] != SkipTeam)
+			{
+				OutIndices.Add(Start + Index);
+			}
+		}
+		break;
+	}
+	case EOWSTargetingShape::Cone:
+	{
+		const float ForwardX = (float)Query.Forward.X;
+		const float ForwardY = (float)Query.Forward.Y;
+		const float ForwardZ = (float)Query.Forward.Z;
+
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const float DX = X[Index] - OriginX;
+			const float DY = Y[Index] - OriginY;
+			const float DZ = Z[Index] - OriginZ;
+			const float DistanceSquared = DX * DX + DY * DY + DZ * DZ;
+			const float Reach = Query.Radius + R[Index];
+
+			//Angle to the pawn's center is within the half angle, without an Acos or a normalize
+			const float Dot = DX * ForwardX + DY * ForwardY + DZ * ForwardZ;
+
+			if (DistanceSquared <= Reach * Reach && Dot >= Query.CosHalfAngle * FMath::Sqrt(DistanceSquared) && Teams[Index] != SkipTeam)
+			{
+				OutIndices.Add(Start + Index);
+			}
+		}
+		break;
+	}
+	case EOWSTargetingShape::Box:
+	{
+		const FVector3f AxisX(Query.Rotation.GetAxisX());
+		const FVector3f AxisY(Query.Rotation.GetAxisY());
+		const FVector3f AxisZ(Query.Rotation.GetAxisZ());
+		const FVector3f Extent(Query.BoxExtent);
+
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const float DX = X[Index] - OriginX;
+			const float DY = Y[Index] - OriginY;
+			const float DZ = Z[Index] - OriginZ;
+
+			//Pawn center in box space, against the box grown by the pawn's radius
+			const float LocalX = FMath::Abs(DX * AxisX.X + DY * AxisX.Y + DZ * AxisX.Z);
+			const float LocalY = FMath::Abs(DX * AxisY.X + DY * AxisY.Y + DZ * AxisY.Z);
+			const float LocalZ = FMath::Abs(DX * AxisZ.X + DY * AxisZ.Y + DZ * AxisZ.Z);
+
+			if (LocalX <= Extent.X + R[Index] && LocalY <= Extent.Y + R[Index] && LocalZ <= Extent.Z + R[Index] && Teams[Index] != SkipTeam)
+			{
+				OutIndices.Add(Start + Index);
+			}
+		}
+		break;
+	}
+	}
+}
+
+void UOWSTargetingSubsystem::GatherQueryHits(const FOWSTargetingQuery& Query, TArray<int32>& OutIndices) const
+{
+	if (Cells.Num() == 0)
+	{
+		return;
+	}
+
+	//Horizontal reach of the shape, grown by the widest pawn so pawns centered in a neighbouring cell are still found
+	FVector2D Reach;
+	if (Query.Shape == EOWSTargetingShape::Box)
+	{
+		const FVector AxisX = Query.Rotation.GetAxisX() * Query.BoxExtent.X;
+		const FVector AxisY = Query.Rotation.GetAxisY() * Query.BoxExtent.Y;
+		const FVector AxisZ = Query.Rotation.GetAxisZ() * Query.BoxExtent.Z;
+		Reach.X = FMath::Abs(AxisX.X) + FMath::Abs(AxisY.X) + FMath::Abs(AxisZ.X);
+		Reach.Y = FMath::Abs(AxisX.Y) + FMath::Abs(AxisY.Y) + FMath::Abs(AxisZ.Y);
+	}
+	else
+	{
+		Reach = FVector2D(Query.Radius, Query.Radius);
+	}
+	Reach += FVector2D(MaxPawnRadius, MaxPawnRadius);
+
+	const FIntPoint MinCell = GetCell(Query.Origin.X - Reach.X, Query.Origin.Y - Reach.Y);
+	const FIntPoint MaxCell = GetCell(Query.Origin.X + Reach.X, Query.Origin.Y + Reach.Y);
+	const int64 CellsInRange = (int64)(MaxCell.X - MinCell.X + 1) * (int64)(MaxCell.Y - MinCell.Y + 1);
+
+	//A huge shape over a sparse world is cheaper to test against the occupied cells
+	if (CellsInRange > Cells.Num())
+	{
+		for (const TPair<FIntPoint, FOWSTargetingCell>& Cell : Cells)
+		{
+			if (Cell.Key.X >= MinCell.X && Cell.Key.X <= MaxCell.X && Cell.Key.Y >= MinCell.Y && Cell.Key.Y <= MaxCell.Y)
+			{
+				TestRange(Query, Cell.Value.Start, Cell.Value.Num, OutIndices);
+			}
+		}
+		return;
+	}
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++)
+		{
+			if (const FOWSTargetingCell* Cell = Cells.Find(FIntPoint(CellX, CellY)))
+			{
+				TestRange(Query, Cell->Start, Cell->Num, OutIndices);
+			}
+		}
+	}
+}
+
+void UOWSTargetingSubsystem::RunQuery(const FOWSTargetingQuery& Query, TFunctionRef<bool(APawn*)> ShouldConsiderPawn, TArray<APawn*>& OutPawns) const
+{
+	TArray<int32> Hits;
+	GatherQueryHits(Query, Hits);
+
+	for (const int32 Index : Hits)
+	{
+		APawn* Pawn = SortedPawns[Index].Get();
+		if (Pawn && ShouldConsiderPawn(Pawn))
+		{
+			OutPawns.Add(Pawn);
+		}
+	}
+}
+
+void UOWSTargetingSubsystem::RunQueries(TConstArrayView<FOWSTargetingQuery> Queries, TFunctionRef<bool(int32 QueryIndex, APawn*)> ShouldConsiderPawn, TArray<TArray<APawn*>>& OutPawns) const
+{
+	OutPawns.SetNum(Queries.Num());
+
+	TArray<int32> Hits;
+	for (int32 QueryIndex = 0; QueryIndex < Queries.Num(); QueryIndex++)
+	{
+		Hits.Reset();
+		GatherQueryHits(Queries[QueryIndex], Hits);
+
+		TArray<APawn*>& QueryPawns = OutPawns[QueryIndex];
+		QueryPawns.Reset();
+
+		for (const int32 Index : Hits)
+		{
+			APawn* Pawn = SortedPawns[Index].Get();
+			if (Pawn && ShouldConsiderPawn(QueryIndex, Pawn))
+			{
+				QueryPawns.Add(Pawn);
+			}
+		}
+	}
+}
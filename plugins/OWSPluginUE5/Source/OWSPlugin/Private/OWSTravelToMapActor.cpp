@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "OWSTravelToMapActor.h"
+#include "OWSSaveSchedulerSubsystem.h"
 #include "Runtime/Engine/Classes/GameFramework/PlayerState.h"
 #include "Runtime/Core/Public/Misc/ConfigCacheIni.h"
 
@@ -36,6 +37,13 @@ void AOWSTravelToMapActor::Tick( float DeltaTime )
 void AOWSTravelToMapActor::GetMapServerToTravelTo(APlayerController* PlayerController, TEnumAsByte<ERPGSchemeToChooseMap::SchemeToChooseMap> SelectedSchemeToChooseMap, int32 WorldServerID)
 {
 	FString CharacterName = PlayerController->PlayerState->GetPlayerName();
+
+	//Save where they left from before they leave this zone
+	if (UOWSSaveSchedulerSubsystem* SaveScheduler = GetWorld()->GetSubsystem<UOWSSaveSchedulerSubsystem>())
+	{
+		SaveScheduler->FlushPlayer(PlayerController);
+	}
+
 	OWSPlayerControllerComponent->GetZoneServerToTravelTo(CharacterName, SelectedSchemeToChooseMap, WorldServerID, ZoneName);
 }
 
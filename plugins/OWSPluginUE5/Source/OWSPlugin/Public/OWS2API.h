@@ -522,6 +522,42 @@ public:
 		FString MapName;
 };
 
+USTRUCT()
+struct FUpdateAllPlayerPositionsDeltaJSONPost
+{
+	GENERATED_BODY()
+
+public:
+	FUpdateAllPlayerPositionsDeltaJSONPost() {
+		SerializedPlayerLocationDelta = "";
+		MapName = "";
+	}
+
+	UPROPERTY()
+		FString SerializedPlayerLocationDelta;
+	UPROPERTY()
+		FString MapName;
+};
+
+USTRUCT()
+struct FUpdateAllPlayerPositionsDeltaResult
+{
+	GENERATED_BODY()
+
+public:
+	FUpdateAllPlayerPositionsDeltaResult() {
+		Success = false;
+		ErrorMessage = "";
+	}
+
+	UPROPERTY()
+		bool Success;
+	UPROPERTY()
+		FString ErrorMessage;
+	UPROPERTY()
+		TArray<FString> PlayersNeedingKeyframe;
+};
+
 
 USTRUCT()
 struct FUpdateNumberOfPlayersJSONPost
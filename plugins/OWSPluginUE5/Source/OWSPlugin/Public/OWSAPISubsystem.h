@@ -6,6 +6,7 @@
 #include "OWSPlugin.h"
 #include "OWS2API.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/EngineTypes.h"
 #include "Runtime/Online/HTTP/Public/Http.h"
 #include "JsonObjectConverter.h"
 #include "OWSAPISubsystem.generated.h"
@@ -26,6 +27,29 @@ DECLARE_DELEGATE_OneParam(FErrorCreateCharacterUsingDefaultCharacterValuesDelega
 DECLARE_DELEGATE(FNotifyLogoutDelegate)
 DECLARE_DELEGATE_OneParam(FErrorLogoutDelegate, const FString&)
 
+//Queued Requests
+DECLARE_DELEGATE_TwoParams(FOWSQueuedRequestCompleteDelegate, bool /*bWasSuccessful*/, const FString& /*ResponseContent*/)
+
+//A single call waiting in the request pipeline
+struct FOWSQueuedRequest
+{
+	FString ApiModuleToCall;
+	FString ApiToCall;
+	FString PostParameters;
+	//Calls that share an OrderingKey reach the API in the order they were queued.  Empty means no ordering.
+	FString OrderingKey;
+	FOWSQueuedRequestCompleteDelegate OnComplete;
+};
+
+//All calls to the same endpoint that arrived inside the same batch window
+struct FOWSQueuedRequestBatch
+{
+	FString ApiModuleToCall;
+	FString ApiToCall;
+	TArray<FOWSQueuedRequest> Requests;
+	FTimerHandle FlushTimerHandle;
+};
+
 
 /**
  * 
@@ -55,9 +79,32 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category = "Config")
 		FString OWSEncryptionKey = "";
 
+	//How long queued calls to the same endpoint are held so they can be sent together.  0 sends every call immediately.
+	UPROPERTY(BlueprintReadWrite, Category = "Config")
+		float OWSRequestBatchWindowInSeconds = 0.05f;
+
+	//A batch is sent early when it reaches this many calls
+	UPROPERTY(BlueprintReadWrite, Category = "Config")
+		int32 OWSMaxRequestsPerBatch = 100;
+
 protected:
 	FHttpModule* Http;
 
+	//Maps an endpoint that can be batched to the bulk endpoint that accepts an array of its request bodies
+	TMap<FString, FString> BulkEndpoints;
+
+	//Pending batches keyed by ApiModuleToCall + ApiToCall
+	TMap<FString, FOWSQueuedRequestBatch> PendingRequestBatches;
+
+	//The pending batch that holds calls for each OrderingKey.  All calls for one OrderingKey wait in the same batch.
+	TMap<FString, FString> PendingBatchKeyByOrderingKey;
+
+	//Number of sent calls per OrderingKey that have not had a response yet
+	TMap<FString, int32> InFlightRequestCountByOrderingKey;
+
+	//Calls held back until every earlier call with the same OrderingKey has had a response
+	TMap<FString, TArray<FOWSQueuedRequest>> DeferredRequestsByOrderingKey;
+
 public:
 	//Get Global Data Item
 	UFUNCTION(BlueprintCallable, Category = "GlobalData")
@@ -95,7 +142,22 @@ public:
 	FNotifyLogoutDelegate OnNotifyLogoutDelegate;
 	FErrorLogoutDelegate OnErrorLogoutDelegate;
 
+	//Request Pipeline
+	void QueueOWS2POSTRequest(FString ApiModuleToCall, FString ApiToCall, FString PostParameters, FOWSQueuedRequestCompleteDelegate OnComplete, FString OrderingKey = FString());
+	void RegisterBulkEndpoint(FString ApiToCall, FString BulkApiToCall);
+	void FlushAllQueuedRequests();
+
+	//Reads the FSuccessAndErrorMessage a queued call gets back.  Returns false and fills ErrorMsg when the call failed.
+	static bool ReadQueuedRequestResult(bool bWasSuccessful, const FString& ResponseContent, FString& ErrorMsg);
+
 protected:
+	void QueueOWS2POSTRequest_Internal(FOWSQueuedRequest QueuedRequest);
+	void SendQueuedRequests(const FString& ApiModuleToCall, const FString& ApiToCall, TArray<FOWSQueuedRequest> QueuedRequests, bool bSendToBulkEndpoint, FString PostParameters);
+	void FlushQueuedRequestBatch(FString BatchKey);
+	void OnQueuedRequestResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TArray<FOWSQueuedRequest> QueuedRequests, bool bSentToBulkEndpoint);
+	void ReleaseOrderedRequests(const TArray<FOWSQueuedRequest>& CompletedRequests);
+	FString GetOWS2APIPathForModule(const FString& ApiModuleToCall) const;
+
 	void ProcessOWS2POSTRequest(FString ApiModuleToCall, FString ApiToCall, FString PostParameters, void (UOWSAPISubsystem::* InMethodPtr)(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful));
 	void ProcessOWS2GETRequest(FString ApiModuleToCall, FString ApiToCall, void (UOWSAPISubsystem::* InMethodPtr)(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful));
 	void GetJsonObjectFromResponse(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, FString CallingMethodName, FString& ErrorMsg, TSharedPtr<FJsonObject>& JsonObject);
@@ -0,0 +1,81 @@
+// Copyright 2022 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "OWSAbilitySet.generated.h"
+
+class UGameplayAbility;
+
+UENUM(BlueprintType)
+enum class EOWSAbilitySetSlot : uint8
+{
+	//Granted without an input binding
+	None,
+	//Bound to UseAbility1..UseAbility22
+	Spell,
+	//Bound to UseWeapon1..UseWeapon2
+	Weapon
+};
+
+USTRUCT(BlueprintType)
+struct FOWSAbilitySetEntry
+{
+	GENERATED_BODY()
+
+public:
+	FOWSAbilitySetEntry() {
+		AbilityLevel = 1;
+		SlotType = EOWSAbilitySetSlot::None;
+		SlotNumber = 1;
+	}
+
+	FOWSAbilitySetEntry(TSubclassOf<UGameplayAbility> InAbility, EOWSAbilitySetSlot InSlotType, int32 InSlotNumber) {
+		Ability = InAbility;
+		AbilityLevel = 1;
+		SlotType = InSlotType;
+		SlotNumber = InSlotNumber;
+	}
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Abilities")
+	TSubclassOf<UGameplayAbility> Ability;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Abilities", meta = (ClampMin = 1))
+	int32 AbilityLevel;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Abilities")
+	EOWSAbilitySetSlot SlotType;
+
+	//1 based, the same as AOWSCharacterWithAbilities::ChangeSpell and ChangeWeapon
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Abilities", meta = (ClampMin = 1, EditCondition = "SlotType != EOWSAbilitySetSlot::None"))
+	int32 SlotNumber;
+
+	//The AbilityInput the ability is bound to, or INDEX_NONE
+	int32 GetInputID() const
+	{
+		switch (SlotType)
+		{
+		case EOWSAbilitySetSlot::Spell:
+			return SlotNumber - 1;
+		case EOWSAbilitySetSlot::Weapon:
+			return SlotNumber + 21;
+		default:
+			return INDEX_NONE;
+		}
+	}
+};
+
+/**
+ * The abilities a character class starts with.  Set one as DefaultAbilitySet on an AOWSCharacterWithAbilities Blueprint
+ * so every character of that class shares one list instead of filling in the Ability1..Ability22 and Weapon1..Weapon2 slots.
+ */
+UCLASS(BlueprintType)
+class OWSPLUGIN_API UOWSAbilitySet : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Abilities")
+	TArray<FOWSAbilitySetEntry> Abilities;
+};
@@ -64,6 +64,9 @@ class OWSPLUGIN_API UOWSAbilityTask_SpawnProjectile : public UAbilityTask
 
 	void SpawnDelayedFakeProjectile();
 
+	/** Takes the projectile from the world's UOWSProjectilePoolSubsystem, which reuses an idle one when it can */
+	AOWSAdvancedProjectile* SpawnOrReuseProjectile(TSubclassOf<AOWSAdvancedProjectile> InProjectileClass, const FTransform& SpawnTransform, APawn* MyPawn, bool bFakeClientProjectile);
+
 	void GetAimTransform(FTransform& SpawnTransform);
 
 	virtual void Activate() override;
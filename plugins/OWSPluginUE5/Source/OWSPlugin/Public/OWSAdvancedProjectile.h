@@ -76,10 +76,20 @@ struct FRepUTProjMovement
 };
 
 
+/** Visibility of one projectile component as spawned, restored when a pooled projectile is reused */
+struct FOWSProjectileComponentVisibility
+{
+	TWeakObjectPtr<USceneComponent> Component;
+	bool bHiddenInGame;
+	bool bVisible;
+};
+
 UCLASS(meta = (ChildCanTick))
 class OWSPLUGIN_API AOWSAdvancedProjectile : public AActor
 {
 	GENERATED_UCLASS_BODY()
+
+	friend class UOWSProjectileSimulationSubsystem;
 	
 protected:	
 	// Sets default values for this actor's properties
@@ -136,18 +146,41 @@ protected:
 	/** true if already exploded (to avoid recursion, etc) */
 	bool bExploded;
 
+	/** How far back pawns are rewound when testing this projectile for hits.  Only set on the server for projectiles fired by remote players. */
+	float LagCompensationRewindSeconds;
+
+	/** Where this projectile was at the end of the last lag compensated sweep */
+	FVector LagCompensationPreviousLocation;
+
+	/** Starts lag compensated ticking if this projectile was fired by a remote player */
+	virtual void StartLagCompensation();
+
+	/** Hands movement to the UOWSProjectileSimulationSubsystem when bUseBatchedSimulation is set and the movement is simple enough */
+	void StartBatchedSimulation();
+	void StopBatchedSimulation();
+
+	/** Slot in the UOWSProjectileSimulationSubsystem, or INDEX_NONE while the movement component ticks on its own */
+	int32 BatchedSimulationIndex;
+
+	/** Sweeps the path travelled since the last tick against where pawns were LagCompensationRewindSeconds ago */
+	virtual void LagCompensatedPawnSweep();
+
 	/** Return true if InFakeProjectile is a possible match for this projectile. */
 	virtual bool CanMatchFake(AOWSAdvancedProjectile* InFakeProjectile, const FVector& VelDir) const;
 
 	/** Synchronize replicated projectile with the associated client-side fake projectile */
 	virtual void BeginFakeProjectileSynch(AOWSAdvancedProjectile* InFakeProjectile);
 
+	/** Catches a replicated projectile up to where it is on the server and hands its visuals to the matching fake projectile */
+	virtual void InitReplicatedProjectile();
+
 	/** Server catchup ticking for client's projectile */
 	virtual void CatchupTick(float CatchupTickDelta);
 
 	virtual void PreInitializeComponents() override;
 	virtual void TornOff() override;
 	virtual void Destroyed() override;
+	virtual void LifeSpanExpired() override;
 
 	UFUNCTION()
 		virtual void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
@@ -185,6 +218,28 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent)
 		void OnShutdown();
 
+	/** blueprint hook for projectiles reused from the pool, to restart any blueprint-created effects turned off in OnShutdown */
+	UFUNCTION(BlueprintImplementableEvent)
+		void OnActivatedFromPool();
+
+	/** Bumped by the server each time it reuses this projectile from the pool, so clients restart their copy */
+	UPROPERTY(ReplicatedUsing = OnRep_PoolGeneration)
+		uint8 PoolGeneration;
+
+	UFUNCTION()
+		virtual void OnRep_PoolGeneration();
+
+	/** Spawned by UOWSProjectilePoolSubsystem and goes back to it instead of being destroyed */
+	bool bPooledProjectile;
+
+	/** Idle in the pool, waiting to be reused */
+	bool bInProjectilePool;
+
+	TArray<FOWSProjectileComponentVisibility> PooledComponentVisibility;
+
+	/** True on a listen or dedicated server for a replicated projectile */
+	bool IsReplicatedByServer() const;
+
 	/** True once fully spawned, to avoid destroying replicated projectiles during spawn on client */
 	UPROPERTY()
 		bool bHasSpawnedFully;
@@ -218,6 +273,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Projectile)
 		float OverlapRadius;
 
+	/** Server tests pawn hits against where pawns were when the instigating player fired, rather than where they are now */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Projectile)
+		bool bUseLagCompensation;
+
+	/** Spent projectiles go back to the UOWSProjectilePoolSubsystem instead of being destroyed.  Servers only reuse classes that are not bNetTemporary. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Projectile)
+		bool bUseProjectilePool;
+
+	/** Servers move this projectile in one batch with every other one instead of ticking its movement component.  Only used for projectiles that don't bounce or simulate physics. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = Projectile)
+		bool bUseBatchedSimulation;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Projectile)
 		float ExplosionDamageRadius;
 
@@ -241,6 +308,21 @@ public:
 		FPredictionKey ProjectilePredictionKey;
 	*/
 
+	/** Called by UOWSProjectilePoolSubsystem on projectiles it spawns.  Remembers component visibility so it can be restored on reuse. */
+	void MarkPooled();
+
+	bool IsInProjectilePool() const { return bInProjectilePool; }
+
+	/** Turns off collision, movement, effects and lag compensation and drops any fake or master projectile.  Called when going back to the pool. */
+	virtual void ResetForPool();
+
+	/** Undoes ResetForPool and sets the projectile up for a new shot from SpawnTransform the same way a fresh spawn would be */
+	virtual void ActivateFromPool(const FTransform& SpawnTransform, APawn* NewInstigator);
+
+	/** Goes back to the pool if this projectile came from one, otherwise destroys it */
+	UFUNCTION(BlueprintCallable, Category = Projectile)
+		void ReturnToPoolOrDestroy();
+
 	/** Perform any custom initialization for this projectile as fake client side projectile */
 	virtual void InitFakeProjectile(class AOWSPlayerController* OwningPlayer);
 
@@ -6,8 +6,25 @@
 #include "Animation/AnimInstance.h"
 #include "OWSAnimInstance.generated.h"
 
+class UAnimSequence;
+
 /**
- * 
+ * Distance to time lookup for one UAnimSequence, built once from its DistanceCurve keys and shared by every anim instance playing it.
+ * Distances never decrease, so a lookup is a binary search plus a lerp.
+ */
+struct OWSPLUGIN_API FOWSDistanceMatchingTable
+{
+	TArray<float> Distances;
+	TArray<float> Times;
+
+	float GetTimeAtDistance(float Distance) const;
+
+	//Safe to call from worker threads.  Builds the table on first use and returns null if AnimSequence has no usable DistanceCurve.
+	static TSharedPtr<const FOWSDistanceMatchingTable> FindOrBuild(const UAnimSequence* AnimSequence);
+};
+
+/**
+ *
  */
 UCLASS()
 class OWSPLUGIN_API UOWSAnimInstance : public UAnimInstance
@@ -16,9 +33,13 @@ class OWSPLUGIN_API UOWSAnimInstance : public UAnimInstance
 
 public:
 
-	UFUNCTION(BlueprintCallable, Category = "Movement")
+	virtual void NativeInitializeAnimation() override;
+
+	UFUNCTION(BlueprintCallable, Category = "Movement", meta = (BlueprintThreadSafe))
 		float GetStartTimeByDistance(UAnimSequence* AnimSequence, float distance);
 
+	//Distance matched sequences to build lookup tables for when the anim instance initializes, instead of on the first GetStartTimeByDistance
+	UPROPERTY(EditDefaultsOnly, Category = "Movement")
+		TArray<TObjectPtr<UAnimSequence>> DistanceMatchedSequences;
 
-	
 };
@@ -0,0 +1,86 @@
+// Copyright 2022 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/StreamableManager.h"
+#include "OWSCharacter.h"
+#include "OWSAssetCacheSubsystem.generated.h"
+
+DECLARE_DELEGATE_OneParam(FOWSAssetLoadedDelegate, UObject*)
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOWSAssetLoadedDynamicDelegate, UObject*, LoadedAsset);
+
+//One cached path.  The handle keeps the asset loaded until the entry is evicted.
+struct FOWSCachedAsset
+{
+	TSharedPtr<FStreamableHandle> Handle;
+	//Callbacks waiting on the load, so a path is only ever requested once
+	TArray<FOWSAssetLoadedDelegate> PendingCallbacks;
+	//Position in the LRU list.  Only set once the load has finished.
+	TDoubleLinkedList<FSoftObjectPath>::TDoubleLinkedListNode* LRUNode = nullptr;
+};
+
+/**
+ * Streams assets named by path (item meshes, weapon classes, cosmetic materials) and keeps the most recently used ones loaded.
+ * Requests for a path that is already loading join the existing request.  Once more than OWSAssetCacheMaxAssets loaded assets
+ * are cached, the least recently used one is released so it can be garbage collected.
+ * UOWSGameInstance's Load*FromPath helpers go through this cache, so prefetching an item's assets turns their load into a lookup.
+ */
+UCLASS()
+class OWSPLUGIN_API UOWSAssetCacheSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	//Calls OnLoaded with the asset once it is loaded, or with nullptr if it can't be.  Calls it immediately on a cache hit.
+	void RequestAsset(const FSoftObjectPath& AssetPath, FOWSAssetLoadedDelegate OnLoaded);
+
+	UFUNCTION(BlueprintCallable, Category = "Assets")
+		void RequestAssetAsync(const FString& AssetPath, const FOWSAssetLoadedDynamicDelegate& OnLoaded);
+
+	//Returns the asset if it is loaded and cached, without loading it
+	UObject* GetCachedAsset(const FSoftObjectPath& AssetPath);
+
+	//Returns the asset, loading it on the game thread if it isn't cached yet.  Waits for an in flight request instead of issuing another.
+	UObject* LoadAssetSynchronous(const FSoftObjectPath& AssetPath);
+
+	template <typename T>
+	T* LoadAssetSynchronous(const FString& AssetPath)
+	{
+		return Cast<T>(LoadAssetSynchronous(FSoftObjectPath(AssetPath)));
+	}
+
+	//Starts streaming every path that isn't cached or loading yet, without waiting on any of them
+	void PrefetchAssets(const TArray<FSoftObjectPath>& AssetPaths);
+
+	//Prefetch the weapon class, meshes and icon of every item
+	UFUNCTION(BlueprintCallable, Category = "Assets")
+		void PrefetchItemAssets(const TArray<FInventoryItemStruct>& Items);
+
+	//Prefetch every custom data value that is an asset path, e.g. cosmetic meshes and materials
+	UFUNCTION(BlueprintCallable, Category = "Assets")
+		void PrefetchCustomCharacterDataAssets(const TArray<FCustomCharacterDataStruct>& CustomCharacterData);
+
+	//Releases the cached handle for AssetPath.  The asset is unloaded by the next garbage collection unless something else references it.
+	void EvictAsset(const FSoftObjectPath& AssetPath);
+
+	int32 GetNumCachedAssets() const { return LRUList.Num(); }
+
+protected:
+	void OnAssetLoaded(FSoftObjectPath AssetPath);
+	void MarkUsed(FOWSCachedAsset& CachedAsset);
+	void EvictLeastRecentlyUsed();
+
+	FStreamableManager StreamableManager;
+
+	TMap<FSoftObjectPath, FOWSCachedAsset> CachedAssets;
+
+	//Loaded paths, most recently used at the head
+	TDoubleLinkedList<FSoftObjectPath> LRUList;
+
+	int32 MaxCachedAssets;
+};
@@ -0,0 +1,26 @@
+// Copyright 2022 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Frame times recorded by the OWS.* stress console commands while a pass runs, logged as the average, 99th percentile and worst frame when it ends.
+ */
+struct OWSPLUGIN_API FOWSBenchmarkFrameTimes
+{
+	//Reserves room for Seconds of frames at up to 240 fps
+	void Reserve(float Seconds);
+
+	void Add(float DeltaTime) { FrameTimes.Add(DeltaTime); }
+
+	//Logs the frame time summary line and empties the samples
+	void LogAndReset();
+
+private:
+	TArray<float> FrameTimes;
+};
+
+#endif
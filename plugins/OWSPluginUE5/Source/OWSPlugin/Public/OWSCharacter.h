@@ -8,8 +8,10 @@
 #include "Runtime/JsonUtilities/Public/JsonObjectConverter.h"
 #include "Runtime/Core/Public/Misc/Guid.h"
 #include "GenericTeamAgentInterface.h"
+#include "Engine/NetSerialization.h"
 #include "OWS2API.h"
 #include "OWSInventory.h"
+#include "OWSItemCatalog.h"
 #include "OWSCharacter.generated.h"
 
 class AOWSGameMode;
@@ -332,6 +334,33 @@ public:
 		FCharacterStats UpdateCharacterStats;
 };
 
+/**
+ * The owner-only part of the character sheet, replicated as one property.  Each net update sends only the stats that changed since
+ * the last update that connection received, with a bit per stat saying whether its value follows.
+ */
+USTRUCT()
+struct FOWSCharacterStatSheet
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+		TArray<float> FloatStats;
+	UPROPERTY()
+		TArray<int32> IntStats;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+template<>
+struct TStructOpsTypeTraits<FOWSCharacterStatSheet> : public TStructOpsTypeTraitsBase2<FOWSCharacterStatSheet>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
 UCLASS()
 class OWSPLUGIN_API AOWSCharacter : public AOWSCharacterBase, public IGenericTeamAgentInterface
 {
@@ -387,6 +416,40 @@ public:
 
 	virtual void PossessedBy(AController* NewController) override;
 
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+	/*
+	 * Stats replicate in three tiers.  Name, class, level, team and health go to everyone.  The rest of the sheet only goes
+	 * to the owning connection, through OwnerStatSheet.  Other players get it on demand with RequestInspectStats, minus currency.
+	 */
+
+	//Ask the server for Target's stat sheet.  Call on the local player's own character.  NotifyInspectStatsReceived fires on Target when it arrives.
+	//The server ignores the request if Target is further away than MaxInspectDistance.
+	UFUNCTION(BlueprintCallable, Category = "Stats")
+		void RequestInspectStats(AOWSCharacter* Target);
+
+	UFUNCTION(BlueprintImplementableEvent, Category = "Stats")
+		void NotifyInspectStatsReceived();
+
+	//How close Target has to be for the server to answer RequestInspectStats
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+		float MaxInspectDistance;
+
+	UFUNCTION(Server, Reliable, WithValidation)
+		void Server_RequestInspectStats(AOWSCharacter* Target);
+
+	UFUNCTION(Client, Reliable)
+		void Client_ReceiveInspectStats(AOWSCharacter* Target, const TArray<float>& FloatStats, const TArray<int32>& IntStats);
+
+	void PackStatSheet(FOWSCharacterStatSheet& OutStatSheet) const;
+	void UnpackStatSheet(const FOWSCharacterStatSheet& StatSheet);
+
+	UPROPERTY(ReplicatedUsing = OnRep_OwnerStatSheet)
+		FOWSCharacterStatSheet OwnerStatSheet;
+
+	UFUNCTION()
+		void OnRep_OwnerStatSheet();
+
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Init")
 		void OnRPGInitalizationComplete();
 
@@ -399,6 +462,15 @@ public:
 	virtual void LoadCharacterStats();
 	virtual void LoadCharacterStatsFromJSON(TSharedPtr<FJsonObject> JsonObject);
 
+	//Get stats, custom data, abilities and ability bars in one request.  Each arrives through the same notify as its individual Get call.
+	UFUNCTION(BlueprintCallable, Category = "Stats")
+		void LoadCharacterBootstrap();
+
+	//Load the character with LoadCharacterBootstrap on possess instead of LoadCharacterStats.  Don't also call GetCustomCharacterData,
+	//GetCharacterAbilities or GetAbilityBars on possess when this is on, or they will be loaded twice.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stats")
+		bool bLoadCharacterWithBootstrap;
+
 	//Update Character Stats
 	UFUNCTION(BlueprintCallable, Category = "Stats")
 		void UpdateCharacterStatsBase();
@@ -464,8 +536,11 @@ public:
 	UPROPERTY(Transient)
 		TArray<FInventoryItemStruct> LocalInventoryItems;
 
-	//UPROPERTY(Transient, ReplicatedUsing = OnRep_InventoriesToManage)
-	UPROPERTY(Transient)
+	//Hashed index over LocalInventoryItems
+	FOWSItemCatalog LocalInventoryItemCatalog;
+
+	//Each inventory is also registered as an owner only replicated subobject
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_InventoriesToManage)
 		TArray<UOWSInventory*> InventoriesToManage;
 
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
@@ -478,18 +553,22 @@ public:
 		void Client_AddItemToLocalInventoryItems(const FString& ItemName, const bool ItemCanStack, const bool IsUsable, const bool IsConsumedOnUse, const int32 ItemTypeID, 
 			const FString& TextureToUseForIcon, const int32 IconSlotWidth, const int32 IconSlotHeight, const int32 ItemMeshID, const FString& CustomData);
 
-	UFUNCTION(Client, Reliable)
-		void Client_CreateHUDInventory(FName InventoryName, int32 Size, int32 NumberOfColumns);
-
-	UFUNCTION(Client, Reliable)
-		void Client_AddItemToInventory(const FName& InventoryName, const FString& ItemName, const int32 StackSize, const int32 InSlotNumber, const int32 NumberOfUsesLeft, const int32 Condition,
-			const FString& PerInstanceCustomData, const FGuid UniqueItemGUID, const int32 ItemMeshID);
-
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 		UOWSInventory* GetHUDInventoryFromName(FName InventoryName);
 
 	FString SerializeInventory(FName InventoryName);
 
+	//HUD inventory actions.  A client's inventories only mirror the server's, so these change the server's copy and the result replicates back.
+	//Called with authority (listen server host, standalone) they run locally.
+
+	//Stacks the item in SourceSlot onto DestSlot if it can, otherwise swaps the two slots.  The slots can be in different inventories.
+	UFUNCTION(Server, Reliable, WithValidation)
+		void Server_MoveInventorySlot(FName SourceInventoryName, int32 SourceSlot, FName DestInventoryName, int32 DestSlot);
+
+	//Moves Quantity items off the stack in Slot into the first empty slot they fit in
+	UFUNCTION(Server, Reliable, WithValidation)
+		void Server_SplitInventoryStack(FName InventoryName, int32 Slot, int32 Quantity);
+
 	//Get Character Inventory
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 		void GetInventoryItems(FString InventoryName);
@@ -606,154 +685,154 @@ public:
 		bool IsEnemy;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes", Replicated)
 		int32 CharacterLevel;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes")
 		int32 XP;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes", Replicated)
 		int32 TeamNumber;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes")
 		int32 Gold;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes")
 		int32 Silver;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes")
 		int32 Copper;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes")
 		int32 FreeCurrency;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes")
 		int32 PremiumCurrency;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterAttributes")
 		int32 Score;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float HitDie;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
 		float Wounds;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Thirst;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Hunger;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
 		float MaxHealth;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
 		float Health;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float HealthRegenRate;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float MaxMana;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Mana;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float ManaRegenRate;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float MaxEnergy;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Energy;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float EnergyRegenRate;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float MaxFatigue;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Fatigue;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float FatigueRegenRate;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float MaxStamina;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Stamina;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float StaminaRegenRate;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float MaxEndurance;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Endurance;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float EnduranceRegenRate;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Strength;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Dexterity;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Constitution;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Intellect;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Wisdom;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Charisma;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Agility;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Spirit;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Magic;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Fortitude;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Reflex;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Willpower;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float BaseAttack;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float BaseAttackBonus;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float AttackPower;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float AttackSpeed;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float CritChance;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float CritMultiplier;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Haste;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float SpellPower;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float SpellPenetration;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Defense;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Dodge;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Parry;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Avoidance;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Versatility;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Multishot;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Initiative;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float NaturalArmor;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float PhysicalArmor;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float BonusArmor;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float ForceArmor;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float MagicArmor;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Resistance;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float ReloadSpeed;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Range;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		float Speed;
 
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		int32 HitDice;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
 		int32 MaxHP;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		int32 Perception;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		int32 Acrobatics;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		int32 Climb;
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats", Replicated)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CharacterStats")
 		int32 Stealth;
 
 };
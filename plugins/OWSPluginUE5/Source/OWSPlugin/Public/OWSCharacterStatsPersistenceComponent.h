@@ -0,0 +1,92 @@
+// Copyright 2022 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Containers/BitArray.h"
+#include "GameplayEffectTypes.h"
+#include "OWSCharacterStatsPersistenceComponent.generated.h"
+
+class AOWSCharacterWithAbilities;
+
+//The stats that changed since the last save, keyed by Characters column name
+USTRUCT()
+struct FUpdateCharacterStatsDelta
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		FString CharName;
+	UPROPERTY()
+		TMap<FString, float> FloatStats;
+	UPROPERTY()
+		TMap<FString, int32> IntStats;
+};
+
+USTRUCT()
+struct FUpdateCharacterStatsDeltaJSONPost
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		FUpdateCharacterStatsDelta UpdateCharacterStatsDelta;
+};
+
+/**
+ * Saves an AOWSCharacterWithAbilities' stats as they change instead of as a full sheet.
+ * Attribute changes set a bit in a dirty bitset through the ability system's change delegates.  Stats that live on the character
+ * itself (XP, currency, skills) are compared against their last saved values at flush time.  Every OWSCharacterStatsFlushInterval
+ * seconds, only the stats whose value differs from the last save are sent to UpdateCharacterStatsDelta.
+ * Nothing is saved until the character's stats have been loaded, so defaults never overwrite a saved character.
+ * AOWSCharacterWithAbilities::UpdateCharacterStats still saves the full sheet and resets the baseline.
+ */
+UCLASS(ClassGroup = (Custom))
+class OWSPLUGIN_API UOWSCharacterStatsPersistenceComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UOWSCharacterStatsPersistenceComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	//Send whatever changed since the last save.  Server only.
+	UFUNCTION(BlueprintCallable, Category = "Stats")
+		void FlushDirtyStats();
+
+	//Save the full sheet now, e.g. after a GM edit or when the database may be out of sync
+	UFUNCTION(BlueprintCallable, Category = "Stats")
+		void RequestFullResync();
+
+	//Treat the current values as saved.  Called after the stats are loaded and after a full sheet save.
+	void MarkAllStatsSaved();
+
+	int32 GetNumDirtyStats() const { return DirtyStats.CountSetBits(); }
+
+protected:
+	void OnAttributeChanged(const FOnAttributeChangeData& Data, int32 StatIndex);
+	void OnFlushSucceeded();
+	void OnFlushFailed(const FString& ErrorMsg);
+
+	double GetStatValue(int32 StatIndex) const;
+
+	UPROPERTY()
+		AOWSCharacterWithAbilities* OwningCharacter;
+
+	float FlushInterval;
+	FTimerHandle FlushTimerHandle;
+
+	//Whether the stats have been loaded and SavedValues is meaningful
+	bool bHasSavedBaseline;
+
+	//One entry per persisted stat, in the order of the stat table
+	TArray<double> SavedValues;
+	TBitArray<> DirtyStats;
+
+	//The stats in the save that hasn't been answered yet, and the values that were sent
+	TBitArray<> InFlightStats;
+	TArray<double> InFlightValues;
+	bool bFlushInFlight;
+};
@@ -7,9 +7,11 @@
 #include "OWSAttributeSet.h"
 //#include "OWSGameplayAbility.h"
 #include "GameplayEffectTypes.h"
+#include "OWSAbilitySet.h"
 #include "OWSCharacterWithAbilities.generated.h"
 
 class AOWSAdvancedProjectile;
+class UOWSCharacterStatsPersistenceComponent;
 
 UENUM(BlueprintType)
 enum class AbilityInput : uint8
@@ -66,6 +68,7 @@ public:
 
 	virtual void OnRep_Controller() override;
 
+	//Grants the Ability and Weapon slots plus DefaultAbilitySet, once per character
 	void AddDefaultGameplayAbilities();
 	void SetupAttributeChangeDelegates();
 
@@ -112,10 +115,13 @@ public:
 
 	//void OnGetCharacterStatsResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
 
-	//Update Character Stats
+	//Update Character Stats.  Saves the full sheet.  StatsPersistence saves individual stats as they change in between.
 	UFUNCTION(BlueprintCallable, Category = "Stats")
 		void UpdateCharacterStats();
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Stats")
+		UOWSCharacterStatsPersistenceComponent* StatsPersistence;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Abilities, meta = (AllowPrivateAccess = "true"))
 		TObjectPtr<UAbilitySystemComponent> AbilitySystem;
 
@@ -137,6 +143,11 @@ public:
 		void GrantAbility(TSubclassOf<class UGameplayAbility> NewAbility);
 	UFUNCTION(BlueprintCallable, Category = Combat)
 		void GrantAbilityKeyBind(TSubclassOf<class UGameplayAbility> NewAbility, int AbilityLevel, int InputID);
+	UFUNCTION(BlueprintCallable, Category = Combat)
+		void GrantAbilitySet(const UOWSAbilitySet* AbilitySet);
+
+	//Gives every entry to the ability system in one pass.  Spell and Weapon entries replace whatever is in their slot.
+	void GrantAbilities(TConstArrayView<FOWSAbilitySetEntry> Abilities);
 	UFUNCTION(BlueprintImplementableEvent, Category = Combat)
 		void OnDeath(AOWSCharacter* WhoKilledMe);
 	UFUNCTION(BlueprintImplementableEvent, Category = Combat)
@@ -144,6 +155,12 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category = Combat)
 		void OnInflictDamage(AOWSCharacter* WhoWasDamaged, float DamageAmount, bool IsCritical);
 
+	//Granted on top of the Ability and Weapon slots below
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Abilities)
+		TObjectPtr<UOWSAbilitySet> DefaultAbilitySet;
+
+	bool bDefaultAbilitiesGranted;
+
 	//Spells
 	UPROPERTY()
 		TArray<FGameplayAbilitySpecHandle> SpellAbilityHandles;
@@ -3,9 +3,11 @@
 #pragma once
 
 #include "GameFramework/Actor.h"
-#include "Runtime/Online/HTTP/Public/Http.h"
 #include "OWSChatManager.generated.h"
 
+class IWebSocket;
+class AOWSPlayerController;
+
 USTRUCT(BlueprintType, Blueprintable)
 struct FChatMessage
 {
@@ -32,7 +34,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Chat")
 		FString SentByCharName;
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Chat")
-		int32 SentToCharID;	
+		int32 SentToCharID;
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Chat")
 		FString SentToCharName;
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Chat")
@@ -41,62 +43,127 @@ public:
 		FString ChatGroupName;
 };
 
+//A character on this zone server joining or leaving a chat group, so the relay knows where to route group messages
+USTRUCT()
+struct FChatGroupMembershipChange
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+		FString CharacterName;
+	UPROPERTY()
+		FString ChatGroupName;
+	UPROPERTY()
+		bool Joined = false;
+};
+
+//One text frame on the chat relay connection, in either direction.  Outbound frames batch everything queued since the last flush.
+USTRUCT()
+struct FChatRelayFrame
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+		TArray<FChatMessage> Messages;
+	UPROPERTY()
+		TArray<FChatGroupMembershipChange> MembershipChanges;
+};
+
+/**
+ * Chat for a zone server.  The server keeps one WebSocket open to the chat relay (OWSChatRelayURL) for the life of the zone.
+ * Outgoing messages are queued and sent as one frame every OWSChatFlushInterval seconds.  Messages the relay pushes back are
+ * fanned out to players over RPCs: global chat as one multicast, private and group chat as one client RPC per recipient per flush.
+ * Without a relay URL, chat stays local to this zone server.
+ */
 UCLASS()
 class OWSPLUGIN_API AOWSChatManager : public AActor
 {
 	GENERATED_BODY()
 
-	FHttpModule* Http;
-
-public:	
+public:
 	// Sets default values for this actor's properties
 	AOWSChatManager();
 
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
-	
-	// Called every frame
-	virtual void Tick( float DeltaSeconds ) override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	//Send Global Chat
 	UFUNCTION(BlueprintCallable, Category = "Chat")
 		void SendGlobalChat(FString SentFromCharacterName, FString Message);
 
-	void OnSendGlobalChatResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
-
 	//Send Chat to Channel
 	UFUNCTION(BlueprintCallable, Category = "Chat")
 		void SendChatToChannel(FString SentFromCharacterName, FString Message, FString ChatChannelName);
 
-	void OnSendChatToChannelResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
-
 	//Send Private Message
 	UFUNCTION(BlueprintCallable, Category = "Chat")
 		void SendPrivateChatMessage(FString SentFromCharacterName, FString SendToCharacterName, FString Message);
 
-	void OnSendPrivateChatMessageResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);	
-
-	//Get new Chat Messages
+	//Get new Chat Messages.  Messages are pushed as they arrive, so this only replays recently received messages newer than LastChatMessageReceived.
 	UFUNCTION(BlueprintCallable, Category = "Chat")
 		void GetNewChatMessages(int32 LastChatMessageReceived);
 
-	void OnGetNewChatMessagesResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
-
 	UFUNCTION(BlueprintImplementableEvent, Category = "Chat")
 		void NotifyGetNewChatMessages(const TArray<FChatMessage> &NewChatMessages, const int32 MaxMessageID);
 	UFUNCTION(BlueprintImplementableEvent, Category = "Chat")
 		void ErrorGetNewChatMessages(const FString &ErrorMsg);
 
-	//Add to Chat Group
+	//Add to Chat Group.  Server only.
 	UFUNCTION(BlueprintCallable, Category = "Chat")
 		void AddOrJoinChatGroup(FString CharacterNameToAdd, FString ChatGroupName);
 
-	void OnAddOrJoinChatGroupResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
-
-	//Leave Chat Group
+	//Leave Chat Group.  Server only.
 	UFUNCTION(BlueprintCallable, Category = "Chat")
 		void LeaveChatGroup(FString CharacterNameToRemove, FString ChatGroupName);
 
-	void OnLeaveChatGroupResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
-	
+	//Queues a message on the server, from SendChatMessage with authority or from AOWSPlayerController::Server_SendChatMessage.
+	void QueueOutgoingChatMessage(const FChatMessage& ChatMessage);
+
+	//Called on clients with a batch of messages for the local player
+	void ReceiveChatMessages(const TArray<FChatMessage>& ChatMessages);
+
+protected:
+	UFUNCTION(NetMulticast, Reliable)
+		void Multicast_ReceiveGlobalChatMessages(const TArray<FChatMessage>& ChatMessages);
+
+	//With authority the message is queued as SentFromCharacterName.  On a client it goes through the local player's Server_SendChatMessage.
+	void SendChatMessage(const FString& SentFromCharacterName, const FString& Message, const FString& SendToCharacterName, const FString& ChatGroupName);
+
+	void ConnectToChatRelay();
+	void OnChatRelayConnected();
+	void OnChatRelayConnectionError(const FString& Error);
+	void OnChatRelayClosed(int32 StatusCode, const FString& Reason, bool bWasClean);
+	void OnChatRelayRawMessage(const void* Data, SIZE_T Size, SIZE_T BytesRemaining);
+	void ScheduleReconnect();
+
+	//Sends the queued outbound frame and fans out everything received since the last flush
+	void FlushChat();
+	void FanOutIncomingMessages();
+
+	TSharedPtr<IWebSocket> ChatRelaySocket;
+
+	FString ChatRelayURL;
+	FString OWSAPICustomerKey;
+	float ChatFlushInterval;
+	float ChatReconnectDelay;
+	int32 ChatHistorySize;
+
+	FTimerHandle FlushTimerHandle;
+	FTimerHandle ReconnectTimerHandle;
+
+	FChatRelayFrame PendingOutbound;
+	TArray<FChatMessage> PendingIncoming;
+	TArray<uint8> ReceiveBuffer;
+
+	//Chat groups of characters on this server, by group name
+	TMap<FString, TSet<FString>> ChatGroupMembers;
+
+	//Most recently received messages, oldest first, for GetNewChatMessages
+	TArray<FChatMessage> RecentMessages;
+	int32 MaxMessageID;
+
+	//IDs for messages that stay on this server when there is no relay to number them
+	int32 LastLocalChatMessageID;
 };
@@ -42,6 +42,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "JSON")
 		FString SerializeStructToJSONString(const UStruct* StructToSerialize);
 
+	//The Load*FromPath helpers go through UOWSAssetCacheSubsystem.  They only load on the game thread when the asset wasn't prefetched.
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 		TSubclassOf<class AActor> LoadWeaponActorClassFromPath(FString WeaponActorClassPath);
 
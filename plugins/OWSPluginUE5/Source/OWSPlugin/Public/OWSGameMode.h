@@ -7,8 +7,11 @@
 #include "OWSGameModeComponent.h"
 #include "OWSCharacter.h"
 #include "OWSPlayerController.h"
+#include "OWSItemCatalog.h"
 #include "OWSGameMode.generated.h"
 
+class AOWSItemMeshRegistry;
+
 USTRUCT(BlueprintType)
 struct FCharactersOnlineStruct
 {
@@ -94,6 +97,17 @@ public:
 
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FItemLibraryLoadedSignature);
+
+//Quantized player transform as last sent by SaveAllPlayerLocations.  Location is in 1/10 units, rotation uses FRotator::CompressAxisToShort.
+struct FOWSSavedPlayerPosition
+{
+	int64 X = 0;
+	int64 Y = 0;
+	int64 Z = 0;
+	uint16 RX = 0;
+	uint16 RY = 0;
+	uint16 RZ = 0;
+};
 /**
  * 
  */
@@ -109,6 +123,18 @@ protected:
 	//Used to keep track of the batch for SaveAllPlayerLocations
 	int NextSaveGroupIndex = -1;
 
+	//Last position the API acknowledged for each player.  Delta saves are encoded against these.
+	TMap<FString, FOWSSavedPlayerPosition> AcknowledgedPlayerPositions;
+	//Players in a delta save that hasn't been answered yet.  They are skipped until it is, so every delta is against an acknowledged position.
+	TSet<FString> PlayersWithPositionSaveInFlight;
+	//Final position to send for a player that was flushed while a save was in flight
+	TMap<FString, FOWSSavedPlayerPosition> PendingFinalPlayerPositions;
+	//Players that logged out while a save was in flight.  Their acknowledged position is dropped once it's answered.
+	TSet<FString> PlayersPendingLogout;
+
+	bool GetPlayerPositionToSave(APlayerController* PlayerController, FString& PlayerName, FOWSSavedPlayerPosition& Position) const;
+	void WritePlayerLocationRecord(TArray<uint8>& Records, const FString& PlayerName, const FOWSSavedPlayerPosition& Position, const FOWSSavedPlayerPosition* Acknowledged) const;
+
 	FString InitNewPlayer(APlayerController* NewPlayerController, const FUniqueNetIdRepl& UniqueId, const FString& Options, const FString& Portal);	
 
 public:
@@ -120,6 +146,10 @@ public:
 
 	virtual void StartPlay();
 
+	virtual void PostLogin(APlayerController* NewPlayer) override;
+
+	virtual void Logout(AController* Exiting) override;
+
 	APawn * SpawnDefaultPawnFor_Implementation(AController * NewPlayer, class AActor * StartSpot);
 
 	UPROPERTY(BlueprintAssignable, Category = "Item Library Loaded")
@@ -137,11 +167,25 @@ public:
 	UPROPERTY()
 		TMap<FString, int32> MeshItemsMap;
 
+	//Replicates MeshItemsMap to every client.  Spawned in StartPlay.
+	UPROPERTY()
+		AOWSItemMeshRegistry* ItemMeshRegistry;
+
 	UFUNCTION()
 		void AddItemMeshToAllPlayers(const FString& ItemName, const int32 ItemMeshID);
 
+	//Logs an error and returns an empty definition if ItemName is not in AllInventoryItems
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 		FInventoryItemStruct& FindItemDefinition(FString ItemName);
+
+	//Returns nullptr if ItemName is not in AllInventoryItems
+	const FInventoryItemStruct* FindItemDefinitionByName(const FName ItemName);
+
+	//Hashed index over AllInventoryItems
+	FOWSItemCatalog ItemCatalog;
+
+	//Returned by FindItemDefinition for items that don't exist
+	FInventoryItemStruct MissingItemDefinition;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Zones")
 		TArray<FCharactersOnlineStruct> CharactersOnline;
@@ -169,6 +213,29 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
 		int SplitSaveIntoHowManyGroups;
 
+	//Send SaveAllPlayerLocations as a binary delta snapshot containing only players that moved.  Turn off to use the original delimited string format.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
+		bool bSavePlayerLocationsAsDeltas = true;
+
+	//A player is only included in a delta save after moving at least this far since their last acknowledged save
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
+		float SavePlayerLocationMinDistance = 10.f;
+
+	//A player is only included in a delta save after turning at least this many degrees on any axis since their last acknowledged save
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
+		float SavePlayerLocationMinRotationDegrees = 5.f;
+
+	//Save player locations through UOWSSaveSchedulerSubsystem instead of the SaveAllPlayerLocations timer.  Requires bSavePlayerLocationsAsDeltas.
+	//SaveIntervalInSeconds becomes the longest a moving player can go without being saved.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
+		bool bUseSaveScheduler = true;
+
+	//How long the save scheduler may spend picking and encoding players each frame
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Settings")
+		float SaveSchedulerBudgetMilliseconds = 0.2f;
+
+	bool IsUsingSaveScheduler() const { return bUseSaveScheduler && bSavePlayerLocationsAsDeltas && SaveIntervalInSeconds > 0.f; }
+
 	FTimerHandle SaveAllPlayerLocationsTimerHandle;
 
 
@@ -253,6 +320,13 @@ public:
 		void SaveAllPlayerLocations();
 
 	void OnSaveAllPlayerLocationsResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+	void SaveAllPlayerLocationsAsDeltas();
+	//Appends a record for this player if they moved enough since their last acknowledged save.  Returns false if they can't be saved until a save in flight is answered.
+	bool AppendPlayerLocationRecord(APlayerController* PlayerController, TArray<uint8>& Records, TMap<FString, FOWSSavedPlayerPosition>& SentPlayerPositions, bool bForceKeyframe);
+	void SendPlayerLocationRecords(const TArray<uint8>& Records, TMap<FString, FOWSSavedPlayerPosition> SentPlayerPositions);
+	//Saves this player's location now as a keyframe, whether or not they moved
+	void FlushPlayerLocation(APlayerController* PlayerController);
+	void OnSaveAllPlayerLocationsDeltaResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful, TMap<FString, FOWSSavedPlayerPosition> SentPlayerPositions);
 
 	//Get all players online
 	UFUNCTION(BlueprintCallable, Category = "Character")
@@ -291,6 +365,9 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category = "Zones")
 		void ErrorGetZoneInstanceFromZoneInstanceID(const FString &ErrorMsg);
 
+	//Sizes the UOWSReplicationGraph grid to this zone's bounds when the net driver uses it
+	void ApplyZoneReplicationSettings(const FString& MapName);
+
 	//Update Number of Players
 	UFUNCTION(BlueprintCallable, Category = "Zones")
 	void UpdateNumberOfPlayers();
@@ -341,6 +418,7 @@ public:
 	AOWSPlayerController* GetPlayerControllerFromCharacterName(const FString CharacterName);
 
 	void ProcessOWS2POSTRequest(FString ApiModuleToCall, FString ApiToCall, FString PostParameters, void (AOWSGameMode::* InMethodPtr)(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful));
+	TSharedRef<IHttpRequest, ESPMode::ThreadSafe> CreateOWS2POSTRequest(FString ApiModuleToCall, FString ApiToCall, FString PostParameters);
 
 protected:
 	void BroadcastItemLibraryLoaded()
@@ -25,11 +25,11 @@ class OWSPLUGIN_API AOWSGameplayAbilityTargetActor_Tr : public AOWSGameplayAbili
 public:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-	/** Traces as normal, but will manually filter all hit actors */
-	static void LineTraceWithFilter(FHitResult& OutHitResult, const UWorld* World, const FOWSGameplayTargetDataFilterHandle FilterHandle, const FVector& Start, const FVector& End, FName ProfileName, const FCollisionQueryParams Params);
+	/** Traces as normal, but will manually filter all hit actors.  When RewindSeconds is above zero, pawns are tested where they were that long ago on the server. */
+	static void LineTraceWithFilter(FHitResult& OutHitResult, const UWorld* World, const FOWSGameplayTargetDataFilterHandle FilterHandle, const FVector& Start, const FVector& End, FName ProfileName, const FCollisionQueryParams Params, float RewindSeconds = 0.f);
 
-	/** Sweeps as normal, but will manually filter all hit actors */
-	static void SweepWithFilter(FHitResult& OutHitResult, const UWorld* World, const FOWSGameplayTargetDataFilterHandle FilterHandle, const FVector& Start, const FVector& End, const FQuat& Rotation, const FCollisionShape CollisionShape, FName ProfileName, const FCollisionQueryParams Params);
+	/** Sweeps as normal, but will manually filter all hit actors.  When RewindSeconds is above zero, pawns are tested where they were that long ago on the server. */
+	static void SweepWithFilter(FHitResult& OutHitResult, const UWorld* World, const FOWSGameplayTargetDataFilterHandle FilterHandle, const FVector& Start, const FVector& End, const FQuat& Rotation, const FCollisionShape CollisionShape, FName ProfileName, const FCollisionQueryParams Params, float RewindSeconds = 0.f);
 
 	void AimWithPlayerController(const AActor* InSourceActor, FCollisionQueryParams Params, const FVector& TraceStart, FVector& OutTraceEnd, bool bIgnorePitch = false) const;
 
@@ -51,9 +51,19 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ExposeOnSpawn = true), Category = Trace)
 		bool bTraceAffectsAimPitch;
 
+	// Test remote players' traces against where pawns were when they fired, rather than where the server has them now
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ExposeOnSpawn = true), Category = Trace)
+		bool bUseLagCompensation;
+
 protected:
 	virtual FHitResult PerformTrace(AActor* InSourceActor) PURE_VIRTUAL(AGameplayAbilityTargetActor_Trace, return FHitResult(););
 
+	/** How far back to rewind pawns for the owning player's traces.  Zero on clients, for local players, or when lag compensation is off. */
+	float GetLagCompensationRewindSeconds() const;
+
+	/** Replaces OutHitResult with a hit on a rewound pawn if one is closer than the world hit.  HitResults must be the unfiltered physics hits. */
+	static void ApplyLagCompensation(FHitResult& OutHitResult, const UWorld* World, const FOWSGameplayTargetDataFilterHandle& FilterHandle, const FVector& Start, const FVector& End, float SweepRadius, FName ProfileName, const FCollisionQueryParams& Params, const TArray<FHitResult>& HitResults, float RewindSeconds);
+
 	FGameplayAbilityTargetDataHandle MakeTargetData(const FHitResult& HitResult) const;
 
 	TWeakObjectPtr<AGameplayAbilityWorldReticle> ReticleActor;
@@ -5,7 +5,6 @@
 #include "CoreMinimal.h"
 #include "GameFramework/HUD.h"
 #include "OWSCharacter.h"
-#include "OWSInventoryItemStack.h"
 #include "OWSInventory.h"
 #include "Engine/Canvas.h"
 #include "Engine/Font.h"
@@ -43,6 +42,9 @@ struct FFloatingDamage
 		DamageText = "";
 		DamageTextLength = 0.f;
 		TimeLeft = 0.f;
+		TimeSinceLastHit = 0.f;
+		Amount = 0;
+		IsNumeric = false;
 		Alpha = 0.f;
 		DisplayLocation = FVector2D(0);
 		DamagedActor = nullptr;
@@ -89,6 +91,40 @@ struct FFloatingDamage
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Floating Text")
 		bool ShowOutline;
+
+	//Seconds since the item was added or last had a hit added to it
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Floating Text")
+		float TimeSinceLastHit;
+
+	//DamageText as a number, when it is one.  Hits on the same actor are added together.
+	int64 Amount;
+	bool IsNumeric;
+};
+
+//Widths of the characters in numeric floating text, measured once per font
+struct FOWSNumericGlyphWidths
+{
+	static constexpr int32 NumGlyphs = 14;
+
+	//0-9, then + - . ,
+	float Widths[NumGlyphs];
+
+	static int32 GetGlyphIndex(TCHAR Char)
+	{
+		if (Char >= TEXT('0') && Char <= TEXT('9'))
+		{
+			return Char - TEXT('0');
+		}
+
+		switch (Char)
+		{
+		case TEXT('+'): return 10;
+		case TEXT('-'): return 11;
+		case TEXT('.'): return 12;
+		case TEXT(','): return 13;
+		default: return INDEX_NONE;
+		}
+	}
 };
 
 USTRUCT(BlueprintType)
@@ -228,6 +264,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Floating Critical Healing")
 		float FloatingCriticalHealingFadeOutSpeed;
 
+	//Floating damage items are drawn from a pool of this many.  When every item is in use the oldest one is replaced.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Floating Damage", meta = (ClampMin = 1))
+		int32 MaxFloatingDamageItems;
+	//Numeric hits on the same actor, of the same kind, within this many seconds of each other are shown as one number.  0 to show every hit.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Floating Damage")
+		float FloatingDamageAggregationWindow;
+
 	UFUNCTION(BlueprintCallable, Category = "Damage")
 		void AddFloatingDamageItem(FString DamageText, AActor* DamagedActor, FVector DamagedActorOffset, bool IsHealing = false, bool IsCritical = false, bool ShowDropShadow = false, bool ShowOutline = false);
 
@@ -253,18 +296,31 @@ protected:
 	bool SplitDialogOpen;
 	int32 SplitNumber;
 	int32 StackToSplitSize;
-	UOWSInventoryItemStack* InventoryItemStackToSplit;
+	FName InventoryToSplitFrom;
+	int32 SlotToSplit;
 	UTexture* SplitDialogTexture;
 	//int32 ScreenCenterX;
 	//int32 ScreenCenterY;
 	int32 ScreenWidth;
 	int32 ScreenHeight;
 
+	//Fixed size pool used as a ring.  Items with MarkedForDeletion set are free.
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Damage")
 		TArray<FFloatingDamage> FloatingDamageItems;
+	//The pool slot the next new item goes in
+	int32 NextFloatingDamageItem;
+
+	TMap<TObjectKey<UFont>, FOWSNumericGlyphWidths> NumericGlyphWidthCache;
+
+	//Adds the hit to a recent item on the same actor.  Returns false if there isn't one.
+	bool AggregateFloatingDamage(AActor* DamagedActor, int64 Amount, bool IsHealing, bool IsCritical);
+	float MeasureFloatingText(const FString& Text, UFont* Font);
+
+	//The item being dragged is in SlotBeingDraggedFrom of InventoryBeingDraggedFrom
+	bool bIsDraggingItem;
 
-	UPROPERTY()
-		UOWSInventoryItemStack* ItemStackBeingDragged;
+	bool IsSlotBeingDragged(const UOWSInventory* Inventory, int32 Slot) const;
+	const FOWSInventoryItemRecord* GetItemBeingDragged() const;
 
 	UFUNCTION(BlueprintCallable, Category = "Damage")
 		void RenderFloatingDamage(float DeltaTime);
@@ -5,15 +5,62 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "OWSInventoryItem.h"
-#include "OWSInventoryItemStack.h"
+#include "OWSInventoryOccupancy.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "OWSInventory.generated.h"
 
 class AOWSCharacter;
+class UOWSInventory;
 
-#define OWS_MAXNUMBEROFITEMSINSTACK 999
+//A filled slot, as replicated to the owning client
+USTRUCT()
+struct FOWSInventorySlotEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		int32 SlotNumber = INDEX_NONE;
+	UPROPERTY()
+		FOWSInventoryItemRecord Item;
+	//Usually empty, so it costs almost nothing to send
+	UPROPERTY()
+		FString PerInstanceCustomData;
+
+	void PreReplicatedRemove(const struct FOWSInventorySlotEntries& InArraySerializer);
+	void PostReplicatedAdd(const struct FOWSInventorySlotEntries& InArraySerializer);
+	void PostReplicatedChange(const struct FOWSInventorySlotEntries& InArraySerializer);
+};
+
+USTRUCT()
+struct FOWSInventorySlotEntries : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		TArray<FOWSInventorySlotEntry> Items;
+
+	//The inventory these entries belong to, for the client side callbacks
+	UOWSInventory* Owner = nullptr;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FOWSInventorySlotEntry, FOWSInventorySlotEntries>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOWSInventorySlotEntries> : public TStructOpsTypeTraitsBase2<FOWSInventorySlotEntries>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
 
 /**
- * 
+ * A grid of slots, each holding one FOWSInventoryItemRecord.  An empty record is an empty slot.
+ * AOWSCharacter replicates its inventories to the owning client as subobjects.  Filled slots are mirrored into ReplicatedSlots on
+ * the server and marked dirty one at a time, so a change only sends the slots it touched and a reconnect only sends filled slots.
  */
 UCLASS(Blueprintable, BlueprintType)
 class OWSPLUGIN_API UOWSInventory : public UObject
@@ -28,22 +75,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 		void SetOwningPlayerCharacter(AOWSCharacter* inOwningPlayerCharacter);
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
-		TArray<UOWSInventoryItemStack*> InventoryItemStacks;
+	virtual bool IsSupportedForNetworking() const override { return true; }
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	//One record per slot
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+		TArray<FOWSInventoryItemRecord> InventoryItemRecords;
+
+	UPROPERTY(Replicated, VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
 		FName InventoryName;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Inventory")
+	UPROPERTY(Replicated, VisibleAnywhere, BlueprintReadWrite, Category = "Inventory")
 		int32 NumberOfGroupsUnlocked;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Inventory")
+	UPROPERTY(Replicated, VisibleAnywhere, BlueprintReadWrite, Category = "Inventory")
 		int32 SlotsPerGroup;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Inventory")
+	UPROPERTY(ReplicatedUsing = OnRep_InventoryLayout, VisibleAnywhere, BlueprintReadWrite, Category = "Inventory")
 		int32 NumberOfSlots;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Inventory")
+	UPROPERTY(ReplicatedUsing = OnRep_InventoryLayout, VisibleAnywhere, BlueprintReadWrite, Category = "Inventory")
 		int32 NumberOfColumns;
 
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
@@ -52,33 +103,51 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 		void SetInventoryName(FName inInventoryName);
 
-	UFUNCTION(BlueprintCallable, Category = "Inventory")
-		void AddStackToSlot(UOWSInventoryItemStack* ItemStack, int32 Slot);
-
+	//Empties Slot
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 		void RemoveStackFromSlot(int32 Slot);
 
+	//Picks up an item lying in the world.  The caller is responsible for destroying the actor.
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 		bool AddItemToInventory(AOWSInventoryItem* Item);
 
-	
-
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
-		void AddItemToSlot(AOWSInventoryItem* Item, int32 Slot);
+		void AddItemToSlot(const FOWSInventoryItemRecord& Item, const FString& InPerInstanceCustomData, int32 Slot);
 
-		void AddItemToSlot_Internal(AOWSInventoryItem* Item, int32 Slot);
+	//Adds Item.Quantity items to Slot without notifying the client.  Fails if Slot holds an item Item can't stack with, the stack would go over its max size, or the custom data differs.
+	bool AddItemToSlot_Internal(const FOWSInventoryItemRecord& Item, const FString& InPerInstanceCustomData, int32 Slot);
 
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 		void AddItemsFromInventoryItemStruct(const TArray<FInventoryItemStruct>& ItemsToAdd);
 
+	//Takes up to Quantity items off the stack in Slot and returns them.  The returned record has no CustomDataHandle; its custom data is returned in OutPerInstanceCustomData.
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+		FOWSInventoryItemRecord RemoveItemsFromSlot(int32 Slot, int32 Quantity, FString& OutPerInstanceCustomData);
+
+	//Removes Quantity items from Slot and spawns them into the world as one ItemClass actor.  Server only.
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
-		AOWSInventoryItem* RemoveOneItemFromSlot(int32 Slot);
+		AOWSInventoryItem* DropItemsFromSlot(int32 Slot, int32 Quantity, const FTransform& SpawnTransform, TSubclassOf<AOWSInventoryItem> ItemClass);
 
+	//Swaps the items in SlotA and SlotB.  Returns false and changes nothing if either item's footprint wouldn't fit at its new slot.
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
-		void SwapSlots(int32 SlotA, int32 SlotB);
+		bool SwapSlots(int32 SlotA, int32 SlotB);
 
+	//Swaps Slot with OtherSlot in OtherInventory, moving per instance custom data along with the items.  Returns false and changes nothing if either item wouldn't fit.
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
-		UOWSInventoryItemStack* GetStackInSlot(int32 Slot);
+		bool SwapSlotWithInventory(int32 Slot, UOWSInventory* OtherInventory, int32 OtherSlot);
+
+	//Moves as much of the stack in SourceSlot onto the stack in DestSlot as fits under its max stack size.  Returns false and changes nothing if they can't stack or DestSlot is full.
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+		bool MergeSlots(int32 SourceSlot, int32 DestSlot);
+
+	//Returns the item in Slot, or nullptr if Slot is empty or out of range
+	const FOWSInventoryItemRecord* FindItemInSlot(int32 Slot) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+		bool GetItemInSlot(int32 Slot, FOWSInventoryItemRecord& OutItem) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+		FString GetPerInstanceCustomData(const FOWSInventoryItemRecord& Item) const;
 
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 		int32 FindFirstEmptySlotToFitItemOfSize(int32 IconSlotWidth, int32 IconSlotHeight);
@@ -89,7 +158,44 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 		bool IsSlotFilled(int32 SlotNumber);
 	
+	//Re-reads the item in Slot into the occupancy grid and, on the server, marks it for replication.  Call this after changing a record in InventoryItemRecords directly.
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+		void RefreshSlot(int32 Slot);
+
+	//Re-resolves the icon of every slot holding ItemName, for when the item definition arrives after the slot
+	void RefreshItemIcons(FName ItemName);
+
+	//Client side fast array callbacks
+	void OnSlotReplicated(const FOWSInventorySlotEntry& Entry);
+	void OnSlotRemoved(const FOWSInventorySlotEntry& Entry);
+
 protected:
+	UFUNCTION()
+		void OnRep_InventoryLayout();
+
+	//Rebuilds the whole occupancy grid from InventoryItemRecords
 	void UpdateSlotsFilled();
-	TArray<bool> SlotsFilled;
+	void UpdateSlotOccupancy(int32 Slot);
+	//Width x Height of the item anchored at Slot, 0 x 0 if the slot is empty
+	FIntPoint GetSlotFootprint(int32 Slot) const;
+	bool DoesFootprintFitAt(int32 Slot, const FIntPoint& Size) const;
+	FOWSInventoryOccupancy SlotsFilled;
+
+	bool IsServerInventory() const;
+	//Adds, updates or removes Slot's entry in ReplicatedSlots.  Server only.
+	void UpdateReplicatedSlot(int32 Slot);
+	void ResolveIconTexture(FOWSInventoryItemRecord& Item);
+
+	UPROPERTY(Replicated)
+		FOWSInventorySlotEntries ReplicatedSlots;
+
+	//Index into ReplicatedSlots.Items by slot.  Server only.
+	TMap<int32, int32> ReplicatedSlotIndices;
+
+	int32 AddPerInstanceCustomData(const FString& InPerInstanceCustomData);
+	//Frees the custom data of the record in Slot and returns it
+	FString ReleasePerInstanceCustomData(int32 Slot);
+
+	//Indexed by FOWSInventoryItemRecord::CustomDataHandle.  Most items have no custom data, so it is kept out of the records.
+	TSparseArray<FString> PerInstanceCustomData;
 };
@@ -180,6 +180,67 @@ public:
 		FString PerInstanceCustomData;
 };
 
+#define OWS_MAXNUMBEROFITEMSINSTACK 999
+
+/**
+ * One stack of items in an inventory slot.  Plain data, so a whole bag is one contiguous array and a stack of 999 arrows is one
+ * record with a Quantity of 999 instead of 999 objects.  Per instance custom data lives in the owning UOWSInventory and is
+ * referenced by CustomDataHandle so records stay small.  AOWSInventoryItem actors are only spawned when an item is dropped into the world.
+ */
+USTRUCT(BlueprintType)
+struct FOWSInventoryItemRecord
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+		FName ItemName;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+		FGuid UniqueItemGUID;
+
+	//0 means the slot is empty
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+		int32 Quantity = 0;
+
+	//0 means OWS_MAXNUMBEROFITEMSINSTACK
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+		int32 MaxStackSize = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+		int32 Condition = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+		int32 NumberOfUsesLeft = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+		int32 ItemMeshID = 0;
+
+	//Index into the owning inventory's per instance custom data, INDEX_NONE if the item has none.  Only meaningful to that inventory.
+	UPROPERTY(NotReplicated, VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+		int32 CustomDataHandle = INDEX_NONE;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+		uint8 IconSlotWidth = 1;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+		uint8 IconSlotHeight = 1;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+		bool bCanStack = false;
+
+	//Resolved locally from the item definition
+	UPROPERTY(NotReplicated, VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+		UTexture2D* IconTexture = nullptr;
+
+	bool IsEmpty() const { return Quantity <= 0; }
+
+	int32 GetMaxStackSize() const { return MaxStackSize > 0 ? MaxStackSize : OWS_MAXNUMBEROFITEMSINSTACK; }
+
+	//Stacks only merge when they are the same stackable item instance
+	bool CanStackWith(const FOWSInventoryItemRecord& Other) const { return bCanStack && ItemName == Other.ItemName && UniqueItemGUID == Other.UniqueItemGUID; }
+};
+
+//An item lying in the world.  Items in an inventory are FOWSInventoryItemRecords, not actors.
 UCLASS()
 class OWSPLUGIN_API AOWSInventoryItem : public AActor
 {
@@ -235,6 +296,10 @@ public:
 	/*UPROPERTY(EditAnywhere, Category = "Inventory")
 		FInventoryItemStruct InventoryItemData;*/
 
+	//StackSize is the number of items in this pickup
+	FOWSInventoryItemRecord MakeInventoryRecord() const;
+	void InitFromInventoryRecord(const FOWSInventoryItemRecord& Record, const FString& InPerInstanceCustomData);
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
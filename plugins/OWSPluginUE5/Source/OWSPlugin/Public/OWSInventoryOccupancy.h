@@ -0,0 +1,50 @@
+// Copyright 2022 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Tracks which cells of an inventory grid are covered by an item.
+ * Each row is stored as a bitmask, so testing whether an item fits is one AND per row (per 64 columns) instead of a per cell scan.
+ * Items are recorded by their anchor (top left) slot and size.  Changing one item only touches the rows it covers.
+ * FindFirstFit results are cached per item size and only dropped when a change touches rows that could affect them.
+ */
+class OWSPLUGIN_API FOWSInventoryOccupancy
+{
+public:
+	void Reset(int32 InNumberOfSlots, int32 InNumberOfColumns);
+
+	//Records an item of Width x Height anchored at Slot, replacing whatever was anchored there.  A size of 0 x 0 clears the slot.
+	void SetItemAt(int32 Slot, int32 Width, int32 Height);
+	void ClearItemAt(int32 Slot) { SetItemAt(Slot, 0, 0); }
+
+	bool IsCellFilled(int32 Slot) const;
+	bool CanFitAt(int32 Slot, int32 Width, int32 Height) const;
+
+	//Returns the first slot an item of Width x Height fits in, or INDEX_NONE if there isn't one
+	int32 FindFirstFit(int32 Width, int32 Height);
+
+	int32 GetNumberOfSlots() const { return NumberOfSlots; }
+	int32 GetNumberOfColumns() const { return NumberOfColumns; }
+	int32 GetNumberOfRows() const { return NumberOfRows; }
+
+private:
+	void AddFootprint(int32 Slot, const FIntPoint& Size, int32 Delta);
+	void InvalidateFirstFitCache(int32 FirstRow, int32 LastRow, bool bCellsFreed);
+	bool IsRunFree(int32 Row, int32 FirstColumn, int32 Width) const;
+
+	int32 NumberOfSlots = 0;
+	int32 NumberOfColumns = 1;
+	int32 NumberOfRows = 0;
+	int32 WordsPerRow = 1;
+
+	//NumberOfRows * WordsPerRow words.  A set bit is a filled cell, or a cell past the end of a short last row.
+	TArray<uint64> RowBits;
+	//How many items cover each cell, so overlapping items don't clear each other's bits
+	TArray<uint16> CellCoverCounts;
+	//Size of the item anchored at each slot, 0 x 0 if none
+	TArray<FIntPoint> AnchoredItemSizes;
+	//Item size -> first slot it fits in
+	TMap<FIntPoint, int32> FirstFitCache;
+};
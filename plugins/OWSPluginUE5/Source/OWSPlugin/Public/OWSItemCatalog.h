@@ -0,0 +1,37 @@
+// Copyright 2022 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OWSInventoryItem.h"
+
+/**
+ * Hashed index over an array of item definitions.
+ * Item names are interned as FNames and resolve to an integer item ID, which is the definition's index in the array.
+ * The catalog doesn't own the array.  Anything that adds to it should go through Add so the index stays current.
+ * If the array is changed some other way (e.g. from Blueprint), the index notices and rebuilds on the next lookup:
+ * a count change, a hit whose definition was renamed, or a miss for a name that is in the array all trigger a rebuild.
+ */
+class OWSPLUGIN_API FOWSItemCatalog
+{
+public:
+	static constexpr int32 InvalidItemID = INDEX_NONE;
+
+	//Returns the item ID for ItemName in Items, or InvalidItemID if there is no such item
+	int32 FindItemID(const TArray<FInventoryItemStruct>& Items, const FName ItemName);
+
+	//Returns the definition for ItemName in Items, or nullptr if there is no such item.  The pointer is valid until Items changes.
+	FInventoryItemStruct* FindItem(TArray<FInventoryItemStruct>& Items, const FName ItemName);
+	const FInventoryItemStruct* FindItem(const TArray<FInventoryItemStruct>& Items, const FName ItemName);
+
+	bool Contains(const TArray<FInventoryItemStruct>& Items, const FName ItemName) { return FindItemID(Items, ItemName) != InvalidItemID; }
+
+	//Appends Item to Items and indexes it.  Returns the new item ID.
+	int32 Add(TArray<FInventoryItemStruct>& Items, const FInventoryItemStruct& Item);
+
+	void Rebuild(const TArray<FInventoryItemStruct>& Items);
+
+private:
+	TMap<FName, int32> ItemIDsByName;
+	int32 IndexedItemCount = 0;
+};
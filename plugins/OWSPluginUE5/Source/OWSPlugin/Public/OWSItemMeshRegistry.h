@@ -0,0 +1,83 @@
+// Copyright 2022 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "OWSItemMeshRegistry.generated.h"
+
+class AOWSItemMeshRegistry;
+
+//One ItemName to ItemMeshID mapping
+USTRUCT()
+struct FOWSItemMeshEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		FString ItemName;
+	UPROPERTY()
+		int32 ItemMeshID = 0;
+
+	void PostReplicatedAdd(const struct FOWSItemMeshEntries& InArraySerializer);
+	void PostReplicatedChange(const struct FOWSItemMeshEntries& InArraySerializer);
+};
+
+USTRUCT()
+struct FOWSItemMeshEntries : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+		TArray<FOWSItemMeshEntry> Items;
+
+	//The registry this table belongs to, for PostReplicatedAdd on clients
+	AOWSItemMeshRegistry* Owner = nullptr;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FOWSItemMeshEntry, FOWSItemMeshEntries>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FOWSItemMeshEntries> : public TStructOpsTypeTraitsBase2<FOWSItemMeshEntries>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/**
+ * The zone's ItemName to ItemMeshID table.  One always relevant actor, spawned by AOWSGameMode, replicates the table to every
+ * client as fast array deltas.  Late joiners get the whole table in their initial bunch instead of one reliable RPC per item.
+ * On clients, every entry is copied into UOWSGameInstance::LocalMeshItemsMap as it arrives.
+ */
+UCLASS(NotPlaceable)
+class OWSPLUGIN_API AOWSItemMeshRegistry : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AOWSItemMeshRegistry();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	//Adds or updates an entry.  Server only.
+	void AddItemMesh(const FString& ItemName, int32 ItemMeshID);
+
+	//Returns INDEX_NONE if ItemName has no mesh yet
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+		int32 FindItemMeshID(const FString& ItemName) const;
+
+	void OnItemMeshReplicated(const FOWSItemMeshEntry& Entry);
+
+protected:
+	UPROPERTY(Replicated)
+		FOWSItemMeshEntries ItemMeshes;
+
+	//Index into ItemMeshes.Items by ItemName
+	TMap<FString, int32> ItemMeshIndices;
+};
@@ -0,0 +1,67 @@
+// Copyright 2022 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+#include "Interfaces/IHttpResponse.h"
+
+/**
+ * Decodes OWS API responses straight from the UTF-8 response body into USTRUCTs.
+ * The JSON is read in a single forward pass and written directly into the target properties, so there is no
+ * GetContentAsString copy and no FJsonObject DOM in between.  Property lookups are cached per struct type.
+ * JSON field names are matched to property names case-insensitively, the same as FJsonObjectConverter.
+ * Unknown fields and nulls are skipped, leaving the property at its default.
+ */
+class OWSPLUGIN_API FOWSJsonStructReader
+{
+public:
+	//Reads a JSON object into OutStruct, which must be an instance of StructDefinition.  Returns false if the JSON is malformed.
+	static bool ReadStruct(TConstArrayView<uint8> Utf8Json, const UStruct* StructDefinition, void* OutStruct);
+
+	//Reads a JSON array of objects.  AddElement is called once per element and must return a default constructed StructDefinition to fill in.
+	static bool ReadStructArray(TConstArrayView<uint8> Utf8Json, const UStruct* StructDefinition, TFunctionRef<void* ()> AddElement);
+
+	//Splits a JSON array into the raw JSON text of each element without decoding the elements
+	static bool ReadArrayElements(TConstArrayView<uint8> Utf8Json, TArray<FString>& OutElements);
+
+	template <typename T>
+	static bool ReadStruct(TConstArrayView<uint8> Utf8Json, T& OutStruct)
+	{
+		return ReadStruct(Utf8Json, T::StaticStruct(), &OutStruct);
+	}
+
+	template <typename T>
+	static bool ReadStructArray(TConstArrayView<uint8> Utf8Json, TArray<T>& OutArray)
+	{
+		OutArray.Reset();
+		if (!ReadStructArray(Utf8Json, T::StaticStruct(), [&OutArray]() -> void* { return &OutArray.AddDefaulted_GetRef(); }))
+		{
+			OutArray.Reset();
+			return false;
+		}
+		return true;
+	}
+
+	//Reads a response containing a single JSON object.  On failure, logs, sets ErrorMsg and returns nullptr.
+	template <typename T>
+	static TSharedPtr<T> ReadResponse(FHttpResponsePtr Response, bool bWasSuccessful, const FString& CallingMethodName, FString& ErrorMsg)
+	{
+		TSharedPtr<T> Result = MakeShared<T>();
+		if (!ReadResponseContent(Response, bWasSuccessful, CallingMethodName, ErrorMsg, [&Result](TConstArrayView<uint8> Content) { return ReadStruct(Content, *Result); }))
+		{
+			return nullptr;
+		}
+		return Result;
+	}
+
+	//Reads a response containing a JSON array of objects.  On failure, logs, sets ErrorMsg and returns false.
+	template <typename T>
+	static bool ReadResponseArray(FHttpResponsePtr Response, bool bWasSuccessful, const FString& CallingMethodName, FString& ErrorMsg, TArray<T>& OutArray)
+	{
+		return ReadResponseContent(Response, bWasSuccessful, CallingMethodName, ErrorMsg, [&OutArray](TConstArrayView<uint8> Content) { return ReadStructArray(Content, OutArray); });
+	}
+
+private:
+	static bool ReadResponseContent(FHttpResponsePtr Response, bool bWasSuccessful, const FString& CallingMethodName, FString& ErrorMsg, TFunctionRef<bool(TConstArrayView<uint8>)> ReadContent);
+};
@@ -0,0 +1,117 @@
+// Copyright 2022 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OWSPlugin.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/Function.h"
+#include "Engine/HitResult.h"
+#include "OWSLagCompensationSubsystem.generated.h"
+
+//Where one pawn was at the end of one server frame.  The capsule is the pawn's simple collision cylinder.
+struct FOWSLagCompensationSample
+{
+	FVector Location = FVector::ZeroVector;
+	FQuat4f Rotation = FQuat4f::Identity;
+	float CapsuleRadius = 0.f;
+	float CapsuleHalfHeight = 0.f;
+};
+
+//A tracked pawn and the first frame it has history for
+struct FOWSLagCompensatedPawn
+{
+	TWeakObjectPtr<APawn> Pawn;
+	int64 FirstRecordedFrame = 0;
+};
+
+//A hit against a rewound pawn capsule
+struct OWSPLUGIN_API FOWSLagCompensationHit
+{
+	APawn* Pawn = nullptr;
+	//Distance along the trace to the hit
+	double Distance = 0.0;
+	//Center of the sweep shape at the time of the hit
+	FVector Location = FVector::ZeroVector;
+	//Point on the rewound capsule that was hit
+	FVector ImpactPoint = FVector::ZeroVector;
+	FVector ImpactNormal = FVector::ZeroVector;
+	//Where the pawn was at the rewind time
+	FVector RewoundPawnLocation = FVector::ZeroVector;
+
+	FHitResult ToHitResult(const FVector& TraceStart, const FVector& TraceEnd) const;
+};
+
+/**
+ * Server-side history of where every pawn was over the last OWSLagCompensationHistoryFrames server frames.
+ * Samples live in one flat array, one fixed-size ring per pawn, all sharing the same frame timestamps.
+ * Hits can be tested against where pawns were when a remote player fired, without moving anything or querying the physics scene.
+ */
+UCLASS()
+class OWSPLUGIN_API UOWSLagCompensationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterPawn(APawn* Pawn);
+	void UnregisterPawn(APawn* Pawn);
+	bool IsTrackingPawn(const APawn* Pawn) const;
+
+	double GetServerTime() const;
+
+	//How far back a hitscan from this shooter should be tested: their round trip time, capped at MaxRewindSeconds.  Zero for local shooters.
+	float GetRewindSeconds(const AController* Shooter) const;
+
+	float GetMaxRewindSeconds() const { return MaxRewindSeconds; }
+
+	//Where Pawn was at ServerTime, interpolated between recorded frames and clamped to the history that exists
+	bool GetRewoundSample(const APawn* Pawn, double ServerTime, FOWSLagCompensationSample& OutSample) const;
+
+	UFUNCTION(BlueprintCallable, Category = "Lag Compensation")
+		bool GetRewoundPawnLocation(APawn* Pawn, float RewindSeconds, FVector& OutLocation, FRotator& OutRotation) const;
+
+	/**
+	 * Finds the closest tracked pawn whose capsule at ServerTime is touched by a sphere of SweepRadius moving from Start to End.
+	 * Use a SweepRadius of zero for a line trace.  ShouldConsiderPawn can reject pawns, e.g. the shooter.
+	 */
+	bool SweepRewoundPawns(const FVector& Start, const FVector& End, float SweepRadius, double ServerTime, TFunctionRef<bool(APawn*)> ShouldConsiderPawn, FOWSLagCompensationHit& OutHit) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	//Recorded frames that bracket ServerTime, and how far between them it falls
+	struct FRewindFrames
+	{
+		int64 OlderFrame = 0;
+		int64 NewerFrame = 0;
+		float Alpha = 0.f;
+	};
+
+	bool FindRewindFrames(double ServerTime, FRewindFrames& OutFrames) const;
+	void SampleSlot(int32 Slot, const FRewindFrames& Frames, FOWSLagCompensationSample& OutSample) const;
+	void RecordSample(int32 Slot, int32 RingIndex);
+
+	void OnActorSpawned(AActor* Actor);
+
+	//Number of frames kept per pawn
+	int32 HistoryFrames;
+	float MaxRewindSeconds;
+
+	//Total frames recorded so far.  Frame N is stored at ring index N % HistoryFrames.
+	int64 RecordedFrames;
+	TArray<double> FrameTimes;
+
+	//Slot * HistoryFrames + ring index
+	TArray<FOWSLagCompensationSample> Samples;
+	TArray<FOWSLagCompensatedPawn> Slots;
+	TArray<int32> FreeSlots;
+	TMap<TWeakObjectPtr<const APawn>, int32> SlotsByPawn;
+
+	FDelegateHandle ActorSpawnedHandle;
+};
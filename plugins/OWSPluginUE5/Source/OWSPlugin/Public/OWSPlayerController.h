@@ -8,6 +8,8 @@
 //#include "OWSCharacterWithAbilities.h"
 #include "OWSPlayerState.h"
 #include "OWSPlayerControllerComponent.h"
+#include "OWSChatManager.h"
+#include "OWSReplicationGraph.h"
 #include "OWSPlayerController.generated.h"
 
 class AOWSCharacterWithAbilities;
@@ -54,27 +56,36 @@ public:
 		float ServerTravelRY;
 		float ServerTravelRZ;
 
-	UPROPERTY()
-		TMap<FString, int32> LocalMeshItemsMap;
-
+	//Item meshes reach clients through AOWSItemMeshRegistry, which late joiners get in their initial bunch.  Kept for existing Blueprints.
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 		void SynchUpLocalMeshItemsMap();
 
+	//Adds the mapping to the zone's AOWSItemMeshRegistry, which replicates it to every player
 	UFUNCTION()
 		void AddItemToLocalMeshItemsMap(const FString& ItemName, const int32 ItemMeshID);
 
-	UFUNCTION(Client, Reliable)
-		void Client_AddItemToLocalMeshItemsMap(const FString& ItemName, const int32 ItemMeshID);
-
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Selection")
 		AOWSCharacter* SelectedCharacter;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Groups")
 		TArray<FPlayerGroup> PlayerGroupsPlayerIsIn;
 
+	//PlayerGroupTypeID of the last GetPlayerGroupsCharacterIsIn, to tell whether its result covers parties
+	int32 PlayerGroupTypeIDRequested = 0;
+
+	//Chat messages this player can still send right now, as of LastChatMessageAllowanceTime
+	float ChatMessageAllowance = 0.f;
+	double LastChatMessageAllowanceTime = 0.0;
+
+	bool TakeChatMessageAllowance();
+
 	UFUNCTION(BlueprintCallable, Category = "Player State")
 		AOWSPlayerState* GetOWSPlayerState() const;
 
+	//Null when the net driver isn't using UOWSReplicationGraph
+	UFUNCTION(BlueprintCallable, Category = "Replication")
+		UOWSReplicationGraph* GetReplicationGraph() const;
+
 	UFUNCTION(BlueprintCallable, Category = "Travel")
 		void TravelToMap(const FString& URL, const bool SeamlessTravel);
 
@@ -179,6 +190,25 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category = "Chat")
 		void ErrorGetChatGroupsForPlayer(const FString &ErrorMsg);
 
+	//Chat messages go through the server so the sender name always comes from this player's PlayerState
+	UFUNCTION(Server, Reliable, WithValidation)
+		void Server_SendChatMessage(const FString& Message, const FString& SendToCharacterName, const FString& ChatGroupName);
+
+	//Longer messages or names fail Server_SendChatMessage validation.  AOWSChatManager never sends them from a normal client.
+	static constexpr int32 MaxChatMessageLength = 512;
+	static constexpr int32 MaxChatNameLength = 64;
+
+	//Server_SendChatMessage rate limit.  Each player can send ChatMessageBurst messages at once, refilled at ChatMessagesPerSecond.
+	UPROPERTY(BlueprintReadWrite, Category = "Config")
+		float ChatMessagesPerSecond = 2.f;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Config")
+		float ChatMessageBurst = 5.f;
+
+	//Private and group chat pushed from the AOWSChatManager on the server, batched per flush
+	UFUNCTION(Client, Reliable)
+		void Client_ReceiveChatMessages(const TArray<FChatMessage>& ChatMessages);
+
 	//Is Player Online?
 	UFUNCTION(BlueprintCallable, Category = "Chat")
 		void IsPlayerOnline(FString PlayerName);
@@ -251,6 +281,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Player Groups")
 		void GetPlayerGroupsCharacterIsIn(FString UserSessionGUID, FString CharacterName, int32 PlayerGroupTypeID);
 
+	//Keeps this player's party in the replication graph in step with the groups the API returned, then calls NotifyGetPlayerGroupsCharacterIsIn
+	void OnGetPlayerGroupsCharacterIsIn(const TArray<FPlayerGroup>& PlayerGroups);
+
 	UFUNCTION(BlueprintImplementableEvent, Category = "Player Groups")
 		void NotifyGetPlayerGroupsCharacterIsIn(const TArray<FPlayerGroup> &PlayerGroups);
 	UFUNCTION(BlueprintImplementableEvent, Category = "Player Groups")
@@ -27,10 +27,18 @@ DECLARE_DELEGATE_OneParam(FErrorGetCharacterStatsDelegate, const FString&)
 DECLARE_DELEGATE_OneParam(FNotifyGetCharacterDataAndCustomDataDelegate, TSharedPtr<FJsonObject>)
 DECLARE_DELEGATE_OneParam(FErrorGetCharacterDataAndCustomDataDelegate, const FString&)
 
+//Get Character Bootstrap
+DECLARE_DELEGATE(FNotifyGetCharacterBootstrapDelegate)
+DECLARE_DELEGATE_OneParam(FErrorGetCharacterBootstrapDelegate, const FString&)
+
 //Update Character Stats
 DECLARE_DELEGATE(FNotifyUpdateCharacterStatsDelegate)
 DECLARE_DELEGATE_OneParam(FErrorUpdateCharacterStatsDelegate, const FString&)
 
+//Update Character Stats Delta
+DECLARE_DELEGATE(FNotifyUpdateCharacterStatsDeltaDelegate)
+DECLARE_DELEGATE_OneParam(FErrorUpdateCharacterStatsDeltaDelegate, const FString&)
+
 //Get Custom Character Data
 DECLARE_DELEGATE_OneParam(FNotifyGetCustomCharacterDataDelegate, TSharedPtr<FJsonObject>)
 DECLARE_DELEGATE_OneParam(FErrorGetCustomCharacterDataDelegate, const FString&)
@@ -165,6 +173,17 @@ public:
 	FNotifyGetCharacterStatsDelegate OnNotifyGetCharacterStatsDelegate;
 	FErrorGetCharacterStatsDelegate OnErrorGetCharacterStatsDelegate;
 
+	//Get Character Bootstrap.  Gets stats, custom data, abilities and ability bars in one request, then calls OnNotifyGetCharacterStatsDelegate,
+	//OnNotifyGetCustomCharacterDataDelegate, OnNotifyGetCharacterAbilitiesDelegate and OnNotifyGetAbilityBarsDelegate in that order.
+	UFUNCTION(BlueprintCallable, Category = "Character")
+		void GetCharacterBootstrap(FString CharName);
+
+	void OnGetCharacterBootstrapResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	//Called after the individual delegates
+	FNotifyGetCharacterBootstrapDelegate OnNotifyGetCharacterBootstrapDelegate;
+	FErrorGetCharacterBootstrapDelegate OnErrorGetCharacterBootstrapDelegate;
+
 	//Get Character Data and Custom Data
 	UFUNCTION(BlueprintCallable, Category = "Character")
 		void GetCharacterDataAndCustomData(FString UserSessionGUID, FString CharName);
@@ -183,6 +202,14 @@ public:
 	FNotifyUpdateCharacterStatsDelegate OnNotifyUpdateCharacterStatsDelegate;
 	FErrorUpdateCharacterStatsDelegate OnErrorUpdateCharacterStatsDelegate;
 
+	//Update only the stats that changed.  JSONString is an FUpdateCharacterStatsDeltaJSONPost.
+	void UpdateCharacterStatsDelta(FString JSONString);
+
+	void OnUpdateCharacterStatsDeltaResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+
+	FNotifyUpdateCharacterStatsDeltaDelegate OnNotifyUpdateCharacterStatsDeltaDelegate;
+	FErrorUpdateCharacterStatsDeltaDelegate OnErrorUpdateCharacterStatsDeltaDelegate;
+
 	//Get Custom Character Data
 	UFUNCTION(BlueprintCallable, Category = "Character")
 		void GetCustomCharacterData(FString CharName);
@@ -196,7 +223,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Character")
 		void AddOrUpdateCustomCharacterData(FString CharName, FString CustomFieldName, FString CustomValue);
 
-	void OnAddOrUpdateCustomCharacterDataResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+	void OnAddOrUpdateCustomCharacterDataResponseReceived(bool bWasSuccessful, const FString& ResponseContent);
 
 	FNotifyAddOrUpdateCustomCharacterDataDelegate OnNotifyAddOrUpdateCustomCharacterDataDelegate;
 	FErrorAddOrUpdateCustomCharacterDataDelegate OnErrorAddOrUpdateCustomCharacterDataDelegate;
@@ -220,7 +247,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Character")
 		void AddAbilityToCharacter(FString CharName, FString AbilityName, int32 AbilityLevel, FString CustomJSON);
 
-	void OnAddAbilityToCharacterResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+	void OnAddAbilityToCharacterResponseReceived(bool bWasSuccessful, const FString& ResponseContent);
 
 	FNotifyAddAbilityToCharacterDelegate OnNotifyAddAbilityToCharacterDelegate;
 	FErrorAddAbilityToCharacterDelegate OnErrorAddAbilityToCharacterDelegate;	
@@ -247,7 +274,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Character")
 		void UpdateAbilityOnCharacter(FString CharName, FString AbilityName, int32 AbilityLevel, FString CustomJSON);
 
-	void OnUpdateAbilityOnCharacterResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+	void OnUpdateAbilityOnCharacterResponseReceived(bool bWasSuccessful, const FString& ResponseContent);
 
 	FNotifyUpdateAbilityOnCharacterDelegate OnNotifyUpdateAbilityOnCharacterDelegate;
 	FErrorUpdateAbilityOnCharacterDelegate OnErrorUpdateAbilityOnCharacterDelegate;
@@ -256,7 +283,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Character")
 		void RemoveAbilityFromCharacter(FString CharName, FString AbilityName);
 
-	void OnRemoveAbilityFromCharacterResponseReceived(FHttpRequestPtr Request, FHttpResponsePtr Response, bool bWasSuccessful);
+	void OnRemoveAbilityFromCharacterResponseReceived(bool bWasSuccessful, const FString& ResponseContent);
 
 	FNotifyRemoveAbilityFromCharacterDelegate OnNotifyRemoveAbilityFromCharacterDelegate;
 	FErrorRemoveAbilityFromCharacterDelegate OnErrorRemoveAbilityFromCharacterDelegate;
@@ -0,0 +1,64 @@
+// Copyright 2022 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OWSPlugin.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OWSProjectilePoolSubsystem.generated.h"
+
+class AOWSAdvancedProjectile;
+
+//Idle projectiles of one class
+USTRUCT()
+struct FOWSProjectilePoolList
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AOWSAdvancedProjectile>> Projectiles;
+};
+
+/**
+ * Keeps spent AOWSAdvancedProjectiles around, hidden with collision and movement off, and hands them back out instead of spawning a new actor for every shot.
+ * Predicting clients pool their fake projectiles.  Servers can only reuse projectile classes that are not bNetTemporary: a net temporary actor is sent to each
+ * connection once, so a reused one would never show up on clients again.  Those classes, and classes with bUseProjectilePool off, are spawned and destroyed as before.
+ */
+UCLASS()
+class OWSPLUGIN_API UOWSProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	//Spawns idle projectiles up front, e.g. when a weapon is equipped, so the first volley doesn't pay for them
+	UFUNCTION(BlueprintCallable, Category = "Projectiles")
+	void WarmUp(TSubclassOf<AOWSAdvancedProjectile> ProjectileClass, int32 Count);
+
+	//An idle projectile moved to SpawnTransform and reactivated, or a newly spawned one when the pool is empty or can't be used.  Nullptr if the spawn failed.
+	AOWSAdvancedProjectile* AcquireProjectile(TSubclassOf<AOWSAdvancedProjectile> ProjectileClass, const FTransform& SpawnTransform, APawn* Instigator, bool bFakeClientProjectile);
+
+	//Shuts Projectile down and keeps it for the next AcquireProjectile, or destroys it once its class already has MaxIdleProjectilesPerClass idle
+	void ReleaseProjectile(AOWSAdvancedProjectile* Projectile);
+
+	bool CanPool(TSubclassOf<AOWSAdvancedProjectile> ProjectileClass, bool bFakeClientProjectile) const;
+
+	int32 GetNumIdle(TSubclassOf<AOWSAdvancedProjectile> ProjectileClass) const;
+
+	int32 GetNumSpawned() const { return NumSpawned; }
+	int32 GetNumReused() const { return NumReused; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	AOWSAdvancedProjectile* SpawnProjectile(UClass* ProjectileClass, const FTransform& SpawnTransform, APawn* Instigator, bool bPooled);
+
+	int32 MaxIdleProjectilesPerClass;
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FOWSProjectilePoolList> IdleProjectiles;
+
+	int32 NumSpawned;
+	int32 NumReused;
+};
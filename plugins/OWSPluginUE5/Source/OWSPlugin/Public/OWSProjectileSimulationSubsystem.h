@@ -0,0 +1,70 @@
+// Copyright 2022 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OWSPlugin.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "OWSProjectileSimulationSubsystem.generated.h"
+
+class AOWSAdvancedProjectile;
+
+//Where one projectile ends up this frame and what it touched on the way
+struct FOWSProjectileMoveResult
+{
+	FVector Location;
+	FQuat Rotation;
+	FVector Velocity;
+	bool bBlockingHit;
+	FHitResult BlockingHit;
+	TArray<FHitResult, TInlineAllocator<2>> CollisionTouches;
+	TArray<FHitResult, TInlineAllocator<2>> PawnTouches;
+};
+
+/**
+ * Server-side batched movement for AOWSAdvancedProjectiles with bUseBatchedSimulation, in place of each projectile ticking its own UProjectileMovementComponent.
+ * Every frame the locations, velocities and accelerations of all simulated projectiles are gathered into flat arrays, integrated and swept against the world
+ * in one ParallelFor, then applied on the game thread.  Actor callbacks (OnOverlapBegin, ProcessHit, Explode) only run for projectiles that touched something.
+ * Only plain UProjectileMovementComponents without bouncing, interpolation or physics are simulated here; homing and gravity are supported.
+ */
+UCLASS()
+class OWSPLUGIN_API UOWSProjectileSimulationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	static bool CanSimulate(const AOWSAdvancedProjectile* Projectile);
+
+	//Takes over Projectile's movement.  False if it can't be simulated here, in which case its movement component keeps ticking.
+	bool RegisterProjectile(AOWSAdvancedProjectile* Projectile);
+
+	//Hands movement back to the projectile's movement component.  Safe to call from inside hit callbacks during Tick.
+	void UnregisterProjectile(AOWSAdvancedProjectile* Projectile);
+
+	int32 GetNumSimulated() const { return NumSimulated; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	//Drops the slots of projectiles unregistered or destroyed since the last frame
+	void CompactProjectiles();
+	void RestoreProjectile(AOWSAdvancedProjectile* Projectile, uint8 OverlapFlags);
+	void SimulateProjectile(int32 Index, float DeltaTime);
+	void ApplyMove(int32 Index);
+
+	//Slots of unregistered projectiles are null until the next compaction
+	TArray<TWeakObjectPtr<AOWSAdvancedProjectile>> Projectiles;
+	//bGenerateOverlapEvents of the collision and pawn overlap spheres before registering, restored on unregister
+	TArray<uint8> SavedOverlapFlags;
+	int32 NumSimulated = 0;
+
+	//Gathered every frame
+	TArray<FVector> Locations;
+	TArray<FVector> Velocities;
+	TArray<FVector> Accelerations;
+	TArray<FOWSProjectileMoveResult> Results;
+};
@@ -0,0 +1,322 @@
+// Copyright 2018 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "UObject/ObjectKey.h"
+#include "OWSPlayerState.h"
+#include "OWSReplicationGraph.generated.h"
+
+class UOWSReplicationGraphNode_PlayerStateFrequencyLimiter;
+class UOWSReplicationGraphNode_DistantCharacters;
+class UOWSReplicationGraphNode_AlwaysRelevantToParty;
+
+/** Which graph node an actor class is routed to */
+UENUM()
+enum class EOWSClassRepNodeMapping : uint8
+{
+	NotRouted,					// Not replicated through the graph
+	RelevantAllConnections,		// Always relevant to every connection
+	RelevantToOwner,			// Only relevant to the owning connection
+	Spatialize_Static,			// Spatialized, and never moves
+	Spatialize_Dynamic,			// Spatialized, and moves every frame
+	Spatialize_Dormancy,		// Spatialized, treated as static while dormant and dynamic while awake
+};
+
+/** Replication settings for an actor class and its subclasses.  Negative values keep the value derived from the class defaults. */
+USTRUCT()
+struct FOWSClassReplicationRule
+{
+	GENERATED_BODY()
+
+	FOWSClassReplicationRule() { }
+	FOWSClassReplicationRule(TSoftClassPtr<AActor> InActorClass, EOWSClassRepNodeMapping InNodeMapping, float InCullDistance, int32 InReplicationPeriodFrame, float InStarvationPriorityScale)
+		: ActorClass(InActorClass), NodeMapping(InNodeMapping), CullDistance(InCullDistance), ReplicationPeriodFrame(InReplicationPeriodFrame), StarvationPriorityScale(InStarvationPriorityScale) { }
+
+	UPROPERTY(config)
+		TSoftClassPtr<AActor> ActorClass;
+
+	UPROPERTY(config)
+		EOWSClassRepNodeMapping NodeMapping = EOWSClassRepNodeMapping::Spatialize_Dormancy;
+
+	/** Zero replicates at any distance */
+	UPROPERTY(config)
+		float CullDistance = -1.f;
+
+	/** Replicate every N server frames */
+	UPROPERTY(config)
+		int32 ReplicationPeriodFrame = -1;
+
+	/** How much priority grows for each frame the actor was skipped */
+	UPROPERTY(config)
+		float StarvationPriorityScale = -1.f;
+};
+
+/** The playable area of a zone, used to size the spatialization grid.  Matched against the zone name first, then the map name. */
+USTRUCT()
+struct FOWSZoneSpatialSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(config)
+		FString ZoneName;
+
+	UPROPERTY(config)
+		FVector2D BoundsMin = FVector2D::ZeroVector;
+
+	UPROPERTY(config)
+		FVector2D BoundsMax = FVector2D::ZeroVector;
+
+	/** Zero or less derives the cell size from the bounds */
+	UPROPERTY(config)
+		float CellSize = 0.f;
+};
+
+/**
+ * Set ReplicationDriverClassName="/Script/OWSPlugin.OWSReplicationGraph" under [/Script/OnlineSubsystemUtils.IpNetDriver] in DefaultEngine.ini to use this graph.
+ * The grid starts at DefaultGridCellSize and is resized to the zone's bounds once AOWSGameMode knows which zone it is running.
+ */
+UCLASS(transient, config = Engine)
+class OWSPLUGIN_API UOWSReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+
+	UOWSReplicationGraph();
+
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual void RemoveClientConnection(UNetConnection* NetConnection) override;
+
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+	UOWSReplicationGraphNode_AlwaysRelevantToParty* GetNodeForParty(int32 PartyID);
+
+	/** Adds PS to the party in its AlwaysRelevantPartyID, leaving any other party it is in */
+	UFUNCTION(BlueprintCallable)
+	void AddPlayerToParty(AOWSPlayerState* PS);
+
+	/** Sets AlwaysRelevantPartyID back to 0.  The party node goes back to the pool once its last member leaves. */
+	UFUNCTION(BlueprintCallable)
+	void RemovePlayerFromParty(AOWSPlayerState* PS);
+
+	UFUNCTION(BlueprintCallable)
+	void DisbandParty(int32 PartyID);
+
+	/** Sizes the grid to the zone's entry in ZoneSpatialSettings, or to the bounds of the persistent level when there is none */
+	void ApplyZoneSpatialSettings(const FString& ZoneName, const FString& MapName);
+
+	UPROPERTY()
+		UReplicationGraphNode_GridSpatialization2D* GridNode;
+
+	UPROPERTY()
+		UReplicationGraphNode_ActorList* AlwaysRelevantNode;
+
+	UPROPERTY()
+		UOWSReplicationGraphNode_PlayerStateFrequencyLimiter* PlayerStateNode;
+
+	UPROPERTY()
+		UOWSReplicationGraphNode_DistantCharacters* DistantCharacterNode;
+
+	UPROPERTY()
+		TMap<UNetConnection*, UReplicationGraphNode_AlwaysRelevant_ForConnection*> AlwaysRelevantForConnectionMap;
+
+	/** Actors that are only supposed to replicate to their owning connection, but that did not have a connection on spawn */
+	UPROPERTY()
+		TArray<AActor*> ActorsWithoutNetConnection;
+
+	UPROPERTY()
+		TMap<int32, UOWSReplicationGraphNode_AlwaysRelevantToParty*> PartyMap;
+
+	/** Empty party nodes, reused by GetNodeForParty */
+	UPROPERTY()
+		TArray<UOWSReplicationGraphNode_AlwaysRelevantToParty*> PartyNodePool;
+
+	/** Per-class replication settings, most derived class wins.  Set in DefaultEngine.ini under [/Script/OWSPlugin.OWSReplicationGraph] to replace the defaults. */
+	UPROPERTY(config)
+		TArray<FOWSClassReplicationRule> ClassReplicationRules;
+
+	/** Per-zone grid bounds, set in DefaultEngine.ini under [/Script/OWSPlugin.OWSReplicationGraph] */
+	UPROPERTY(config)
+		TArray<FOWSZoneSpatialSettings> ZoneSpatialSettings;
+
+	/** Used until the zone is known */
+	UPROPERTY(config)
+		float DefaultGridCellSize = 10000.f;
+
+	/** Cell sizes derived from a zone's bounds aim for this many cells along its longest side, clamped to MinGridCellSize..MaxGridCellSize */
+	UPROPERTY(config)
+		int32 TargetGridCellsPerAxis = 32;
+
+	UPROPERTY(config)
+		float MinGridCellSize = 5000.f;
+
+	UPROPERTY(config)
+		float MaxGridCellSize = 25000.f;
+
+	/** Characters routed Spatialize_Dynamic that are past their class cull distance but within this distance replicate through DistantCharacterNode.  Zero turns it off. */
+	UPROPERTY(config)
+		float DistantCharacterCullDistance = 40000.f;
+
+	/** Each connection gets distant characters every N server frames */
+	UPROPERTY(config)
+		int32 DistantCharacterReplicationPeriodFrames = 8;
+
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* GetAlwaysRelevantNodeForConnection(UNetConnection* Connection);
+
+protected:
+
+	EOWSClassRepNodeMapping GetMappingPolicy(UClass* Class);
+
+	void SetGridSpatialBounds(const FBox2D& Bounds, float CellSize);
+
+	void ReleasePartyNode(UOWSReplicationGraphNode_AlwaysRelevantToParty* PartyNode);
+	void RemovePartyMember(UOWSReplicationGraphNode_AlwaysRelevantToParty* PartyNode, int32 MemberIndex);
+	void RestoreCullDistance(UNetConnection* NetConnection, AActor* Actor);
+	static UNetReplicationGraphConnection* GetConnectionManager(UNetConnection* NetConnection);
+
+	/** The party node each member is in, and the member on each connection, kept by AddPlayerToParty and RemovePlayerFromParty */
+	TMap<AOWSPlayerState*, UOWSReplicationGraphNode_AlwaysRelevantToParty*> PlayerPartyNodes;
+	TMap<UNetConnection*, AOWSPlayerState*> PartyMembersByConnection;
+
+	/** Resolved from ClassReplicationRules and class defaults in InitGlobalActorClassSettings */
+	TClassMap<EOWSClassRepNodeMapping> ClassRepNodePolicies;
+};
+
+
+/**
+ * This is a specialized node for handling PlayerState replication in a frequency limited fashion. It tracks all player states but only returns a subset of them to the replication driver each frame.
+ * Player states are kept in a persistent compact list maintained by add/remove notifications, so nothing is rebuilt on frames where no player joined, left or changed party.
+ * Each connection also gets its own party members every frame and nearby players every NearbyReplicationPeriodFrames, ahead of the rolling buckets.
+ */
+UCLASS()
+class UOWSReplicationGraphNode_PlayerStateFrequencyLimiter : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+
+	UOWSReplicationGraphNode_PlayerStateFrequencyLimiter();
+
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+
+	/** Call when a player state's AlwaysRelevantPartyID changes */
+	void NotifyPartyChanged(APlayerState* PlayerState);
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	virtual void PrepareForReplication() override;
+
+	virtual void LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const override;
+
+	/** How many actors we want to return to the replication driver per frame. Will not suppress ForceNetUpdate. */
+	int32 TargetActorsPerFrame = 2;
+
+	/** Player states whose pawns share a cell of this size with the viewer are replicated ahead of the rolling buckets */
+	float NearbyCellSize = 5000.f;
+
+	/** How often nearby player states are returned, and how often pawn positions are re-bucketed into cells */
+	int32 NearbyReplicationPeriodFrames = 4;
+
+private:
+
+	void RebuildBuckets();
+	void RebuildPartyLists();
+	void RebuildNearbyCells();
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** Every tracked player state, compact.  Removal swaps the last entry into the hole. */
+	TArray<APlayerState*> PlayerStates;
+	TMap<APlayerState*, int32> PlayerStateIndices;
+
+	bool bBucketsDirty = false;
+	bool bPartyListsDirty = false;
+	uint32 PreparedFrames = 0;
+
+	TArray<FActorRepListRefView> ReplicationActorLists;
+	FActorRepListRefView ForceNetUpdateReplicationActorList;
+
+	TMap<int32, FActorRepListRefView> PartyLists;
+	TMap<FIntPoint, FActorRepListRefView> NearbyCells;
+};
+
+
+/**
+ * Replicates characters that are past their class cull distance, so the grid does not have to spread them over every cell they can be seen from.
+ * Characters are bucketed into coarse cells of CellSize every ReplicationPeriodFrames, and each connection gets the 3x3 cells around its viewer
+ * once every ReplicationPeriodFrames, staggered across connections.  The cost per connection follows how many characters are around it, not the zone population.
+ */
+UCLASS()
+class UOWSReplicationGraphNode_DistantCharacters : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+
+	UOWSReplicationGraphNode_DistantCharacters();
+
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& Actor) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	virtual void PrepareForReplication() override;
+
+	virtual void LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const override;
+
+	/** Also the cull distance of the characters this node returns */
+	float CellSize = 40000.f;
+
+	int32 ReplicationPeriodFrames = 8;
+
+private:
+
+	void RebuildCells();
+	FIntPoint GetCell(const FVector& Location) const;
+
+	/** Every tracked character, compact.  Removal swaps the last entry into the hole. */
+	TArray<AActor*> Characters;
+	TMap<AActor*, int32> CharacterIndices;
+
+	uint32 PreparedFrames = 0;
+
+	TMap<FIntPoint, FActorRepListRefView> Cells;
+
+	/** Characters whose cull distance this node widened for each connection, so it can be put back when they leave the connection's 3x3 cells */
+	TMap<TObjectKey<UNetReplicationGraphConnection>, TSet<AActor*>> WidenedActorsByConnection;
+};
+
+
+/** Always relevant party ID **/
+UCLASS()
+class UOWSReplicationGraphNode_AlwaysRelevantToParty : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+
+	UOWSReplicationGraphNode_AlwaysRelevantToParty();
+
+	int32 PartyID;
+	bool UpdatePerConnectionCullDistance;
+	TArray<AOWSPlayerState*> PlayerStates;
+
+	/** The connection each of PlayerStates joined on, so the node can still be detached after the player state loses it */
+	TArray<UNetConnection*> NetConnections;
+
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+	virtual void PrepareForReplication() override;
+	virtual void LogNode(FReplicationGraphDebugInfo& DebugInfo, const FString& NodeName) const override;
+
+private:
+
+	FActorRepListRefView ReplicationActorList;
+};
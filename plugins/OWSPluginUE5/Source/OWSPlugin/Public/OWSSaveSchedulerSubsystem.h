@@ -0,0 +1,76 @@
+// Copyright 2022 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OWSPlugin.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "OWSSaveSchedulerSubsystem.generated.h"
+
+class AOWSGameMode;
+
+//Save bookkeeping for one registered player
+struct FOWSPlayerSaveState
+{
+	double LastSaveTime = 0.0;
+	bool bDirty = false;
+	TWeakObjectPtr<USceneComponent> WatchedRootComponent;
+	FDelegateHandle TransformUpdatedHandle;
+	FDelegateHandle NewPawnHandle;
+};
+
+//Entry in the dirty heap.  The stalest player is always on top.
+struct FOWSDirtyPlayer
+{
+	double LastSaveTime = 0.0;
+	TWeakObjectPtr<APlayerController> PlayerController;
+
+	bool operator<(const FOWSDirtyPlayer& Other) const { return LastSaveTime < Other.LastSaveTime; }
+};
+
+/**
+ * Saves player locations on the server as players move.
+ * A player is marked dirty when their pawn's transform changes. Each frame, dirty players are saved stalest first until
+ * AOWSGameMode::SaveSchedulerBudgetMilliseconds is used up. A player is saved at most once every SaveIntervalInSeconds.
+ * Players are flushed immediately on logout and zone travel.
+ */
+UCLASS()
+class OWSPLUGIN_API UOWSSaveSchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterPlayer(APlayerController* PlayerController);
+	//Flushes the player's location and stops tracking them
+	void UnregisterPlayer(APlayerController* PlayerController);
+
+	UFUNCTION(BlueprintCallable, Category = "Save")
+		void MarkPlayerDirty(APlayerController* PlayerController);
+
+	//Saves the player's location now, without waiting for their turn
+	UFUNCTION(BlueprintCallable, Category = "Save")
+		void FlushPlayer(APlayerController* PlayerController);
+
+	UFUNCTION(BlueprintCallable, Category = "Save")
+		void FlushAllPlayers();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	AOWSGameMode* GetOWSGameMode() const;
+
+	void WatchPawn(APlayerController* PlayerController, APawn* Pawn);
+	void StopWatchingPawn(FOWSPlayerSaveState& SaveState);
+
+	void OnNewPawn(APawn* NewPawn, TWeakObjectPtr<APlayerController> PlayerController);
+	void OnPawnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, TWeakObjectPtr<APlayerController> PlayerController);
+
+	TMap<TWeakObjectPtr<APlayerController>, FOWSPlayerSaveState> Players;
+	TArray<FOWSDirtyPlayer> DirtyPlayers;
+};
@@ -0,0 +1,112 @@
+// Copyright 2022 Sabre Dart Studios
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OWSPlugin.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/Function.h"
+#include "OWSTargetingSubsystem.generated.h"
+
+struct FOWSGameplayTargetDataFilter;
+
+enum class EOWSTargetingShape : uint8
+{
+	Sphere,
+	Cone,
+	Box
+};
+
+//One area to find pawns in.  Pawns are treated as spheres of their collision radius around their actor location.
+struct OWSPLUGIN_API FOWSTargetingQuery
+{
+	EOWSTargetingShape Shape = EOWSTargetingShape::Sphere;
+	FVector Origin = FVector::ZeroVector;
+
+	//Sphere and cone
+	float Radius = 0.f;
+
+	//Cone.  Pawns whose center is within the half angle of Forward pass, tested as a dot product against CosHalfAngle.
+	FVector Forward = FVector::ForwardVector;
+	float CosHalfAngle = -1.f;
+
+	//Box
+	FQuat Rotation = FQuat::Identity;
+	FVector BoxExtent = FVector::ZeroVector;
+
+	//Pawns on this team are skipped before any other test.  0 for no team filter.
+	int32 ExcludedTeamNumber = 0;
+
+	static FOWSTargetingQuery MakeSphere(const FVector& Origin, float Radius);
+	static FOWSTargetingQuery MakeCone(const FVector& Origin, const FVector& Forward, float Radius, float HalfAngleDegrees);
+	static FOWSTargetingQuery MakeBox(const FVector& Origin, const FQuat& Rotation, const FVector& BoxExtent);
+
+	//Skips Filter.TeamNumber the same way FOWSGameplayTargetDataFilter::FilterPassesForActor does, without touching the pawns
+	void SetTeamFilter(const FOWSGameplayTargetDataFilter& Filter);
+};
+
+//A run of pawns in SortedPawns that share a grid cell
+struct FOWSTargetingCell
+{
+	int32 Start = 0;
+	int32 Num = 0;
+};
+
+/**
+ * Server-side uniform grid of every pawn, rebuilt once per frame.
+ * Pawn positions are kept as separate X, Y and Z arrays sorted by cell, so a query walks a few contiguous runs and tests each pawn
+ * with plain float math instead of issuing a physics scene overlap.  Cone tests compare a dot product against a precomputed cos(half angle).
+ * Queries see pawns where they were at the start of the frame.
+ */
+UCLASS()
+class OWSPLUGIN_API UOWSTargetingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterPawn(APawn* Pawn);
+	void UnregisterPawn(APawn* Pawn);
+
+	//False on clients, which don't track anything.  Fall back to a physics query there.
+	bool IsTrackingPawns() const { return bTrackingPawns; }
+
+	//Appends every pawn inside Query that ShouldConsiderPawn accepts to OutPawns
+	void RunQuery(const FOWSTargetingQuery& Query, TFunctionRef<bool(APawn*)> ShouldConsiderPawn, TArray<APawn*>& OutPawns) const;
+
+	//Runs several queries against this frame's grid, e.g. every AoE of a raid boss this frame, reusing one scratch buffer.  OutPawns[i] holds the results of Queries[i].
+	void RunQueries(TConstArrayView<FOWSTargetingQuery> Queries, TFunctionRef<bool(int32 QueryIndex, APawn*)> ShouldConsiderPawn, TArray<TArray<APawn*>>& OutPawns) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	void OnActorSpawned(AActor* Actor);
+
+	FIntPoint GetCell(float X, float Y) const;
+	//Indices into SortedPawns of every pawn whose cylinder reaches Query
+	void GatherQueryHits(const FOWSTargetingQuery& Query, TArray<int32>& OutIndices) const;
+	void TestRange(const FOWSTargetingQuery& Query, int32 Start, int32 Num, TArray<int32>& OutIndices) const;
+
+	float CellSize;
+	bool bTrackingPawns;
+
+	TArray<TWeakObjectPtr<APawn>> TrackedPawns;
+
+	//Rebuilt every frame, sorted by cell
+	TArray<TWeakObjectPtr<APawn>> SortedPawns;
+	TArray<float> PositionsX;
+	TArray<float> PositionsY;
+	TArray<float> PositionsZ;
+	TArray<float> Radii;
+	TArray<int32> TeamNumbers;
+	float MaxPawnRadius;
+
+	TMap<FIntPoint, FOWSTargetingCell> Cells;
+
+	FDelegateHandle ActorSpawnedHandle;
+};
@@ -84,6 +84,25 @@ namespace OWSCharacterPersistence.Controllers
             return await request.Handle();
         }
 
+        /// <summary>
+        /// Add Ability To Character Bulk
+        /// </summary>
+        /// <remarks>
+        /// Takes a JSON array of AddAbilityToCharacter requests and runs them in one call.  Returns one result per request, in the same order they were posted.
+        /// </remarks>
+        /// <param name="requests">
+        /// A list of AddAbilityToCharacter requests.  See AddAbilityToCharacter for the fields on each request.
+        /// </param>
+        [HttpPost]
+        [Route("AddAbilityToCharacterBulk")]
+        [Produces(typeof(List<SuccessAndErrorMessage>))]
+        public async Task<List<SuccessAndErrorMessage>> AddAbilityToCharacterBulk([FromBody] List<AddAbilityToCharacterRequest> requests)
+        {
+            AddAbilityToCharacterBulkRequest request = new AddAbilityToCharacterBulkRequest() { Requests = requests };
+            request.SetData(_charactersRepository, _customerGuid);
+            return await request.Handle();
+        }
+
         /// <summary>
         /// Get Character Abilities
         /// </summary>
@@ -193,5 +212,24 @@ namespace OWSCharacterPersistence.Controllers
             request.SetData(_charactersRepository, _customerGuid);
             return await request.Handle();
         }
+
+        /// <summary>
+        /// Update Ability on Character Bulk
+        /// </summary>
+        /// <remarks>
+        /// Takes a JSON array of UpdateAbilityOnCharacter requests and runs them in one call.  Returns one result per request, in the same order they were posted.
+        /// </remarks>
+        /// <param name="requests">
+        /// A list of UpdateAbilityOnCharacter requests.  See UpdateAbilityOnCharacter for the fields on each request.
+        /// </param>
+        [HttpPost]
+        [Route("UpdateAbilityOnCharacterBulk")]
+        [Produces(typeof(List<SuccessAndErrorMessage>))]
+        public async Task<List<SuccessAndErrorMessage>> UpdateAbilityOnCharacterBulk([FromBody] List<UpdateAbilityOnCharacterRequest> requests)
+        {
+            UpdateAbilityOnCharacterBulkRequest request = new UpdateAbilityOnCharacterBulkRequest() { Requests = requests };
+            request.SetData(_charactersRepository, _customerGuid);
+            return await request.Handle();
+        }
     }
 }
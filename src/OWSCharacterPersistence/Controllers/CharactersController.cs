@@ -18,12 +18,15 @@ namespace OWSCharacterPersistence.Controllers
     {
         private readonly ICharactersRepository _charactersRepository;
         private readonly IHeaderCustomerGUID _customerGuid;
+        private readonly IPlayerPositionBaselineStore _playerPositionBaselineStore;
 
         public CharactersController(ICharactersRepository charactersRepository,
-            IHeaderCustomerGUID customerGuid)
+            IHeaderCustomerGUID customerGuid,
+            IPlayerPositionBaselineStore playerPositionBaselineStore)
         {
             _charactersRepository = charactersRepository;
             _customerGuid = customerGuid;
+            _playerPositionBaselineStore = playerPositionBaselineStore;
         }
 
         [HttpPost]
@@ -36,6 +39,25 @@ namespace OWSCharacterPersistence.Controllers
             return;
         }
 
+        [HttpPost]
+        [Route("AddOrUpdateCustomDataBulk")]
+        [Produces(typeof(List<SuccessAndErrorMessage>))]
+        public async Task<List<SuccessAndErrorMessage>> AddOrUpdateCustomDataBulk([FromBody] List<AddOrUpdateCustomDataRequest> requests)
+        {
+            AddOrUpdateCustomDataBulkRequest request = new AddOrUpdateCustomDataBulkRequest() { Requests = requests };
+            request.SetData(_charactersRepository, _customerGuid);
+            return await request.Handle();
+        }
+
+        [HttpPost]
+        [Route("GetBootstrap")]
+        [Produces(typeof(CharacterBootstrap))]
+        public async Task<CharacterBootstrap> GetBootstrap([FromBody] GetBootstrapRequest request)
+        {
+            request.SetData(_charactersRepository, _customerGuid);
+            return await request.Handle();
+        }
+
         [HttpPost]
         [Route("GetByName")]
         [Produces(typeof(GetCharByCharName))]
@@ -63,6 +85,15 @@ namespace OWSCharacterPersistence.Controllers
             return await request.Handle();
         }
 
+        [HttpPost]
+        [Route("UpdateAllPlayerPositionsDelta")]
+        [Produces(typeof(UpdateAllPlayerPositionsDeltaResult))]
+        public async Task<UpdateAllPlayerPositionsDeltaResult> UpdateAllPlayerPositionsDelta([FromBody] UpdateAllPlayerPositionsDeltaRequest request)
+        {
+            request.SetData(_charactersRepository, _playerPositionBaselineStore, _customerGuid);
+            return await request.Handle();
+        }
+
         [HttpPost]
         [Route("UpdateCharacterStats")]
         [Produces(typeof(SuccessAndErrorMessage))]
@@ -72,6 +103,15 @@ namespace OWSCharacterPersistence.Controllers
             return await request.Handle();
         }
 
+        [HttpPost]
+        [Route("UpdateCharacterStatsDelta")]
+        [Produces(typeof(SuccessAndErrorMessage))]
+        public async Task<SuccessAndErrorMessage> UpdateCharacterStatsDelta([FromBody] UpdateCharacterStatsDeltaRequest request)
+        {
+            request.SetData(_charactersRepository, _customerGuid);
+            return await request.Handle();
+        }
+
         [HttpPost]
         [Route("PlayerLogout")]
         [Produces(typeof(SuccessAndErrorMessage))]
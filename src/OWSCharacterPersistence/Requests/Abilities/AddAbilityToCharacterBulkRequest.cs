@@ -0,0 +1,56 @@
+﻿using OWSData.Models.Composites;
+using OWSData.Repositories.Interfaces;
+using OWSShared.Interfaces;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace OWSCharacterPersistence.Requests.Abilities
+{
+    /// <summary>
+    /// Add Ability To Character Bulk
+    /// </summary>
+    /// <remarks>
+    /// Runs a batch of AddAbilityToCharacter requests and returns one result per request, in the same order they were posted.
+    /// </remarks>
+    public class AddAbilityToCharacterBulkRequest
+    {
+        /// <summary>
+        /// Requests
+        /// </summary>
+        /// <remarks>
+        /// The individual AddAbilityToCharacter requests in this batch.
+        /// </remarks>
+        public List<AddAbilityToCharacterRequest> Requests { get; set; }
+
+        private ICharactersRepository charactersRepository;
+        private IHeaderCustomerGUID customerGuid;
+
+        public void SetData(ICharactersRepository charactersRepository, IHeaderCustomerGUID customerGuid)
+        {
+            this.charactersRepository = charactersRepository;
+            this.customerGuid = customerGuid;
+        }
+
+        public async Task<List<SuccessAndErrorMessage>> Handle()
+        {
+            List<SuccessAndErrorMessage> output = new List<SuccessAndErrorMessage>();
+
+            foreach (AddAbilityToCharacterRequest request in Requests ?? new List<AddAbilityToCharacterRequest>())
+            {
+                try
+                {
+                    request.SetData(charactersRepository, customerGuid);
+                    output.Add(await request.Handle());
+                }
+                catch (Exception ex)
+                {
+                    output.Add(new SuccessAndErrorMessage() { Success = false, ErrorMessage = ex.Message });
+                }
+            }
+
+            return output;
+        }
+    }
+}
@@ -0,0 +1,56 @@
+﻿using OWSData.Models.Composites;
+using OWSData.Repositories.Interfaces;
+using OWSShared.Interfaces;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace OWSCharacterPersistence.Requests.Abilities
+{
+    /// <summary>
+    /// Update Ability On Character Bulk
+    /// </summary>
+    /// <remarks>
+    /// Runs a batch of UpdateAbilityOnCharacter requests and returns one result per request, in the same order they were posted.
+    /// </remarks>
+    public class UpdateAbilityOnCharacterBulkRequest
+    {
+        /// <summary>
+        /// Requests
+        /// </summary>
+        /// <remarks>
+        /// The individual UpdateAbilityOnCharacter requests in this batch.
+        /// </remarks>
+        public List<UpdateAbilityOnCharacterRequest> Requests { get; set; }
+
+        private ICharactersRepository charactersRepository;
+        private IHeaderCustomerGUID customerGuid;
+
+        public void SetData(ICharactersRepository charactersRepository, IHeaderCustomerGUID customerGuid)
+        {
+            this.charactersRepository = charactersRepository;
+            this.customerGuid = customerGuid;
+        }
+
+        public async Task<List<SuccessAndErrorMessage>> Handle()
+        {
+            List<SuccessAndErrorMessage> output = new List<SuccessAndErrorMessage>();
+
+            foreach (UpdateAbilityOnCharacterRequest request in Requests ?? new List<UpdateAbilityOnCharacterRequest>())
+            {
+                try
+                {
+                    request.SetData(charactersRepository, customerGuid);
+                    output.Add(await request.Handle());
+                }
+                catch (Exception ex)
+                {
+                    output.Add(new SuccessAndErrorMessage() { Success = false, ErrorMessage = ex.Message });
+                }
+            }
+
+            return output;
+        }
+    }
+}
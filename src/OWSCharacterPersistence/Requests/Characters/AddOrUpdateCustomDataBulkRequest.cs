@@ -0,0 +1,53 @@
+﻿using OWSData.Models.Composites;
+using OWSData.Repositories.Interfaces;
+using OWSShared.Interfaces;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace OWSCharacterPersistence.Requests.Characters
+{
+    public class AddOrUpdateCustomDataBulkRequest
+    {
+        public List<AddOrUpdateCustomDataRequest> Requests { get; set; }
+
+        private ICharactersRepository charactersRepository;
+        private IHeaderCustomerGUID customerGuid;
+
+        public void SetData(ICharactersRepository charactersRepository, IHeaderCustomerGUID customerGuid)
+        {
+            this.charactersRepository = charactersRepository;
+            this.customerGuid = customerGuid;
+        }
+
+        public async Task<List<SuccessAndErrorMessage>> Handle()
+        {
+            //One result per request, in the same order they were posted
+            List<SuccessAndErrorMessage> output = new List<SuccessAndErrorMessage>();
+
+            foreach (AddOrUpdateCustomDataRequest request in Requests ?? new List<AddOrUpdateCustomDataRequest>())
+            {
+                SuccessAndErrorMessage result = new SuccessAndErrorMessage();
+
+                try
+                {
+                    request.SetData(charactersRepository, customerGuid);
+                    await request.Handle();
+
+                    result.Success = true;
+                    result.ErrorMessage = "";
+                }
+                catch (Exception ex)
+                {
+                    result.Success = false;
+                    result.ErrorMessage = ex.Message;
+                }
+
+                output.Add(result);
+            }
+
+            return output;
+        }
+    }
+}
@@ -0,0 +1,59 @@
+﻿using OWSData.Models.Composites;
+using OWSData.Models.StoredProcs;
+using OWSData.Models.Tables;
+using OWSData.Repositories.Interfaces;
+using OWSShared.Interfaces;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace OWSCharacterPersistence.Requests.Characters
+{
+    /// <summary>
+    /// Get Bootstrap
+    /// </summary>
+    /// <remarks>
+    /// Get everything a character needs when it enters a zone in one call: character stats, Custom Data, abilities and ability bars.
+    /// Each part has the same shape as the response from GetByName, GetCustomData, GetCharacterAbilities and GetAbilityBars.
+    /// </remarks>
+    public class GetBootstrapRequest
+    {
+        /// <summary>
+        /// Character Name
+        /// </summary>
+        /// <remarks>
+        /// This is the name of the character to get bootstrap data for.
+        /// </remarks>
+        public string CharacterName { get; set; }
+
+        private Guid customerGUID;
+        private ICharactersRepository charactersRepository;
+
+        public void SetData(ICharactersRepository charactersRepository, IHeaderCustomerGUID customerGuid)
+        {
+            this.charactersRepository = charactersRepository;
+            customerGUID = customerGuid.CustomerGUID;
+        }
+
+        public async Task<CharacterBootstrap> Handle()
+        {
+            //Each repository call opens its own connection, so the queries can run at the same time
+            Task<GetCharByCharName> characterDataTask = charactersRepository.GetCharByCharName(customerGUID, CharacterName);
+            Task<IEnumerable<CustomCharacterData>> customCharacterDataTask = charactersRepository.GetCustomCharacterData(customerGUID, CharacterName);
+            Task<IEnumerable<GetCharacterAbilities>> abilitiesTask = charactersRepository.GetCharacterAbilities(customerGUID, CharacterName);
+            Task<IEnumerable<GetAbilityBars>> abilityBarsTask = charactersRepository.GetAbilityBars(customerGUID, CharacterName);
+
+            await Task.WhenAll(characterDataTask, customCharacterDataTask, abilitiesTask, abilityBarsTask);
+
+            CharacterBootstrap output = new CharacterBootstrap();
+
+            output.CharacterData = characterDataTask.Result;
+            output.CustomCharacterData = new CustomCharacterDataRows() { Rows = customCharacterDataTask.Result };
+            output.Abilities = abilitiesTask.Result;
+            output.AbilityBars = abilityBarsTask.Result;
+
+            return output;
+        }
+    }
+}
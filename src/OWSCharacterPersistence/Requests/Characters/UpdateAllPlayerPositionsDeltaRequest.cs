@@ -0,0 +1,72 @@
+﻿using OWSData.Models.Composites;
+using OWSData.Repositories.Interfaces;
+using OWSShared.Interfaces;
+using OWSShared.PositionSnapshots;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace OWSCharacterPersistence.Requests.Characters
+{
+    public class UpdateAllPlayerPositionsDeltaRequest
+    {
+        //Base64 encoded binary snapshot.  See PlayerPositionDeltaDecoder for the layout.
+        public string SerializedPlayerLocationDelta { get; set; }
+        public string MapName { get; set; }
+
+        private Guid customerGUID;
+        private ICharactersRepository charactersRepository;
+        private IPlayerPositionBaselineStore playerPositionBaselineStore;
+
+        public void SetData(ICharactersRepository charactersRepository, IPlayerPositionBaselineStore playerPositionBaselineStore, IHeaderCustomerGUID customerGuid)
+        {
+            this.charactersRepository = charactersRepository;
+            this.playerPositionBaselineStore = playerPositionBaselineStore;
+            customerGUID = customerGuid.CustomerGUID;
+        }
+
+        public async Task<UpdateAllPlayerPositionsDeltaResult> Handle()
+        {
+            UpdateAllPlayerPositionsDeltaResult output = new UpdateAllPlayerPositionsDeltaResult();
+            output.PlayersNeedingKeyframe = new List<string>();
+
+            List<PlayerPositionDelta> records;
+
+            try
+            {
+                records = PlayerPositionDeltaDecoder.Decode(Convert.FromBase64String(SerializedPlayerLocationDelta ?? ""));
+            }
+            catch (FormatException ex)
+            {
+                output.Success = false;
+                output.ErrorMessage = ex.Message;
+                return output;
+            }
+
+            foreach (PlayerPositionDelta record in records)
+            {
+                PlayerPositionBaseline baseline = null;
+
+                //The baseline store is per process, so the one we hold may not be the one the game server encoded against.
+                //Only apply a delta on top of the exact position it was made from.
+                if (!record.IsKeyframe && (!playerPositionBaselineStore.TryGetBaseline(customerGUID, record.PlayerName, out baseline) || baseline.GetHash() != record.BaselineHash))
+                {
+                    output.PlayersNeedingKeyframe.Add(record.PlayerName);
+                    continue;
+                }
+
+                PlayerPositionBaseline position = (baseline ?? new PlayerPositionBaseline()).Apply(record);
+                playerPositionBaselineStore.SetBaseline(customerGUID, record.PlayerName, position);
+
+                await charactersRepository.UpdatePosition(customerGUID, record.PlayerName, MapName, position.GetX(), position.GetY(), position.GetZ(),
+                    position.GetRX(), position.GetRY(), position.GetRZ());
+            }
+
+            output.Success = true;
+            output.ErrorMessage = "";
+
+            return output;
+        }
+    }
+}
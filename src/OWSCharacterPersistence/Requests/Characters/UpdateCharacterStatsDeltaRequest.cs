@@ -0,0 +1,51 @@
+﻿using OWSData.Models.Composites;
+using OWSData.Models.StoredProcs;
+using OWSData.Repositories.Interfaces;
+using OWSShared.Interfaces;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace OWSCharacterPersistence.Requests.Characters
+{
+    //Saves only the stats that changed since the character's last save.  Stats are keyed by Characters column name.
+    public class UpdateCharacterStatsDeltaRequest
+    {
+        public UpdateCharacterStatsDelta updateCharacterStatsDelta { get; set; }
+
+        private Guid customerGUID;
+        private ICharactersRepository charactersRepository;
+
+        public void SetData(ICharactersRepository charactersRepository, IHeaderCustomerGUID customerGuid)
+        {
+            this.charactersRepository = charactersRepository;
+            customerGUID = customerGuid.CustomerGUID;
+        }
+
+        public async Task<SuccessAndErrorMessage> Handle()
+        {
+            SuccessAndErrorMessage successAndErrorMessage = new SuccessAndErrorMessage();
+            successAndErrorMessage.Success = true;
+
+            if (updateCharacterStatsDelta == null || String.IsNullOrEmpty(updateCharacterStatsDelta.CharName))
+            {
+                successAndErrorMessage.ErrorMessage = "No character name was sent";
+                successAndErrorMessage.Success = false;
+                return successAndErrorMessage;
+            }
+
+            try
+            {
+                await charactersRepository.UpdateCharacterStatsDelta(customerGUID, updateCharacterStatsDelta);
+            }
+            catch (Exception ex)
+            {
+                successAndErrorMessage.ErrorMessage = ex.Message;
+                successAndErrorMessage.Success = false;
+            }
+
+            return successAndErrorMessage;
+        }
+    }
+}
@@ -152,6 +152,7 @@ namespace OWSCharacterPersistence
                 }
             }
             container.Register<IHeaderCustomerGUID, HeaderCustomerGUID>(Lifestyle.Scoped);
+            container.Register<IPlayerPositionBaselineStore, InMemoryPlayerPositionBaselineStore>(Lifestyle.Singleton);
 
             var provider = services.BuildServiceProvider();
             container.RegisterInstance<IServiceProvider>(provider);
@@ -0,0 +1,129 @@
+﻿using System.Collections.Generic;
+using System.Linq;
+using OWSChatRelay.Models;
+
+namespace OWSChatRelay
+{
+    /// <summary>
+    /// Routes chat between the zone servers of one customer.
+    /// </summary>
+    /// <remarks>
+    /// Every message gets the next ChatMessageID.  Group messages go to the zone servers that have told us they have a member of that group.
+    /// Global and private messages go to every zone server, and each AOWSChatManager only delivers them to its own players.
+    /// </remarks>
+    public class ChatRelayRouter
+    {
+        private readonly object routeLock = new object();
+        private readonly HashSet<string> connectionIDs = new HashSet<string>();
+        //Chat group name -> zone server connection -> characters in that group on that zone server
+        private readonly Dictionary<string, Dictionary<string, HashSet<string>>> chatGroupMembers = new Dictionary<string, Dictionary<string, HashSet<string>>>();
+        private int lastChatMessageID;
+
+        public void AddConnection(string connectionID)
+        {
+            lock (routeLock)
+            {
+                connectionIDs.Add(connectionID);
+            }
+        }
+
+        //The zone server sends its group members again when it reconnects
+        public void RemoveConnection(string connectionID)
+        {
+            lock (routeLock)
+            {
+                connectionIDs.Remove(connectionID);
+
+                foreach (string chatGroupName in chatGroupMembers.Keys.ToList())
+                {
+                    chatGroupMembers[chatGroupName].Remove(connectionID);
+                    if (chatGroupMembers[chatGroupName].Count == 0)
+                    {
+                        chatGroupMembers.Remove(chatGroupName);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Applies the membership changes in a frame from a zone server and returns the frame to send to each zone server, by connection ID.
+        /// </summary>
+        public Dictionary<string, ChatRelayFrame> Route(string fromConnectionID, ChatRelayFrame frame)
+        {
+            Dictionary<string, ChatRelayFrame> output = new Dictionary<string, ChatRelayFrame>();
+
+            lock (routeLock)
+            {
+                foreach (ChatGroupMembershipChange membershipChange in frame.MembershipChanges ?? new List<ChatGroupMembershipChange>())
+                {
+                    ApplyMembershipChange(fromConnectionID, membershipChange);
+                }
+
+                foreach (ChatMessage chatMessage in frame.Messages ?? new List<ChatMessage>())
+                {
+                    chatMessage.ChatMessageID = ++lastChatMessageID;
+
+                    IEnumerable<string> recipients = connectionIDs;
+                    if (string.IsNullOrEmpty(chatMessage.SentToCharName) && !string.IsNullOrEmpty(chatMessage.ChatGroupName))
+                    {
+                        recipients = chatGroupMembers.TryGetValue(chatMessage.ChatGroupName, out Dictionary<string, HashSet<string>> members)
+                            ? members.Keys : Enumerable.Empty<string>();
+                    }
+
+                    foreach (string recipient in recipients)
+                    {
+                        if (!output.TryGetValue(recipient, out ChatRelayFrame recipientFrame))
+                        {
+                            recipientFrame = new ChatRelayFrame();
+                            output.Add(recipient, recipientFrame);
+                        }
+
+                        recipientFrame.Messages.Add(chatMessage);
+                    }
+                }
+            }
+
+            return output;
+        }
+
+        private void ApplyMembershipChange(string connectionID, ChatGroupMembershipChange membershipChange)
+        {
+            if (string.IsNullOrEmpty(membershipChange.ChatGroupName) || string.IsNullOrEmpty(membershipChange.CharacterName))
+            {
+                return;
+            }
+
+            if (membershipChange.Joined)
+            {
+                if (!chatGroupMembers.TryGetValue(membershipChange.ChatGroupName, out Dictionary<string, HashSet<string>> connections))
+                {
+                    connections = new Dictionary<string, HashSet<string>>();
+                    chatGroupMembers.Add(membershipChange.ChatGroupName, connections);
+                }
+
+                if (!connections.TryGetValue(connectionID, out HashSet<string> characters))
+                {
+                    characters = new HashSet<string>();
+                    connections.Add(connectionID, characters);
+                }
+
+                characters.Add(membershipChange.CharacterName);
+            }
+            else if (chatGroupMembers.TryGetValue(membershipChange.ChatGroupName, out Dictionary<string, HashSet<string>> connections)
+                && connections.TryGetValue(connectionID, out HashSet<string> characters))
+            {
+                characters.Remove(membershipChange.CharacterName);
+
+                if (characters.Count == 0)
+                {
+                    connections.Remove(connectionID);
+                }
+
+                if (connections.Count == 0)
+                {
+                    chatGroupMembers.Remove(membershipChange.ChatGroupName);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+﻿using System.Collections.Generic;
+using System.Text.Json.Serialization;
+
+namespace OWSChatRelay.Models
+{
+    /// <summary>
+    /// Mirrors FChatMessage in the plugin's OWSChatManager.h.
+    /// </summary>
+    public class ChatMessage
+    {
+        //FChatMessage::ChatMessage.  C# doesn't allow a member named after its class.
+        [JsonPropertyName("ChatMessage")]
+        public string ChatMessageText { get; set; }
+        public int ChatMessageID { get; set; }
+        public int SentByCharID { get; set; }
+        public string SentByCharName { get; set; }
+        public int SentToCharID { get; set; }
+        public string SentToCharName { get; set; }
+        public int ChatGroupID { get; set; }
+        public string ChatGroupName { get; set; }
+    }
+
+    /// <summary>
+    /// Mirrors FChatGroupMembershipChange.  A character on the sending zone server joining or leaving a chat group.
+    /// </summary>
+    public class ChatGroupMembershipChange
+    {
+        public string CharacterName { get; set; }
+        public string ChatGroupName { get; set; }
+        public bool Joined { get; set; }
+    }
+
+    /// <summary>
+    /// Mirrors FChatRelayFrame.  One WebSocket text frame in either direction.
+    /// </summary>
+    public class ChatRelayFrame
+    {
+        public List<ChatMessage> Messages { get; set; } = new List<ChatMessage>();
+        public List<ChatGroupMembershipChange> MembershipChanges { get; set; } = new List<ChatGroupMembershipChange>();
+    }
+}
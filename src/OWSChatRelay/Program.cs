@@ -0,0 +1,176 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.IO;
+using System.Net.WebSockets;
+using System.Text.Json;
+using System.Threading;
+using System.Threading.Tasks;
+using Microsoft.AspNetCore.Builder;
+using Microsoft.AspNetCore.Http;
+using Microsoft.Extensions.Logging;
+using OWSChatRelay.Models;
+
+namespace OWSChatRelay
+{
+    /// <summary>
+    /// Minimal stand-in for the chat relay that AOWSChatManager connects to with OWSChatRelayURL, for local testing of the push path.
+    /// </summary>
+    /// <remarks>
+    /// Zone servers connect with a WebSocket using the ows-chat subprotocol and an X-CustomerGUID header.  Zone servers only exchange chat with
+    /// other zone servers of the same customer.  State is in memory, so run a single instance.  Set ASPNETCORE_URLS to choose the port, and point
+    /// OWSChatRelayURL at it, for example ws://localhost:5000/.
+    /// </remarks>
+    public class Program
+    {
+        private const string SubProtocol = "ows-chat";
+
+        private static readonly JsonSerializerOptions jsonOptions = new JsonSerializerOptions() { PropertyNameCaseInsensitive = true };
+        private static readonly ConcurrentDictionary<string, ChatRelayRouter> routersByCustomer = new ConcurrentDictionary<string, ChatRelayRouter>();
+        private static readonly ConcurrentDictionary<string, ChatRelayConnection> connections = new ConcurrentDictionary<string, ChatRelayConnection>();
+
+        public static void Main(string[] args)
+        {
+            WebApplication app = WebApplication.CreateBuilder(args).Build();
+
+            app.UseWebSockets();
+            app.Map("/", HandleZoneServer);
+            app.Run();
+        }
+
+        private static async Task HandleZoneServer(HttpContext context)
+        {
+            string customerGUID = context.Request.Headers["X-CustomerGUID"];
+
+            if (!context.WebSockets.IsWebSocketRequest || string.IsNullOrEmpty(customerGUID))
+            {
+                context.Response.StatusCode = StatusCodes.Status400BadRequest;
+                return;
+            }
+
+            ILogger logger = context.RequestServices.GetService(typeof(ILogger<Program>)) as ILogger;
+            ChatRelayRouter router = routersByCustomer.GetOrAdd(customerGUID, _ => new ChatRelayRouter());
+            ChatRelayConnection connection = new ChatRelayConnection(Guid.NewGuid().ToString(), await context.WebSockets.AcceptWebSocketAsync(SubProtocol));
+
+            connections[connection.ID] = connection;
+            router.AddConnection(connection.ID);
+            logger?.LogInformation("Zone server {ConnectionID} connected from {RemoteIpAddress}", connection.ID, context.Connection.RemoteIpAddress);
+
+            try
+            {
+                while (true)
+                {
+                    string frameJson = await connection.ReceiveTextAsync(context.RequestAborted);
+                    if (frameJson == null)
+                    {
+                        break;
+                    }
+
+                    ChatRelayFrame frame;
+                    try
+                    {
+                        frame = JsonSerializer.Deserialize<ChatRelayFrame>(frameJson, jsonOptions);
+                    }
+                    catch (JsonException ex)
+                    {
+                        logger?.LogWarning("Dropped a frame from zone server {ConnectionID} that isn't a chat relay frame: {Error}", connection.ID, ex.Message);
+                        continue;
+                    }
+
+                    if (frame == null)
+                    {
+                        continue;
+                    }
+
+                    foreach (KeyValuePair<string, ChatRelayFrame> outbound in router.Route(connection.ID, frame))
+                    {
+                        if (!connections.TryGetValue(outbound.Key, out ChatRelayConnection recipient))
+                        {
+                            continue;
+                        }
+
+                        //A recipient that just dropped is cleaned up by its own loop.  It must not take the sender down with it.
+                        try
+                        {
+                            await recipient.SendTextAsync(JsonSerializer.Serialize(outbound.Value, jsonOptions), CancellationToken.None);
+                        }
+                        catch (WebSocketException ex)
+                        {
+                            logger?.LogInformation("Could not send to zone server {ConnectionID}: {Error}", recipient.ID, ex.Message);
+                        }
+                    }
+                }
+            }
+            catch (Exception ex) when (ex is WebSocketException || ex is OperationCanceledException)
+            {
+                logger?.LogInformation("Zone server {ConnectionID} connection lost: {Error}", connection.ID, ex.Message);
+            }
+            finally
+            {
+                router.RemoveConnection(connection.ID);
+                connections.TryRemove(connection.ID, out _);
+                logger?.LogInformation("Zone server {ConnectionID} disconnected", connection.ID);
+            }
+        }
+    }
+
+    /// <summary>
+    /// One zone server's WebSocket.  Sends are serialized because a WebSocket allows only one send at a time.
+    /// </summary>
+    public class ChatRelayConnection
+    {
+        public string ID { get; }
+
+        private readonly WebSocket socket;
+        private readonly SemaphoreSlim sendLock = new SemaphoreSlim(1, 1);
+
+        public ChatRelayConnection(string id, WebSocket socket)
+        {
+            ID = id;
+            this.socket = socket;
+        }
+
+        //Returns null when the zone server closes the connection
+        public async Task<string> ReceiveTextAsync(CancellationToken cancellationToken)
+        {
+            byte[] buffer = new byte[16 * 1024];
+            using MemoryStream message = new MemoryStream();
+
+            while (true)
+            {
+                WebSocketReceiveResult result = await socket.ReceiveAsync(new ArraySegment<byte>(buffer), cancellationToken);
+
+                if (result.MessageType == WebSocketMessageType.Close)
+                {
+                    await socket.CloseOutputAsync(WebSocketCloseStatus.NormalClosure, "", cancellationToken);
+                    return null;
+                }
+
+                message.Write(buffer, 0, result.Count);
+
+                if (result.EndOfMessage)
+                {
+                    return System.Text.Encoding.UTF8.GetString(message.GetBuffer(), 0, (int)message.Length);
+                }
+            }
+        }
+
+        public async Task SendTextAsync(string text, CancellationToken cancellationToken)
+        {
+            byte[] payload = System.Text.Encoding.UTF8.GetBytes(text);
+
+            await sendLock.WaitAsync(cancellationToken);
+            try
+            {
+                if (socket.State == WebSocketState.Open)
+                {
+                    await socket.SendAsync(new ArraySegment<byte>(payload), WebSocketMessageType.Text, true, cancellationToken);
+                }
+            }
+            finally
+            {
+                sendLock.Release();
+            }
+        }
+    }
+}
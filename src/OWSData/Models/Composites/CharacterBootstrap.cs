@@ -0,0 +1,15 @@
+﻿using OWSData.Models.StoredProcs;
+using System;
+using System.Collections.Generic;
+using System.Text;
+
+namespace OWSData.Models.Composites
+{
+    public class CharacterBootstrap
+    {
+        public GetCharByCharName CharacterData { get; set; }
+        public CustomCharacterDataRows CustomCharacterData { get; set; }
+        public IEnumerable<GetCharacterAbilities> Abilities { get; set; }
+        public IEnumerable<GetAbilityBars> AbilityBars { get; set; }
+    }
+}
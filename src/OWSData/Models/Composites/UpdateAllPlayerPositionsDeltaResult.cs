@@ -0,0 +1,15 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace OWSData.Models.Composites
+{
+    public class UpdateAllPlayerPositionsDeltaResult
+    {
+        public bool Success { get; set; }
+        public string ErrorMessage { get; set; }
+        //Players whose delta could not be applied because there was no baseline, or it wasn't the one the delta was made from.  The next save for these players must be a keyframe.
+        public List<string> PlayersNeedingKeyframe { get; set; }
+    }
+}
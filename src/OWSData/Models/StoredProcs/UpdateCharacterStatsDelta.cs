@@ -0,0 +1,14 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Text;
+
+namespace OWSData.Models.StoredProcs
+{
+    //Only the stats that changed since the last save, keyed by column name
+    public class UpdateCharacterStatsDelta
+    {
+        public string CharName { get; set; }
+        public Dictionary<string, float> FloatStats { get; set; }
+        public Dictionary<string, int> IntStats { get; set; }
+    }
+}
@@ -423,6 +423,45 @@ namespace OWSData.Repositories.Implementations.MySQL
             }
         }
 
+        public async Task UpdateCharacterStatsDelta(Guid customerGUID, UpdateCharacterStatsDelta updateCharacterStatsDelta)
+        {
+            var p = new DynamicParameters();
+            p.Add("@CustomerGUID", customerGUID);
+            p.Add("@CharName", updateCharacterStatsDelta.CharName);
+
+            List<string> columnNames = new List<string>();
+
+            if (updateCharacterStatsDelta.FloatStats != null)
+            {
+                foreach (KeyValuePair<string, float> stat in updateCharacterStatsDelta.FloatStats)
+                {
+                    columnNames.Add(stat.Key);
+                    p.Add("@" + stat.Key, stat.Value);
+                }
+            }
+
+            if (updateCharacterStatsDelta.IntStats != null)
+            {
+                foreach (KeyValuePair<string, int> stat in updateCharacterStatsDelta.IntStats)
+                {
+                    columnNames.Add(stat.Key);
+                    p.Add("@" + stat.Key, stat.Value);
+                }
+            }
+
+            if (columnNames.Count == 0)
+            {
+                return;
+            }
+
+            using (Connection)
+            {
+                await Connection.ExecuteAsync(GenericQueries.BuildUpdateCharacterStatsDelta(columnNames).Replace("Range = ", "`Range` = "), // TODO Remove post Table cleanup
+                    p,
+                    commandType: CommandType.Text);
+            }
+        }
+
         public async Task UpdatePosition(Guid customerGUID, string characterName, string mapName, float X, float Y, float Z, float RX, float RY, float RZ)
         {
             using (Connection)
@@ -453,6 +453,45 @@ namespace OWSData.Repositories.Implementations.Postgres
             }
         }
 
+        public async Task UpdateCharacterStatsDelta(Guid customerGUID, UpdateCharacterStatsDelta updateCharacterStatsDelta)
+        {
+            var p = new DynamicParameters();
+            p.Add("@CustomerGUID", customerGUID);
+            p.Add("@CharName", updateCharacterStatsDelta.CharName);
+
+            List<string> columnNames = new List<string>();
+
+            if (updateCharacterStatsDelta.FloatStats != null)
+            {
+                foreach (KeyValuePair<string, float> stat in updateCharacterStatsDelta.FloatStats)
+                {
+                    columnNames.Add(stat.Key);
+                    p.Add("@" + stat.Key, stat.Value);
+                }
+            }
+
+            if (updateCharacterStatsDelta.IntStats != null)
+            {
+                foreach (KeyValuePair<string, int> stat in updateCharacterStatsDelta.IntStats)
+                {
+                    columnNames.Add(stat.Key);
+                    p.Add("@" + stat.Key, stat.Value);
+                }
+            }
+
+            if (columnNames.Count == 0)
+            {
+                return;
+            }
+
+            using (var connection = (NpgsqlConnection)Connection)
+            {
+                await connection.ExecuteAsync(GenericQueries.BuildUpdateCharacterStatsDelta(columnNames).Replace("@CustomerGUID", "@CustomerGUID::uuid"), // NOTE Postgres text=>uuid
+                    p,
+                    commandType: CommandType.Text);
+            }
+        }
+
         public async Task UpdatePosition(Guid customerGUID, string characterName, string mapName, float X, float Y, float Z, float RX, float RY, float RZ)
         {
             using (var connection = (NpgsqlConnection)Connection)
@@ -18,6 +18,7 @@ namespace OWSData.Repositories.Interfaces
         Task<IEnumerable<DefaultCustomData>> GetDefaultCustomCharacterData(Guid customerGUID, string defaultSetName);
         Task<JoinMapByCharName> JoinMapByCharName(Guid customerGUID, string characterName, string zoneName, int playerGroupType);
         Task UpdateCharacterStats(UpdateCharacterStats updateCharacterStats);
+        Task UpdateCharacterStatsDelta(Guid customerGUID, UpdateCharacterStatsDelta updateCharacterStatsDelta);
         Task UpdatePosition(Guid customerGUID, string characterName, string mapName, float X, float Y, float Z, float RX, float RY, float RZ);
         Task PlayerLogout(Guid customerGUID, string characterName);
         Task AddAbilityToCharacter(Guid customerGUID, string abilityName, string characterName, int abilityLevel, string charHasAbilitiesCustomJSON);
@@ -279,6 +279,46 @@ namespace OWSData.SQL
 				WHERE CharName = @CharName
 				  AND CustomerGUID = @CustomerGUID";
 
+	    //Stat columns UpdateCharacterStatsDelta may set.  Column names are checked against this before they go into the SQL.
+	    public static readonly HashSet<string> CharacterStatColumns = new HashSet<string>(StringComparer.Ordinal)
+	    {
+			"CharacterLevel", "Gender", "Weight", "Size", "Fame", "Alignment", "XP", "TeamNumber", "HitDie", "Wounds",
+			"Thirst", "Hunger", "MaxHealth", "Health", "HealthRegenRate", "MaxMana", "Mana", "ManaRegenRate", "MaxEnergy", "Energy",
+			"EnergyRegenRate", "MaxFatigue", "Fatigue", "FatigueRegenRate", "MaxStamina", "Stamina", "StaminaRegenRate", "MaxEndurance",
+			"Endurance", "EnduranceRegenRate", "Strength", "Dexterity", "Constitution", "Intellect", "Wisdom", "Charisma", "Agility",
+			"Spirit", "Magic", "Fortitude", "Reflex", "Willpower", "BaseAttack", "BaseAttackBonus", "AttackPower", "AttackSpeed",
+			"CritChance", "CritMultiplier", "Haste", "SpellPower", "SpellPenetration", "Defense", "Dodge", "Parry", "Avoidance",
+			"Versatility", "Multishot", "Initiative", "NaturalArmor", "PhysicalArmor", "BonusArmor", "ForceArmor", "MagicArmor",
+			"Resistance", "ReloadSpeed", "Range", "Speed", "Gold", "Silver", "Copper", "FreeCurrency", "PremiumCurrency", "Perception",
+			"Acrobatics", "Climb", "Stealth", "Score"
+	    };
+
+	    //UPDATE for just the given stat columns.  Every column must be in CharacterStatColumns.
+	    public static string BuildUpdateCharacterStatsDelta(IEnumerable<string> columnNames)
+	    {
+		    StringBuilder setClause = new StringBuilder();
+
+		    foreach (string columnName in columnNames)
+		    {
+			    if (!CharacterStatColumns.Contains(columnName))
+			    {
+				    throw new ArgumentException($"{columnName} is not a character stat column", nameof(columnNames));
+			    }
+
+			    if (setClause.Length > 0)
+			    {
+				    setClause.Append(",\n\t\t\t\t\t");
+			    }
+
+			    setClause.Append(columnName).Append(" = @").Append(columnName);
+		    }
+
+		    return @"UPDATE Characters
+				SET	" + setClause + @"
+				WHERE CharName = @CharName
+				  AND CustomerGUID = @CustomerGUID";
+	    }
+
 	    public static readonly string UpdateCharacterZone = @"UPDATE Characters
 				SET	MapName = @ZoneName
 				WHERE CharacterID = @CharacterID
@@ -0,0 +1,25 @@
+﻿using System;
+using System.Collections.Concurrent;
+using OWSShared.PositionSnapshots;
+using OWSShared.Interfaces;
+
+namespace OWSShared.Implementations
+{
+    //Keeps the last applied position snapshot for each player so delta snapshots can be resolved without a database read.
+    //Baselines are lost on restart and are not shared between API instances.  Each delta carries the hash of the baseline it was
+    //made from, and the game server resends a keyframe for any player whose baseline is missing or doesn't match.
+    public class InMemoryPlayerPositionBaselineStore : IPlayerPositionBaselineStore
+    {
+        private readonly ConcurrentDictionary<(Guid, string), PlayerPositionBaseline> baselines = new ConcurrentDictionary<(Guid, string), PlayerPositionBaseline>();
+
+        public bool TryGetBaseline(Guid customerGUID, string playerName, out PlayerPositionBaseline baseline)
+        {
+            return baselines.TryGetValue((customerGUID, playerName), out baseline);
+        }
+
+        public void SetBaseline(Guid customerGUID, string playerName, PlayerPositionBaseline baseline)
+        {
+            baselines[(customerGUID, playerName)] = baseline;
+        }
+    }
+}
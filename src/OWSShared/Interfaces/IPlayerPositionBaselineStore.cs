@@ -0,0 +1,11 @@
+﻿using System;
+using OWSShared.PositionSnapshots;
+
+namespace OWSShared.Interfaces
+{
+    public interface IPlayerPositionBaselineStore
+    {
+        bool TryGetBaseline(Guid customerGUID, string playerName, out PlayerPositionBaseline baseline);
+        void SetBaseline(Guid customerGUID, string playerName, PlayerPositionBaseline baseline);
+    }
+}
@@ -0,0 +1,199 @@
+﻿using System;
+using System.Buffers.Binary;
+using System.Collections.Generic;
+using System.Text;
+
+namespace OWSShared.PositionSnapshots
+{
+    /// <summary>
+    /// One player record from a binary player position snapshot.
+    /// </summary>
+    /// <remarks>
+    /// Location is fixed point in units of 1 / LocationScale.  Rotation is Roll, Pitch and Yaw compressed to 16 bits per axis, the same as FRotator::CompressAxisToShort.
+    /// When IsKeyframe is false the values are deltas against the last snapshot that was applied for this player, and BaselineHash is
+    /// PlayerPositionBaseline.GetHash of the position the game server encoded them against.
+    /// </remarks>
+    public class PlayerPositionDelta
+    {
+        public const int LocationScale = 10;
+
+        public string PlayerName { get; set; }
+        public bool IsKeyframe { get; set; }
+        public uint BaselineHash { get; set; }
+        public long X { get; set; }
+        public long Y { get; set; }
+        public long Z { get; set; }
+        public int RX { get; set; }
+        public int RY { get; set; }
+        public int RZ { get; set; }
+    }
+
+    /// <summary>
+    /// Absolute quantized position of a player, as last applied from a snapshot.
+    /// </summary>
+    public class PlayerPositionBaseline
+    {
+        public long X { get; set; }
+        public long Y { get; set; }
+        public long Z { get; set; }
+        public ushort RX { get; set; }
+        public ushort RY { get; set; }
+        public ushort RZ { get; set; }
+
+        public float GetX() { return (float)X / PlayerPositionDelta.LocationScale; }
+        public float GetY() { return (float)Y / PlayerPositionDelta.LocationScale; }
+        public float GetZ() { return (float)Z / PlayerPositionDelta.LocationScale; }
+        public float GetRX() { return RX * 360f / 65536f; }
+        public float GetRY() { return RY * 360f / 65536f; }
+        public float GetRZ() { return RZ * 360f / 65536f; }
+
+        /// <summary>
+        /// 32 bit FNV-1a of X, Y, Z as little endian int64 followed by RX, RY, RZ as little endian uint16.  Matches OWSPlayerLocationSnapshot::HashPosition in the plugin.
+        /// </summary>
+        public uint GetHash()
+        {
+            uint hash = 2166136261;
+
+            void HashBytes(ulong value, int byteCount)
+            {
+                for (int byteIndex = 0; byteIndex < byteCount; byteIndex++)
+                {
+                    hash = unchecked((hash ^ (byte)(value >> (byteIndex * 8))) * 16777619);
+                }
+            }
+
+            HashBytes((ulong)X, 8);
+            HashBytes((ulong)Y, 8);
+            HashBytes((ulong)Z, 8);
+            HashBytes(RX, 2);
+            HashBytes(RY, 2);
+            HashBytes(RZ, 2);
+
+            return hash;
+        }
+
+        public PlayerPositionBaseline Apply(PlayerPositionDelta delta)
+        {
+            if (delta.IsKeyframe)
+            {
+                return new PlayerPositionBaseline()
+                {
+                    X = delta.X, Y = delta.Y, Z = delta.Z,
+                    RX = (ushort)delta.RX, RY = (ushort)delta.RY, RZ = (ushort)delta.RZ
+                };
+            }
+
+            //Rotation deltas wrap around at 16 bits, so adding them with ushort overflow lands on the right axis value
+            return new PlayerPositionBaseline()
+            {
+                X = X + delta.X, Y = Y + delta.Y, Z = Z + delta.Z,
+                RX = unchecked((ushort)(RX + delta.RX)), RY = unchecked((ushort)(RY + delta.RY)), RZ = unchecked((ushort)(RZ + delta.RZ))
+            };
+        }
+    }
+
+    /// <summary>
+    /// Decodes the binary player position snapshot sent by AOWSGameMode::SaveAllPlayerLocations.
+    /// </summary>
+    /// <remarks>
+    /// Layout (all integers are LEB128 varints, signed values are zigzag encoded):<br/>
+    /// byte Version, varint RecordCount, then per record:<br/>
+    /// varint NameLength, UTF-8 Name, byte Flags (bit 0 = keyframe), [uint32 little endian BaselineHash, deltas only], zigzag X, Y, Z, zigzag RX, RY, RZ
+    /// </remarks>
+    public static class PlayerPositionDeltaDecoder
+    {
+        public const byte Version = 2;
+        public const byte KeyframeFlag = 1;
+
+        public static List<PlayerPositionDelta> Decode(byte[] data)
+        {
+            int offset = 0;
+
+            if (data == null || data.Length < 1)
+            {
+                throw new FormatException("Player position snapshot is empty.");
+            }
+
+            if (data[offset++] != Version)
+            {
+                throw new FormatException($"Unsupported player position snapshot version {data[0]}.");
+            }
+
+            ulong recordCount = ReadVarUInt(data, ref offset);
+            //Every record takes at least 8 bytes, so a larger count can only come from a corrupt snapshot
+            if (recordCount > (ulong)data.Length)
+            {
+                throw new FormatException("Player position snapshot record count is larger than the snapshot.");
+            }
+
+            List<PlayerPositionDelta> output = new List<PlayerPositionDelta>((int)recordCount);
+
+            for (ulong recordIndex = 0; recordIndex < recordCount; recordIndex++)
+            {
+                int nameLength = (int)ReadVarUInt(data, ref offset);
+                if (nameLength < 0 || offset + nameLength + 1 > data.Length)
+                {
+                    throw new FormatException("Player position snapshot is truncated.");
+                }
+
+                PlayerPositionDelta record = new PlayerPositionDelta();
+                record.PlayerName = Encoding.UTF8.GetString(data, offset, nameLength);
+                offset += nameLength;
+
+                record.IsKeyframe = (data[offset++] & KeyframeFlag) != 0;
+
+                if (!record.IsKeyframe)
+                {
+                    if (offset + 4 > data.Length)
+                    {
+                        throw new FormatException("Player position snapshot is truncated.");
+                    }
+
+                    record.BaselineHash = BinaryPrimitives.ReadUInt32LittleEndian(new ReadOnlySpan<byte>(data, offset, 4));
+                    offset += 4;
+                }
+
+                record.X = ReadVarInt(data, ref offset);
+                record.Y = ReadVarInt(data, ref offset);
+                record.Z = ReadVarInt(data, ref offset);
+                record.RX = (int)ReadVarInt(data, ref offset);
+                record.RY = (int)ReadVarInt(data, ref offset);
+                record.RZ = (int)ReadVarInt(data, ref offset);
+
+                output.Add(record);
+            }
+
+            return output;
+        }
+
+        private static ulong ReadVarUInt(byte[] data, ref int offset)
+        {
+            ulong value = 0;
+            int shift = 0;
+
+            while (true)
+            {
+                if (offset >= data.Length || shift > 63)
+                {
+                    throw new FormatException("Player position snapshot is truncated.");
+                }
+
+                byte b = data[offset++];
+                value |= (ulong)(b & 0x7F) << shift;
+
+                if ((b & 0x80) == 0)
+                {
+                    return value;
+                }
+
+                shift += 7;
+            }
+        }
+
+        private static long ReadVarInt(byte[] data, ref int offset)
+        {
+            ulong zigzag = ReadVarUInt(data, ref offset);
+            return (long)(zigzag >> 1) ^ -(long)(zigzag & 1);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+﻿using OWSChatRelay;
+using OWSChatRelay.Models;
+using System.Collections.Generic;
+using System.Linq;
+using Xunit;
+
+namespace OWSTests.ChatRelay
+{
+    public class ChatRelayRouterTests
+    {
+        private static ChatRelayFrame Frame(params ChatMessage[] messages)
+        {
+            return new ChatRelayFrame() { Messages = messages.ToList() };
+        }
+
+        private static ChatRelayFrame Join(string characterName, string chatGroupName, bool joined = true)
+        {
+            return new ChatRelayFrame()
+            {
+                MembershipChanges = new List<ChatGroupMembershipChange>()
+                {
+                    new ChatGroupMembershipChange() { CharacterName = characterName, ChatGroupName = chatGroupName, Joined = joined }
+                }
+            };
+        }
+
+        [Fact]
+        public void Global_Messages_Go_To_Every_Zone_Server_With_Increasing_IDs()
+        {
+            ChatRelayRouter router = new ChatRelayRouter();
+            router.AddConnection("ZoneA");
+            router.AddConnection("ZoneB");
+
+            Dictionary<string, ChatRelayFrame> output = router.Route("ZoneA", Frame(
+                new ChatMessage() { ChatMessageText = "first", SentByCharName = "Al" },
+                new ChatMessage() { ChatMessageText = "second", SentByCharName = "Al" }));
+
+            Assert.Equal(new[] { "ZoneA", "ZoneB" }, output.Keys.OrderBy(key => key));
+            Assert.Equal(new[] { 1, 2 }, output["ZoneB"].Messages.Select(message => message.ChatMessageID));
+        }
+
+        [Fact]
+        public void Group_Messages_Only_Go_To_Zone_Servers_With_A_Member()
+        {
+            ChatRelayRouter router = new ChatRelayRouter();
+            router.AddConnection("ZoneA");
+            router.AddConnection("ZoneB");
+            router.AddConnection("ZoneC");
+            router.Route("ZoneB", Join("Bob", "Guild"));
+
+            Dictionary<string, ChatRelayFrame> output = router.Route("ZoneA", Frame(new ChatMessage() { ChatMessageText = "hi", SentByCharName = "Al", ChatGroupName = "Guild" }));
+
+            Assert.Equal("ZoneB", output.Keys.Single());
+        }
+
+        [Fact]
+        public void Leaving_Or_Disconnecting_Stops_Group_Messages()
+        {
+            ChatRelayRouter router = new ChatRelayRouter();
+            router.AddConnection("ZoneA");
+            router.AddConnection("ZoneB");
+            router.AddConnection("ZoneC");
+            router.Route("ZoneB", Join("Bob", "Guild"));
+            router.Route("ZoneC", Join("Cy", "Guild"));
+
+            router.Route("ZoneB", Join("Bob", "Guild", false));
+            router.RemoveConnection("ZoneC");
+
+            Dictionary<string, ChatRelayFrame> output = router.Route("ZoneA", Frame(new ChatMessage() { ChatMessageText = "hi", SentByCharName = "Al", ChatGroupName = "Guild" }));
+
+            Assert.Empty(output);
+        }
+    }
+}
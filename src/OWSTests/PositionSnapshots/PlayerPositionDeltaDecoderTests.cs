@@ -0,0 +1,134 @@
+﻿using OWSShared.PositionSnapshots;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using Xunit;
+
+namespace OWSTests.PositionSnapshots
+{
+    public class PlayerPositionDeltaDecoderTests
+    {
+        //Mirrors the encoder in AOWSGameMode::SaveAllPlayerLocations
+        private static void WriteVarUInt(List<byte> output, ulong value)
+        {
+            while (value >= 0x80)
+            {
+                output.Add((byte)(value | 0x80));
+                value >>= 7;
+            }
+            output.Add((byte)value);
+        }
+
+        private static void WriteVarInt(List<byte> output, long value)
+        {
+            WriteVarUInt(output, (ulong)((value << 1) ^ (value >> 63)));
+        }
+
+        private static void WriteRecord(List<byte> output, string playerName, bool isKeyframe, long x, long y, long z, int rx, int ry, int rz, uint baselineHash = 0)
+        {
+            byte[] name = Encoding.UTF8.GetBytes(playerName);
+            WriteVarUInt(output, (ulong)name.Length);
+            output.AddRange(name);
+            output.Add(isKeyframe ? PlayerPositionDeltaDecoder.KeyframeFlag : (byte)0);
+            if (!isKeyframe)
+            {
+                output.Add((byte)baselineHash);
+                output.Add((byte)(baselineHash >> 8));
+                output.Add((byte)(baselineHash >> 16));
+                output.Add((byte)(baselineHash >> 24));
+            }
+            WriteVarInt(output, x);
+            WriteVarInt(output, y);
+            WriteVarInt(output, z);
+            WriteVarInt(output, rx);
+            WriteVarInt(output, ry);
+            WriteVarInt(output, rz);
+        }
+
+        [Fact]
+        public void Keyframe_And_Delta_Decode_To_Absolute_Position()
+        {
+            List<byte> keyframe = new List<byte> { PlayerPositionDeltaDecoder.Version };
+            WriteVarUInt(keyframe, 1);
+            WriteRecord(keyframe, "Tester", true, 12345, -678, 1000, 0, 16384, 65000);
+
+            PlayerPositionDelta keyframeRecord = PlayerPositionDeltaDecoder.Decode(keyframe.ToArray()).Single();
+            PlayerPositionBaseline baseline = new PlayerPositionBaseline().Apply(keyframeRecord);
+
+            List<byte> delta = new List<byte> { PlayerPositionDeltaDecoder.Version };
+            WriteVarUInt(delta, 1);
+            WriteRecord(delta, "Tester", false, -45, 8, 0, 0, -16384, 1036, baseline.GetHash());
+
+            PlayerPositionDelta deltaRecord = PlayerPositionDeltaDecoder.Decode(delta.ToArray()).Single();
+
+            Assert.Equal("Tester", keyframeRecord.PlayerName);
+            Assert.True(keyframeRecord.IsKeyframe);
+            Assert.False(deltaRecord.IsKeyframe);
+            Assert.Equal(baseline.GetHash(), deltaRecord.BaselineHash);
+
+            PlayerPositionBaseline position = baseline.Apply(deltaRecord);
+
+            Assert.Equal(1230f, position.GetX());
+            Assert.Equal(-67f, position.GetY());
+            Assert.Equal(100f, position.GetZ());
+            Assert.Equal(0f, position.GetRY());
+            //65000 + 1036 wraps around to 500
+            Assert.Equal((ushort)500, position.RZ);
+        }
+
+        [Fact]
+        public void Baseline_Hash_Matches_The_Plugin_Encoder()
+        {
+            //Same input and expected value as OWSPlayerLocationSnapshot::HashPosition.  If this changes, deltas from the game server will never match.
+            PlayerPositionBaseline baseline = new PlayerPositionBaseline() { X = 12345, Y = -678, Z = 1000, RX = 0, RY = 16384, RZ = 65000 };
+
+            Assert.Equal(0x94FD09B1u, baseline.GetHash());
+        }
+
+        [Fact]
+        public void Baseline_Hash_Changes_When_The_Baseline_Differs()
+        {
+            PlayerPositionBaseline baseline = new PlayerPositionBaseline() { X = 12345, Y = -678, Z = 1000, RX = 0, RY = 16384, RZ = 65000 };
+            PlayerPositionBaseline stale = new PlayerPositionBaseline() { X = 12345, Y = -678, Z = 1001, RX = 0, RY = 16384, RZ = 65000 };
+
+            Assert.NotEqual(baseline.GetHash(), stale.GetHash());
+        }
+
+        [Fact]
+        public void Delta_Without_Baseline_Hash_Is_Rejected()
+        {
+            byte[] name = Encoding.UTF8.GetBytes("Tester");
+            List<byte> snapshot = new List<byte> { PlayerPositionDeltaDecoder.Version };
+            WriteVarUInt(snapshot, 1);
+            WriteVarUInt(snapshot, (ulong)name.Length);
+            snapshot.AddRange(name);
+            snapshot.Add(0);
+            snapshot.Add(0);
+
+            Assert.Throws<FormatException>(() => PlayerPositionDeltaDecoder.Decode(snapshot.ToArray()));
+        }
+
+        [Fact]
+        public void Empty_Snapshot_Decodes_To_No_Records()
+        {
+            Assert.Empty(PlayerPositionDeltaDecoder.Decode(new byte[] { PlayerPositionDeltaDecoder.Version, 0 }));
+        }
+
+        [Fact]
+        public void Truncated_Snapshot_Is_Rejected()
+        {
+            List<byte> snapshot = new List<byte> { PlayerPositionDeltaDecoder.Version };
+            WriteVarUInt(snapshot, 2);
+            WriteRecord(snapshot, "Tester", true, 1, 2, 3, 4, 5, 6);
+
+            Assert.Throws<FormatException>(() => PlayerPositionDeltaDecoder.Decode(snapshot.ToArray()));
+        }
+
+        [Fact]
+        public void Unknown_Version_Is_Rejected()
+        {
+            Assert.Throws<FormatException>(() => PlayerPositionDeltaDecoder.Decode(new byte[] { 99, 0 }));
+        }
+    }
+}